@@ -0,0 +1,95 @@
+// LAF Base Library
+// Copyright (c) 2025 Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "base/arena.h"
+
+#include "base/debug.h"
+
+#include <algorithm>
+
+namespace base {
+
+arena::arena(const size_t block_size) : m_block_size(std::max<size_t>(block_size, 64))
+{
+}
+
+arena::~arena()
+{
+  release();
+}
+
+void arena::release()
+{
+  for (block& b : m_blocks)
+    base_free(b.data);
+  m_blocks.clear();
+  m_current = 0;
+  m_offset = 0;
+}
+
+size_t arena::used() const
+{
+  size_t n = m_offset;
+  for (size_t i = 0; i < m_current && i < m_blocks.size(); ++i)
+    n += m_blocks[i].size;
+  return n;
+}
+
+size_t arena::capacity() const
+{
+  size_t n = 0;
+  for (const block& b : m_blocks)
+    n += b.size;
+  return n;
+}
+
+void* arena::allocate_slow(const size_t bytes, const size_t alignment)
+{
+  ASSERT(alignment > 0);
+
+  // Try to reuse the next blocks (allocated before a reset()/rewind())
+  while (m_current + 1 < m_blocks.size()) {
+    ++m_current;
+    const block& b = m_blocks[m_current];
+    const size_t offset = align_offset(b, 0, alignment);
+    if (offset + bytes <= b.size) {
+      m_offset = offset + bytes;
+      return b.data + offset;
+    }
+  }
+
+  // Each new block is twice the size of the previous one (up to
+  // kMaxBlockSize) so the number of blocks is kept small.
+  size_t size = m_block_size;
+  if (!m_blocks.empty())
+    size = std::max(size, std::min(m_blocks.back().size * 2, kMaxBlockSize));
+  size = std::max(size, bytes + alignment);
+
+  auto* data = static_cast<uint8_t*>(base_malloc(size));
+  if (!data)
+    throw std::bad_alloc();
+
+  m_blocks.push_back(block{ data, size });
+  m_current = m_blocks.size() - 1;
+
+  const block& b = m_blocks[m_current];
+  const size_t offset = align_offset(b, 0, alignment);
+  m_offset = offset + bytes;
+  return b.data + offset;
+}
+
+// static
+arena& arena::per_thread()
+{
+  static thread_local arena a;
+  return a;
+}
+
+} // namespace base
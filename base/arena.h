@@ -0,0 +1,204 @@
+// LAF Base Library
+// Copyright (c) 2025 Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef BASE_ARENA_H_INCLUDED
+#define BASE_ARENA_H_INCLUDED
+#pragma once
+
+#include "base/config.h"
+#include "base/disable_copying.h"
+#include "base/memory.h"
+
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#if HAVE_MEMORY_RESOURCE
+  #include <memory_resource>
+#endif
+
+namespace base {
+
+// Monotonic allocator: memory is allocated incrementally from big
+// blocks, deallocate() does nothing, and all the memory is freed at
+// once with reset() (which keeps the blocks to be reused in the
+// next round of allocations, so after a warm-up period an arena
+// doesn't touch the heap at all).
+//
+// Useful for short-lived data (e.g. temporary vectors for one
+// frame, one shaped string, etc.). It's not thread-safe, but each
+// thread has its own arena in arena::per_thread().
+class arena {
+public:
+  static constexpr size_t kDefaultBlockSize = 4096;
+  static constexpr size_t kMaxBlockSize = 1024 * 1024;
+
+  // Position in the arena to rewind to (see arena_scope).
+  struct mark {
+    size_t block;
+    size_t offset;
+  };
+
+  explicit arena(size_t block_size = kDefaultBlockSize);
+  ~arena();
+
+  void* allocate(size_t bytes, size_t alignment = base_alignment)
+  {
+    if (m_current < m_blocks.size()) {
+      block& b = m_blocks[m_current];
+      const size_t offset = align_offset(b, m_offset, alignment);
+      if (offset + bytes <= b.size) {
+        m_offset = offset + bytes;
+        return b.data + offset;
+      }
+    }
+    return allocate_slow(bytes, alignment);
+  }
+
+  void deallocate(void*, size_t, size_t = base_alignment) {}
+
+  // Creates an object in the arena. Destructors are never called
+  // so only trivially destructible types are allowed.
+  template<typename T, typename... Args>
+  T* make(Args&&... args)
+  {
+    static_assert(std::is_trivially_destructible_v<T>,
+                  "Objects in a base::arena are not destroyed");
+    return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+
+  // Frees all the allocated memory at once, but keeps the blocks to
+  // be reused.
+  void reset() { rewind(mark{ 0, 0 }); }
+
+  // Frees all the allocated memory and the blocks.
+  void release();
+
+  mark get_mark() const { return mark{ m_current, m_offset }; }
+  void rewind(const mark& m)
+  {
+    m_current = m.block;
+    m_offset = m.offset;
+  }
+
+  // Bytes allocated from the arena since the last reset (including
+  // padding for alignment and unused space at the end of blocks).
+  size_t used() const;
+
+  // Total size of all blocks.
+  size_t capacity() const;
+
+  // Number of blocks allocated from the heap.
+  size_t block_count() const { return m_blocks.size(); }
+
+  // Returns an arena for the current thread. Use arena_scope to
+  // free the memory used from it.
+  static arena& per_thread();
+
+  DISABLE_COPYING(arena);
+
+private:
+  struct block {
+    uint8_t* data;
+    size_t size;
+  };
+
+  static size_t align_offset(const block& b, const size_t offset, const size_t alignment)
+  {
+    const uintptr_t ptr = uintptr_t(b.data) + offset;
+    return offset + ((alignment - (ptr % alignment)) % alignment);
+  }
+
+  void* allocate_slow(size_t bytes, size_t alignment);
+
+  std::vector<block> m_blocks;
+  size_t m_current = 0;
+  size_t m_offset = 0;
+  size_t m_block_size;
+};
+
+// Frees all the memory allocated from the arena after the creation
+// of the arena_scope when it's destroyed. Scopes can be nested, so
+// it's safe to use the arena::per_thread() arena from different
+// functions of the same call stack.
+class arena_scope {
+public:
+  explicit arena_scope(arena& a = arena::per_thread()) : m_arena(a), m_mark(a.get_mark()) {}
+  ~arena_scope() { m_arena.rewind(m_mark); }
+
+  arena& get() const { return m_arena; }
+
+  DISABLE_COPYING(arena_scope);
+
+private:
+  arena& m_arena;
+  arena::mark m_mark;
+};
+
+// STL allocator to use an arena in std containers, e.g.
+//
+//   base::arena_scope scope;
+//   std::vector<int, base::arena_allocator<int>> v(scope.get());
+//
+template<typename T>
+class arena_allocator {
+public:
+  using value_type = T;
+
+  arena_allocator(arena& a) : m_arena(&a) {}
+  arena_allocator(const arena_allocator& other) = default;
+  template<typename U>
+  arena_allocator(const arena_allocator<U>& other) : m_arena(other.get_arena())
+  {
+  }
+
+  T* allocate(size_t n) { return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T))); }
+  void deallocate(T*, size_t) {}
+
+  arena* get_arena() const { return m_arena; }
+
+  template<typename U>
+  bool operator==(const arena_allocator<U>& other) const
+  {
+    return m_arena == other.get_arena();
+  }
+  template<typename U>
+  bool operator!=(const arena_allocator<U>& other) const
+  {
+    return m_arena != other.get_arena();
+  }
+
+private:
+  arena* m_arena;
+};
+
+#if HAVE_MEMORY_RESOURCE
+// Adapter to use an arena with std::pmr containers.
+class arena_resource : public std::pmr::memory_resource {
+public:
+  explicit arena_resource(arena& a = arena::per_thread()) : m_arena(a) {}
+
+  arena& get() const { return m_arena; }
+
+private:
+  void* do_allocate(size_t bytes, size_t alignment) override
+  {
+    return m_arena.allocate(bytes, alignment);
+  }
+  void do_deallocate(void*, size_t, size_t) override {}
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+
+  arena& m_arena;
+};
+#endif
+
+} // namespace base
+
+#endif
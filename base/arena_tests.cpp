@@ -0,0 +1,103 @@
+// LAF Base Library
+// Copyright (c) 2025 Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include <gtest/gtest.h>
+
+#include "base/arena.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace base;
+
+TEST(Arena, Alignment)
+{
+  arena a;
+  for (size_t align : { 1, 2, 4, 8, 16, 32, 64 }) {
+    a.allocate(1, 1);
+    void* ptr = a.allocate(3, align);
+    EXPECT_EQ(0, uintptr_t(ptr) % align);
+  }
+}
+
+TEST(Arena, ResetReusesBlocks)
+{
+  arena a(256);
+  for (int i = 0; i < 100; ++i)
+    a.allocate(100);
+  const size_t blocks = a.block_count();
+  const size_t capacity = a.capacity();
+  EXPECT_LT(1, blocks);
+  EXPECT_LE(100 * 100, a.used());
+
+  for (int j = 0; j < 10; ++j) {
+    a.reset();
+    EXPECT_EQ(0, a.used());
+    for (int i = 0; i < 100; ++i)
+      a.allocate(100);
+    EXPECT_EQ(blocks, a.block_count());
+    EXPECT_EQ(capacity, a.capacity());
+  }
+
+  a.release();
+  EXPECT_EQ(0, a.block_count());
+}
+
+TEST(Arena, BigAllocation)
+{
+  arena a(64);
+  auto* ptr = static_cast<uint8_t*>(a.allocate(arena::kMaxBlockSize * 2));
+  ptr[0] = 1;
+  ptr[arena::kMaxBlockSize * 2 - 1] = 2;
+  EXPECT_LE(arena::kMaxBlockSize * 2, a.capacity());
+}
+
+TEST(Arena, NestedScopes)
+{
+  arena a(128);
+  {
+    arena_scope scope1(a);
+    a.allocate(64);
+    const size_t used1 = a.used();
+    {
+      arena_scope scope2(a);
+      for (int i = 0; i < 10; ++i)
+        a.allocate(64);
+      EXPECT_LT(used1, a.used());
+    }
+    EXPECT_EQ(used1, a.used());
+  }
+  EXPECT_EQ(0, a.used());
+}
+
+TEST(Arena, Allocator)
+{
+  arena_scope scope;
+  std::vector<int, arena_allocator<int>> v(scope.get());
+  for (int i = 0; i < 1000; ++i)
+    v.push_back(i);
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(i, v[i]);
+}
+
+#if HAVE_MEMORY_RESOURCE
+TEST(Arena, MemoryResource)
+{
+  arena a;
+  arena_resource res(a);
+  std::pmr::vector<int> v(&res);
+  for (int i = 0; i < 1000; ++i)
+    v.push_back(i);
+  EXPECT_EQ(999, v.back());
+  EXPECT_LT(1000 * sizeof(int), a.used());
+}
+#endif
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
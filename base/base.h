@@ -1,5 +1,5 @@
 // LAF Base Library
-// Copyright (c) 2020  Igara Studio S.A.
+// Copyright (c) 2020-2025  Igara Studio S.A.
 // Copyright (c) 2001-2016  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -40,9 +40,10 @@
 #define SGN(x) (((x) >= 0) ? 1 : -1)
 
 //////////////////////////////////////////////////////////////////////
-// Overloaded new/delete operators to detect memory-leaks
+// Overloaded new/delete operators to detect memory-leaks or profile
+// the heap
 
-#if defined __cplusplus && defined LAF_MEMLEAK
+#if defined __cplusplus && (defined LAF_MEMLEAK || defined LAF_HEAPPROF)
 
   #include <new>
 
@@ -1,5 +1,5 @@
 // LAF Base Library
-// Copyright (c) 2019-2022 Igara Studio S.A.
+// Copyright (c) 2019-2025 Igara Studio S.A.
 // Copyright (c) 2001-2016 David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -69,6 +69,17 @@ public:
     return true;
   }
 
+  // Calls merge(back, value) to merge the new value with the last
+  // element of the queue, if it returns false (or the queue is
+  // empty) the value is pushed at the end of the queue.
+  template<typename MergeFunc>
+  void push_or_merge(const T& value, MergeFunc merge)
+  {
+    const std::lock_guard lock(m_mutex);
+    if (m_queue.empty() || !merge(m_queue.back(), value))
+      m_queue.push_back(value);
+  }
+
   template<typename UnaryPredicate>
   void prioritize(UnaryPredicate p)
   {
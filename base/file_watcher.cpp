@@ -0,0 +1,51 @@
+// LAF Base Library
+// Copyright (c) 2025 Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "base/file_watcher.h"
+
+#if __linux__
+  #include "base/file_watcher_inotify.h"
+#else
+  #include "base/file_watcher_none.h"
+#endif
+
+namespace base {
+
+FileWatcher::FileWatcher(Callback&& callback, double debounce)
+  : m_impl(std::make_unique<FileWatcherImpl>(std::move(callback), debounce))
+{
+}
+
+FileWatcher::~FileWatcher()
+{
+}
+
+// static
+bool FileWatcher::isSupported()
+{
+  return FileWatcherImpl::isSupported();
+}
+
+bool FileWatcher::addPath(const std::string& path, bool recursive)
+{
+  return m_impl->addPath(path, recursive);
+}
+
+void FileWatcher::removePath(const std::string& path)
+{
+  m_impl->removePath(path);
+}
+
+size_t FileWatcher::watchedCount() const
+{
+  return m_impl->watchedCount();
+}
+
+} // namespace base
@@ -0,0 +1,84 @@
+// LAF Base Library
+// Copyright (c) 2025 Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef BASE_FILE_WATCHER_H_INCLUDED
+#define BASE_FILE_WATCHER_H_INCLUDED
+#pragma once
+
+#include "base/disable_copying.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace base {
+
+struct FileChange {
+  enum class Type {
+    Created,
+    Modified,
+    Deleted,
+    // The kernel event queue overflowed and some changes were
+    // lost. "path" is empty and the client should re-scan all its
+    // watched paths.
+    Overflow,
+  };
+
+  Type type;
+  std::string path;
+
+  FileChange(Type type, const std::string& path) : type(type), path(path) {}
+};
+
+using FileChanges = std::vector<FileChange>;
+
+// Watches files and directories for changes without polling (it
+// uses inotify on Linux). Changes are coalesced by path and
+// delivered in batches, once no new changes were received for the
+// "debounce" period of time.
+//
+// The callback is called from a background thread owned by the
+// FileWatcher. Use os::queue_file_changes() as the callback to
+// receive the batches as os::Event::FilesChanged events in the UI
+// thread.
+class FileWatcher {
+public:
+  using Callback = std::function<void(const FileChanges&)>;
+
+  static constexpr const double kDefaultDebounce = 0.1; // In seconds
+
+  FileWatcher(Callback&& callback, double debounce = kDefaultDebounce);
+  ~FileWatcher();
+
+  // Returns false if there is no file change notification mechanism
+  // on this platform (in that case addPath() always fails).
+  static bool isSupported();
+
+  // Starts watching the given file or directory. If "recursive" is
+  // true and "path" is a directory, all its sub-directories (and
+  // the ones created in the future) are watched too. Returns false
+  // if the path cannot be watched (e.g. it doesn't exist or the
+  // system limit of watches was reached).
+  bool addPath(const std::string& path, bool recursive = false);
+
+  // Stops watching the given path (and its sub-directories if it was
+  // added as recursive).
+  void removePath(const std::string& path);
+
+  // Number of files/directories being watched.
+  size_t watchedCount() const;
+
+  DISABLE_COPYING(FileWatcher);
+
+private:
+  class FileWatcherImpl;
+  std::unique_ptr<FileWatcherImpl> m_impl;
+};
+
+} // namespace base
+
+#endif
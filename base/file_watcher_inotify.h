@@ -0,0 +1,354 @@
+// LAF Base Library
+// Copyright (c) 2025 Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include "base/debug.h"
+#include "base/fs.h"
+#include "base/log.h"
+#include "base/thread.h"
+#include "base/time.h"
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+class base::FileWatcher::FileWatcherImpl {
+  // Changes are delivered after "debounce" seconds without new
+  // changes, but never later than kMaxDelay times the debounce
+  // period since the first change of the batch (so a file that is
+  // being written constantly is still reported).
+  static constexpr const int kMaxDelay = 10;
+
+  static constexpr const uint32_t kFileMask = IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB |
+                                              IN_DELETE_SELF | IN_MOVE_SELF;
+  static constexpr const uint32_t kDirMask = kFileMask | IN_CREATE | IN_DELETE | IN_MOVED_FROM |
+                                             IN_MOVED_TO;
+
+  struct Watch {
+    std::string path;
+    bool recursive;
+  };
+
+  struct Pending {
+    FileChange change;
+    bool removed;
+  };
+
+public:
+  FileWatcherImpl(Callback&& callback, double debounce)
+    : m_callback(std::move(callback))
+    , m_debounce(tick_t(std::max(0.0, debounce) * 1000.0))
+    , m_running(false)
+  {
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0) {
+      LOG(ERROR, "FW: inotify_init1() failed: %s\n", std::strerror(errno));
+      return;
+    }
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_wakeFd < 0) {
+      LOG(ERROR, "FW: eventfd() failed: %s\n", std::strerror(errno));
+      close(m_fd);
+      m_fd = -1;
+      return;
+    }
+    m_running = true;
+    m_thread = std::thread([this] { threadProc(); });
+  }
+
+  ~FileWatcherImpl()
+  {
+    if (m_running) {
+      m_running = false;
+      const uint64_t one = 1;
+      if (write(m_wakeFd, &one, sizeof(one)) < 0) {
+        LOG(ERROR, "FW: Error waking up the watcher thread\n");
+      }
+      m_thread.join();
+    }
+    if (m_wakeFd >= 0)
+      close(m_wakeFd);
+    if (m_fd >= 0)
+      close(m_fd); // Removes all watches
+  }
+
+  static bool isSupported() { return true; }
+
+  bool addPath(const std::string& path, bool recursive)
+  {
+    if (m_fd < 0)
+      return false;
+
+    const std::string fixedPath = remove_path_separator(normalize_path(path));
+    const std::lock_guard lock(m_mutex);
+    return addTree(fixedPath, recursive, nullptr);
+  }
+
+  void removePath(const std::string& path)
+  {
+    if (m_fd < 0)
+      return;
+
+    const std::string fixedPath = remove_path_separator(normalize_path(path));
+    const std::lock_guard lock(m_mutex);
+    removeTree(fixedPath);
+  }
+
+  size_t watchedCount() const
+  {
+    const std::lock_guard lock(m_mutex);
+    return m_watches.size();
+  }
+
+private:
+  // Adds a watch for "path", and for all its sub-directories if
+  // "recursive" is true. If "found" is not nullptr, the items found
+  // inside the directories are added there (used to report files
+  // created inside a new directory before we were able to watch it).
+  bool addTree(const std::string& path, const bool recursive, FileChanges* found)
+  {
+    const bool isDir = is_directory(path);
+    const int wd = inotify_add_watch(m_fd, path.c_str(), (isDir ? kDirMask : kFileMask));
+    if (wd < 0) {
+      if (errno == ENOSPC) {
+        LOG(ERROR,
+            "FW: Limit of inotify watches reached (see /proc/sys/fs/inotify/max_user_watches)\n");
+      }
+      else {
+        LOG(ERROR, "FW: Cannot watch '%s': %s\n", path.c_str(), std::strerror(errno));
+      }
+      return false;
+    }
+
+    m_watches[wd] = Watch{ path, recursive };
+    m_wds[path] = wd;
+
+    if (isDir && (recursive || found)) {
+      for (const std::string& item : list_files(path)) {
+        const std::string itemPath = join_path(path, item);
+        if (found)
+          found->emplace_back(FileChange::Type::Created, itemPath);
+        if (recursive && is_directory(itemPath))
+          addTree(itemPath, recursive, found);
+      }
+    }
+    return true;
+  }
+
+  void removeTree(const std::string& path)
+  {
+    const std::string prefix = path + path_separator;
+    for (auto it = m_wds.begin(); it != m_wds.end();) {
+      if (it->first == path || it->first.compare(0, prefix.size(), prefix) == 0) {
+        inotify_rm_watch(m_fd, it->second);
+        m_watches.erase(it->second);
+        it = m_wds.erase(it);
+      }
+      else
+        ++it;
+    }
+  }
+
+  void threadProc()
+  {
+    base::this_thread::set_name("laf-file-watcher");
+
+    pollfd fds[2];
+    fds[0].fd = m_fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = m_wakeFd;
+    fds[1].events = POLLIN;
+
+    while (m_running) {
+      // Wait forever if there is nothing pending to report, so we
+      // don't use CPU at all while there are no changes.
+      int timeout = -1;
+      if (!m_pending.empty()) {
+        const tick_t now = current_tick();
+        const tick_t deadline = std::min(m_lastChange + m_debounce,
+                                         m_firstChange + kMaxDelay * m_debounce);
+        if (now >= deadline) {
+          flushChanges();
+          continue;
+        }
+        timeout = int(deadline - now);
+      }
+
+      const int result = poll(fds, 2, timeout);
+      if (result < 0) {
+        if (errno == EINTR)
+          continue;
+        LOG(ERROR, "FW: poll() failed: %s\n", std::strerror(errno));
+        break;
+      }
+      if (fds[1].revents & POLLIN) {
+        uint64_t value;
+        if (read(m_wakeFd, &value, sizeof(value)) < 0) {
+          // Nothing to do, m_running will tell us if we have to stop
+        }
+      }
+      if (fds[0].revents & POLLIN)
+        readEvents();
+    }
+  }
+
+  void readEvents()
+  {
+    alignas(inotify_event) char buf[64 * 1024];
+    FileChanges newItems;
+
+    while (true) {
+      const ssize_t len = read(m_fd, buf, sizeof(buf));
+      if (len <= 0) {
+        ASSERT(len == 0 || errno == EAGAIN || errno == EINTR);
+        break;
+      }
+
+      const std::lock_guard lock(m_mutex);
+      for (const char* ptr = buf; ptr < buf + len;) {
+        const auto* ev = reinterpret_cast<const inotify_event*>(ptr);
+        ptr += sizeof(inotify_event) + ev->len;
+
+        if (ev->mask & IN_Q_OVERFLOW) {
+          addChange(FileChange::Type::Overflow, std::string());
+          continue;
+        }
+
+        auto it = m_watches.find(ev->wd);
+        if (it == m_watches.end())
+          continue;
+
+        if (ev->mask & IN_IGNORED) {
+          // The watch was removed (inotify_rm_watch() or the file was
+          // deleted). The path might be already watched with a new
+          // descriptor (e.g. the file was deleted and created again),
+          // in that case we keep the new one.
+          auto wdIt = m_wds.find(it->second.path);
+          if (wdIt != m_wds.end() && wdIt->second == ev->wd)
+            m_wds.erase(wdIt);
+          m_watches.erase(it);
+          continue;
+        }
+
+        const Watch& watch = it->second;
+        const std::string path = (ev->len > 0 ? join_path(watch.path, ev->name) : watch.path);
+        const bool isDir = (ev->mask & IN_ISDIR);
+
+        if (ev->mask & (IN_CREATE | IN_MOVED_TO)) {
+          addChange(FileChange::Type::Created, path);
+          if (isDir && watch.recursive) {
+            newItems.clear();
+            addTree(path, true, &newItems);
+            for (const FileChange& item : newItems)
+              addChange(item.type, item.path);
+          }
+        }
+        if (ev->mask & (IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB)) {
+          // Ignore metadata changes of directories (e.g. when a
+          // file is added, the parent directory mtime changes).
+          if (!isDir && (ev->len > 0 || !is_directory(path)))
+            addChange(FileChange::Type::Modified, path);
+        }
+        if (ev->mask & (IN_DELETE | IN_MOVED_FROM)) {
+          addChange(FileChange::Type::Deleted, path);
+          // The watches of a moved directory still exist but they
+          // have the old paths, so we just remove them.
+          if (isDir && (ev->mask & IN_MOVED_FROM))
+            removeTree(path);
+        }
+        if (ev->mask & (IN_DELETE_SELF | IN_MOVE_SELF)) {
+          addChange(FileChange::Type::Deleted, watch.path);
+        }
+      }
+    }
+
+    if (!m_pending.empty())
+      m_lastChange = current_tick();
+  }
+
+  // Coalesces a new change with the pending ones for the same path.
+  void addChange(const FileChange::Type type, const std::string& path)
+  {
+    if (m_pending.empty())
+      m_firstChange = current_tick();
+
+    auto it = m_pendingIndex.find(path);
+    if (it == m_pendingIndex.end()) {
+      m_pendingIndex[path] = m_pending.size();
+      m_pending.push_back(Pending{ FileChange(type, path), false });
+      return;
+    }
+
+    Pending& pending = m_pending[it->second];
+    FileChange& change = pending.change;
+    if (change.type == FileChange::Type::Created) {
+      // Created + Deleted = nothing, Created + Modified = Created
+      if (type == FileChange::Type::Deleted) {
+        // The entry is removed in flushChanges(), so we don't have
+        // to move all the following entries (and re-index them).
+        pending.removed = true;
+        m_pendingIndex.erase(it);
+      }
+    }
+    else if (change.type == FileChange::Type::Deleted && type == FileChange::Type::Created) {
+      // The file was replaced (e.g. an editor that saves the file
+      // writing a new one and renaming it)
+      change.type = FileChange::Type::Modified;
+    }
+    else if (change.type != FileChange::Type::Overflow) {
+      change.type = type;
+    }
+  }
+
+  void flushChanges()
+  {
+    FileChanges changes;
+    changes.reserve(m_pendingIndex.size());
+    for (Pending& pending : m_pending) {
+      if (!pending.removed)
+        changes.push_back(std::move(pending.change));
+    }
+    m_pending.clear();
+    m_pendingIndex.clear();
+
+    if (!changes.empty() && m_callback) {
+      try {
+        m_callback(changes);
+      }
+      catch (const std::exception& ex) {
+        LOG(ERROR, "FW: Exception in file watcher callback: %s\n", ex.what());
+      }
+    }
+  }
+
+  Callback m_callback;
+  tick_t m_debounce;
+  int m_fd = -1;
+  int m_wakeFd = -1;
+  std::atomic<bool> m_running;
+  std::thread m_thread;
+
+  // Watch descriptors <-> watched paths (protected by m_mutex).
+  mutable std::mutex m_mutex;
+  std::unordered_map<int, Watch> m_watches;
+  std::unordered_map<std::string, int> m_wds;
+
+  // Pending changes to be reported (only used from the watcher
+  // thread). Entries with "removed" are skipped when they are
+  // reported.
+  std::vector<Pending> m_pending;
+  std::unordered_map<std::string, size_t> m_pendingIndex;
+  tick_t m_firstChange = 0;
+  tick_t m_lastChange = 0;
+};
@@ -0,0 +1,22 @@
+// LAF Base Library
+// Copyright (c) 2025 Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+// Fallback for platforms without a FileWatcher implementation (only
+// inotify on Linux is supported): FileWatcher::isSupported() returns
+// false and no path can be watched, so clients must check the files
+// by other means (e.g. comparing modification times when the app is
+// activated).
+
+class base::FileWatcher::FileWatcherImpl {
+public:
+  FileWatcherImpl(Callback&&, double) {}
+
+  static bool isSupported() { return false; }
+
+  bool addPath(const std::string&, bool) { return false; }
+  void removePath(const std::string&) {}
+  size_t watchedCount() const { return 0; }
+};
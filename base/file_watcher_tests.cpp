@@ -0,0 +1,179 @@
+// LAF Base Library
+// Copyright (c) 2025 Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include <gtest/gtest.h>
+
+#include "base/file_content.h"
+#include "base/file_watcher.h"
+#include "base/fs.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+using namespace base;
+
+class FileWatcherTest : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    m_dir = join_path(get_temp_path(), "laf_file_watcher_tests");
+    removeAll(m_dir);
+    make_directory(m_dir);
+  }
+
+  void TearDown() override { removeAll(m_dir); }
+
+  FileWatcher::Callback callback()
+  {
+    return [this](const FileChanges& changes) {
+      const std::lock_guard lock(m_mutex);
+      m_changes.insert(m_changes.end(), changes.begin(), changes.end());
+      ++m_batches;
+      m_cv.notify_all();
+    };
+  }
+
+  // Waits until a change of the given type for the given path is received.
+  bool waitChange(const FileChange::Type type, const std::string& path)
+  {
+    std::unique_lock lock(m_mutex);
+    return m_cv.wait_for(lock, std::chrono::seconds(5), [&] {
+      return std::find_if(m_changes.begin(), m_changes.end(), [&](const FileChange& c) {
+               return c.type == type && c.path == path;
+             }) != m_changes.end();
+    });
+  }
+
+  void writeFile(const std::string& path, const std::string& content)
+  {
+    write_file_content(path, (const uint8_t*)content.c_str(), content.size());
+  }
+
+  static void removeAll(const std::string& path)
+  {
+    if (is_directory(path)) {
+      for (const auto& item : list_files(path))
+        removeAll(join_path(path, item));
+      remove_directory(path);
+    }
+    else if (is_file(path))
+      delete_file(path);
+  }
+
+  std::string m_dir;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  FileChanges m_changes;
+  int m_batches = 0;
+};
+
+TEST_F(FileWatcherTest, CreateModifyDelete)
+{
+  if (!FileWatcher::isSupported())
+    GTEST_SKIP();
+
+  FileWatcher watcher(callback(), 0.01);
+  EXPECT_TRUE(watcher.addPath(m_dir));
+  EXPECT_EQ(1, watcher.watchedCount());
+
+  const std::string fn = join_path(m_dir, "a.txt");
+  writeFile(fn, "hello");
+  EXPECT_TRUE(waitChange(FileChange::Type::Created, fn));
+
+  writeFile(fn, "world");
+  EXPECT_TRUE(waitChange(FileChange::Type::Modified, fn));
+
+  delete_file(fn);
+  EXPECT_TRUE(waitChange(FileChange::Type::Deleted, fn));
+}
+
+TEST_F(FileWatcherTest, Recursive)
+{
+  if (!FileWatcher::isSupported())
+    GTEST_SKIP();
+
+  make_directory(join_path(m_dir, "sub"));
+
+  FileWatcher watcher(callback(), 0.01);
+  EXPECT_TRUE(watcher.addPath(m_dir, true));
+  EXPECT_EQ(2, watcher.watchedCount());
+
+  const std::string fn = join_path(join_path(m_dir, "sub"), "b.txt");
+  writeFile(fn, "hello");
+  EXPECT_TRUE(waitChange(FileChange::Type::Created, fn));
+
+  // New sub-directories are watched automatically
+  const std::string newDir = join_path(m_dir, "new");
+  make_directory(newDir);
+  EXPECT_TRUE(waitChange(FileChange::Type::Created, newDir));
+
+  const std::string fn2 = join_path(newDir, "c.txt");
+  writeFile(fn2, "hello");
+  EXPECT_TRUE(waitChange(FileChange::Type::Created, fn2));
+
+  watcher.removePath(m_dir);
+  EXPECT_EQ(0, watcher.watchedCount());
+}
+
+TEST_F(FileWatcherTest, Debounce)
+{
+  if (!FileWatcher::isSupported())
+    GTEST_SKIP();
+
+  FileWatcher watcher(callback(), 0.2);
+  EXPECT_TRUE(watcher.addPath(m_dir));
+
+  // Several changes to the same file are reported as one change in
+  // one batch.
+  const std::string fn = join_path(m_dir, "a.txt");
+  for (int i = 0; i < 10; ++i)
+    writeFile(fn, std::to_string(i));
+  EXPECT_TRUE(waitChange(FileChange::Type::Created, fn));
+
+  const std::lock_guard lock(m_mutex);
+  EXPECT_EQ(1, m_batches);
+  EXPECT_EQ(1, m_changes.size());
+}
+
+TEST_F(FileWatcherTest, CreatedAndDeleted)
+{
+  if (!FileWatcher::isSupported())
+    GTEST_SKIP();
+
+  FileWatcher watcher(callback(), 0.2);
+  EXPECT_TRUE(watcher.addPath(m_dir));
+
+  // A file created and deleted in the same batch is not reported,
+  // the other changes keep their order.
+  const std::string a = join_path(m_dir, "a.txt");
+  const std::string b = join_path(m_dir, "b.txt");
+  const std::string c = join_path(m_dir, "c.txt");
+  writeFile(a, "a");
+  writeFile(b, "b");
+  delete_file(a);
+  writeFile(c, "c");
+  EXPECT_TRUE(waitChange(FileChange::Type::Created, c));
+
+  const std::lock_guard lock(m_mutex);
+  ASSERT_EQ(2, m_changes.size());
+  EXPECT_EQ(b, m_changes[0].path);
+  EXPECT_EQ(c, m_changes[1].path);
+}
+
+TEST_F(FileWatcherTest, NonExistentPath)
+{
+  FileWatcher watcher(callback());
+  EXPECT_FALSE(watcher.addPath(join_path(m_dir, "does_not_exist")));
+  EXPECT_EQ(0, watcher.watchedCount());
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
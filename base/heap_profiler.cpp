@@ -0,0 +1,446 @@
+// LAF Base Library
+// Copyright (c) 2025 Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "base/heap_profiler.h"
+
+#include "base/config.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if LAF_WINDOWS
+  #include <windows.h>
+#elif HAVE_EXECINFO_H
+  #include <execinfo.h>
+#endif
+
+// All the memory used by the profiler is allocated with calloc()/free()
+// directly (never with base_malloc() or new) to avoid reentrancy.
+
+namespace base { namespace heap_profiler {
+
+namespace {
+
+constexpr int kMaxFrames = 32;
+constexpr int kSkipFrames = 3; // capture_stack() + sample() + on_alloc()
+constexpr size_t kMaxCallsites = 8192;
+constexpr size_t kMaxLiveSamples = 65536;
+constexpr size_t kMaxProbes = 128;
+
+// Each different call stack where a sampled allocation was done.
+struct callsite {
+  std::atomic<uint64_t> hash;  // 0 = empty slot
+  std::atomic<bool> ready;     // true when "stack" is filled
+  int depth;
+  void* stack[kMaxFrames];
+  std::atomic<int64_t> alloc_objects;
+  std::atomic<int64_t> alloc_bytes;
+  std::atomic<int64_t> inuse_objects;
+  std::atomic<int64_t> inuse_bytes;
+};
+
+// A sampled allocation that is still alive.
+struct live_sample {
+  std::atomic<uintptr_t> ptr; // 0 = empty, kTombstone = deleted
+  std::atomic<uint32_t> site;
+  std::atomic<uint64_t> size;
+  std::atomic<int64_t> weight;
+};
+
+constexpr uintptr_t kTombstone = 1;
+
+std::atomic<bool> g_running(false);
+size_t g_interval = kDefaultSamplingInterval;
+callsite* g_callsites = nullptr;
+live_sample* g_live = nullptr;
+std::atomic<int64_t> g_live_count(0);
+std::atomic<int64_t> g_dropped(0);
+std::atomic<int64_t> g_estimated_inuse(0);
+std::atomic<int64_t> g_estimated_alloc(0);
+
+// Per-thread sampling state (trivial types to avoid TLS guards).
+thread_local int64_t t_bytes_until_sample = 0;
+thread_local uint64_t t_rng = 0;
+thread_local bool t_busy = false;
+
+uint64_t hash_ptr(uintptr_t p)
+{
+  // Fibonacci hashing (ignoring the low bits which are always zero
+  // for aligned pointers)
+  return (uint64_t(p) >> 4) * 0x9E3779B97F4A7C15ull;
+}
+
+uint64_t hash_stack(void* const* stack, int depth)
+{
+  // FNV-1a
+  uint64_t h = 0xcbf29ce484222325ull;
+  for (int i = 0; i < depth; ++i) {
+    h ^= uint64_t(uintptr_t(stack[i]));
+    h *= 0x100000001b3ull;
+  }
+  return (h ? h : 1);
+}
+
+uint64_t next_random()
+{
+  // xorshift64*
+  t_rng ^= t_rng >> 12;
+  t_rng ^= t_rng << 25;
+  t_rng ^= t_rng >> 27;
+  return t_rng * 0x2545F4914F6CDD1Dull;
+}
+
+// Returns the number of bytes until the next sample, using an
+// exponential distribution so samples are a Poisson process with
+// one sample each g_interval bytes on average.
+int64_t next_sample_distance()
+{
+  if (t_rng == 0) {
+    t_rng = uint64_t(uintptr_t(&t_rng)) ^
+            uint64_t(std::chrono::steady_clock::now().time_since_epoch().count());
+    if (t_rng == 0)
+      t_rng = 1;
+  }
+  // Uniform value in (0, 1]
+  const double u = double((next_random() >> 11) + 1) / double(1ull << 53);
+  return std::max<int64_t>(1, int64_t(-std::log(u) * double(g_interval)));
+}
+
+int capture_stack(void** stack)
+{
+#if LAF_WINDOWS
+  return CaptureStackBackTrace(kSkipFrames, kMaxFrames, stack, nullptr);
+#elif HAVE_EXECINFO_H
+  void* frames[kMaxFrames + kSkipFrames];
+  const int n = backtrace(frames, kMaxFrames + kSkipFrames);
+  const int depth = std::max(0, n - kSkipFrames);
+  std::copy(frames + (n - depth), frames + n, stack);
+  return depth;
+#else
+  stack[0] = __builtin_return_address(0);
+  return 1;
+#endif
+}
+
+callsite* find_callsite(void* const* stack, int depth, uint32_t& index)
+{
+  const uint64_t h = hash_stack(stack, depth);
+  for (size_t i = 0; i < kMaxProbes; ++i) {
+    index = uint32_t((h + i) & (kMaxCallsites - 1));
+    callsite* site = &g_callsites[index];
+
+    uint64_t current = site->hash.load(std::memory_order_acquire);
+    if (current == 0) {
+      if (site->hash.compare_exchange_strong(current, h, std::memory_order_acq_rel)) {
+        site->depth = depth;
+        std::copy(stack, stack + depth, site->stack);
+        site->ready.store(true, std::memory_order_release);
+        return site;
+      }
+      // Other thread took this slot, "current" has its hash now
+    }
+    if (current == h)
+      return site;
+  }
+  return nullptr;
+}
+
+// Estimated number of real bytes represented by a sample of the
+// given size.
+int64_t sample_weight(size_t size)
+{
+  const double p = 1.0 - std::exp(-double(size) / double(g_interval));
+  return (p > 0.0 ? int64_t(double(size) / p) : int64_t(size));
+}
+
+// Adds "ptr" to the table of live samples and to the in-use
+// counters of the given call-site.
+bool add_live_sample(void* ptr, uint32_t siteIndex, size_t size, int64_t weight)
+{
+  const uint64_t h = hash_ptr(uintptr_t(ptr));
+  for (size_t i = 0; i < kMaxProbes; ++i) {
+    live_sample& live = g_live[(h + i) & (kMaxLiveSamples - 1)];
+    uintptr_t current = live.ptr.load(std::memory_order_relaxed);
+    if ((current == 0 || current == kTombstone) &&
+        live.ptr.compare_exchange_strong(current, uintptr_t(ptr), std::memory_order_acq_rel)) {
+      live.site.store(siteIndex, std::memory_order_relaxed);
+      live.size.store(size, std::memory_order_relaxed);
+      live.weight.store(weight, std::memory_order_relaxed);
+      ++g_live_count;
+
+      callsite& site = g_callsites[siteIndex];
+      site.inuse_objects.fetch_add(1, std::memory_order_relaxed);
+      site.inuse_bytes.fetch_add(size, std::memory_order_relaxed);
+      g_estimated_inuse.fetch_add(weight, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  ++g_dropped;
+  return false;
+}
+
+void sample(void* ptr, size_t size)
+{
+  void* stack[kMaxFrames];
+  const int depth = capture_stack(stack);
+
+  uint32_t siteIndex;
+  callsite* site = find_callsite(stack, depth, siteIndex);
+  if (!site) {
+    ++g_dropped;
+    return;
+  }
+
+  const int64_t weight = sample_weight(size);
+  if (add_live_sample(ptr, siteIndex, size, weight)) {
+    site->alloc_objects.fetch_add(1, std::memory_order_relaxed);
+    site->alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    g_estimated_alloc.fetch_add(weight, std::memory_order_relaxed);
+  }
+}
+
+// Marks the deleted sample at the given index (and the previous
+// deleted ones) as empty when the next slot is empty, i.e. when no
+// probe sequence continues after them. In this way on_free() of
+// pointers that were not sampled (most of them) can stop at the
+// first empty slot instead of skipping all the tombstones that a
+// long-running program would accumulate.
+void reclaim_tombstones(size_t index)
+{
+  for (size_t i = 0; i < kMaxProbes; ++i) {
+    live_sample& live = g_live[index];
+    const live_sample& next = g_live[(index + 1) & (kMaxLiveSamples - 1)];
+    if (next.ptr.load(std::memory_order_acquire) != 0)
+      return;
+
+    uintptr_t current = kTombstone;
+    if (!live.ptr.compare_exchange_strong(current, 0, std::memory_order_acq_rel))
+      return; // Reused by other thread
+
+    // Other thread might have added a sample in the next slot (after
+    // skipping this one when it was still alive), in that case we
+    // restore the tombstone to keep its probe sequence.
+    if (next.ptr.load(std::memory_order_acquire) != 0) {
+      current = 0;
+      live.ptr.compare_exchange_strong(current, kTombstone, std::memory_order_acq_rel);
+      return;
+    }
+
+    index = (index - 1) & (kMaxLiveSamples - 1);
+  }
+}
+
+} // anonymous namespace
+
+void start(const size_t sampling_interval)
+{
+  g_running = false;
+  g_interval = std::max<size_t>(sampling_interval, 1);
+
+  if (!g_callsites) {
+    g_callsites = static_cast<callsite*>(std::calloc(kMaxCallsites, sizeof(callsite)));
+    g_live = static_cast<live_sample*>(std::calloc(kMaxLiveSamples, sizeof(live_sample)));
+    if (!g_callsites || !g_live) {
+      std::free(g_callsites);
+      std::free(g_live);
+      g_callsites = nullptr;
+      g_live = nullptr;
+      return;
+    }
+  }
+  else {
+    std::memset((void*)g_callsites, 0, kMaxCallsites * sizeof(callsite));
+    std::memset((void*)g_live, 0, kMaxLiveSamples * sizeof(live_sample));
+  }
+  g_live_count = 0;
+  g_dropped = 0;
+  g_estimated_inuse = 0;
+  g_estimated_alloc = 0;
+
+#if HAVE_EXECINFO_H
+  // The first call to backtrace() can allocate memory (it loads
+  // libgcc), we do it now and not in the middle of a sample.
+  void* frames[1];
+  backtrace(frames, 1);
+#endif
+
+  t_bytes_until_sample = next_sample_distance();
+  g_running = true;
+}
+
+void stop()
+{
+  g_running = false;
+}
+
+bool is_running()
+{
+  return g_running;
+}
+
+void on_alloc(void* ptr, size_t size)
+{
+  if (!ptr || !g_running.load(std::memory_order_relaxed))
+    return;
+
+  t_bytes_until_sample -= int64_t(size);
+  if (t_bytes_until_sample >= 0)
+    return;
+
+  // First allocation in this thread, just initialize the counter
+  if (t_rng == 0) {
+    t_bytes_until_sample = next_sample_distance();
+    return;
+  }
+
+  t_bytes_until_sample = next_sample_distance();
+  if (t_busy)
+    return;
+
+  t_busy = true;
+  sample(ptr, size);
+  t_busy = false;
+}
+
+removed_sample on_free(void* ptr)
+{
+  removed_sample removed;
+
+  // Fast path: no live samples (or the profiler never started)
+  if (!ptr || g_live_count.load(std::memory_order_relaxed) == 0)
+    return removed;
+
+  const uint64_t h = hash_ptr(uintptr_t(ptr));
+  for (size_t i = 0; i < kMaxProbes; ++i) {
+    const size_t index = (h + i) & (kMaxLiveSamples - 1);
+    live_sample& live = g_live[index];
+    uintptr_t current = live.ptr.load(std::memory_order_acquire);
+    if (current == 0)
+      return removed; // Not sampled
+    if (current == uintptr_t(ptr)) {
+      const uint32_t siteIndex = live.site.load(std::memory_order_relaxed);
+      const int64_t size = live.size.load(std::memory_order_relaxed);
+      const int64_t weight = live.weight.load(std::memory_order_relaxed);
+      if (!live.ptr.compare_exchange_strong(current, kTombstone, std::memory_order_acq_rel))
+        return removed;
+      --g_live_count;
+
+      callsite& site = g_callsites[siteIndex];
+      site.inuse_objects.fetch_sub(1, std::memory_order_relaxed);
+      site.inuse_bytes.fetch_sub(size, std::memory_order_relaxed);
+      g_estimated_inuse.fetch_sub(weight, std::memory_order_relaxed);
+
+      reclaim_tombstones(index);
+
+      removed.site = siteIndex;
+      removed.size = size_t(size);
+      removed.weight = weight;
+      return removed;
+    }
+  }
+  return removed;
+}
+
+void on_restore(void* ptr, const removed_sample& sample)
+{
+  if (!ptr || sample.size == 0 || !g_live)
+    return;
+
+  add_live_sample(ptr, sample.site, sample.size, sample.weight);
+}
+
+stats get_stats()
+{
+  stats s;
+  if (!g_callsites)
+    return s;
+
+  for (size_t i = 0; i < kMaxCallsites; ++i) {
+    const callsite& site = g_callsites[i];
+    if (!site.ready.load(std::memory_order_acquire))
+      continue;
+    ++s.callsites;
+    s.sampled_inuse_objects += site.inuse_objects;
+    s.sampled_inuse_bytes += site.inuse_bytes;
+    s.sampled_alloc_objects += site.alloc_objects;
+    s.sampled_alloc_bytes += site.alloc_bytes;
+  }
+  for (size_t i = 0; i < kMaxLiveSamples; ++i) {
+    if (g_live[i].ptr.load(std::memory_order_relaxed) == kTombstone)
+      ++s.tombstones;
+  }
+  s.estimated_inuse_bytes = g_estimated_inuse;
+  s.estimated_alloc_bytes = g_estimated_alloc;
+  s.dropped = g_dropped;
+  return s;
+}
+
+bool dump(const std::string& filename)
+{
+  if (!g_callsites)
+    return false;
+
+  const bool wasBusy = t_busy;
+  t_busy = true; // Don't sample allocations from fopen()/fprintf()
+
+  FILE* f = std::fopen(filename.c_str(), "w");
+  if (!f) {
+    t_busy = wasBusy;
+    return false;
+  }
+
+  const stats s = get_stats();
+  std::fprintf(f,
+               "heap profile: %6lld: %8lld [%6lld: %8lld] @ heap_v2/%llu\n",
+               (long long)s.sampled_inuse_objects,
+               (long long)s.sampled_inuse_bytes,
+               (long long)s.sampled_alloc_objects,
+               (long long)s.sampled_alloc_bytes,
+               (unsigned long long)g_interval);
+
+  for (size_t i = 0; i < kMaxCallsites; ++i) {
+    const callsite& site = g_callsites[i];
+    if (!site.ready.load(std::memory_order_acquire))
+      continue;
+
+    std::fprintf(f,
+                 "%6lld: %8lld [%6lld: %8lld] @",
+                 (long long)site.inuse_objects,
+                 (long long)site.inuse_bytes,
+                 (long long)site.alloc_objects,
+                 (long long)site.alloc_bytes);
+    for (int j = 0; j < site.depth; ++j)
+      std::fprintf(f, " 0x%llx", (unsigned long long)uintptr_t(site.stack[j]));
+    std::fputc('\n', f);
+  }
+
+#if __linux__
+  // Mapped libraries are needed by pprof to symbolize addresses
+  if (FILE* maps = std::fopen("/proc/self/maps", "r")) {
+    std::fputs("\nMAPPED_LIBRARIES:\n", f);
+    char buf[4096];
+    size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), maps)) > 0)
+      std::fwrite(buf, 1, n, f);
+    std::fclose(maps);
+  }
+#endif
+
+  std::fclose(f);
+  t_busy = wasBusy;
+  return true;
+}
+
+}} // namespace base::heap_profiler
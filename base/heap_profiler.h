@@ -0,0 +1,86 @@
+// LAF Base Library
+// Copyright (c) 2025 Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef BASE_HEAP_PROFILER_H_INCLUDED
+#define BASE_HEAP_PROFILER_H_INCLUDED
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Sampling heap profiler. Instead of recording every allocation (as
+// the LAF_MEMLEAK mode does), allocations are sampled as a Poisson
+// process: on average one sample each "sampling_interval" bytes
+// allocated by each thread. Each sample records its call stack, and
+// samples are aggregated by call-site in lock-free tables.
+//
+// When laf is compiled with LAF_HEAPPROF, base_malloc()/base_free(),
+// base_aligned_alloc()/base_aligned_free() and the new/delete
+// operators report their allocations automatically (see
+// base_heapprof_init()). Without LAF_HEAPPROF the on_alloc()/on_free()
+// functions can be used to profile custom allocators.
+namespace base { namespace heap_profiler {
+
+static constexpr const size_t kDefaultSamplingInterval = 512 * 1024;
+
+struct stats {
+  // Number of sampled objects/bytes (not scaled).
+  int64_t sampled_inuse_objects = 0;
+  int64_t sampled_inuse_bytes = 0;
+  int64_t sampled_alloc_objects = 0;
+  int64_t sampled_alloc_bytes = 0;
+
+  // Estimated real bytes in use/allocated (scaled from the samples).
+  int64_t estimated_inuse_bytes = 0;
+  int64_t estimated_alloc_bytes = 0;
+
+  // Number of different call-sites.
+  int callsites = 0;
+
+  // Samples that couldn't be recorded because the tables were full.
+  int64_t dropped = 0;
+
+  // Deleted samples that are still in the table of live samples
+  // (they are removed when they are at the end of a probe sequence).
+  int64_t tombstones = 0;
+};
+
+// A sample removed by on_free() ("size" is 0 if the pointer wasn't
+// sampled).
+struct removed_sample {
+  uint32_t site = 0;
+  size_t size = 0;
+  int64_t weight = 0;
+};
+
+// Starts/stops sampling allocations. start() clears the previous
+// samples, so it must be called when no other thread is reporting
+// allocations (e.g. at the beginning of the program).
+void start(size_t sampling_interval = kDefaultSamplingInterval);
+void stop();
+bool is_running();
+
+// Must be called after each allocation and before each deallocation.
+void on_alloc(void* ptr, size_t size);
+removed_sample on_free(void* ptr);
+
+// Adds again a sample removed by on_free() when the memory wasn't
+// deallocated after all (e.g. when realloc() fails).
+void on_restore(void* ptr, const removed_sample& sample);
+
+stats get_stats();
+
+// Writes the aggregated call-site statistics in the legacy pprof
+// heap profile format ("heap_v2"), which can be analyzed with:
+//
+//   pprof -http=: your_program heap.prof
+//
+bool dump(const std::string& filename);
+
+}} // namespace base::heap_profiler
+
+#endif
@@ -0,0 +1,165 @@
+// LAF Base Library
+// Copyright (c) 2025 Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include <gtest/gtest.h>
+
+#include "base/file_content.h"
+#include "base/fs.h"
+#include "base/heap_profiler.h"
+
+#include <cstdint>
+#include <string>
+
+using namespace base;
+
+// Fake addresses, they are never dereferenced
+static void* fake_ptr(size_t i)
+{
+  return (void*)(uintptr_t(0x10000) + i * 64);
+}
+
+TEST(HeapProfiler, SampleEverything)
+{
+  heap_profiler::start(1);
+  for (size_t i = 0; i < 100; ++i)
+    heap_profiler::on_alloc(fake_ptr(i), 1000);
+
+  heap_profiler::stats s = heap_profiler::get_stats();
+  EXPECT_LE(99, s.sampled_alloc_objects);
+  EXPECT_EQ(s.sampled_alloc_objects, s.sampled_inuse_objects);
+  EXPECT_EQ(s.sampled_alloc_objects * 1000, s.sampled_alloc_bytes);
+  EXPECT_LE(1, s.callsites);
+  EXPECT_EQ(0, s.dropped);
+
+  for (size_t i = 0; i < 100; ++i)
+    heap_profiler::on_free(fake_ptr(i));
+
+  s = heap_profiler::get_stats();
+  EXPECT_EQ(0, s.sampled_inuse_objects);
+  EXPECT_EQ(0, s.sampled_inuse_bytes);
+  EXPECT_EQ(0, s.estimated_inuse_bytes);
+  EXPECT_LE(99, s.sampled_alloc_objects);
+
+  heap_profiler::stop();
+}
+
+TEST(HeapProfiler, PoissonEstimation)
+{
+  const size_t interval = 4096;
+  const size_t n = 1000000;
+  const size_t size = 64;
+
+  heap_profiler::start(interval);
+  for (size_t i = 0; i < n; ++i) {
+    heap_profiler::on_alloc(fake_ptr(i), size);
+    heap_profiler::on_free(fake_ptr(i));
+  }
+  heap_profiler::stop();
+
+  // The estimated number of allocated bytes should be near to the
+  // real value (the standard deviation of the number of samples is
+  // sqrt(n*size/interval) ~= 125, i.e. ~0.8% of the samples).
+  const heap_profiler::stats s = heap_profiler::get_stats();
+  const double real = double(n * size);
+  EXPECT_NEAR(real, double(s.estimated_alloc_bytes), real * 0.05);
+  EXPECT_EQ(0, s.sampled_inuse_objects);
+  EXPECT_EQ(0, s.dropped);
+}
+
+TEST(HeapProfiler, Churn)
+{
+  heap_profiler::start(1);
+
+  // Some long-lived samples, so on_free() cannot use its fast path
+  for (size_t i = 0; i < 100; ++i)
+    heap_profiler::on_alloc(fake_ptr(i * 7), 1000);
+
+  // A lot of short-lived allocations in different addresses
+  for (size_t i = 0; i < 100000; ++i) {
+    heap_profiler::on_alloc(fake_ptr(i * 7 + 1), 100);
+    heap_profiler::on_alloc(fake_ptr(i * 7 + 2), 100);
+    heap_profiler::on_free(fake_ptr(i * 7 + 1));
+    heap_profiler::on_free(fake_ptr(i * 7 + 2));
+  }
+
+  // Deleted samples are reclaimed, only the ones before long-lived
+  // samples can be kept
+  heap_profiler::stats s = heap_profiler::get_stats();
+  EXPECT_EQ(0, s.dropped);
+  EXPECT_GE(100, s.tombstones);
+  EXPECT_LE(99, s.sampled_inuse_objects);
+
+  for (size_t i = 0; i < 100; ++i)
+    heap_profiler::on_free(fake_ptr(i * 7));
+
+  s = heap_profiler::get_stats();
+  EXPECT_EQ(0, s.sampled_inuse_objects);
+  EXPECT_EQ(0, s.tombstones);
+
+  heap_profiler::stop();
+}
+
+TEST(HeapProfiler, Restore)
+{
+  heap_profiler::start(1);
+  heap_profiler::on_alloc(fake_ptr(0), 1000);
+  const heap_profiler::stats before = heap_profiler::get_stats();
+  ASSERT_EQ(1, before.sampled_inuse_objects);
+
+  // Remove the sample like a failed realloc() does, and add it again
+  const heap_profiler::removed_sample sample = heap_profiler::on_free(fake_ptr(0));
+  EXPECT_EQ(1000, sample.size);
+  EXPECT_EQ(0, heap_profiler::get_stats().sampled_inuse_objects);
+  heap_profiler::on_restore(fake_ptr(0), sample);
+
+  heap_profiler::stats s = heap_profiler::get_stats();
+  EXPECT_EQ(1, s.sampled_inuse_objects);
+  EXPECT_EQ(1000, s.sampled_inuse_bytes);
+  EXPECT_EQ(before.estimated_inuse_bytes, s.estimated_inuse_bytes);
+  EXPECT_EQ(before.sampled_alloc_objects, s.sampled_alloc_objects);
+
+  // Pointers that weren't sampled are not restored
+  EXPECT_EQ(0, heap_profiler::on_free(fake_ptr(1)).size);
+  heap_profiler::on_restore(fake_ptr(1), heap_profiler::removed_sample());
+  EXPECT_EQ(1, heap_profiler::get_stats().sampled_inuse_objects);
+
+  heap_profiler::on_free(fake_ptr(0));
+  EXPECT_EQ(0, heap_profiler::get_stats().sampled_inuse_objects);
+  heap_profiler::stop();
+}
+
+TEST(HeapProfiler, NotRunning)
+{
+  heap_profiler::start(1);
+  heap_profiler::stop();
+  EXPECT_FALSE(heap_profiler::is_running());
+
+  heap_profiler::on_alloc(fake_ptr(0), 1000);
+  EXPECT_EQ(0, heap_profiler::get_stats().sampled_alloc_objects);
+}
+
+TEST(HeapProfiler, Dump)
+{
+  heap_profiler::start(1);
+  for (size_t i = 0; i < 10; ++i)
+    heap_profiler::on_alloc(fake_ptr(i), 100);
+  heap_profiler::stop();
+
+  const std::string fn = join_path(get_temp_path(), "laf_heap_profiler_tests.prof");
+  ASSERT_TRUE(heap_profiler::dump(fn));
+
+  const buffer buf = read_file_content(fn);
+  const std::string content(buf.begin(), buf.end());
+  EXPECT_EQ(0, content.find("heap profile: "));
+  EXPECT_NE(std::string::npos, content.find("@ heap_v2/1\n"));
+  delete_file(fn);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,5 +1,5 @@
 // LAF Base Library
-// Copyright (c) 2022-2024 Igara Studio S.A.
+// Copyright (c) 2022-2025 Igara Studio S.A.
 // Copyright (c) 2001-2016 David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -19,7 +19,85 @@
 
 using namespace std;
 
-#if !defined LAF_MEMLEAK // Without leak detection
+#if defined LAF_HEAPPROF // With sampling heap profiler
+
+  #include "base/heap_profiler.h"
+
+void base_heapprof_init(size_t sampling_interval)
+{
+  base::heap_profiler::start(sampling_interval);
+}
+
+void base_heapprof_exit()
+{
+  base::heap_profiler::stop();
+}
+
+bool base_heapprof_dump(const char* filename)
+{
+  return base::heap_profiler::dump(filename);
+}
+
+void* base_malloc(size_t bytes)
+{
+  void* mem = malloc(bytes);
+  base::heap_profiler::on_alloc(mem, bytes);
+  return mem;
+}
+
+void* base_malloc0(size_t bytes)
+{
+  void* mem = calloc(1, bytes);
+  base::heap_profiler::on_alloc(mem, bytes);
+  return mem;
+}
+
+void* base_realloc(void* mem, size_t bytes)
+{
+  // realloc(mem, 0) might free the memory and return nullptr, which
+  // cannot be distinguished from a failure
+  if (mem && bytes == 0) {
+    base::heap_profiler::on_free(mem);
+    free(mem);
+    return nullptr;
+  }
+
+  // The sample is removed before realloc() because "mem" can be
+  // reused by other thread as soon as it's deallocated
+  const base::heap_profiler::removed_sample sample = base::heap_profiler::on_free(mem);
+
+  void* newmem = realloc(mem, bytes);
+  if (!newmem) {
+    // "mem" is still valid
+    base::heap_profiler::on_restore(mem, sample);
+    return nullptr;
+  }
+
+  base::heap_profiler::on_alloc(newmem, bytes);
+  return newmem;
+}
+
+void base_free(void* mem)
+{
+  assert(mem);
+  base::heap_profiler::on_free(mem);
+  free(mem);
+}
+
+char* base_strdup(const char* string)
+{
+  assert(string);
+  #ifdef _MSC_VER
+  char* mem = _strdup(string);
+  #else
+  char* mem = strdup(string);
+  #endif
+  if (mem)
+    base::heap_profiler::on_alloc(mem, strlen(mem) + 1);
+  return mem;
+}
+
+#elif !defined LAF_MEMLEAK // Without leak detection
 
 void* base_malloc(size_t bytes)
 {
@@ -269,6 +347,10 @@ char* base_strdup(const char* string)
   return mem;
 }
 
+#endif
+
+#if defined LAF_MEMLEAK || defined LAF_HEAPPROF
+
 // C++ operators
 
 void* operator new(std::size_t size)
@@ -306,18 +388,25 @@ void operator delete[](void* ptr) LAF_NOEXCEPT
 void* base_aligned_alloc(std::size_t bytes, std::size_t alignment)
 {
 #if LAF_WINDOWS
-  return _aligned_malloc(bytes, alignment);
+  void* mem = _aligned_malloc(bytes, alignment);
 #else
   ASSERT(alignment > 0);
   std::size_t misaligned = (bytes % alignment);
   if (misaligned > 0)
     bytes += alignment - misaligned;
-  return aligned_alloc(alignment, bytes);
+  void* mem = aligned_alloc(alignment, bytes);
 #endif
+#if defined LAF_HEAPPROF
+  base::heap_profiler::on_alloc(mem, bytes);
+#endif
+  return mem;
 }
 
 void base_aligned_free(void* mem)
 {
+#if defined LAF_HEAPPROF
+  base::heap_profiler::on_free(mem);
+#endif
 #if LAF_WINDOWS
   _aligned_free(mem);
 #else
@@ -1,4 +1,5 @@
 // LAF Base Library
+// Copyright (c) 2025 Igara Studio S.A.
 // Copyright (c) 2001-2016 David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -45,4 +46,17 @@ void base_memleak_init();
 void base_memleak_exit();
 #endif
 
+// LAF_HEAPPROF is a low-overhead alternative to LAF_MEMLEAK that
+// samples allocations (see base/heap_profiler.h) so it can be enabled
+// in production builds. base_heapprof_dump() can be called at any
+// moment to write the current profile.
+#ifdef LAF_HEAPPROF
+  #if defined LAF_MEMLEAK
+    #error LAF_MEMLEAK and LAF_HEAPPROF cannot be used at the same time
+  #endif
+void base_heapprof_init(std::size_t sampling_interval);
+void base_heapprof_exit();
+bool base_heapprof_dump(const char* filename);
+#endif
+
 #endif
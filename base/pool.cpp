@@ -0,0 +1,64 @@
+// LAF Base Library
+// Copyright (c) 2025 Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "base/pool.h"
+
+#include "base/debug.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace base {
+
+fixed_pool::fixed_pool(const size_t slot_size,
+                       const size_t slot_alignment,
+                       const size_t slots_per_chunk)
+  : m_slot_alignment(std::max(slot_alignment, alignof(free_slot)))
+  , m_slots_per_chunk(std::max<size_t>(slots_per_chunk, 1))
+{
+  ASSERT(slot_alignment > 0);
+  m_slot_size = base_align_size(std::max(slot_size, sizeof(free_slot)), m_slot_alignment);
+}
+
+fixed_pool::~fixed_pool()
+{
+  // All slots must be deallocated before destroying the pool
+  ASSERT(m_used == 0);
+  release();
+}
+
+void fixed_pool::release()
+{
+  for (void* chunk : m_chunks)
+    base_aligned_free(chunk);
+  m_chunks.clear();
+  m_free = nullptr;
+  m_used = 0;
+}
+
+void fixed_pool::add_chunk()
+{
+  auto* chunk = static_cast<uint8_t*>(
+    base_aligned_alloc(m_slot_size * m_slots_per_chunk, m_slot_alignment));
+  if (!chunk)
+    throw std::bad_alloc();
+
+  m_chunks.push_back(chunk);
+
+  // Add all slots to the free list (in order, so consecutive
+  // allocations return consecutive addresses).
+  for (size_t i = m_slots_per_chunk; i > 0; --i) {
+    auto* slot = reinterpret_cast<free_slot*>(chunk + (i - 1) * m_slot_size);
+    slot->next = m_free;
+    m_free = slot;
+  }
+}
+
+} // namespace base
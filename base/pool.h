@@ -0,0 +1,169 @@
+// LAF Base Library
+// Copyright (c) 2025 Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef BASE_POOL_H_INCLUDED
+#define BASE_POOL_H_INCLUDED
+#pragma once
+
+#include "base/config.h"
+#include "base/disable_copying.h"
+#include "base/memory.h"
+
+#include <new>
+#include <utility>
+#include <vector>
+
+#if HAVE_MEMORY_RESOURCE
+  #include <memory_resource>
+#endif
+
+namespace base {
+
+// Pool of fixed-size memory slots. Slots are allocated in chunks
+// and returned slots are reused from a free list, so allocating and
+// deallocating is O(1) and doesn't touch the heap after a warm-up
+// period. It's not thread-safe.
+class fixed_pool {
+public:
+  static constexpr size_t kDefaultSlotsPerChunk = 64;
+
+  fixed_pool(size_t slot_size,
+             size_t slot_alignment = base_alignment,
+             size_t slots_per_chunk = kDefaultSlotsPerChunk);
+  ~fixed_pool();
+
+  void* allocate()
+  {
+    if (!m_free)
+      add_chunk();
+    free_slot* slot = m_free;
+    m_free = slot->next;
+    ++m_used;
+    return slot;
+  }
+
+  void deallocate(void* ptr)
+  {
+    auto* slot = static_cast<free_slot*>(ptr);
+    slot->next = m_free;
+    m_free = slot;
+    --m_used;
+  }
+
+  // Frees all the chunks. All slots must be deallocated before.
+  void release();
+
+  size_t slot_size() const { return m_slot_size; }
+  size_t slot_alignment() const { return m_slot_alignment; }
+
+  // Number of slots in use.
+  size_t used() const { return m_used; }
+
+  // Number of chunks allocated from the heap.
+  size_t chunk_count() const { return m_chunks.size(); }
+
+  DISABLE_COPYING(fixed_pool);
+
+private:
+  struct free_slot {
+    free_slot* next;
+  };
+
+  void add_chunk();
+
+  size_t m_slot_size;
+  size_t m_slot_alignment;
+  size_t m_slots_per_chunk;
+  size_t m_used = 0;
+  free_slot* m_free = nullptr;
+  std::vector<void*> m_chunks;
+};
+
+// Pool of objects of type T.
+template<typename T>
+class object_pool {
+public:
+  explicit object_pool(size_t objects_per_chunk = fixed_pool::kDefaultSlotsPerChunk)
+    : m_pool(sizeof(T), alignof(T), objects_per_chunk)
+  {
+  }
+
+  template<typename... Args>
+  T* make(Args&&... args)
+  {
+    void* ptr = m_pool.allocate();
+    try {
+      return new (ptr) T(std::forward<Args>(args)...);
+    }
+    catch (...) {
+      m_pool.deallocate(ptr);
+      throw;
+    }
+  }
+
+  void destroy(T* obj)
+  {
+    obj->~T();
+    m_pool.deallocate(obj);
+  }
+
+  size_t used() const { return m_pool.used(); }
+  size_t chunk_count() const { return m_pool.chunk_count(); }
+
+private:
+  fixed_pool m_pool;
+};
+
+#if HAVE_MEMORY_RESOURCE
+// Adapter to use a fixed_pool with std::pmr node-based containers
+// (std::pmr::list, std::pmr::map, etc.). Requests that don't fit in
+// a slot are forwarded to the upstream resource.
+class fixed_pool_resource : public std::pmr::memory_resource {
+public:
+  explicit fixed_pool_resource(
+    fixed_pool& pool,
+    std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+    : m_pool(pool)
+    , m_upstream(upstream)
+  {
+  }
+
+  fixed_pool& get() const { return m_pool; }
+
+private:
+  bool fits(size_t bytes, size_t alignment) const
+  {
+    return bytes <= m_pool.slot_size() && alignment <= m_pool.slot_alignment();
+  }
+
+  void* do_allocate(size_t bytes, size_t alignment) override
+  {
+    if (fits(bytes, alignment))
+      return m_pool.allocate();
+    return m_upstream->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* ptr, size_t bytes, size_t alignment) override
+  {
+    if (fits(bytes, alignment))
+      m_pool.deallocate(ptr);
+    else
+      m_upstream->deallocate(ptr, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+
+  fixed_pool& m_pool;
+  std::pmr::memory_resource* m_upstream;
+};
+#endif
+
+} // namespace base
+
+#endif
@@ -0,0 +1,79 @@
+// LAF Base Library
+// Copyright (c) 2025 Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include <gtest/gtest.h>
+
+#include "base/pool.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if HAVE_MEMORY_RESOURCE
+  #include <list>
+#endif
+
+using namespace base;
+
+TEST(FixedPool, ReuseSlots)
+{
+  fixed_pool pool(24, 8, 16);
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 100; ++i) {
+    void* ptr = pool.allocate();
+    EXPECT_EQ(0, uintptr_t(ptr) % 8);
+    ptrs.push_back(ptr);
+  }
+  EXPECT_EQ(100, pool.used());
+  const size_t chunks = pool.chunk_count();
+  EXPECT_EQ(7, chunks);
+
+  for (int j = 0; j < 10; ++j) {
+    for (void* ptr : ptrs)
+      pool.deallocate(ptr);
+    EXPECT_EQ(0, pool.used());
+    for (void*& ptr : ptrs)
+      ptr = pool.allocate();
+    EXPECT_EQ(chunks, pool.chunk_count());
+  }
+
+  for (void* ptr : ptrs)
+    pool.deallocate(ptr);
+}
+
+TEST(ObjectPool, MakeDestroy)
+{
+  object_pool<std::string> pool;
+  std::string* a = pool.make("hello");
+  std::string* b = pool.make(5, 'x');
+  EXPECT_EQ("hello", *a);
+  EXPECT_EQ("xxxxx", *b);
+  EXPECT_EQ(2, pool.used());
+  pool.destroy(a);
+  pool.destroy(b);
+  EXPECT_EQ(0, pool.used());
+}
+
+#if HAVE_MEMORY_RESOURCE
+TEST(FixedPool, MemoryResource)
+{
+  fixed_pool pool(64);
+  fixed_pool_resource res(pool);
+  {
+    std::pmr::list<int> list(&res);
+    for (int i = 0; i < 100; ++i)
+      list.push_back(i);
+    EXPECT_EQ(100, pool.used());
+  }
+  EXPECT_EQ(0, pool.used());
+}
+#endif
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,26 @@
+// LAF Base Library
+// Copyright (c) 2025 Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef BASE_SIMD_H_INCLUDED
+#define BASE_SIMD_H_INCLUDED
+#pragma once
+
+// Defines LAF_SSE2 or LAF_NEON when the compiler targets a CPU with
+// those instruction sets (SSE2 is always available on x86-64, and
+// NEON on arm64), and includes the intrinsics headers. Code using
+// these macros must have a scalar fallback.
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define LAF_SSE2 1
+  #include <emmintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+  #define LAF_NEON 1
+  #include <arm_neon.h>
+#endif
+
+#endif
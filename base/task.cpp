@@ -1,5 +1,5 @@
 // LAF Base Library
-// Copyright (C) 2019  Igara Studio S.A.
+// Copyright (C) 2019-2025  Igara Studio S.A.
 //
 // This file is released under the terms of the MIT license.
 // Read LICENSE.txt for more information.
@@ -25,7 +25,7 @@ task::~task()
   ASSERT(m_state != state::RUNNING);
 }
 
-task_token& task::start(thread_pool& pool)
+task_token& task::start(thread_pool& pool, const thread_pool::priority priority)
 {
   // Cannot start the task if it's already running or enqueued
   ASSERT(m_state != state::RUNNING && m_state != state::ENQUEUED);
@@ -33,7 +33,7 @@ task_token& task::start(thread_pool& pool)
   m_state = state::ENQUEUED;
   m_token.reset();
 
-  m_token.m_work = pool.execute([this] { in_worker_thread(); });
+  m_token.m_work = pool.execute([this] { in_worker_thread(); }, priority);
   return m_token;
 }
 
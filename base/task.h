@@ -1,5 +1,5 @@
 // LAF Base Library
-// Copyright (C) 2019  Igara Studio S.A.
+// Copyright (C) 2019-2025  Igara Studio S.A.
 //
 // This file is released under the terms of the MIT license.
 // Read LICENSE.txt for more information.
@@ -88,7 +88,8 @@ public:
   // safely.
   void on_finished(finfunc_t&& f) { m_finished = std::move(f); }
 
-  task_token& start(thread_pool& pool);
+  task_token& start(thread_pool& pool,
+                    thread_pool::priority priority = thread_pool::priority::NORMAL);
   bool try_pop(thread_pool& pool);
 
   bool running() const { return m_state == state::RUNNING; }
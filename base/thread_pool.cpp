@@ -1,5 +1,5 @@
 // LAF Base Library
-// Copyright (C) 2019-2022  Igara Studio S.A.
+// Copyright (C) 2019-2025  Igara Studio S.A.
 //
 // This file is released under the terms of the MIT license.
 // Read LICENSE.txt for more information.
@@ -12,6 +12,8 @@
 #include "base/log.h"
 #include "base/thread_pool.h"
 
+#include <algorithm>
+
 namespace base {
 
 thread_pool::thread_pool(const size_t n) : m_running(true), m_threads(n), m_doingWork(0)
@@ -26,13 +28,14 @@ thread_pool::~thread_pool()
   join_all();
 }
 
-const thread_pool::work* thread_pool::execute(std::function<void()>&& func)
+const thread_pool::work* thread_pool::execute(std::function<void()>&& func, const priority p)
 {
-  thread_pool::work_ptr work = std::make_unique<thread_pool::work>(std::move(func));
+  thread_pool::work_ptr work = std::make_unique<thread_pool::work>(std::move(func), p);
   const thread_pool::work* result = work.get();
   const std::unique_lock lock(m_mutex);
   ASSERT(m_running);
-  m_work.push_back(std::move(work));
+  work->m_queued_at = clock::now();
+  m_work[int(p)].push_back(std::move(work));
   m_cv.notify_one();
   return result;
 }
@@ -40,10 +43,12 @@ const thread_pool::work* thread_pool::execute(std::function<void()>&& func)
 bool thread_pool::try_pop(const work* w)
 {
   std::unique_lock<std::mutex> lock(m_mutex);
-  for (auto it = m_work.begin(); it != m_work.end(); ++it) {
-    if (w == it->get()) {
-      m_work.erase(it);
-      return true;
+  for (auto& queue : m_work) {
+    for (auto it = queue.begin(); it != queue.end(); ++it) {
+      if (w == it->get()) {
+        queue.erase(it);
+        return true;
+      }
     }
   }
   return false;
@@ -52,8 +57,70 @@ bool thread_pool::try_pop(const work* w)
 void thread_pool::wait_all()
 {
   std::unique_lock<std::mutex> lock(m_mutex);
-  m_cvWait.wait(lock,
-                [this]() -> bool { return !m_running || (m_work.empty() && m_doingWork == 0); });
+  m_cvWait.wait(lock, [this]() -> bool { return !m_running || (!has_work() && m_doingWork == 0); });
+}
+
+void thread_pool::set_aging(const clock::duration aging)
+{
+  const std::unique_lock lock(m_mutex);
+  m_aging = aging;
+}
+
+thread_pool::wait_stats thread_pool::queue_wait(const priority p) const
+{
+  const std::unique_lock lock(m_mutex);
+  return m_stats[int(p)];
+}
+
+void thread_pool::reset_queue_wait()
+{
+  const std::unique_lock lock(m_mutex);
+  for (auto& stats : m_stats)
+    stats = wait_stats();
+}
+
+bool thread_pool::has_work() const
+{
+  for (const auto& queue : m_work) {
+    if (!queue.empty())
+      return true;
+  }
+  return false;
+}
+
+thread_pool::work_ptr thread_pool::pop_next_work()
+{
+  const clock::time_point now = clock::now();
+
+  // Use the first work of the queue with the highest priority
+  // (adding the aging bonus of each work).
+  int best = -1;
+  int bestLevel = 0;
+  for (int i = 0; i < kPriorities; ++i) {
+    if (m_work[i].empty())
+      continue;
+
+    int level = i;
+    if (m_aging > clock::duration::zero())
+      level -= int((now - m_work[i].front()->m_queued_at) / m_aging);
+
+    if (best < 0 || level < bestLevel) {
+      best = i;
+      bestLevel = level;
+    }
+  }
+  if (best < 0)
+    return nullptr;
+
+  work_ptr w = std::move(m_work[best].front());
+  m_work[best].pop_front();
+
+  wait_stats& stats = m_stats[best];
+  const double wait = std::chrono::duration<double>(now - w->m_queued_at).count();
+  ++stats.count;
+  stats.total += wait;
+  stats.max = std::max(stats.max, wait);
+  return w;
 }
 
 void thread_pool::join_all()
@@ -91,12 +158,13 @@ void thread_pool::worker()
     std::function<void()> func;
     {
       std::unique_lock<std::mutex> lock(m_mutex);
-      m_cv.wait(lock, [this]() -> bool { return !m_running || !m_work.empty(); });
+      m_cv.wait(lock, [this]() -> bool { return !m_running || has_work(); });
       running = m_running;
-      if (m_running && !m_work.empty()) {
-        func = std::move(m_work.front()->m_func);
-        ++m_doingWork;
-        m_work.pop_front();
+      if (m_running) {
+        if (work_ptr w = pop_next_work()) {
+          func = std::move(w->m_func);
+          ++m_doingWork;
+        }
       }
     }
     try {
@@ -1,5 +1,5 @@
 // LAF Base Library
-// Copyright (C) 2019-2022  Igara Studio S.A.
+// Copyright (C) 2019-2025  Igara Studio S.A.
 //
 // This file is released under the terms of the MIT license.
 // Read LICENSE.txt for more information.
@@ -8,6 +8,7 @@
 #define BASE_THREAD_POOL_H_INCLUDED
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <functional>
@@ -19,22 +20,48 @@ namespace base {
 
 class thread_pool {
 public:
+  // Works with higher priority are executed first (each priority has
+  // its own FIFO queue).
+  enum class priority {
+    INTERACTIVE, // The user is waiting the result (e.g. a preview)
+    NORMAL,
+    BACKGROUND, // E.g. autosave, thumbnails, etc.
+  };
+  static constexpr const int kPriorities = 3;
+
+  typedef std::chrono::steady_clock clock;
+
   class work {
     friend class thread_pool;
 
   public:
-    work(std::function<void()>&& func) { m_func = std::move(func); }
+    work(std::function<void()>&& func, priority p = priority::NORMAL)
+      : m_func(std::move(func))
+      , m_priority(p)
+    {
+    }
 
   private:
     std::function<void()> m_func = nullptr;
+    priority m_priority;
+    clock::time_point m_queued_at;
   };
 
   typedef std::unique_ptr<work> work_ptr;
 
+  // Time that works waited in the queue before being executed.
+  struct wait_stats {
+    int count = 0;
+    double total = 0.0; // In seconds
+    double max = 0.0;
+
+    double average() const { return (count > 0 ? total / count : 0.0); }
+  };
+
   thread_pool(const size_t n);
   ~thread_pool();
 
-  const work* execute(std::function<void()>&& func);
+  const work* execute(std::function<void()>&& func, priority p = priority::NORMAL);
 
   // Removes the specified work from the queue if possible. Returns true if it
   // was able to do so, or false otherwise.
@@ -43,6 +70,16 @@ public:
   // Waits until the queue is empty.
   void wait_all();
 
+  // Works with lower priority that waited more than the given time
+  // are executed as if they had one more level of priority (two
+  // levels if they waited twice that time, etc.), so they are not
+  // starved by works with higher priority. Zero (the default)
+  // disables aging.
+  void set_aging(clock::duration aging);
+
+  wait_stats queue_wait(priority p) const;
+  void reset_queue_wait();
+
 private:
   // Joins all threads without waiting the queue to be processed.
   void join_all();
@@ -50,13 +87,20 @@ private:
   // Called for each worker thread.
   void worker();
 
+  bool has_work() const;
+
+  // Removes the next work to execute from the queues.
+  work_ptr pop_next_work();
+
   bool m_running;
   std::vector<std::thread> m_threads;
-  std::mutex m_mutex;
+  mutable std::mutex m_mutex;
   std::condition_variable m_cv;
   std::condition_variable m_cvWait;
-  std::deque<work_ptr> m_work;
+  std::deque<work_ptr> m_work[kPriorities];
   int m_doingWork;
+  clock::duration m_aging = clock::duration::zero();
+  wait_stats m_stats[kPriorities];
 };
 
 } // namespace base
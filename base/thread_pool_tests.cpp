@@ -1,5 +1,5 @@
 // LAF Base Library
-// Copyright (C) 2019  Igara Studio S.A.
+// Copyright (C) 2019-2025  Igara Studio S.A.
 //
 // This file is released under the terms of the MIT license.
 // Read LICENSE.txt for more information.
@@ -9,6 +9,8 @@
 #include "base/thread_pool.h"
 
 #include <atomic>
+#include <chrono>
+#include <string>
 
 using namespace base;
 
@@ -23,6 +25,87 @@ TEST(ThreadPool, Basic)
   EXPECT_EQ(10000, c);
 }
 
+namespace {
+
+// Keeps the only thread of the pool busy until release() is called,
+// so we can queue several works before they are executed.
+class blocker {
+public:
+  blocker(thread_pool& p)
+  {
+    p.execute([this] {
+      while (!m_released)
+        std::this_thread::yield();
+    });
+  }
+  void release() { m_released = true; }
+
+private:
+  std::atomic<bool> m_released = false;
+};
+
+} // anonymous namespace
+
+TEST(ThreadPool, Priorities)
+{
+  thread_pool p(1);
+  std::string order;
+  blocker b(p);
+  p.execute([&order] { order += "b1"; }, thread_pool::priority::BACKGROUND);
+  p.execute([&order] { order += "n1"; });
+  p.execute([&order] { order += "b2"; }, thread_pool::priority::BACKGROUND);
+  p.execute([&order] { order += "i1"; }, thread_pool::priority::INTERACTIVE);
+  p.execute([&order] { order += "n2"; }, thread_pool::priority::NORMAL);
+  p.execute([&order] { order += "i2"; }, thread_pool::priority::INTERACTIVE);
+  b.release();
+  p.wait_all();
+
+  EXPECT_EQ("i1i2n1n2b1b2", order);
+
+  EXPECT_EQ(2, p.queue_wait(thread_pool::priority::INTERACTIVE).count);
+  EXPECT_EQ(3, p.queue_wait(thread_pool::priority::NORMAL).count); // Including the blocker
+  EXPECT_EQ(2, p.queue_wait(thread_pool::priority::BACKGROUND).count);
+  EXPECT_LE(p.queue_wait(thread_pool::priority::INTERACTIVE).max,
+            p.queue_wait(thread_pool::priority::BACKGROUND).max);
+
+  p.reset_queue_wait();
+  EXPECT_EQ(0, p.queue_wait(thread_pool::priority::NORMAL).count);
+  EXPECT_EQ(0.0, p.queue_wait(thread_pool::priority::NORMAL).average());
+}
+
+TEST(ThreadPool, Aging)
+{
+  thread_pool p(1);
+  p.set_aging(std::chrono::milliseconds(5));
+
+  std::string order;
+  blocker b(p);
+  p.execute([&order] { order += "b"; }, thread_pool::priority::BACKGROUND);
+  // The background work waits more than 2 aging periods, so it's
+  // executed before the new interactive one.
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  p.execute([&order] { order += "i"; }, thread_pool::priority::INTERACTIVE);
+  b.release();
+  p.wait_all();
+
+  EXPECT_EQ("bi", order);
+}
+
+TEST(ThreadPool, TryPop)
+{
+  thread_pool p(1);
+  std::atomic<int> c(0);
+  blocker b(p);
+  const thread_pool::work* w = p.execute([&c] { ++c; }, thread_pool::priority::BACKGROUND);
+  p.execute([&c] { c += 2; }, thread_pool::priority::INTERACTIVE);
+  EXPECT_TRUE(p.try_pop(w));
+  EXPECT_FALSE(p.try_pop(w));
+  b.release();
+  p.wait_all();
+
+  EXPECT_EQ(2, c);
+}
+
 int main(int argc, char** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -1,5 +1,5 @@
 // LAF Base Library
-// Copyright (c) 2022-2024 Igara Studio S.A.
+// Copyright (c) 2022-2025 Igara Studio S.A.
 //
 // This file is released under the terms of the MIT license.
 // Read LICENSE.txt for more information.
@@ -25,6 +25,7 @@ public:
   utf8_decode& operator=(const utf8_decode&) = default;
 
   explicit utf8_decode(string_ref str) : m_it(str.begin()), m_end(str.end()) {}
+  utf8_decode(iterator begin, iterator end) : m_it(begin), m_end(end) {}
 
   iterator pos() const { return m_it; }
 
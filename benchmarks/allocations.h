@@ -0,0 +1,41 @@
+// LAF Benchmarks
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef LAF_BENCHMARKS_ALLOCATIONS_H_INCLUDED
+#define LAF_BENCHMARKS_ALLOCATIONS_H_INCLUDED
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+// Number of calls to the global operator new since the program
+// started (see allocations.cpp).
+uint64_t heap_allocations();
+
+// Counts the heap allocations of the measured iterations of a
+// benchmark, reported as the "allocs" counter (allocations per
+// iteration). Create it just before the "for (auto _ : state)" loop.
+class AllocationCounter {
+public:
+  explicit AllocationCounter(benchmark::State& state)
+    : m_state(state)
+    , m_start(heap_allocations())
+  {
+  }
+
+  ~AllocationCounter()
+  {
+    m_state.counters["allocs"] = benchmark::Counter(double(heap_allocations() - m_start),
+                                                    benchmark::Counter::kAvgIterations);
+  }
+
+private:
+  benchmark::State& m_state;
+  uint64_t m_start;
+};
+
+#endif
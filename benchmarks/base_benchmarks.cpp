@@ -0,0 +1,118 @@
+// LAF Benchmarks
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "base/base64.h"
+#include "base/buffer.h"
+#include "base/thread_pool.h"
+#include "base/utf8_decode.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <iterator>
+#include <random>
+#include <string>
+
+namespace {
+
+// Mixed ASCII/Latin-1/CJK/emoji text, like translated UI strings.
+std::string make_utf8_text(const size_t size)
+{
+  static const char* kWords[] = { "Layer",         "Frame",  "Tileset", "Capa", "Pincel",
+                                  "Añadir",        "Größe",  "Fenêtre", "レイヤー", "フレーム",
+                                  "图层",          "Слой",   "\xF0\x9F\x8E\xA8" };
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<size_t> dist(0, std::size(kWords) - 1);
+
+  std::string text;
+  text.reserve(size + 32);
+  while (text.size() < size) {
+    text += kWords[dist(gen)];
+    text.push_back(' ');
+  }
+  return text;
+}
+
+base::buffer make_random_buffer(const size_t size)
+{
+  std::mt19937 gen(42);
+  base::buffer buf(size);
+  for (auto& byte : buf)
+    byte = uint8_t(gen());
+  return buf;
+}
+
+} // anonymous namespace
+
+// Thread pool overhead with small tasks (one "execute()" + the task
+// + "wait_all()" for each batch of 256 tasks).
+static void BM_ThreadPool_SmallTasks(benchmark::State& state)
+{
+  base::thread_pool pool(state.range(0));
+  std::atomic<int> counter(0);
+  const int kTasks = 256;
+
+  for (auto _ : state) {
+    for (int i = 0; i < kTasks; ++i)
+      pool.execute([&counter] { ++counter; });
+    pool.wait_all();
+  }
+  state.SetItemsProcessed(state.iterations() * kTasks);
+}
+BENCHMARK(BM_ThreadPool_SmallTasks)
+  ->ArgName("threads")
+  ->Arg(1)
+  ->Arg(2)
+  ->Arg(4)
+  ->Arg(8)
+  ->UseRealTime();
+
+static void BM_Utf8Decode(benchmark::State& state)
+{
+  const std::string text = make_utf8_text(state.range(0));
+
+  for (auto _ : state) {
+    base::utf8_decode decode(text);
+    base::codepoint_t sum = 0;
+    while (base::codepoint_t chr = decode.next())
+      sum += chr;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_Utf8Decode)->Arg(64)->Arg(64 << 10);
+
+static void BM_Base64Encode(benchmark::State& state)
+{
+  const base::buffer input = make_random_buffer(state.range(0));
+  std::string output;
+
+  for (auto _ : state) {
+    output.clear();
+    base::encode_base64(input, output);
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_Base64Encode)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_Base64Decode(benchmark::State& state)
+{
+  const std::string input = base::encode_base64(make_random_buffer(state.range(0)));
+  base::buffer output;
+
+  for (auto _ : state) {
+    output.clear();
+    base::decode_base64(input, output);
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_Base64Decode)->Arg(1 << 10)->Arg(1 << 20);
@@ -0,0 +1,593 @@
+// LAF Benchmarks
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "allocations.h"
+#include "base/task.h"
+#include "gfx/color.h"
+#include "gfx/color_models.h"
+#include "gfx/color_space.h"
+#include "gfx/color_space_converter.h"
+#include "gfx/integer_scale.h"
+#include "gfx/packing_rects.h"
+#include "gfx/pixel_conversion.h"
+#include "gfx/rect.h"
+#include "gfx/region.h"
+#include "gfx/size.h"
+
+#include "gfx/path.h"
+#include "gfx/path_rasterizer.h"
+
+#if LAF_SKIA
+  #include "include/core/SkBitmap.h"
+  #include "include/core/SkCanvas.h"
+  #include "include/core/SkPaint.h"
+  #include "include/core/SkRegion.h"
+#endif
+
+#if LAF_BENCHMARK_PIXMAN
+  #include <pixman.h>
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+// Rectangles like the ones invalidated by a UI in one frame: a lot
+// of small widgets (some of them overlapped) in a 1920x1080 window.
+std::vector<gfx::Rect> make_widget_rects(const int n)
+{
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> x(0, 1920 - 64), y(0, 1080 - 32);
+  std::uniform_int_distribution<int> w(8, 128), h(8, 32);
+
+  std::vector<gfx::Rect> rects(n);
+  for (auto& rc : rects)
+    rc = gfx::Rect(x(gen), y(gen), w(gen), h(gen));
+  return rects;
+}
+
+std::vector<gfx::Color> make_random_colors(const int n)
+{
+  std::mt19937 gen(42);
+  std::vector<gfx::Color> colors(n);
+  for (auto& c : colors)
+    c = gfx::Color(gen());
+  return colors;
+}
+
+} // anonymous namespace
+
+//////////////////////////////////////////////////////////////////////
+// gfx::Region
+
+static void BM_Region_Union(benchmark::State& state)
+{
+  const auto rects = make_widget_rects(state.range(0));
+
+  for (auto _ : state) {
+    gfx::Region rgn;
+    for (const auto& rc : rects)
+      rgn |= gfx::Region(rc);
+    benchmark::DoNotOptimize(rgn.size());
+  }
+  state.SetItemsProcessed(state.iterations() * rects.size());
+}
+BENCHMARK(BM_Region_Union)->Arg(16)->Arg(256)->Arg(1024);
+
+static void BM_Region_Subtract(benchmark::State& state)
+{
+  const auto rects = make_widget_rects(state.range(0));
+
+  for (auto _ : state) {
+    gfx::Region rgn(gfx::Rect(0, 0, 1920, 1080));
+    for (const auto& rc : rects)
+      rgn -= gfx::Region(rc);
+    benchmark::DoNotOptimize(rgn.size());
+  }
+  state.SetItemsProcessed(state.iterations() * rects.size());
+}
+BENCHMARK(BM_Region_Subtract)->Arg(16)->Arg(256);
+
+static void BM_Region_Intersect(benchmark::State& state)
+{
+  gfx::Region a, b;
+  for (const auto& rc : make_widget_rects(256))
+    a |= gfx::Region(rc);
+  for (const auto& rc : make_widget_rects(state.range(0)))
+    b |= gfx::Region(gfx::Rect(rc).offset(16, 8));
+
+  for (auto _ : state) {
+    gfx::Region rgn;
+    rgn.createIntersection(a, b);
+    benchmark::DoNotOptimize(rgn.size());
+  }
+}
+BENCHMARK(BM_Region_Intersect)->Arg(16)->Arg(256);
+
+static void BM_Region_Contains(benchmark::State& state)
+{
+  const auto rects = make_widget_rects(256);
+  gfx::Region rgn;
+  for (const auto& rc : rects)
+    rgn |= gfx::Region(rc);
+
+  const auto queries = make_widget_rects(1024);
+  for (auto _ : state) {
+    int inside = 0;
+    for (const auto& rc : queries)
+      inside += (rgn.contains(rc) == gfx::Region::In);
+    benchmark::DoNotOptimize(inside);
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_Region_Contains);
+
+#if LAF_BENCHMARK_PIXMAN
+
+// The same benchmarks using Pixman directly, as a baseline for our
+// own gfx::Region implementation (see LAF_WITH_REGION_BAND).
+
+static void BM_PixmanRegion_Union(benchmark::State& state)
+{
+  const auto rects = make_widget_rects(state.range(0));
+
+  for (auto _ : state) {
+    pixman_region32_t rgn, rc;
+    pixman_region32_init(&rgn);
+    for (const auto& r : rects) {
+      pixman_region32_init_rect(&rc, r.x, r.y, r.w, r.h);
+      pixman_region32_union(&rgn, &rgn, &rc);
+      pixman_region32_fini(&rc);
+    }
+    benchmark::DoNotOptimize(pixman_region32_n_rects(&rgn));
+    pixman_region32_fini(&rgn);
+  }
+  state.SetItemsProcessed(state.iterations() * rects.size());
+}
+BENCHMARK(BM_PixmanRegion_Union)->Arg(16)->Arg(256)->Arg(1024);
+
+static void BM_PixmanRegion_Subtract(benchmark::State& state)
+{
+  const auto rects = make_widget_rects(state.range(0));
+
+  for (auto _ : state) {
+    pixman_region32_t rgn, rc;
+    pixman_region32_init_rect(&rgn, 0, 0, 1920, 1080);
+    for (const auto& r : rects) {
+      pixman_region32_init_rect(&rc, r.x, r.y, r.w, r.h);
+      pixman_region32_subtract(&rgn, &rgn, &rc);
+      pixman_region32_fini(&rc);
+    }
+    benchmark::DoNotOptimize(pixman_region32_n_rects(&rgn));
+    pixman_region32_fini(&rgn);
+  }
+  state.SetItemsProcessed(state.iterations() * rects.size());
+}
+BENCHMARK(BM_PixmanRegion_Subtract)->Arg(16)->Arg(256);
+
+static void BM_PixmanRegion_Intersect(benchmark::State& state)
+{
+  pixman_region32_t a, b, rc;
+  pixman_region32_init(&a);
+  pixman_region32_init(&b);
+  for (const auto& r : make_widget_rects(256)) {
+    pixman_region32_init_rect(&rc, r.x, r.y, r.w, r.h);
+    pixman_region32_union(&a, &a, &rc);
+    pixman_region32_fini(&rc);
+  }
+  for (const auto& r : make_widget_rects(state.range(0))) {
+    pixman_region32_init_rect(&rc, r.x + 16, r.y + 8, r.w, r.h);
+    pixman_region32_union(&b, &b, &rc);
+    pixman_region32_fini(&rc);
+  }
+
+  for (auto _ : state) {
+    pixman_region32_t rgn;
+    pixman_region32_init(&rgn);
+    pixman_region32_intersect(&rgn, &a, &b);
+    benchmark::DoNotOptimize(pixman_region32_n_rects(&rgn));
+    pixman_region32_fini(&rgn);
+  }
+  pixman_region32_fini(&a);
+  pixman_region32_fini(&b);
+}
+BENCHMARK(BM_PixmanRegion_Intersect)->Arg(16)->Arg(256);
+
+static void BM_PixmanRegion_Contains(benchmark::State& state)
+{
+  const auto rects = make_widget_rects(256);
+  pixman_region32_t rgn, rc;
+  pixman_region32_init(&rgn);
+  for (const auto& r : rects) {
+    pixman_region32_init_rect(&rc, r.x, r.y, r.w, r.h);
+    pixman_region32_union(&rgn, &rgn, &rc);
+    pixman_region32_fini(&rc);
+  }
+
+  const auto queries = make_widget_rects(1024);
+  for (auto _ : state) {
+    int inside = 0;
+    for (const auto& r : queries) {
+      pixman_box32_t box = { r.x, r.y, r.x2(), r.y2() };
+      inside += (pixman_region32_contains_rectangle(&rgn, &box) == PIXMAN_REGION_IN);
+    }
+    benchmark::DoNotOptimize(inside);
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+  pixman_region32_fini(&rgn);
+}
+BENCHMARK(BM_PixmanRegion_Contains);
+
+#endif // LAF_BENCHMARK_PIXMAN
+
+#if LAF_SKIA
+
+// The same benchmarks using SkRegion directly. gfx::Region is a
+// wrapper of SkRegion in Skia builds, so these results can be
+// compared with the BM_Region_* ones of a build with our own
+// gfx::Region implementation (see LAF_WITH_REGION_BAND).
+
+static void BM_SkRegion_Union(benchmark::State& state)
+{
+  const auto rects = make_widget_rects(state.range(0));
+
+  for (auto _ : state) {
+    SkRegion rgn;
+    for (const auto& r : rects)
+      rgn.op(SkIRect::MakeXYWH(r.x, r.y, r.w, r.h), SkRegion::kUnion_Op);
+    benchmark::DoNotOptimize(rgn.computeRegionComplexity());
+  }
+  state.SetItemsProcessed(state.iterations() * rects.size());
+}
+BENCHMARK(BM_SkRegion_Union)->Arg(16)->Arg(256)->Arg(1024);
+
+static void BM_SkRegion_Subtract(benchmark::State& state)
+{
+  const auto rects = make_widget_rects(state.range(0));
+
+  for (auto _ : state) {
+    SkRegion rgn(SkIRect::MakeWH(1920, 1080));
+    for (const auto& r : rects)
+      rgn.op(SkIRect::MakeXYWH(r.x, r.y, r.w, r.h), SkRegion::kDifference_Op);
+    benchmark::DoNotOptimize(rgn.computeRegionComplexity());
+  }
+  state.SetItemsProcessed(state.iterations() * rects.size());
+}
+BENCHMARK(BM_SkRegion_Subtract)->Arg(16)->Arg(256);
+
+static void BM_SkRegion_Intersect(benchmark::State& state)
+{
+  SkRegion a, b;
+  for (const auto& r : make_widget_rects(256))
+    a.op(SkIRect::MakeXYWH(r.x, r.y, r.w, r.h), SkRegion::kUnion_Op);
+  for (const auto& r : make_widget_rects(state.range(0)))
+    b.op(SkIRect::MakeXYWH(r.x + 16, r.y + 8, r.w, r.h), SkRegion::kUnion_Op);
+
+  for (auto _ : state) {
+    SkRegion rgn;
+    rgn.op(a, b, SkRegion::kIntersect_Op);
+    benchmark::DoNotOptimize(rgn.computeRegionComplexity());
+  }
+}
+BENCHMARK(BM_SkRegion_Intersect)->Arg(16)->Arg(256);
+
+static void BM_SkRegion_Contains(benchmark::State& state)
+{
+  SkRegion rgn;
+  for (const auto& r : make_widget_rects(256))
+    rgn.op(SkIRect::MakeXYWH(r.x, r.y, r.w, r.h), SkRegion::kUnion_Op);
+
+  // The same checks that gfx::Region::contains(Rect) does to return
+  // In/Part/Out
+  const auto queries = make_widget_rects(1024);
+  for (auto _ : state) {
+    int inside = 0;
+    for (const auto& r : queries) {
+      const SkIRect rc = SkIRect::MakeXYWH(r.x, r.y, r.w, r.h);
+      inside += (rgn.contains(rc) ? 1 : (rgn.intersects(rc) ? 0 : -1));
+    }
+    benchmark::DoNotOptimize(inside);
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_SkRegion_Contains);
+
+#endif // LAF_SKIA
+
+//////////////////////////////////////////////////////////////////////
+// gfx::PackingRects
+
+// Packing a sprite sheet of N frames/glyphs of different sizes.
+static void BM_PackingRects_BestFit(benchmark::State& state)
+{
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> size(4, 64);
+  std::vector<gfx::Size> sizes(state.range(0));
+  for (auto& sz : sizes)
+    sz = gfx::Size(size(gen), size(gen));
+
+  AllocationCounter allocs(state);
+  for (auto _ : state) {
+    gfx::PackingRects pr(1, 1);
+    for (const auto& sz : sizes)
+      pr.add(sz);
+    base::task_token token;
+    benchmark::DoNotOptimize(pr.bestFit(token));
+  }
+  state.SetItemsProcessed(state.iterations() * sizes.size());
+}
+BENCHMARK(BM_PackingRects_BestFit)->Arg(32)->Arg(96)->Unit(benchmark::kMillisecond);
+
+// Just one pack() call (bestFit() calls it for each tried size),
+// "allocs" are the heap allocations per call.
+static void BM_PackingRects_Pack(benchmark::State& state)
+{
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> size(4, 64);
+  gfx::PackingRects pr(1, 1);
+  for (int i = 0; i < state.range(0); ++i)
+    pr.add(gfx::Size(size(gen), size(gen)));
+
+  base::task_token token;
+  const gfx::Size sheetSize = pr.bestFit(token);
+
+  AllocationCounter allocs(state);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(pr.pack(sheetSize, token));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PackingRects_Pack)->Arg(32)->Arg(96);
+
+//////////////////////////////////////////////////////////////////////
+// Color models and color spaces
+
+static void BM_ColorModels_RgbaToHsv(benchmark::State& state)
+{
+  const auto src = make_random_colors(state.range(0));
+  std::vector<gfx::HsvF> dst(src.size());
+
+  for (auto _ : state) {
+    gfx::rgba_to_hsv(src.data(), dst.data(), src.size());
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetItemsProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_ColorModels_RgbaToHsv)->Arg(64 << 10);
+
+static void BM_ColorModels_HsvToRgba(benchmark::State& state)
+{
+  const auto colors = make_random_colors(state.range(0));
+  std::vector<gfx::HsvF> src(colors.size());
+  gfx::rgba_to_hsv(colors.data(), src.data(), colors.size());
+  std::vector<gfx::Color> dst(src.size());
+
+  for (auto _ : state) {
+    gfx::hsv_to_rgba(src.data(), dst.data(), src.size());
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetItemsProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_ColorModels_HsvToRgba)->Arg(64 << 10);
+
+static void BM_ColorModels_RgbaToHsl8(benchmark::State& state)
+{
+  const auto src = make_random_colors(state.range(0));
+  std::vector<gfx::Hsl8> dst(src.size());
+
+  for (auto _ : state) {
+    gfx::rgba_to_hsl8(src.data(), dst.data(), src.size());
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetItemsProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_ColorModels_RgbaToHsl8)->Arg(64 << 10);
+
+static void BM_ColorSpaceConverter_Rgba8(benchmark::State& state)
+{
+  // sRGB -> Display P3
+  const gfx::ColorSpacePrimaries p3 = { 0.680f, 0.320f, 0.265f, 0.690f,
+                                        0.150f, 0.060f, 0.3127f, 0.3290f };
+  const auto conv = gfx::ColorSpaceConverter::Make(gfx::ColorSpace::MakeSRGB(),
+                                                   gfx::ColorSpace::MakeRGBWithSRGBGamma(p3));
+  if (!conv) {
+    state.SkipWithError("Color space converter not available");
+    return;
+  }
+
+  const auto colors = make_random_colors(state.range(0));
+  std::vector<uint32_t> dst(colors.size());
+  for (auto _ : state) {
+    conv->convertRgba8(dst.data(), (const uint32_t*)colors.data(), int(colors.size()));
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetItemsProcessed(state.iterations() * colors.size());
+}
+BENCHMARK(BM_ColorSpaceConverter_Rgba8)->Arg(64 << 10);
+
+//////////////////////////////////////////////////////////////////////
+// Integer upscale
+
+// Presenting a full 960x540 backbuffer on a window with the given
+// scale.
+static void BM_IntegerUpscale(benchmark::State& state)
+{
+  const int scale = state.range(0);
+  const int w = 960, h = 540;
+  const auto src = make_random_colors(w * h);
+  std::vector<uint32_t> dst(w * scale * h * scale);
+  const gfx::Rect rc(0, 0, w * scale, h * scale);
+
+  for (auto _ : state) {
+    gfx::integer_upscale((const uint32_t*)src.data(), w, dst.data(), w * scale, rc, scale);
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetBytesProcessed(state.iterations() * dst.size() * sizeof(uint32_t));
+}
+BENCHMARK(BM_IntegerUpscale)->ArgName("scale")->DenseRange(1, 4);
+
+//////////////////////////////////////////////////////////////////////
+// Pixel conversion
+
+static void BM_PixelConversion_Premultiply(benchmark::State& state)
+{
+  const auto src = make_random_colors(state.range(0));
+  std::vector<uint32_t> dst(src.size());
+
+  for (auto _ : state) {
+    gfx::premultiply_alpha((const uint32_t*)src.data(), dst.data(), int(src.size()));
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetItemsProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_PixelConversion_Premultiply)->Arg(64 << 10);
+
+static void BM_PixelConversion_Unpremultiply(benchmark::State& state)
+{
+  const auto colors = make_random_colors(state.range(0));
+  std::vector<uint32_t> src(colors.size());
+  gfx::premultiply_alpha((const uint32_t*)colors.data(), src.data(), int(src.size()));
+  std::vector<uint32_t> dst(src.size());
+
+  for (auto _ : state) {
+    gfx::unpremultiply_alpha(src.data(), dst.data(), int(src.size()));
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetItemsProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_PixelConversion_Unpremultiply)->Arg(64 << 10);
+
+// Clipboard images are usually 24-bit BGR
+static void BM_PixelConversion_UnpackBgr24(benchmark::State& state)
+{
+  const int n = state.range(0);
+  std::vector<uint8_t> src(3 * n);
+  for (int i = 0; i < int(src.size()); ++i)
+    src[i] = uint8_t(i * 7);
+  std::vector<uint32_t> dst(n);
+  gfx::PixelMasks masks;
+  masks.r = 0xff0000;
+  masks.b = 0xff;
+  masks.a = 0;
+  const gfx::PixelUnpacker unpacker(24, masks);
+
+  for (auto _ : state) {
+    unpacker.unpack(src.data(), dst.data(), n);
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_PixelConversion_UnpackBgr24)->Arg(64 << 10);
+
+//////////////////////////////////////////////////////////////////////
+// Path rasterizer (used by the "none" backend)
+//
+// Skia builds draw the same paths with SkCanvas too, so both can be
+// compared in the same run (e.g. PathRasterizer_Fill vs
+// SkCanvas_DrawPath_Fill). SkCanvas timings include the blending in
+// an A8 bitmap, while the rasterizer benchmarks only generate the
+// coverage spans. The accuracy of both is compared in the
+// PathRasterizer.SkCanvasReference test.
+
+namespace {
+
+gfx::Path make_fill_path()
+{
+  gfx::Path path;
+  path.oval(gfx::RectF(16, 16, 480, 480));
+  path.roundedRect(gfx::RectF(64, 64, 384, 128), 24, 24);
+  return path;
+}
+
+// A polyline like a brush stroke
+gfx::Path make_stroke_path()
+{
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float> coord(0.0f, 512.0f);
+  gfx::Path path;
+  path.moveTo(coord(gen), coord(gen));
+  for (int i = 0; i < 64; ++i)
+    path.lineTo(coord(gen), coord(gen));
+  return path;
+}
+
+} // anonymous namespace
+
+static void BM_PathRasterizer_Fill(benchmark::State& state)
+{
+  const gfx::Path path = make_fill_path();
+  gfx::PathRasterizer rasterizer;
+  rasterizer.antialias(state.range(0) ? true : false);
+
+  for (auto _ : state) {
+    rasterizer.reset(gfx::Rect(0, 0, 512, 512));
+    rasterizer.addPath(path);
+    int pixels = 0;
+    rasterizer.rasterize([&pixels](int x, int y, int len, const uint8_t*) { pixels += len; });
+    benchmark::DoNotOptimize(pixels);
+  }
+}
+BENCHMARK(BM_PathRasterizer_Fill)->ArgName("antialias")->Arg(0)->Arg(1);
+
+static void BM_PathRasterizer_Stroke(benchmark::State& state)
+{
+  const gfx::Path path = make_stroke_path();
+  gfx::PathRasterizer rasterizer;
+  rasterizer.antialias(true);
+
+  for (auto _ : state) {
+    rasterizer.reset(gfx::Rect(0, 0, 512, 512));
+    rasterizer.addStroke(path, gfx::Matrix(), 4.0f);
+    int pixels = 0;
+    rasterizer.rasterize([&pixels](int x, int y, int len, const uint8_t*) { pixels += len; });
+    benchmark::DoNotOptimize(pixels);
+  }
+}
+BENCHMARK(BM_PathRasterizer_Stroke);
+
+#if LAF_SKIA
+
+static void BM_SkCanvas_DrawPath_Fill(benchmark::State& state)
+{
+  const gfx::Path path = make_fill_path();
+  SkBitmap bitmap;
+  bitmap.allocPixels(SkImageInfo::MakeA8(512, 512));
+  SkCanvas canvas(bitmap);
+  SkPaint paint;
+  paint.setAntiAlias(state.range(0) ? true : false);
+
+  for (auto _ : state) {
+    canvas.drawPath(path.skPath(), paint);
+    benchmark::DoNotOptimize(bitmap.getPixels());
+  }
+}
+BENCHMARK(BM_SkCanvas_DrawPath_Fill)->ArgName("antialias")->Arg(0)->Arg(1);
+
+static void BM_SkCanvas_DrawPath_Stroke(benchmark::State& state)
+{
+  const gfx::Path path = make_stroke_path();
+  SkBitmap bitmap;
+  bitmap.allocPixels(SkImageInfo::MakeA8(512, 512));
+  SkCanvas canvas(bitmap);
+  SkPaint paint;
+  paint.setAntiAlias(true);
+  paint.setStyle(SkPaint::kStroke_Style);
+  paint.setStrokeWidth(4.0f);
+
+  for (auto _ : state) {
+    canvas.drawPath(path.skPath(), paint);
+    benchmark::DoNotOptimize(bitmap.getPixels());
+  }
+}
+BENCHMARK(BM_SkCanvas_DrawPath_Stroke);
+
+#endif // LAF_SKIA
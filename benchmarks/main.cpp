@@ -0,0 +1,29 @@
+// LAF Benchmarks
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "os/system.h"
+
+#include <benchmark/benchmark.h>
+
+int app_main(int argc, char** argv)
+{
+#if LAF_SKIA
+  // Required to create Skia surfaces and fonts
+  os::SystemRef system = os::System::make();
+#endif
+
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::Shutdown();
+  return 0;
+}
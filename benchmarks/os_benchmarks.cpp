@@ -0,0 +1,187 @@
+// LAF Benchmarks
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "gfx/region.h"
+#include "os/paint.h"
+#include "os/recording_surface.h"
+#include "os/surface.h"
+#include "os/system.h"
+#include "os/tile_rasterizer.h"
+
+#if !LAF_SKIA
+  #include "os/none/surface.h"
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using namespace os;
+
+namespace {
+
+SurfaceRef make_surface(const int w, const int h)
+{
+#if LAF_SKIA
+  return System::instance()->makeRgbaSurface(w, h);
+#else
+  return os::make_ref<NoneSurface>(w, h, nullptr);
+#endif
+}
+
+// Fills the surface with a pattern of semi-transparent pixels (so
+// blending cannot be skipped).
+void fill_pattern(Surface* s)
+{
+  Paint paint;
+  for (int y = 0; y < s->height(); y += 8) {
+    for (int x = 0; x < s->width(); x += 8) {
+      paint.color(gfx::rgba(x & 255, y & 255, (x + y) & 255, 64 + ((x ^ y) & 127)));
+      s->drawRect(gfx::Rect(x, y, 8, 8), paint);
+    }
+  }
+}
+
+// A UI frame: panels, widgets with borders, text-like rows of small
+// rectangles and some antialiased shapes.
+void draw_ui_frame(Surface* s)
+{
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> x(0, s->width() - 128), y(0, s->height() - 32);
+  Paint paint;
+
+  paint.color(gfx::rgba(32, 32, 40));
+  s->drawRect(gfx::Rect(0, 0, s->width(), s->height()), paint);
+
+  for (int i = 0; i < 500; ++i) {
+    const gfx::Rect rc(x(gen), y(gen), 120, 24);
+    paint.style(Paint::Fill);
+    paint.color(gfx::rgba(64, 64, 80));
+    s->drawRect(rc, paint);
+    paint.style(Paint::Stroke);
+    paint.color(gfx::rgba(128, 128, 160));
+    s->drawRect(rc, paint);
+
+    paint.style(Paint::Fill);
+    paint.color(gfx::rgba(220, 220, 220));
+    for (int j = 0; j < 12; ++j)
+      s->drawRect(gfx::Rect(rc.x + 4 + j * 9, rc.y + 8, 7, 9), paint);
+  }
+
+  paint.antialias(true);
+  paint.color(gfx::rgba(255, 128, 0, 160));
+  for (int i = 0; i < 50; ++i)
+    s->drawCircle(x(gen), y(gen), 20, paint);
+}
+
+} // anonymous namespace
+
+//////////////////////////////////////////////////////////////////////
+// Surface blits
+
+static void BM_Surface_DrawSurface(benchmark::State& state)
+{
+  const int size = state.range(0);
+  SurfaceRef dst = make_surface(1920, 1080);
+  SurfaceRef src = make_surface(size, size);
+  fill_pattern(src.get());
+
+  for (auto _ : state)
+    dst->drawSurface(src.get(), 16, 16);
+  state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_Surface_DrawSurface)->Arg(64)->Arg(512);
+
+static void BM_Surface_DrawRgbaSurface(benchmark::State& state)
+{
+  const int size = state.range(0);
+  SurfaceRef dst = make_surface(1920, 1080);
+  SurfaceRef src = make_surface(size, size);
+  fill_pattern(src.get());
+
+  for (auto _ : state)
+    dst->drawRgbaSurface(src.get(), 16, 16);
+  state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_Surface_DrawRgbaSurface)->Arg(64)->Arg(512);
+
+static void BM_Surface_DrawSurfaceScaled(benchmark::State& state)
+{
+  SurfaceRef dst = make_surface(1920, 1080);
+  SurfaceRef src = make_surface(256, 256);
+  fill_pattern(src.get());
+
+  for (auto _ : state)
+    dst->drawSurface(src.get(), src->bounds(), gfx::Rect(0, 0, 1024, 1024));
+  state.SetItemsProcessed(state.iterations() * 1024 * 1024);
+}
+BENCHMARK(BM_Surface_DrawSurfaceScaled);
+
+static void BM_Surface_BlitTo(benchmark::State& state)
+{
+  SurfaceRef dst = make_surface(1920, 1080);
+  SurfaceRef src = make_surface(1920, 1080);
+  fill_pattern(src.get());
+
+  for (auto _ : state)
+    src->blitTo(dst.get(), 0, 0, 0, 0, 1920, 1080);
+  state.SetBytesProcessed(state.iterations() * 1920 * 1080 * 4);
+}
+BENCHMARK(BM_Surface_BlitTo);
+
+static void BM_Surface_ScrollTo(benchmark::State& state)
+{
+  SurfaceRef s = make_surface(1920, 1080);
+  fill_pattern(s.get());
+
+  int dy = 1;
+  for (auto _ : state) {
+    s->scrollTo(s->bounds(), 0, dy);
+    dy = -dy;
+  }
+  state.SetBytesProcessed(state.iterations() * 1920 * 1080 * 4);
+}
+BENCHMARK(BM_Surface_ScrollTo);
+
+//////////////////////////////////////////////////////////////////////
+// Tiled rasterization of a recorded frame
+
+static void BM_TileRasterizer_Frame(benchmark::State& state)
+{
+  auto recording = os::make_ref<RecordingSurface>(1920, 1080);
+  draw_ui_frame(recording.get());
+
+  SurfaceRef dst = make_surface(1920, 1080);
+  TileRasterizer tiles(state.range(0));
+  const gfx::Region invalid(dst->bounds());
+
+  for (auto _ : state) {
+    gfx::Region present = tiles.rasterize(recording.get(), dst.get(), invalid);
+    benchmark::DoNotOptimize(present.size());
+  }
+  state.counters["commands"] = recording->commandCount();
+}
+BENCHMARK(BM_TileRasterizer_Frame)
+  ->ArgName("threads")
+  ->Arg(1)
+  ->Arg(2)
+  ->Arg(4)
+  ->Arg(8)
+  ->UseRealTime()
+  ->Unit(benchmark::kMillisecond);
+
+// Same frame drawn directly in the surface (without recording).
+static void BM_TileRasterizer_Direct(benchmark::State& state)
+{
+  SurfaceRef dst = make_surface(1920, 1080);
+  for (auto _ : state)
+    draw_ui_frame(dst.get());
+}
+BENCHMARK(BM_TileRasterizer_Direct)->Unit(benchmark::kMillisecond);
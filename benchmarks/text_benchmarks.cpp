@@ -0,0 +1,137 @@
+// LAF Benchmarks
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "allocations.h"
+#include "gfx/color.h"
+#include "os/surface.h"
+#include "os/system.h"
+#include "text/draw_text.h"
+#include "text/font.h"
+#include "text/font_mgr.h"
+#include "text/text_blob.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+using namespace text;
+
+namespace {
+
+// Typical UI strings (a menu item, a tooltip and a mixed LTR/RTL
+// paragraph).
+const char* kTexts[] = {
+  "Open Recent",
+  "Select the layer to move the content of the active cel (Ctrl+Click)",
+  "Añadir capa — レイヤーを追加 — إضافة طبقة — 添加图层 — Добавить слой",
+};
+
+// Colors each word of the text with a different color (like syntax
+// highlighting), using spans or individual characters.
+class HighlightDelegate : public DrawTextDelegate {
+public:
+  HighlightDelegate(const std::string& text, bool spans) : m_text(text), m_spans(spans) {}
+
+  bool useSpans() const override { return m_spans; }
+
+  int preProcessSpan(const int index, gfx::Color& fg, gfx::Color& bg) override
+  {
+    fg = color(index);
+    const size_t end = m_text.find(' ', index + 1);
+    return (end == std::string::npos ? int(m_text.size()) : int(end));
+  }
+
+  void preProcessChar(const int index,
+                      const codepoint_t codepoint,
+                      gfx::Color& fg,
+                      gfx::Color& bg,
+                      const gfx::Rect& charBounds) override
+  {
+    fg = color(index);
+  }
+
+private:
+  gfx::Color color(const int index) const
+  {
+    const size_t begin = m_text.rfind(' ', index);
+    return (begin == std::string::npos || (begin & 1) ? gfx::rgba(255, 255, 255) :
+                                                        gfx::rgba(255, 128, 0));
+  }
+
+  const std::string& m_text;
+  bool m_spans;
+};
+
+} // anonymous namespace
+
+static void BM_TextBlob_Make(benchmark::State& state)
+{
+  FontMgrRef fontMgr = FontMgr::Make();
+  FontRef font = fontMgr->defaultFont(12);
+  const std::string text = kTexts[state.range(0)];
+  if (!TextBlob::Make(font, text)) {
+    state.SkipWithError("TextBlob::Make() is not available for the default font");
+    return;
+  }
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(TextBlob::Make(font, text));
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_TextBlob_Make)->DenseRange(0, 1);
+
+static void BM_TextBlob_MakeWithShaper(benchmark::State& state)
+{
+  FontMgrRef fontMgr = FontMgr::Make();
+  FontRef font = fontMgr->defaultFont(12);
+  const std::string text = kTexts[state.range(0)];
+  if (!TextBlob::MakeWithShaper(fontMgr, font, text)) {
+    state.SkipWithError("No shaper available for the default font");
+    return;
+  }
+
+  AllocationCounter allocs(state);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(TextBlob::MakeWithShaper(fontMgr, font, text));
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_TextBlob_MakeWithShaper)->DenseRange(0, 2);
+
+static void BM_DrawText_Delegate(benchmark::State& state)
+{
+  os::SystemRef system = os::System::instance();
+  FontMgrRef fontMgr = FontMgr::Make();
+  FontRef font = fontMgr->defaultFont(12);
+  std::string text;
+  for (int i = 0; i < 8; ++i)
+    text += std::string(kTexts[1]) + " ";
+  if (!system || !TextBlob::MakeWithShaper(fontMgr, font, text)) {
+    state.SkipWithError("No shaper available for the default font");
+    return;
+  }
+
+  os::SurfaceRef surface = system->makeRgbaSurface(4096, 32);
+  HighlightDelegate delegate(text, state.range(0) ? true : false);
+
+  AllocationCounter allocs(state);
+  for (auto _ : state) {
+    draw_text(surface.get(),
+              fontMgr,
+              font,
+              text,
+              gfx::rgba(255, 255, 255),
+              gfx::ColorNone,
+              0,
+              0,
+              &delegate);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_DrawText_Delegate)->ArgName("spans")->Arg(0)->Arg(1);
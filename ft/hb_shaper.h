@@ -1,5 +1,5 @@
 // LAF FreeType Wrapper
-// Copyright (c) 2020-2024 Igara Studio S.A.
+// Copyright (c) 2020-2025 Igara Studio S.A.
 // Copyright (c) 2017 David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -26,10 +26,21 @@ public:
     if (decode.is_end())
       return;
 
-    hb_buffer_t* buf = hb_buffer_create();
-    hb_buffer_t* chrBuf = hb_buffer_create();
+    // Reuse the harfbuzz buffers of this thread (they keep their
+    // internal arrays between shapers).
+    Buffers& buffers = threadBuffers();
+    hb_buffer_t* buf = buffers.buf;
+    hb_buffer_t* chrBuf = buffers.chrBuf;
+    hb_buffer_reset(buf);
+    hb_buffer_reset(chrBuf);
     hb_script_t script = HB_SCRIPT_UNKNOWN;
 
+    // The number of UTF-8 bytes is a good upper bound for the number
+    // of glyphs, so we avoid growing these arrays for each script run.
+    m_codePoints.reserve(str.size());
+    m_glyphInfo.reserve(str.size());
+    m_glyphPos.reserve(str.size());
+
     const auto begin = str.begin();
     while (true) {
       const auto pos = decode.pos();
@@ -53,9 +64,6 @@ public:
       hb_buffer_add(buf, chr, pos - begin);
     }
     addBuffer(buf, script);
-
-    hb_buffer_destroy(buf);
-    hb_buffer_destroy(chrBuf);
   }
 
   base::codepoint_t next()
@@ -94,6 +102,22 @@ public:
   }
 
 private:
+  struct Buffers {
+    hb_buffer_t* buf = hb_buffer_create();
+    hb_buffer_t* chrBuf = hb_buffer_create();
+    ~Buffers()
+    {
+      hb_buffer_destroy(buf);
+      hb_buffer_destroy(chrBuf);
+    }
+  };
+
+  static Buffers& threadBuffers()
+  {
+    static thread_local Buffers buffers;
+    return buffers;
+  }
+
   void addBuffer(hb_buffer_t* buf, hb_script_t script)
   {
     if (hb_buffer_get_length(buf) == 0)
@@ -0,0 +1,515 @@
+// LAF Gfx Library
+// Copyright (c) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "gfx/color_models.h"
+
+#include "base/simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace gfx {
+
+namespace {
+
+//////////////////////////////////////////////////////////////////////
+// Float kernels
+//
+// The scalar and SSE2 versions use exactly the same operations (in
+// the same order) so they give the same results.
+
+inline float wrap_hue(float h)
+{
+  h -= 360.0f * std::floor(h * (1.0f / 360.0f));
+  return (h >= 360.0f ? h - 360.0f : h);
+}
+
+inline int to_int8(const float v)
+{
+  return int(v * 255.0f + 0.5f);
+}
+
+// Common hue calculation for HSV and HSL (M/m are the max/min of
+// r/g/b in [0, 255], c = M - m).
+inline float hue_from_rgb(const float r,
+                          const float g,
+                          const float b,
+                          const float M,
+                          const float c)
+{
+  const float invC = (c > 0.0f ? 1.0f / c : 0.0f);
+  float h;
+  if (M == r) {
+    h = (g - b) * invC;
+    if (h < 0.0f)
+      h += 6.0f;
+  }
+  else if (M == g)
+    h = (b - r) * invC + 2.0f;
+  else
+    h = (r - g) * invC + 4.0f;
+  return h * 60.0f;
+}
+
+inline void rgba_to_hsv_px(const Color c, HsvF& out)
+{
+  const float r = float(getr(c));
+  const float g = float(getg(c));
+  const float b = float(getb(c));
+  const float M = std::max(r, std::max(g, b));
+  const float m = std::min(r, std::min(g, b));
+  const float chroma = M - m;
+  out.h = hue_from_rgb(r, g, b, M, chroma);
+  out.s = chroma * (M > 0.0f ? 1.0f / M : 0.0f);
+  out.v = M * (1.0f / 255.0f);
+  out.a = float(geta(c)) * (1.0f / 255.0f);
+}
+
+inline void rgba_to_hsl_px(const Color c, HslF& out)
+{
+  const float r = float(getr(c));
+  const float g = float(getg(c));
+  const float b = float(getb(c));
+  const float M = std::max(r, std::max(g, b));
+  const float m = std::min(r, std::min(g, b));
+  const float chroma = M - m;
+  const float den = 255.0f - std::fabs(M + m - 255.0f);
+  out.h = hue_from_rgb(r, g, b, M, chroma);
+  out.s = chroma * (den > 0.0f ? 1.0f / den : 0.0f);
+  out.l = (M + m) * (1.0f / 510.0f);
+  out.a = float(geta(c)) * (1.0f / 255.0f);
+}
+
+// HSV to RGB without branches: f(n) = v - v*s*clamp(min(k, 4-k), 0, 1)
+// with k = (n + h/60) mod 6, for n=5 (red), 3 (green), 1 (blue).
+inline float hsv_channel(const float n, const float hp, const float v, const float vs)
+{
+  float k = n + hp;
+  if (k >= 6.0f)
+    k -= 6.0f;
+  const float t = std::max(std::min(std::min(k, 4.0f - k), 1.0f), 0.0f);
+  return v - vs * t;
+}
+
+inline Color hsv_to_rgba_px(const HsvF& in)
+{
+  const float hp = wrap_hue(in.h) * (1.0f / 60.0f);
+  const float s = std::clamp(in.s, 0.0f, 1.0f);
+  const float v = std::clamp(in.v, 0.0f, 1.0f);
+  const float a = std::clamp(in.a, 0.0f, 1.0f);
+  const float vs = v * s;
+  return rgba(to_int8(hsv_channel(5.0f, hp, v, vs)),
+              to_int8(hsv_channel(3.0f, hp, v, vs)),
+              to_int8(hsv_channel(1.0f, hp, v, vs)),
+              to_int8(a));
+}
+
+// HSL to RGB without branches: f(n) = l - q*clamp(min(k-3, 9-k), -1, 1)
+// with q = s*min(l, 1-l) and k = (n + h/30) mod 12, for n=0 (red),
+// 8 (green), 4 (blue).
+inline float hsl_channel(const float n, const float hp, const float l, const float q)
+{
+  float k = n + hp;
+  if (k >= 12.0f)
+    k -= 12.0f;
+  const float t = std::max(std::min(std::min(k - 3.0f, 9.0f - k), 1.0f), -1.0f);
+  return l - q * t;
+}
+
+inline Color hsl_to_rgba_px(const HslF& in)
+{
+  const float hp = wrap_hue(in.h) * (1.0f / 30.0f);
+  const float s = std::clamp(in.s, 0.0f, 1.0f);
+  const float l = std::clamp(in.l, 0.0f, 1.0f);
+  const float a = std::clamp(in.a, 0.0f, 1.0f);
+  const float q = s * std::min(l, 1.0f - l);
+  return rgba(to_int8(hsl_channel(0.0f, hp, l, q)),
+              to_int8(hsl_channel(8.0f, hp, l, q)),
+              to_int8(hsl_channel(4.0f, hp, l, q)),
+              to_int8(a));
+}
+
+#if LAF_SSE2
+
+// mask ? a : b
+inline __m128 select(const __m128 mask, const __m128 a, const __m128 b)
+{
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline __m128 floor_ps(const __m128 x)
+{
+  const __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+  return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, x), _mm_set1_ps(1.0f)));
+}
+
+inline __m128 clamp01(const __m128 x)
+{
+  return _mm_min_ps(_mm_max_ps(x, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+}
+
+// 1/x or 0 when x is 0
+inline __m128 safe_reciprocal(const __m128 x)
+{
+  const __m128 zero = _mm_setzero_ps();
+  return _mm_and_ps(_mm_cmpgt_ps(x, zero), _mm_div_ps(_mm_set1_ps(1.0f), x));
+}
+
+// Loads 4 pixels as r/g/b/a floats in [0, 255]
+inline void load_rgba(const Color* src, __m128& r, __m128& g, __m128& b, __m128& a)
+{
+  const __m128i px = _mm_loadu_si128((const __m128i*)src);
+  const __m128i mask = _mm_set1_epi32(0xff);
+  r = _mm_cvtepi32_ps(_mm_and_si128(px, mask));
+  g = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(px, 8), mask));
+  b = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(px, 16), mask));
+  a = _mm_cvtepi32_ps(_mm_srli_epi32(px, 24));
+}
+
+// Stores 4 pixels from r/g/b/a floats in [0, 1]
+inline void store_rgba(Color* dst, const __m128 r, const __m128 g, const __m128 b, const __m128 a)
+{
+  const __m128 k255 = _mm_set1_ps(255.0f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128i ri = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(r, k255), half));
+  const __m128i gi = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(g, k255), half));
+  const __m128i bi = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(b, k255), half));
+  const __m128i ai = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(a, k255), half));
+  const __m128i px = _mm_or_si128(_mm_or_si128(ri, _mm_slli_epi32(gi, 8)),
+                                  _mm_or_si128(_mm_slli_epi32(bi, 16), _mm_slli_epi32(ai, 24)));
+  _mm_storeu_si128((__m128i*)dst, px);
+}
+
+inline __m128 hue_from_rgb(const __m128 r,
+                           const __m128 g,
+                           const __m128 b,
+                           const __m128 M,
+                           const __m128 c)
+{
+  const __m128 invC = safe_reciprocal(c);
+  __m128 hr = _mm_mul_ps(_mm_sub_ps(g, b), invC);
+  hr = _mm_add_ps(hr, _mm_and_ps(_mm_cmplt_ps(hr, _mm_setzero_ps()), _mm_set1_ps(6.0f)));
+  const __m128 hg = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(b, r), invC), _mm_set1_ps(2.0f));
+  const __m128 hb = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(r, g), invC), _mm_set1_ps(4.0f));
+  const __m128 h = select(_mm_cmpeq_ps(M, r), hr, select(_mm_cmpeq_ps(M, g), hg, hb));
+  return _mm_mul_ps(h, _mm_set1_ps(60.0f));
+}
+
+void rgba_to_hsv_sse2(const Color* src, HsvF* dst)
+{
+  __m128 r, g, b, a;
+  load_rgba(src, r, g, b, a);
+
+  const __m128 M = _mm_max_ps(r, _mm_max_ps(g, b));
+  const __m128 m = _mm_min_ps(r, _mm_min_ps(g, b));
+  const __m128 chroma = _mm_sub_ps(M, m);
+  const __m128 inv255 = _mm_set1_ps(1.0f / 255.0f);
+
+  __m128 h = hue_from_rgb(r, g, b, M, chroma);
+  __m128 s = _mm_mul_ps(chroma, safe_reciprocal(M));
+  __m128 v = _mm_mul_ps(M, inv255);
+  a = _mm_mul_ps(a, inv255);
+
+  _MM_TRANSPOSE4_PS(h, s, v, a);
+  _mm_storeu_ps(&dst[0].h, h);
+  _mm_storeu_ps(&dst[1].h, s);
+  _mm_storeu_ps(&dst[2].h, v);
+  _mm_storeu_ps(&dst[3].h, a);
+}
+
+void rgba_to_hsl_sse2(const Color* src, HslF* dst)
+{
+  __m128 r, g, b, a;
+  load_rgba(src, r, g, b, a);
+
+  const __m128 k255 = _mm_set1_ps(255.0f);
+  const __m128 M = _mm_max_ps(r, _mm_max_ps(g, b));
+  const __m128 m = _mm_min_ps(r, _mm_min_ps(g, b));
+  const __m128 chroma = _mm_sub_ps(M, m);
+  const __m128 sum = _mm_add_ps(M, m);
+  const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  const __m128 den = _mm_sub_ps(k255, _mm_and_ps(_mm_sub_ps(sum, k255), absMask));
+
+  __m128 h = hue_from_rgb(r, g, b, M, chroma);
+  __m128 s = _mm_mul_ps(chroma, safe_reciprocal(den));
+  __m128 l = _mm_mul_ps(sum, _mm_set1_ps(1.0f / 510.0f));
+  a = _mm_mul_ps(a, _mm_set1_ps(1.0f / 255.0f));
+
+  _MM_TRANSPOSE4_PS(h, s, l, a);
+  _mm_storeu_ps(&dst[0].h, h);
+  _mm_storeu_ps(&dst[1].h, s);
+  _mm_storeu_ps(&dst[2].h, l);
+  _mm_storeu_ps(&dst[3].h, a);
+}
+
+inline __m128 wrap_hue(const __m128 h)
+{
+  const __m128 k360 = _mm_set1_ps(360.0f);
+  __m128 r = _mm_sub_ps(h, _mm_mul_ps(k360, floor_ps(_mm_mul_ps(h, _mm_set1_ps(1.0f / 360.0f)))));
+  return _mm_sub_ps(r, _mm_and_ps(_mm_cmpge_ps(r, k360), k360));
+}
+
+// Returns k = (n + hp) mod period (hp must be in [0, period))
+inline __m128 sector(const float n, const __m128 hp, const float period)
+{
+  const __m128 p = _mm_set1_ps(period);
+  const __m128 k = _mm_add_ps(_mm_set1_ps(n), hp);
+  return _mm_sub_ps(k, _mm_and_ps(_mm_cmpge_ps(k, p), p));
+}
+
+inline __m128 hsv_channel(const float n, const __m128 hp, const __m128 v, const __m128 vs)
+{
+  const __m128 k = sector(n, hp, 6.0f);
+  __m128 t = _mm_min_ps(_mm_min_ps(k, _mm_sub_ps(_mm_set1_ps(4.0f), k)), _mm_set1_ps(1.0f));
+  t = _mm_max_ps(t, _mm_setzero_ps());
+  return _mm_sub_ps(v, _mm_mul_ps(vs, t));
+}
+
+inline __m128 hsl_channel(const float n, const __m128 hp, const __m128 l, const __m128 q)
+{
+  const __m128 k = sector(n, hp, 12.0f);
+  __m128 t = _mm_min_ps(_mm_sub_ps(k, _mm_set1_ps(3.0f)), _mm_sub_ps(_mm_set1_ps(9.0f), k));
+  t = _mm_min_ps(t, _mm_set1_ps(1.0f));
+  t = _mm_max_ps(t, _mm_set1_ps(-1.0f));
+  return _mm_sub_ps(l, _mm_mul_ps(q, t));
+}
+
+void hsv_to_rgba_sse2(const HsvF* src, Color* dst)
+{
+  __m128 h = _mm_loadu_ps(&src[0].h);
+  __m128 s = _mm_loadu_ps(&src[1].h);
+  __m128 v = _mm_loadu_ps(&src[2].h);
+  __m128 a = _mm_loadu_ps(&src[3].h);
+  _MM_TRANSPOSE4_PS(h, s, v, a);
+
+  const __m128 hp = _mm_mul_ps(wrap_hue(h), _mm_set1_ps(1.0f / 60.0f));
+  s = clamp01(s);
+  v = clamp01(v);
+  a = clamp01(a);
+  const __m128 vs = _mm_mul_ps(v, s);
+  store_rgba(dst,
+             hsv_channel(5.0f, hp, v, vs),
+             hsv_channel(3.0f, hp, v, vs),
+             hsv_channel(1.0f, hp, v, vs),
+             a);
+}
+
+void hsl_to_rgba_sse2(const HslF* src, Color* dst)
+{
+  __m128 h = _mm_loadu_ps(&src[0].h);
+  __m128 s = _mm_loadu_ps(&src[1].h);
+  __m128 l = _mm_loadu_ps(&src[2].h);
+  __m128 a = _mm_loadu_ps(&src[3].h);
+  _MM_TRANSPOSE4_PS(h, s, l, a);
+
+  const __m128 hp = _mm_mul_ps(wrap_hue(h), _mm_set1_ps(1.0f / 30.0f));
+  s = clamp01(s);
+  l = clamp01(l);
+  a = clamp01(a);
+  const __m128 q = _mm_mul_ps(s, _mm_min_ps(l, _mm_sub_ps(_mm_set1_ps(1.0f), l)));
+  store_rgba(dst,
+             hsl_channel(0.0f, hp, l, q),
+             hsl_channel(8.0f, hp, l, q),
+             hsl_channel(4.0f, hp, l, q),
+             a);
+}
+
+#endif // LAF_SSE2
+
+//////////////////////////////////////////////////////////////////////
+// Fixed-point 8-bit kernels
+
+struct Reciprocals {
+  // recip255[x] = 255*2^16/x (to calculate 255*y/x)
+  uint32_t recip255[256];
+  // recipHue[x] = 256*2^12/x (to calculate 256*y/x)
+  int32_t recipHue[256];
+
+  Reciprocals()
+  {
+    recip255[0] = 0;
+    recipHue[0] = 0;
+    for (int x = 1; x < 256; ++x) {
+      recip255[x] = uint32_t(((255u << 16) + x / 2) / x);
+      recipHue[x] = int32_t(((256 << 12) + x / 2) / x);
+    }
+  }
+};
+
+const Reciprocals& reciprocals()
+{
+  static const Reciprocals tables;
+  return tables;
+}
+
+// Returns the hue in [0, kHue8Max) for the given r/g/b with max
+// component M and chroma c > 0.
+inline int hue8_from_rgb(const int r,
+                         const int g,
+                         const int b,
+                         const int M,
+                         const int c,
+                         const int32_t* recipHue)
+{
+  int h;
+  if (M == r)
+    h = (((g - b) * recipHue[c] + 2048) >> 12);
+  else if (M == g)
+    h = 512 + (((b - r) * recipHue[c] + 2048) >> 12);
+  else
+    h = 1024 + (((r - g) * recipHue[c] + 2048) >> 12);
+  if (h < 0)
+    h += kHue8Max;
+  else if (h >= kHue8Max)
+    h -= kHue8Max;
+  return h;
+}
+
+// Creates a color from a hue in [0, kHue8Max), and the max component
+// and chroma in 1/256 units.
+inline Color rgba_from_hue8(int h, const int Mf, const int cF, const int a)
+{
+  const int sector = h >> 8;
+  const int delta = (cF * (h & 255)) >> 8;
+  const int mf = Mf - cF;
+  const int rise = mf + delta;
+  const int fall = Mf - delta;
+  int r, g, b;
+  switch (sector) {
+    case 0:  r = Mf, g = rise, b = mf; break;
+    case 1:  r = fall, g = Mf, b = mf; break;
+    case 2:  r = mf, g = Mf, b = rise; break;
+    case 3:  r = mf, g = fall, b = Mf; break;
+    case 4:  r = rise, g = mf, b = Mf; break;
+    default: r = Mf, g = mf, b = fall; break;
+  }
+  auto to8 = [](const int v) { return std::clamp((v + 128) >> 8, 0, 255); };
+  return rgba(to8(r), to8(g), to8(b), a);
+}
+
+} // anonymous namespace
+
+void rgba_to_hsv(const Color* src, HsvF* dst, size_t n)
+{
+  size_t i = 0;
+#if LAF_SSE2
+  for (; i + 4 <= n; i += 4)
+    rgba_to_hsv_sse2(src + i, dst + i);
+#endif
+  for (; i < n; ++i)
+    rgba_to_hsv_px(src[i], dst[i]);
+}
+
+void hsv_to_rgba(const HsvF* src, Color* dst, size_t n)
+{
+  size_t i = 0;
+#if LAF_SSE2
+  for (; i + 4 <= n; i += 4)
+    hsv_to_rgba_sse2(src + i, dst + i);
+#endif
+  for (; i < n; ++i)
+    dst[i] = hsv_to_rgba_px(src[i]);
+}
+
+void rgba_to_hsl(const Color* src, HslF* dst, size_t n)
+{
+  size_t i = 0;
+#if LAF_SSE2
+  for (; i + 4 <= n; i += 4)
+    rgba_to_hsl_sse2(src + i, dst + i);
+#endif
+  for (; i < n; ++i)
+    rgba_to_hsl_px(src[i], dst[i]);
+}
+
+void hsl_to_rgba(const HslF* src, Color* dst, size_t n)
+{
+  size_t i = 0;
+#if LAF_SSE2
+  for (; i + 4 <= n; i += 4)
+    hsl_to_rgba_sse2(src + i, dst + i);
+#endif
+  for (; i < n; ++i)
+    dst[i] = hsl_to_rgba_px(src[i]);
+}
+
+void rgba_to_hsv8(const Color* src, Hsv8* dst, size_t n)
+{
+  const Reciprocals& tables = reciprocals();
+  for (size_t i = 0; i < n; ++i) {
+    const Color c = src[i];
+    const int r = getr(c);
+    const int g = getg(c);
+    const int b = getb(c);
+    const int M = std::max(r, std::max(g, b));
+    const int chroma = M - std::min(r, std::min(g, b));
+    Hsv8& out = dst[i];
+    if (chroma == 0) {
+      out.h = 0;
+      out.s = 0;
+    }
+    else {
+      out.h = uint16_t(hue8_from_rgb(r, g, b, M, chroma, tables.recipHue));
+      out.s = uint8_t((chroma * tables.recip255[M] + 32768) >> 16);
+    }
+    out.v = uint8_t(M);
+    out.a = geta(c);
+  }
+}
+
+void hsv8_to_rgba(const Hsv8* src, Color* dst, size_t n)
+{
+  for (size_t i = 0; i < n; ++i) {
+    const Hsv8& in = src[i];
+    // chroma = v*s/255 in 1/256 units (257/256 ~= 256/255)
+    const int cF = (in.v * in.s * 257 + 128) >> 8;
+    dst[i] = rgba_from_hue8(in.h % kHue8Max, in.v << 8, cF, in.a);
+  }
+}
+
+void rgba_to_hsl8(const Color* src, Hsl8* dst, size_t n)
+{
+  const Reciprocals& tables = reciprocals();
+  for (size_t i = 0; i < n; ++i) {
+    const Color c = src[i];
+    const int r = getr(c);
+    const int g = getg(c);
+    const int b = getb(c);
+    const int M = std::max(r, std::max(g, b));
+    const int m = std::min(r, std::min(g, b));
+    const int chroma = M - m;
+    Hsl8& out = dst[i];
+    if (chroma == 0) {
+      out.h = 0;
+      out.s = 0;
+    }
+    else {
+      const int den = 255 - std::abs(M + m - 255);
+      out.h = uint16_t(hue8_from_rgb(r, g, b, M, chroma, tables.recipHue));
+      out.s = uint8_t((chroma * tables.recip255[den] + 32768) >> 16);
+    }
+    out.l = uint8_t((M + m + 1) >> 1);
+    out.a = geta(c);
+  }
+}
+
+void hsl8_to_rgba(const Hsl8* src, Color* dst, size_t n)
+{
+  for (size_t i = 0; i < n; ++i) {
+    const Hsl8& in = src[i];
+    // chroma = (1 - |2l-1|)*s in 1/256 units
+    const int cF = ((255 - std::abs(2 * in.l - 255)) * in.s * 257 + 128) >> 8;
+    const int Mf = (in.l << 8) + cF / 2;
+    dst[i] = rgba_from_hue8(in.h % kHue8Max, Mf, cF, in.a);
+  }
+}
+
+} // namespace gfx
@@ -0,0 +1,77 @@
+// LAF Gfx Library
+// Copyright (c) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef GFX_COLOR_MODELS_H_INCLUDED
+#define GFX_COLOR_MODELS_H_INCLUDED
+#pragma once
+
+#include "gfx/color.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Batched RGBA <-> HSV/HSL conversions to convert whole images (or
+// rows of pixels). They produce the same results as gfx::Hsv,
+// gfx::Hsl and gfx::Rgb (which use double precision) within the
+// error bounds documented below, but are much faster.
+//
+// The alpha component is kept as it is (converted to/from [0, 1] in
+// the float versions). src and dst can be the same array only when
+// the element sizes are the same (e.g. never for Color <-> HsvF).
+namespace gfx {
+
+// Float versions: hue in [0, 360), the other components in [0, 1].
+// hsv/hsl_to_rgba() accept hues outside the range (they are wrapped)
+// and clamp the other components.
+//
+// Error bounds against the double precision classes:
+// * rgba_to_hsv/hsl(): |hue error| < 1e-3 degrees, and < 1e-6 for
+//   the other components.
+// * hsv/hsl_to_rgba(): components differ at most by 1 (only when the
+//   double result is really close to x.5).
+// * rgba -> hsv/hsl -> rgba is lossless.
+struct HsvF {
+  float h, s, v, a;
+};
+
+struct HslF {
+  float h, s, l, a;
+};
+
+void rgba_to_hsv(const Color* src, HsvF* dst, size_t n);
+void hsv_to_rgba(const HsvF* src, Color* dst, size_t n);
+void rgba_to_hsl(const Color* src, HslF* dst, size_t n);
+void hsl_to_rgba(const HslF* src, Color* dst, size_t n);
+
+// Fixed-point 8-bit versions. The hue is in [0, 1536) (256 units for
+// each 60 degrees sector), the other components in [0, 255]. Divisions
+// are replaced with reciprocal look-up tables.
+//
+// Error bounds:
+// * rgba_to_hsv8/hsl8(): |hue error| <= 1 unit (0.23 degrees), and
+//   <= 1 for the other components (compared with the double result
+//   scaled to 255).
+// * rgba -> hsv8/hsl8 -> rgba: components differ at most by 2.
+static constexpr int kHue8Max = 1536;
+
+struct Hsv8 {
+  uint16_t h;
+  uint8_t s, v, a;
+};
+
+struct Hsl8 {
+  uint16_t h;
+  uint8_t s, l, a;
+};
+
+void rgba_to_hsv8(const Color* src, Hsv8* dst, size_t n);
+void hsv8_to_rgba(const Hsv8* src, Color* dst, size_t n);
+void rgba_to_hsl8(const Color* src, Hsl8* dst, size_t n);
+void hsl8_to_rgba(const Hsl8* src, Color* dst, size_t n);
+
+} // namespace gfx
+
+#endif
@@ -0,0 +1,193 @@
+// LAF Gfx Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <gtest/gtest.h>
+
+#include "gfx/color_models.h"
+#include "gfx/hsl.h"
+#include "gfx/hsv.h"
+#include "gfx/rgb.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace gfx;
+
+namespace {
+
+// A sample of RGB colors (all the combinations of some values,
+// including the extremes) with different alpha values.
+std::vector<Color> sample_colors()
+{
+  std::vector<Color> colors;
+  for (int r = 0; r < 256; r += 3)
+    for (int g = 0; g < 256; g += 5)
+      for (int b = 0; b < 256; b += 1)
+        colors.push_back(rgba(r, g, b, (r + g + b) & 255));
+  colors.push_back(rgba(255, 255, 255, 255));
+  colors.push_back(rgba(254, 255, 255, 255));
+  // Not a multiple of 4 to test the scalar code too
+  colors.push_back(rgba(255, 0, 1, 1));
+  return colors;
+}
+
+double hue_diff(double a, double b)
+{
+  const double d = std::fabs(a - b);
+  return std::min(d, 360.0 - d);
+}
+
+int max_component_diff(const Color a, const Color b)
+{
+  return std::max({ std::abs(getr(a) - getr(b)),
+                    std::abs(getg(a) - getg(b)),
+                    std::abs(getb(a) - getb(b)),
+                    std::abs(geta(a) - geta(b)) });
+}
+
+} // anonymous namespace
+
+TEST(ColorModels, RgbaToHsv)
+{
+  const std::vector<Color> colors = sample_colors();
+  std::vector<HsvF> hsv(colors.size());
+  rgba_to_hsv(colors.data(), hsv.data(), colors.size());
+
+  for (size_t i = 0; i < colors.size(); ++i) {
+    const Color c = colors[i];
+    const Hsv ref(Rgb(getr(c), getg(c), getb(c)));
+    ASSERT_LT(hue_diff(ref.hue(), hsv[i].h), 1e-3) << i;
+    ASSERT_NEAR(ref.saturation(), hsv[i].s, 1e-6) << i;
+    ASSERT_NEAR(ref.value(), hsv[i].v, 1e-6) << i;
+    ASSERT_NEAR(geta(c) / 255.0, hsv[i].a, 1e-6) << i;
+    ASSERT_TRUE(hsv[i].h >= 0.0f && hsv[i].h < 360.0f);
+  }
+
+  // Round-trip
+  std::vector<Color> result(colors.size());
+  hsv_to_rgba(hsv.data(), result.data(), hsv.size());
+  for (size_t i = 0; i < colors.size(); ++i)
+    ASSERT_EQ(colors[i], result[i]) << i;
+}
+
+TEST(ColorModels, RgbaToHsl)
+{
+  const std::vector<Color> colors = sample_colors();
+  std::vector<HslF> hsl(colors.size());
+  rgba_to_hsl(colors.data(), hsl.data(), colors.size());
+
+  for (size_t i = 0; i < colors.size(); ++i) {
+    const Color c = colors[i];
+    const Hsl ref(Rgb(getr(c), getg(c), getb(c)));
+    ASSERT_LT(hue_diff(ref.hue(), hsl[i].h), 1e-3) << i;
+    ASSERT_NEAR(ref.saturation(), hsl[i].s, 1e-6) << i;
+    ASSERT_NEAR(ref.lightness(), hsl[i].l, 1e-6) << i;
+  }
+
+  std::vector<Color> result(colors.size());
+  hsl_to_rgba(hsl.data(), result.data(), hsl.size());
+  for (size_t i = 0; i < colors.size(); ++i)
+    ASSERT_EQ(colors[i], result[i]) << i;
+}
+
+TEST(ColorModels, HsvToRgba)
+{
+  std::vector<HsvF> hsv;
+  for (int h = 0; h < 360; h += 7)
+    for (int s = 0; s <= 100; s += 3)
+      for (int v = 0; v <= 100; v += 3)
+        hsv.push_back(HsvF{ float(h) + 0.25f, s / 100.0f, v / 100.0f, 1.0f });
+
+  std::vector<Color> result(hsv.size());
+  hsv_to_rgba(hsv.data(), result.data(), hsv.size());
+  for (size_t i = 0; i < hsv.size(); ++i) {
+    const Rgb ref(Hsv(hsv[i].h, hsv[i].s, hsv[i].v));
+    ASSERT_LE(max_component_diff(rgba(ref.red(), ref.green(), ref.blue()), result[i]), 1) << i;
+  }
+
+  // Hues are wrapped and other components clamped
+  const HsvF outOfRange[] = {
+    { -120.0f, 1.0f, 1.0f, 1.0f },
+    { 480.0f, 2.0f, 1.0f, 1.0f },
+    { 360.0f, 1.0f, -1.0f, 0.5f },
+  };
+  Color c[3];
+  hsv_to_rgba(outOfRange, c, 3);
+  EXPECT_EQ(rgba(0, 0, 255), c[0]);
+  EXPECT_EQ(rgba(0, 255, 0), c[1]);
+  EXPECT_EQ(rgba(0, 0, 0, 128), c[2]);
+}
+
+TEST(ColorModels, HslToRgba)
+{
+  std::vector<HslF> hsl;
+  for (int h = 0; h < 360; h += 7)
+    for (int s = 0; s <= 100; s += 3)
+      for (int l = 0; l <= 100; l += 3)
+        hsl.push_back(HslF{ float(h) + 0.25f, s / 100.0f, l / 100.0f, 1.0f });
+
+  std::vector<Color> result(hsl.size());
+  hsl_to_rgba(hsl.data(), result.data(), hsl.size());
+  for (size_t i = 0; i < hsl.size(); ++i) {
+    const Rgb ref(Hsl(hsl[i].h, hsl[i].s, hsl[i].l));
+    ASSERT_LE(max_component_diff(rgba(ref.red(), ref.green(), ref.blue()), result[i]), 1) << i;
+  }
+}
+
+TEST(ColorModels, Hsv8)
+{
+  const std::vector<Color> colors = sample_colors();
+  std::vector<Hsv8> hsv(colors.size());
+  rgba_to_hsv8(colors.data(), hsv.data(), colors.size());
+
+  for (size_t i = 0; i < colors.size(); ++i) {
+    const Color c = colors[i];
+    const Hsv ref(Rgb(getr(c), getg(c), getb(c)));
+    ASSERT_LT(hsv[i].h, kHue8Max);
+    ASSERT_LE(hue_diff(ref.hue(), hsv[i].h * 360.0 / kHue8Max), 360.0 / kHue8Max) << i;
+    ASSERT_LE(std::fabs(ref.saturation() * 255.0 - hsv[i].s), 1.0) << i;
+    ASSERT_LE(std::fabs(ref.value() * 255.0 - hsv[i].v), 1.0) << i;
+    ASSERT_EQ(geta(c), hsv[i].a);
+  }
+
+  std::vector<Color> result(colors.size());
+  hsv8_to_rgba(hsv.data(), result.data(), hsv.size());
+  for (size_t i = 0; i < colors.size(); ++i)
+    ASSERT_LE(max_component_diff(colors[i], result[i]), 2) << i;
+}
+
+TEST(ColorModels, Hsl8)
+{
+  const std::vector<Color> colors = sample_colors();
+  std::vector<Hsl8> hsl(colors.size());
+  rgba_to_hsl8(colors.data(), hsl.data(), colors.size());
+
+  for (size_t i = 0; i < colors.size(); ++i) {
+    const Color c = colors[i];
+    const Hsl ref(Rgb(getr(c), getg(c), getb(c)));
+    ASSERT_LT(hsl[i].h, kHue8Max);
+    ASSERT_LE(hue_diff(ref.hue(), hsl[i].h * 360.0 / kHue8Max), 360.0 / kHue8Max) << i;
+    ASSERT_LE(std::fabs(ref.saturation() * 255.0 - hsl[i].s), 1.0) << i;
+    ASSERT_LE(std::fabs(ref.lightness() * 255.0 - hsl[i].l), 1.0) << i;
+  }
+
+  std::vector<Color> result(colors.size());
+  hsl8_to_rgba(hsl.data(), result.data(), hsl.size());
+  for (size_t i = 0; i < colors.size(); ++i)
+    ASSERT_LE(max_component_diff(colors[i], result[i]), 2) << i;
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,684 @@
+// LAF Gfx Library
+// Copyright (c) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "gfx/color_space_converter.h"
+
+#include "base/debug.h"
+#include "base/simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace gfx {
+
+namespace {
+
+// Same values as in skia/src/core/SkColorSpacePriv.h
+constexpr double kSRGB_toXYZD50[9] = {
+  0.4360747, 0.3850649, 0.1430804, // Rx, Gx, Bx
+  0.2225045, 0.7168786, 0.0606169, // Ry, Gy, By
+  0.0139322, 0.0971045, 0.7141733, // Rz, Gz, Bz
+};
+
+constexpr ColorSpaceTransferFn kSRGB_TransferFn = { 2.4f, 1.0f / 1.055f, 0.055f / 1.055f,
+                                                    1.0f / 12.92f, 0.04045f, 0.0f,
+                                                    0.0f };
+
+// D50 white point (ICC PCS illuminant)
+constexpr double kD50[3] = { 0.96422, 1.0, 0.82521 };
+
+// Maximum number of cached converters
+constexpr size_t kMaxCachedConverters = 16;
+
+//////////////////////////////////////////////////////////////////////
+// 3x3 matrix utilities (row-major)
+
+void mat_mul(const double* a, const double* b, double* r)
+{
+  double t[9];
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j)
+      t[i * 3 + j] = a[i * 3] * b[j] + a[i * 3 + 1] * b[3 + j] + a[i * 3 + 2] * b[6 + j];
+  std::copy(t, t + 9, r);
+}
+
+bool mat_invert(const double* m, double* r)
+{
+  const double a0 = m[4] * m[8] - m[5] * m[7];
+  const double a1 = m[5] * m[6] - m[3] * m[8];
+  const double a2 = m[3] * m[7] - m[4] * m[6];
+  const double det = m[0] * a0 + m[1] * a1 + m[2] * a2;
+  if (det == 0.0 || !std::isfinite(det))
+    return false;
+  const double inv = 1.0 / det;
+  const double t[9] = {
+    a0 * inv,
+    (m[2] * m[7] - m[1] * m[8]) * inv,
+    (m[1] * m[5] - m[2] * m[4]) * inv,
+    a1 * inv,
+    (m[0] * m[8] - m[2] * m[6]) * inv,
+    (m[2] * m[3] - m[0] * m[5]) * inv,
+    a2 * inv,
+    (m[1] * m[6] - m[0] * m[7]) * inv,
+    (m[0] * m[4] - m[1] * m[3]) * inv,
+  };
+  std::copy(t, t + 9, r);
+  return true;
+}
+
+void mat_apply(const double* m, const double* v, double* r)
+{
+  const double t[3] = {
+    m[0] * v[0] + m[1] * v[1] + m[2] * v[2],
+    m[3] * v[0] + m[4] * v[1] + m[5] * v[2],
+    m[6] * v[0] + m[7] * v[1] + m[8] * v[2],
+  };
+  std::copy(t, t + 3, r);
+}
+
+// Based on skcms_PrimariesToXYZD50(): RGB -> XYZ matrix from the
+// primaries and the white point, adapted to D50 with the Bradford
+// transform.
+bool primaries_to_xyzd50(const ColorSpacePrimaries& p, double* toXYZD50)
+{
+  if (p.ry == 0 || p.gy == 0 || p.by == 0 || p.wy == 0)
+    return false;
+
+  const double prim[9] = {
+    p.rx,        p.gx,        p.bx,        //
+    p.ry,        p.gy,        p.by,        //
+    1 - p.rx - p.ry, 1 - p.gx - p.gy, 1 - p.bx - p.by,
+  };
+  double primInv[9];
+  if (!mat_invert(prim, primInv))
+    return false;
+
+  const double white[3] = { p.wx / p.wy, 1.0, (1 - p.wx - p.wy) / p.wy };
+  double s[3];
+  mat_apply(primInv, white, s);
+  const double toXYZ[9] = {
+    prim[0] * s[0], prim[1] * s[1], prim[2] * s[2], //
+    prim[3] * s[0], prim[4] * s[1], prim[5] * s[2], //
+    prim[6] * s[0], prim[7] * s[1], prim[8] * s[2],
+  };
+
+  static constexpr double kBradford[9] = {
+    0.8951,  0.2664, -0.1614, //
+    -0.7502, 1.7135, 0.0367,  //
+    0.0389,  -0.0685, 1.0296,
+  };
+  double bradfordInv[9];
+  mat_invert(kBradford, bradfordInv);
+
+  double srcCone[3], dstCone[3];
+  mat_apply(kBradford, white, srcCone);
+  mat_apply(kBradford, kD50, dstCone);
+  const double scale[9] = {
+    dstCone[0] / srcCone[0], 0, 0, //
+    0, dstCone[1] / srcCone[1], 0, //
+    0, 0, dstCone[2] / srcCone[2],
+  };
+
+  double adapt[9];
+  mat_mul(scale, kBradford, adapt);
+  mat_mul(bradfordInv, adapt, adapt);
+  mat_mul(adapt, toXYZ, toXYZD50);
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Minimal ICC parser for matrix/TRC RGB profiles
+
+class IccReader {
+public:
+  IccReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+  uint32_t u32(size_t pos) const
+  {
+    if (pos + 4 > m_size)
+      return 0;
+    return (uint32_t(m_data[pos]) << 24) | (uint32_t(m_data[pos + 1]) << 16) |
+           (uint32_t(m_data[pos + 2]) << 8) | uint32_t(m_data[pos + 3]);
+  }
+
+  uint16_t u16(size_t pos) const
+  {
+    if (pos + 2 > m_size)
+      return 0;
+    return uint16_t((m_data[pos] << 8) | m_data[pos + 1]);
+  }
+
+  double s15f16(size_t pos) const { return int32_t(u32(pos)) / 65536.0; }
+
+  // Returns the offset of the given tag (or 0 if it's not found).
+  size_t findTag(const uint32_t sig, size_t* tagSize) const
+  {
+    const uint32_t count = u32(128);
+    for (uint32_t i = 0; i < count && 132 + 12 * (i + 1) <= m_size; ++i) {
+      const size_t entry = 132 + 12 * i;
+      if (u32(entry) == sig) {
+        const size_t offset = u32(entry + 4);
+        const size_t size = u32(entry + 8);
+        if (offset + size > m_size || size < 8)
+          return 0;
+        *tagSize = size;
+        return offset;
+      }
+    }
+    return 0;
+  }
+
+  bool readXYZ(const uint32_t sig, double* xyz) const
+  {
+    size_t size;
+    const size_t pos = findTag(sig, &size);
+    if (!pos || size < 20 || u32(pos) != sig4("XYZ "))
+      return false;
+    for (int i = 0; i < 3; ++i)
+      xyz[i] = s15f16(pos + 8 + 4 * i);
+    return true;
+  }
+
+  bool readCurve(const uint32_t sig, ColorSpaceConverter::Curve& curve) const
+  {
+    size_t size;
+    const size_t pos = findTag(sig, &size);
+    if (!pos)
+      return false;
+
+    ColorSpaceTransferFn& fn = curve.fn;
+    fn = { 1, 1, 0, 0, 0, 0, 0 };
+    curve.table.clear();
+
+    const uint32_t type = u32(pos);
+    if (type == sig4("curv")) {
+      const uint32_t count = u32(pos + 8);
+      if (12 + 2 * size_t(count) > size)
+        return false;
+      if (count == 0) // Identity
+        return true;
+      if (count == 1) { // Gamma as u8Fixed8
+        fn.g = u16(pos + 12) / 256.0f;
+        return fn.g > 0.0f;
+      }
+      curve.table.resize(count);
+      for (uint32_t i = 0; i < count; ++i)
+        curve.table[i] = u16(pos + 12 + 2 * i) / 65535.0f;
+      return true;
+    }
+    if (type == sig4("para")) {
+      static constexpr int kParams[] = { 1, 3, 4, 5, 7 };
+      const int funcType = u16(pos + 8);
+      if (funcType > 4 || 12 + 4 * size_t(kParams[funcType]) > size)
+        return false;
+      float p[7] = { 0, 0, 0, 0, 0, 0, 0 };
+      for (int i = 0; i < kParams[funcType]; ++i)
+        p[i] = float(s15f16(pos + 12 + 4 * i));
+
+      // Convert the ICC parametric curves to the skcms format
+      fn.g = p[0];
+      switch (funcType) {
+        case 0: break;
+        case 1:
+          fn.a = p[1];
+          fn.b = p[2];
+          fn.d = (p[1] != 0.0f ? -p[2] / p[1] : 0.0f);
+          break;
+        case 2:
+          fn.a = p[1];
+          fn.b = p[2];
+          fn.d = (p[1] != 0.0f ? -p[2] / p[1] : 0.0f);
+          fn.e = fn.f = p[3];
+          break;
+        case 3:
+          fn.a = p[1];
+          fn.b = p[2];
+          fn.c = p[3];
+          fn.d = p[4];
+          break;
+        case 4:
+          fn.a = p[1];
+          fn.b = p[2];
+          fn.c = p[3];
+          fn.d = p[4];
+          fn.e = p[5];
+          fn.f = p[6];
+          break;
+      }
+      return (fn.g > 0.0f);
+    }
+    return false;
+  }
+
+  static constexpr uint32_t sig4(const char* s)
+  {
+    return (uint32_t(uint8_t(s[0])) << 24) | (uint32_t(uint8_t(s[1])) << 16) |
+           (uint32_t(uint8_t(s[2])) << 8) | uint32_t(uint8_t(s[3]));
+  }
+
+private:
+  const uint8_t* m_data;
+  size_t m_size;
+};
+
+bool profile_from_icc(const uint8_t* data, const size_t size, ColorSpaceConverter::Profile& profile)
+{
+  IccReader icc(data, size);
+  if (size < 132 || icc.u32(36) != IccReader::sig4("acsp") ||
+      icc.u32(16) != IccReader::sig4("RGB ") || icc.u32(20) != IccReader::sig4("XYZ ")) {
+    return false;
+  }
+
+  double r[3], g[3], b[3];
+  if (!icc.readXYZ(IccReader::sig4("rXYZ"), r) || !icc.readXYZ(IccReader::sig4("gXYZ"), g) ||
+      !icc.readXYZ(IccReader::sig4("bXYZ"), b) ||
+      !icc.readCurve(IccReader::sig4("rTRC"), profile.curves[0]) ||
+      !icc.readCurve(IccReader::sig4("gTRC"), profile.curves[1]) ||
+      !icc.readCurve(IccReader::sig4("bTRC"), profile.curves[2])) {
+    return false;
+  }
+
+  const double m[9] = { r[0], g[0], b[0], r[1], g[1], b[1], r[2], g[2], b[2] };
+  std::copy(m, m + 9, profile.toXYZD50);
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Cache of converters
+
+// Serializes a color space as a key for the cache
+std::string color_space_key(const ColorSpace& cs)
+{
+  std::string key;
+  key.push_back(char(cs.type()));
+  key.push_back(char(cs.flags()));
+  const float gamma = cs.gamma();
+  key.append((const char*)&gamma, sizeof(gamma));
+  const std::vector<uint8_t>& data = cs.rawData();
+  const uint32_t n = uint32_t(data.size());
+  key.append((const char*)&n, sizeof(n));
+  key.append((const char*)data.data(), data.size());
+  return key;
+}
+
+struct Cache {
+  std::mutex mutex;
+  // Most recently used converters at the end
+  std::vector<std::pair<std::string, ColorSpaceConverterRef>> items;
+};
+
+Cache& cache()
+{
+  static Cache cache;
+  return cache;
+}
+
+} // anonymous namespace
+
+//////////////////////////////////////////////////////////////////////
+// ColorSpaceConverter::Curve
+
+float ColorSpaceConverter::Curve::toLinear(float x) const
+{
+  const float sign = (x < 0.0f ? -1.0f : 1.0f);
+  x = std::fabs(x);
+
+  if (!table.empty()) {
+    if (table.size() == 1)
+      return sign * table[0];
+    const float pos = std::min(x, 1.0f) * float(table.size() - 1);
+    const size_t i = std::min(size_t(pos), table.size() - 2);
+    const float t = pos - float(i);
+    return sign * (table[i] + (table[i + 1] - table[i]) * t);
+  }
+
+  if (x < fn.d)
+    return sign * (fn.c * x + fn.f);
+  return sign * (std::pow(std::max(fn.a * x + fn.b, 0.0f), fn.g) + fn.e);
+}
+
+float ColorSpaceConverter::Curve::fromLinear(float y) const
+{
+  const float sign = (y < 0.0f ? -1.0f : 1.0f);
+  y = std::fabs(y);
+
+  if (!table.empty()) {
+    // Binary search in the (increasing) table
+    if (table.size() == 1 || y <= table.front())
+      return 0.0f;
+    if (y >= table.back())
+      return sign * 1.0f;
+    const auto it = std::upper_bound(table.begin(), table.end(), y);
+    const size_t i = size_t(it - table.begin()) - 1;
+    const float d = table[i + 1] - table[i];
+    const float t = (d > 0.0f ? (y - table[i]) / d : 0.0f);
+    return sign * ((float(i) + t) / float(table.size() - 1));
+  }
+
+  if (y < fn.c * fn.d + fn.f)
+    return sign * (fn.c != 0.0f ? (y - fn.f) / fn.c : 0.0f);
+  if (fn.a == 0.0f || fn.g == 0.0f)
+    return sign * y;
+  return sign * ((std::pow(std::max(y - fn.e, 0.0f), 1.0f / fn.g) - fn.b) / fn.a);
+}
+
+//////////////////////////////////////////////////////////////////////
+// ColorSpaceConverter
+
+// static
+bool ColorSpaceConverter::MakeProfile(const ColorSpace& cs, Profile& profile)
+{
+  for (Curve& curve : profile.curves) {
+    curve.fn = kSRGB_TransferFn;
+    curve.table.clear();
+  }
+  std::copy(kSRGB_toXYZD50, kSRGB_toXYZD50 + 9, profile.toXYZD50);
+
+  switch (cs.type()) {
+    case ColorSpace::None: return true;
+
+    case ColorSpace::sRGB:
+    case ColorSpace::RGB:
+      if (cs.hasGamma()) {
+        for (Curve& curve : profile.curves)
+          curve.fn = ColorSpaceTransferFn{ cs.gamma(), 1, 0, 0, 0, 0, 0 };
+      }
+      else if (cs.hasTransferFn()) {
+        for (Curve& curve : profile.curves)
+          curve.fn = *cs.transferFn();
+      }
+      if (cs.hasPrimaries() && !primaries_to_xyzd50(*cs.primaries(), profile.toXYZD50))
+        return false;
+      return true;
+
+    case ColorSpace::ICC:
+      return profile_from_icc((const uint8_t*)cs.iccData(), cs.iccSize(), profile);
+  }
+  return false;
+}
+
+// static
+ColorSpaceConverterRef ColorSpaceConverter::Make(const ColorSpaceRef& src, const ColorSpaceRef& dst)
+{
+  if (!src || !dst)
+    return nullptr;
+
+  std::string key = color_space_key(*src);
+  key += color_space_key(*dst);
+
+  Cache& c = cache();
+  {
+    std::lock_guard lock(c.mutex);
+    for (auto it = c.items.begin(); it != c.items.end(); ++it) {
+      if (it->first == key) {
+        ColorSpaceConverterRef converter = it->second;
+        // Move to the end (most recently used)
+        std::rotate(it, it + 1, c.items.end());
+        return converter;
+      }
+    }
+  }
+
+  // Create the converter outside the lock (the look-up tables take
+  // some time to be calculated)
+  Profile srcProfile, dstProfile;
+  if (!MakeProfile(*src, srcProfile) || !MakeProfile(*dst, dstProfile))
+    return nullptr;
+
+  // We cannot convert to a color space with a degenerate gamut
+  // (e.g. an ICC profile with two equal colorants)
+  double fromXYZ[9];
+  if (!mat_invert(dstProfile.toXYZD50, fromXYZ))
+    return nullptr;
+
+  auto converter = base::make_ref<ColorSpaceConverter>(srcProfile, dstProfile);
+  // ColorSpace::None means "don't convert" (use the display color
+  // space as it is)
+  if (src->type() == ColorSpace::None || dst->type() == ColorSpace::None ||
+      src->nearlyEqual(*dst)) {
+    converter->m_identity = true;
+  }
+
+  std::lock_guard lock(c.mutex);
+  if (c.items.size() >= kMaxCachedConverters)
+    c.items.erase(c.items.begin());
+  c.items.emplace_back(std::move(key), converter);
+  return converter;
+}
+
+// static
+void ColorSpaceConverter::ClearCache()
+{
+  Cache& c = cache();
+  std::lock_guard lock(c.mutex);
+  c.items.clear();
+}
+
+ColorSpaceConverter::ColorSpaceConverter(const Profile& src, const Profile& dst)
+{
+  // Gamut matrix: src RGB -> XYZ D50 -> dst RGB
+  double fromXYZ[9], m[9];
+  if (!mat_invert(dst.toXYZD50, fromXYZ)) {
+    // Make() doesn't create converters to degenerate gamuts, anyway
+    // we use the XYZ -> sRGB matrix to get valid colors
+    ASSERT(false);
+    mat_invert(kSRGB_toXYZD50, fromXYZ);
+  }
+  mat_mul(fromXYZ, src.toXYZD50, m);
+  for (int i = 0; i < 9; ++i)
+    m_matrix[i] = float(m[i]);
+
+  // Luminance (Y) of each destination component
+  const double ySum = dst.toXYZD50[3] + dst.toXYZD50[4] + dst.toXYZD50[5];
+  for (int i = 0; i < 3; ++i)
+    m_dstLuma[i] = float(ySum != 0.0 ? dst.toXYZD50[3 + i] / ySum : 1.0 / 3.0);
+
+  for (int ch = 0; ch < 3; ++ch) {
+    m_srcCurves[ch] = src.curves[ch];
+    m_dstCurves[ch] = dst.curves[ch];
+
+    for (int i = 0; i < 256; ++i)
+      m_toLinear[ch][i] = m_srcCurves[ch].toLinear(float(i) / 255.0f);
+
+    // m_thresholds[k] = linear value where the k-th 8-bit value starts
+    float* thr = m_thresholds[ch];
+    thr[0] = std::numeric_limits<float>::lowest();
+    for (int k = 1; k < 256; ++k)
+      thr[k] = m_dstCurves[ch].toLinear((float(k) - 0.5f) / 255.0f);
+    thr[256] = std::numeric_limits<float>::max();
+
+    // Lower bound of the 8-bit value for each linear value i/size
+    uint8_t* lut = m_encodeLut[ch];
+    int code = 0;
+    for (int i = 0; i <= kEncodeLutSize; ++i) {
+      const float v = float(i) / float(kEncodeLutSize);
+      while (code < 255 && thr[code + 1] <= v)
+        ++code;
+      lut[i] = uint8_t(code);
+    }
+  }
+}
+
+inline uint8_t ColorSpaceConverter::encode8(const int channel, float v) const
+{
+  if (!(v > 0.0f)) // Includes NaN
+    v = 0.0f;
+  else if (v > 1.0f)
+    v = 1.0f;
+  int code = m_encodeLut[channel][int(v * float(kEncodeLutSize))];
+  const float* thr = m_thresholds[channel];
+  while (v >= thr[code + 1])
+    ++code;
+  return uint8_t(code);
+}
+
+void ColorSpaceConverter::convertRgba8(uint32_t* dst, const uint32_t* src, int n) const
+{
+  if (m_identity) {
+    if (dst != src)
+      std::memmove(dst, src, sizeof(uint32_t) * n);
+    return;
+  }
+
+  const float* m = m_matrix;
+  int i = 0;
+
+#if LAF_SSE2
+  // Four pixels at the same time: linear values in SSE registers (one
+  // register per channel), gamut matrix, and then the encoding.
+  const __m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]), m2 = _mm_set1_ps(m[2]);
+  const __m128 m3 = _mm_set1_ps(m[3]), m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]);
+  const __m128 m6 = _mm_set1_ps(m[6]), m7 = _mm_set1_ps(m[7]), m8 = _mm_set1_ps(m[8]);
+  alignas(16) float out[3][4];
+  for (; i + 4 <= n; i += 4) {
+    const uint32_t c0 = src[i], c1 = src[i + 1], c2 = src[i + 2], c3 = src[i + 3];
+    const __m128 r = _mm_setr_ps(m_toLinear[0][c0 & 0xff],
+                                 m_toLinear[0][c1 & 0xff],
+                                 m_toLinear[0][c2 & 0xff],
+                                 m_toLinear[0][c3 & 0xff]);
+    const __m128 g = _mm_setr_ps(m_toLinear[1][(c0 >> 8) & 0xff],
+                                 m_toLinear[1][(c1 >> 8) & 0xff],
+                                 m_toLinear[1][(c2 >> 8) & 0xff],
+                                 m_toLinear[1][(c3 >> 8) & 0xff]);
+    const __m128 b = _mm_setr_ps(m_toLinear[2][(c0 >> 16) & 0xff],
+                                 m_toLinear[2][(c1 >> 16) & 0xff],
+                                 m_toLinear[2][(c2 >> 16) & 0xff],
+                                 m_toLinear[2][(c3 >> 16) & 0xff]);
+    _mm_store_ps(out[0],
+                 _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, r), _mm_mul_ps(m1, g)), _mm_mul_ps(m2, b)));
+    _mm_store_ps(out[1],
+                 _mm_add_ps(_mm_add_ps(_mm_mul_ps(m3, r), _mm_mul_ps(m4, g)), _mm_mul_ps(m5, b)));
+    _mm_store_ps(out[2],
+                 _mm_add_ps(_mm_add_ps(_mm_mul_ps(m6, r), _mm_mul_ps(m7, g)), _mm_mul_ps(m8, b)));
+
+    for (int j = 0; j < 4; ++j) {
+      dst[i + j] = (src[i + j] & 0xff000000) | encode8(0, out[0][j]) |
+                   (uint32_t(encode8(1, out[1][j])) << 8) |
+                   (uint32_t(encode8(2, out[2][j])) << 16);
+    }
+  }
+#endif
+
+  for (; i < n; ++i) {
+    const uint32_t c = src[i];
+    const float r = m_toLinear[0][c & 0xff];
+    const float g = m_toLinear[1][(c >> 8) & 0xff];
+    const float b = m_toLinear[2][(c >> 16) & 0xff];
+    dst[i] = (c & 0xff000000) | encode8(0, m[0] * r + m[1] * g + m[2] * b) |
+             (uint32_t(encode8(1, m[3] * r + m[4] * g + m[5] * b)) << 8) |
+             (uint32_t(encode8(2, m[6] * r + m[7] * g + m[8] * b)) << 16);
+  }
+}
+
+void ColorSpaceConverter::convertRgbaF16(uint16_t* dst, const uint16_t* src, int n) const
+{
+  if (m_identity) {
+    if (dst != src)
+      std::memmove(dst, src, sizeof(uint16_t) * 4 * n);
+    return;
+  }
+
+  const float* m = m_matrix;
+  for (int i = 0; i < n; ++i, src += 4, dst += 4) {
+    const float r = m_srcCurves[0].toLinear(HalfToFloat(src[0]));
+    const float g = m_srcCurves[1].toLinear(HalfToFloat(src[1]));
+    const float b = m_srcCurves[2].toLinear(HalfToFloat(src[2]));
+    const uint16_t a = src[3];
+    dst[0] = FloatToHalf(m_dstCurves[0].fromLinear(m[0] * r + m[1] * g + m[2] * b));
+    dst[1] = FloatToHalf(m_dstCurves[1].fromLinear(m[3] * r + m[4] * g + m[5] * b));
+    dst[2] = FloatToHalf(m_dstCurves[2].fromLinear(m[6] * r + m[7] * g + m[8] * b));
+    dst[3] = a;
+  }
+}
+
+void ColorSpaceConverter::convertGray8(uint8_t* dst, const uint8_t* src, int n) const
+{
+  if (m_identity) {
+    if (dst != src)
+      std::memmove(dst, src, n);
+    return;
+  }
+
+  // Precalculate the 256 possible results
+  uint8_t lut[256];
+  const float* m = m_matrix;
+  for (int v = 0; v < 256; ++v) {
+    const float r = m_toLinear[0][v];
+    const float g = m_toLinear[1][v];
+    const float b = m_toLinear[2][v];
+    const float y = m_dstLuma[0] * (m[0] * r + m[1] * g + m[2] * b) +
+                    m_dstLuma[1] * (m[3] * r + m[4] * g + m[5] * b) +
+                    m_dstLuma[2] * (m[6] * r + m[7] * g + m[8] * b);
+    lut[v] = encode8(1, y);
+  }
+  for (int i = 0; i < n; ++i)
+    dst[i] = lut[src[i]];
+}
+
+// static
+float ColorSpaceConverter::HalfToFloat(const uint16_t h)
+{
+  const uint32_t sign = uint32_t(h & 0x8000) << 16;
+  const uint32_t exp = (h >> 10) & 0x1f;
+  const uint32_t mant = h & 0x3ff;
+  uint32_t bits;
+  if (exp == 0) {
+    if (mant == 0) {
+      bits = sign;
+    }
+    else {
+      // Subnormal
+      float f = float(mant) / 1024.0f / 16384.0f;
+      return (sign ? -f : f);
+    }
+  }
+  else if (exp == 31) {
+    bits = sign | 0x7f800000 | (mant << 13);
+  }
+  else {
+    bits = sign | ((exp + 112) << 23) | (mant << 13);
+  }
+  float f;
+  std::memcpy(&f, &bits, sizeof(f));
+  return f;
+}
+
+// static
+uint16_t ColorSpaceConverter::FloatToHalf(const float f)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &f, sizeof(bits));
+  const uint16_t sign = uint16_t((bits >> 16) & 0x8000);
+  const uint32_t absBits = bits & 0x7fffffff;
+
+  if (absBits >= 0x7f800000) // Inf or NaN
+    return sign | 0x7c00 | (absBits > 0x7f800000 ? 0x200 : 0);
+  if (absBits >= 0x477ff000) // Too big (>= 65520), infinity
+    return sign | 0x7c00;
+  if (absBits < 0x38800000) { // Subnormal (or zero)
+    const float a = std::fabs(f) * 16384.0f * 1024.0f;
+    return sign | uint16_t(std::nearbyint(a));
+  }
+
+  // Normal: round to nearest even
+  const uint32_t mant = absBits & 0x7fffff;
+  uint32_t h = ((absBits >> 23) - 112) << 10 | (mant >> 13);
+  const uint32_t rest = mant & 0x1fff;
+  if (rest > 0x1000 || (rest == 0x1000 && (h & 1)))
+    ++h;
+  return sign | uint16_t(h);
+}
+
+} // namespace gfx
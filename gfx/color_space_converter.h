@@ -0,0 +1,112 @@
+// LAF Gfx Library
+// Copyright (c) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef GFX_COLOR_SPACE_CONVERTER_H_INCLUDED
+#define GFX_COLOR_SPACE_CONVERTER_H_INCLUDED
+#pragma once
+
+#include "base/ref.h"
+#include "gfx/color_space.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace gfx {
+
+class ColorSpaceConverter;
+using ColorSpaceConverterRef = base::Ref<ColorSpaceConverter>;
+
+// Converts pixels between two color spaces in the CPU (without Skia
+// or any other color management library).
+//
+// Supported color spaces: sRGB, linear sRGB, custom gamma, custom
+// ColorSpaceTransferFn/ColorSpacePrimaries, and matrix/TRC ICC
+// profiles (the most common kind of RGB profiles, the ones generated
+// by monitor calibration tools and embedded in PNG/JPEG files).
+// ColorSpace::None is treated as sRGB.
+//
+// Everything that depends only on the pair of color spaces is
+// precalculated on creation: the 3x3 gamut matrix (source RGB ->
+// XYZ D50 -> destination RGB) and the look-up tables for the transfer
+// functions. 8-bit conversions are exact (the result is the nearest
+// 8-bit value to the real converted value).
+class ColorSpaceConverter : public base::RefCountT<ColorSpaceConverter> {
+public:
+  // Returns a converter from "src" to "dst" color space, or nullptr
+  // if one of the color spaces isn't supported. Converters are cached
+  // by (src, dst) pair, so calling this function for each image is
+  // cheap.
+  static ColorSpaceConverterRef Make(const ColorSpaceRef& src, const ColorSpaceRef& dst);
+  static void ClearCache();
+
+  // True if the source and destination color spaces are the same
+  // (the conversion is just a copy).
+  bool isIdentity() const { return m_identity; }
+
+  // Converts unpremultiplied RGBA pixels with 8-bit components
+  // (gfx::Color layout). Alpha is not modified.
+  void convertRgba8(uint32_t* dst, const uint32_t* src, int n) const;
+
+  // Converts unpremultiplied RGBA pixels with half-float components
+  // (4 x uint16_t for each pixel). Values outside the [0, 1] range
+  // (extended range) are converted too.
+  void convertRgbaF16(uint16_t* dst, const uint16_t* src, int n) const;
+
+  // Converts 8-bit grayscale pixels (without alpha). The result is
+  // the luminance of the converted color.
+  void convertGray8(uint8_t* dst, const uint8_t* src, int n) const;
+
+  // Half-float helpers
+  static float HalfToFloat(uint16_t h);
+  static uint16_t FloatToHalf(float f);
+
+  // Transfer function of one channel: a parametric function or a
+  // table of samples (from ICC curv tags).
+  struct Curve {
+    ColorSpaceTransferFn fn = { 1, 1, 0, 0, 0, 0, 0 };
+    std::vector<float> table;
+
+    // From encoded value to linear value (and its inverse)
+    float toLinear(float x) const;
+    float fromLinear(float x) const;
+  };
+
+  // Transfer curves + RGB to XYZ D50 matrix
+  struct Profile {
+    Curve curves[3];
+    double toXYZD50[9];
+  };
+
+  // Creates the profile for the given color space, returns false if
+  // it's not supported.
+  static bool MakeProfile(const ColorSpace& cs, Profile& profile);
+
+  ColorSpaceConverter(const Profile& src, const Profile& dst);
+
+private:
+  // Number of entries -1 of the linear -> 8-bit look-up table
+  static constexpr int kEncodeLutSize = 4096;
+
+  uint8_t encode8(int channel, float linear) const;
+
+  bool m_identity = false;
+  float m_matrix[9];
+  Curve m_srcCurves[3];
+  Curve m_dstCurves[3];
+  // Luminance of each destination RGB component (for grayscale)
+  float m_dstLuma[3];
+
+  // Source 8-bit value -> linear
+  float m_toLinear[3][256];
+  // Linear value -> lower bound of the 8-bit value, refined with
+  // m_thresholds[] (linear value where each 8-bit value starts).
+  uint8_t m_encodeLut[3][kEncodeLutSize + 1];
+  float m_thresholds[3][257];
+};
+
+} // namespace gfx
+
+#endif
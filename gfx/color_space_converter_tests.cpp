@@ -0,0 +1,316 @@
+// LAF Gfx Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <gtest/gtest.h>
+
+#include "gfx/color.h"
+#include "gfx/color_space_converter.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace gfx;
+
+namespace {
+
+const ColorSpacePrimaries kDisplayP3 = { 0.680f, 0.320f, 0.265f, 0.690f,
+                                         0.150f, 0.060f, 0.3127f, 0.3290f };
+
+const ColorSpaceTransferFn kSRGB_TransferFn = { 2.4f, 1.0f / 1.055f, 0.055f / 1.055f,
+                                                1.0f / 12.92f, 0.04045f, 0.0f,
+                                                0.0f };
+
+std::vector<Color> all_grays()
+{
+  std::vector<Color> colors;
+  for (int v = 0; v < 256; ++v)
+    colors.push_back(rgba(v, v, v, 255 - v));
+  return colors;
+}
+
+// sRGB colorants (XYZ D50 of each primary)
+const double kSRGB_XYZ[3][3] = {
+  { 0.4360747, 0.2225045, 0.0139322 },
+  { 0.3850649, 0.7168786, 0.0971045 },
+  { 0.1430804, 0.0606169, 0.7141733 },
+};
+
+// Minimal matrix/TRC ICC profile with the given colorants and the
+// sRGB transfer function as a parametric curve.
+std::vector<uint8_t> make_icc(const double (&xyz)[3][3] = kSRGB_XYZ)
+{
+  std::vector<uint8_t> icc(128 + 4 + 6 * 12);
+  auto put32 = [&icc](size_t pos, uint32_t v) {
+    icc.resize(std::max(icc.size(), pos + 4));
+    icc[pos] = uint8_t(v >> 24);
+    icc[pos + 1] = uint8_t(v >> 16);
+    icc[pos + 2] = uint8_t(v >> 8);
+    icc[pos + 3] = uint8_t(v);
+  };
+  auto sig = [](const char* s) {
+    return (uint32_t(uint8_t(s[0])) << 24) | (uint32_t(uint8_t(s[1])) << 16) |
+           (uint32_t(uint8_t(s[2])) << 8) | uint32_t(uint8_t(s[3]));
+  };
+  auto fixed = [](double v) { return uint32_t(int32_t(std::round(v * 65536.0))); };
+
+  put32(16, sig("RGB "));
+  put32(20, sig("XYZ "));
+  put32(36, sig("acsp"));
+  put32(128, 6);
+
+  const char* xyzTags[] = { "rXYZ", "gXYZ", "bXYZ" };
+  size_t pos = icc.size();
+  for (int i = 0; i < 3; ++i, pos += 20) {
+    put32(132 + 12 * i, sig(xyzTags[i]));
+    put32(132 + 12 * i + 4, uint32_t(pos));
+    put32(132 + 12 * i + 8, 20);
+    put32(pos, sig("XYZ "));
+    put32(pos + 4, 0);
+    for (int j = 0; j < 3; ++j)
+      put32(pos + 8 + 4 * j, fixed(xyz[i][j]));
+  }
+
+  // All TRC tags point to the same "para" curve (type 3)
+  const size_t para = pos;
+  put32(para, sig("para"));
+  put32(para + 4, 0);
+  put32(para + 8, 3 << 16);
+  const double params[] = { 2.4, 1.0 / 1.055, 0.055 / 1.055, 1.0 / 12.92, 0.04045 };
+  for (int j = 0; j < 5; ++j)
+    put32(para + 12 + 4 * j, fixed(params[j]));
+
+  const char* trcTags[] = { "rTRC", "gTRC", "bTRC" };
+  for (int i = 0; i < 3; ++i) {
+    put32(132 + 12 * (3 + i), sig(trcTags[i]));
+    put32(132 + 12 * (3 + i) + 4, uint32_t(para));
+    put32(132 + 12 * (3 + i) + 8, 32);
+  }
+  return icc;
+}
+
+} // anonymous namespace
+
+TEST(ColorSpaceConverter, Identity)
+{
+  auto conv = ColorSpaceConverter::Make(ColorSpace::MakeSRGB(), ColorSpace::MakeSRGB());
+  ASSERT_TRUE(conv);
+  EXPECT_TRUE(conv->isIdentity());
+
+  conv = ColorSpaceConverter::Make(ColorSpace::MakeNone(), ColorSpace::MakeLinearSRGB());
+  ASSERT_TRUE(conv);
+  EXPECT_TRUE(conv->isIdentity());
+
+  std::vector<Color> colors = all_grays();
+  const std::vector<Color> orig = colors;
+  conv->convertRgba8(colors.data(), colors.data(), int(colors.size()));
+  EXPECT_EQ(orig, colors);
+}
+
+TEST(ColorSpaceConverter, Cache)
+{
+  auto a = ColorSpaceConverter::Make(ColorSpace::MakeSRGB(), ColorSpace::MakeLinearSRGB());
+  auto b = ColorSpaceConverter::Make(ColorSpace::MakeSRGB(), ColorSpace::MakeLinearSRGB());
+  EXPECT_EQ(a.get(), b.get());
+
+  ColorSpaceConverter::ClearCache();
+  auto c = ColorSpaceConverter::Make(ColorSpace::MakeSRGB(), ColorSpace::MakeLinearSRGB());
+  EXPECT_NE(a.get(), c.get());
+}
+
+TEST(ColorSpaceConverter, SRGBToLinear)
+{
+  auto conv = ColorSpaceConverter::Make(ColorSpace::MakeSRGB(), ColorSpace::MakeLinearSRGB());
+  ASSERT_TRUE(conv);
+  EXPECT_FALSE(conv->isIdentity());
+
+  std::vector<Color> colors = all_grays();
+  std::vector<Color> result(colors.size());
+  conv->convertRgba8(result.data(), colors.data(), int(colors.size()));
+
+  for (int v = 0; v < 256; ++v) {
+    // Exact result: nearest 8-bit value to the linear value
+    const double x = v / 255.0;
+    const double lin = (x < 0.04045 ? x / 12.92 : std::pow((x + 0.055) / 1.055, 2.4));
+    const int expected = int(std::round(lin * 255.0));
+    const Color c = result[v];
+    ASSERT_NEAR(expected, getr(c), 1) << v;
+    ASSERT_EQ(getr(c), getg(c));
+    ASSERT_EQ(getr(c), getb(c));
+    ASSERT_EQ(255 - v, geta(c));
+  }
+  EXPECT_EQ(55, getr(result[128]));
+
+  // Back to sRGB (identity for the grays that survived the conversion)
+  auto inv = ColorSpaceConverter::Make(ColorSpace::MakeLinearSRGB(), ColorSpace::MakeSRGB());
+  std::vector<Color> back(colors.size());
+  inv->convertRgba8(back.data(), result.data(), int(result.size()));
+  EXPECT_EQ(0, getr(back[0]));
+  EXPECT_EQ(255, getr(back[255]));
+  for (int v = 1; v < 256; ++v)
+    ASSERT_GE(getr(back[v]), getr(back[v - 1]));
+
+  // Grayscale version
+  std::vector<uint8_t> gray(256), grayResult(256);
+  for (int v = 0; v < 256; ++v)
+    gray[v] = uint8_t(v);
+  conv->convertGray8(grayResult.data(), gray.data(), 256);
+  for (int v = 0; v < 256; ++v)
+    ASSERT_NEAR(getr(result[v]), grayResult[v], 1) << v;
+}
+
+TEST(ColorSpaceConverter, SRGBToDisplayP3)
+{
+  auto p3 = ColorSpace::MakeRGB(kSRGB_TransferFn, kDisplayP3);
+  auto conv = ColorSpaceConverter::Make(ColorSpace::MakeSRGB(), p3);
+  ASSERT_TRUE(conv);
+
+  const Color src[] = { rgba(255, 0, 0), rgba(0, 255, 0, 128), rgba(0, 0, 255, 0),
+                        rgba(255, 255, 255), rgba(0, 0, 0) };
+  Color dst[5];
+  conv->convertRgba8(dst, src, 5);
+
+  auto expect_color = [](int r, int g, int b, int a, Color c) {
+    EXPECT_NEAR(r, getr(c), 1);
+    EXPECT_NEAR(g, getg(c), 1);
+    EXPECT_NEAR(b, getb(c), 1);
+    EXPECT_EQ(a, geta(c));
+  };
+  expect_color(234, 51, 35, 255, dst[0]);
+  expect_color(117, 252, 76, 128, dst[1]);
+  expect_color(0, 0, 245, 0, dst[2]);
+  expect_color(255, 255, 255, 255, dst[3]);
+  expect_color(0, 0, 0, 255, dst[4]);
+
+  // P3 -> sRGB (8-bit quantization of the intermediate P3 values
+  // gives a bigger error near black, where the sRGB curve is steeper)
+  auto inv = ColorSpaceConverter::Make(p3, ColorSpace::MakeSRGB());
+  Color back[5];
+  inv->convertRgba8(back, dst, 5);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_NEAR(getr(src[i]), getr(back[i]), 4) << i;
+    EXPECT_NEAR(getg(src[i]), getg(back[i]), 4) << i;
+    EXPECT_NEAR(getb(src[i]), getb(back[i]), 4) << i;
+  }
+}
+
+TEST(ColorSpaceConverter, Gamma)
+{
+  auto conv = ColorSpaceConverter::Make(ColorSpace::MakeSRGBWithGamma(2.2f),
+                                        ColorSpace::MakeLinearSRGB());
+  ASSERT_TRUE(conv);
+
+  std::vector<Color> colors = all_grays();
+  conv->convertRgba8(colors.data(), colors.data(), int(colors.size()));
+  for (int v = 0; v < 256; ++v) {
+    const int expected = int(std::round(std::pow(v / 255.0, 2.2) * 255.0));
+    ASSERT_NEAR(expected, getr(colors[v]), 1) << v;
+  }
+}
+
+TEST(ColorSpaceConverter, RgbaF16)
+{
+  auto conv = ColorSpaceConverter::Make(ColorSpace::MakeSRGB(), ColorSpace::MakeLinearSRGB());
+  ASSERT_TRUE(conv);
+
+  // Half-float helpers
+  EXPECT_EQ(0x3c00, ColorSpaceConverter::FloatToHalf(1.0f));
+  EXPECT_EQ(0x3800, ColorSpaceConverter::FloatToHalf(0.5f));
+  EXPECT_EQ(0xc000, ColorSpaceConverter::FloatToHalf(-2.0f));
+  EXPECT_EQ(0x7c00, ColorSpaceConverter::FloatToHalf(1e6f));
+  for (uint16_t h = 0; h < 0x7c00; ++h)
+    ASSERT_EQ(h, ColorSpaceConverter::FloatToHalf(ColorSpaceConverter::HalfToFloat(h))) << h;
+
+  // Extended range values (< 0 and > 1) are converted too
+  const float values[] = { 0.0f, 0.5f, 1.0f, 2.0f, -0.5f };
+  std::vector<uint16_t> pixels;
+  for (float v : values) {
+    for (int i = 0; i < 3; ++i)
+      pixels.push_back(ColorSpaceConverter::FloatToHalf(v));
+    pixels.push_back(ColorSpaceConverter::FloatToHalf(0.25f));
+  }
+  conv->convertRgbaF16(pixels.data(), pixels.data(), 5);
+
+  for (int i = 0; i < 5; ++i) {
+    const double x = std::fabs(values[i]);
+    double lin = (x < 0.04045 ? x / 12.92 : std::pow((x + 0.055) / 1.055, 2.4));
+    if (values[i] < 0)
+      lin = -lin;
+    for (int j = 0; j < 3; ++j)
+      EXPECT_NEAR(lin, ColorSpaceConverter::HalfToFloat(pixels[4 * i + j]), std::fabs(lin) * 1e-3)
+        << i;
+    EXPECT_EQ(0.25f, ColorSpaceConverter::HalfToFloat(pixels[4 * i + 3]));
+  }
+}
+
+TEST(ColorSpaceConverter, ICC)
+{
+  const std::vector<uint8_t> data = make_icc();
+  auto icc = ColorSpace::MakeICC(data.data(), data.size());
+
+  ColorSpaceConverter::Profile profile;
+  ASSERT_TRUE(ColorSpaceConverter::MakeProfile(*icc, profile));
+  EXPECT_NEAR(0.4360747, profile.toXYZD50[0], 1e-4);
+  EXPECT_NEAR(0.2140, profile.curves[1].toLinear(0.5f), 1e-3);
+
+  // sRGB -> sRGB ICC is almost the identity
+  auto conv = ColorSpaceConverter::Make(ColorSpace::MakeSRGB(), icc);
+  ASSERT_TRUE(conv);
+  std::vector<Color> colors;
+  for (int r = 0; r < 256; r += 15)
+    for (int g = 0; g < 256; g += 15)
+      for (int b = 0; b < 256; b += 15)
+        colors.push_back(rgba(r, g, b));
+  std::vector<Color> result(colors.size());
+  conv->convertRgba8(result.data(), colors.data(), int(colors.size()));
+  for (size_t i = 0; i < colors.size(); ++i) {
+    ASSERT_NEAR(getr(colors[i]), getr(result[i]), 1) << i;
+    ASSERT_NEAR(getg(colors[i]), getg(result[i]), 1) << i;
+    ASSERT_NEAR(getb(colors[i]), getb(result[i]), 1) << i;
+  }
+
+  // Invalid profiles aren't supported
+  const uint8_t garbage[200] = { 0 };
+  auto invalid = ColorSpace::MakeICC(garbage, sizeof(garbage));
+  EXPECT_FALSE(ColorSpaceConverter::Make(ColorSpace::MakeSRGB(), invalid));
+}
+
+TEST(ColorSpaceConverter, DegenerateDestination)
+{
+  // The blue colorant is the same as the red one, so the gamut
+  // matrix cannot be inverted
+  const double xyz[3][3] = {
+    { 0.4360747, 0.2225045, 0.0139322 },
+    { 0.3850649, 0.7168786, 0.0971045 },
+    { 0.4360747, 0.2225045, 0.0139322 },
+  };
+  const std::vector<uint8_t> data = make_icc(xyz);
+  auto degenerate = ColorSpace::MakeICC(data.data(), data.size());
+
+  ColorSpaceConverter::Profile profile;
+  ASSERT_TRUE(ColorSpaceConverter::MakeProfile(*degenerate, profile));
+
+  // It can be used as source but not as destination
+  auto conv = ColorSpaceConverter::Make(degenerate, ColorSpace::MakeSRGB());
+  ASSERT_TRUE(conv);
+  Color c = rgba(255, 0, 0);
+  conv->convertRgba8(&c, &c, 1);
+  EXPECT_NEAR(255, getr(c), 1);
+  EXPECT_NEAR(0, getg(c), 1);
+  EXPECT_NEAR(0, getb(c), 1);
+
+  EXPECT_FALSE(ColorSpaceConverter::Make(ColorSpace::MakeSRGB(), degenerate));
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,146 @@
+// LAF Gfx Library
+// Copyright (c) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "gfx/integer_scale.h"
+
+#include "base/debug.h"
+#include "base/simd.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace gfx {
+
+namespace {
+
+// Replicates "n" source pixels "Scale" times each.
+template<int Scale>
+void scale_row(const uint32_t* src, uint32_t* dst, int n)
+{
+  static_assert(Scale >= 2 && Scale <= 4);
+  int i = 0;
+
+#if LAF_SSE2
+  for (; i + 4 <= n; i += 4, src += 4, dst += 4 * Scale) {
+    const __m128i v = _mm_loadu_si128((const __m128i*)src);
+    if constexpr (Scale == 2) {
+      _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi32(v, v));
+      _mm_storeu_si128((__m128i*)(dst + 4), _mm_unpackhi_epi32(v, v));
+    }
+    else if constexpr (Scale == 3) {
+      _mm_storeu_si128((__m128i*)dst, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 0, 0)));
+      _mm_storeu_si128((__m128i*)(dst + 4), _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 2, 1, 1)));
+      _mm_storeu_si128((__m128i*)(dst + 8), _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 2)));
+    }
+    else if constexpr (Scale == 4) {
+      _mm_storeu_si128((__m128i*)dst, _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 0, 0, 0)));
+      _mm_storeu_si128((__m128i*)(dst + 4), _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 1, 1, 1)));
+      _mm_storeu_si128((__m128i*)(dst + 8), _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 2, 2, 2)));
+      _mm_storeu_si128((__m128i*)(dst + 12), _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 3)));
+    }
+  }
+#elif LAF_NEON
+  if constexpr (Scale == 2) {
+    for (; i + 4 <= n; i += 4, src += 4, dst += 8) {
+      const uint32x4_t v = vld1q_u32(src);
+      const uint32x4x2_t z = vzipq_u32(v, v);
+      vst1q_u32(dst, z.val[0]);
+      vst1q_u32(dst + 4, z.val[1]);
+    }
+  }
+  else if constexpr (Scale == 4) {
+    for (; i + 4 <= n; i += 4, src += 4, dst += 16) {
+      const uint32x4_t v = vld1q_u32(src);
+      vst1q_u32(dst, vdupq_n_u32(vgetq_lane_u32(v, 0)));
+      vst1q_u32(dst + 4, vdupq_n_u32(vgetq_lane_u32(v, 1)));
+      vst1q_u32(dst + 8, vdupq_n_u32(vgetq_lane_u32(v, 2)));
+      vst1q_u32(dst + 12, vdupq_n_u32(vgetq_lane_u32(v, 3)));
+    }
+  }
+#endif
+
+  for (; i < n; ++i, ++src)
+    for (int j = 0; j < Scale; ++j)
+      *(dst++) = *src;
+}
+
+void scale_row_generic(const uint32_t* src, uint32_t* dst, int n, const int scale)
+{
+  for (int i = 0; i < n; ++i, ++src, dst += scale)
+    std::fill(dst, dst + scale, *src);
+}
+
+// Generates one scaled row: the pixels [x, x+w) of the scaled image
+// from the given source row.
+void scale_row_span(const uint32_t* srcRow, uint32_t* dst, int x, int w, const int scale)
+{
+  // Unaligned head (the last part of a scaled pixel)
+  int sx = x / scale;
+  int head = x % scale;
+  if (head) {
+    const int n = std::min(scale - head, w);
+    std::fill(dst, dst + n, srcRow[sx]);
+    dst += n;
+    w -= n;
+    ++sx;
+  }
+
+  // Complete scaled pixels
+  const int n = w / scale;
+  switch (scale) {
+    case 2:  scale_row<2>(srcRow + sx, dst, n); break;
+    case 3:  scale_row<3>(srcRow + sx, dst, n); break;
+    case 4:  scale_row<4>(srcRow + sx, dst, n); break;
+    default: scale_row_generic(srcRow + sx, dst, n, scale); break;
+  }
+  dst += n * scale;
+  sx += n;
+
+  // Unaligned tail
+  const int tail = w - n * scale;
+  if (tail > 0)
+    std::fill(dst, dst + tail, srcRow[sx]);
+}
+
+} // anonymous namespace
+
+void integer_upscale(const uint32_t* src,
+                     const int srcStride,
+                     uint32_t* dst,
+                     const int dstStride,
+                     const Rect& rc,
+                     const int scale)
+{
+  ASSERT(scale >= 1);
+  if (rc.isEmpty())
+    return;
+
+  if (scale == 1) {
+    for (int y = 0; y < rc.h; ++y, dst += dstStride)
+      std::memcpy(dst, src + (rc.y + y) * srcStride + rc.x, sizeof(uint32_t) * rc.w);
+    return;
+  }
+
+  const uint32_t* lastRow = nullptr;
+  const uint32_t* srcRow = nullptr;
+  for (int y = rc.y; y < rc.y2(); ++y, dst += dstStride) {
+    srcRow = src + (y / scale) * srcStride;
+    if (srcRow == lastRow) {
+      // Same source row, copy the previous scaled row
+      std::memcpy(dst, dst - dstStride, sizeof(uint32_t) * rc.w);
+    }
+    else {
+      scale_row_span(srcRow, dst, rc.x, rc.w, scale);
+      lastRow = srcRow;
+    }
+  }
+}
+
+} // namespace gfx
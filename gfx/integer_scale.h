@@ -0,0 +1,37 @@
+// LAF Gfx Library
+// Copyright (c) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef GFX_INTEGER_SCALE_H_INCLUDED
+#define GFX_INTEGER_SCALE_H_INCLUDED
+#pragma once
+
+#include "gfx/rect.h"
+
+#include <cstdint>
+
+namespace gfx {
+
+// Nearest-neighbor upscaling of 32-bit pixels by an integer factor
+// (used to present the backbuffer of scaled windows).
+//
+// Writes the "rc" area of the scaled image (i.e. "rc" is in scaled
+// coordinates, and it doesn't need to be aligned to "scale") in
+// "dst". "src" points to the pixel (0, 0) of the source image, and
+// "dst" to the pixel where "rc.origin()" goes. Strides are in pixels.
+//
+// Each source pixel is replicated horizontally with SIMD shuffles
+// (for 2x, 3x and 4x), and each scaled row is generated only once
+// and then copied for the next "scale-1" rows.
+void integer_upscale(const uint32_t* src,
+                     int srcStride,
+                     uint32_t* dst,
+                     int dstStride,
+                     const Rect& rc,
+                     int scale);
+
+} // namespace gfx
+
+#endif
@@ -0,0 +1,75 @@
+// LAF Gfx Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <gtest/gtest.h>
+
+#include "gfx/integer_scale.h"
+
+#include <vector>
+
+using namespace gfx;
+
+namespace {
+
+// Straightforward implementation to compare results
+void reference_upscale(const uint32_t* src,
+                       int srcStride,
+                       uint32_t* dst,
+                       int dstStride,
+                       const Rect& rc,
+                       int scale)
+{
+  for (int y = 0; y < rc.h; ++y)
+    for (int x = 0; x < rc.w; ++x)
+      dst[y * dstStride + x] = src[((rc.y + y) / scale) * srcStride + (rc.x + x) / scale];
+}
+
+} // anonymous namespace
+
+TEST(IntegerScale, AllScalesAndRects)
+{
+  const int w = 37, h = 11;
+  std::vector<uint32_t> src(w * h);
+  for (int i = 0; i < w * h; ++i)
+    src[i] = 0xff000000 | (i * 2654435761u >> 8);
+
+  for (int scale = 1; scale <= 5; ++scale) {
+    const Rect bounds(0, 0, w * scale, h * scale);
+    const Rect rects[] = {
+      bounds,
+      Rect(1, 1, 1, 1),
+      Rect(scale - 1, 2, w * scale / 2 + 3, 5),
+      Rect(bounds.w - 13, bounds.h - 3, 13, 3),
+      Rect(3, 0, 9 * scale + 1, bounds.h),
+    };
+    for (const Rect& rc : rects) {
+      const int dstStride = rc.w + 7;
+      std::vector<uint32_t> dst(dstStride * rc.h, 0);
+      std::vector<uint32_t> ref(dstStride * rc.h, 0);
+      integer_upscale(src.data(), w, dst.data(), dstStride, rc, scale);
+      reference_upscale(src.data(), w, ref.data(), dstStride, rc, scale);
+      ASSERT_EQ(ref, dst) << "scale=" << scale << " rc=" << rc.x << "," << rc.y << "," << rc.w
+                          << "," << rc.h;
+    }
+  }
+}
+
+TEST(IntegerScale, EmptyRect)
+{
+  uint32_t src = 1, dst = 2;
+  integer_upscale(&src, 1, &dst, 1, Rect(0, 0, 0, 0), 2);
+  EXPECT_EQ(2, dst);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
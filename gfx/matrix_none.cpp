@@ -0,0 +1,163 @@
+// LAF Gfx Library
+// Copyright (c) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "gfx/matrix.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace gfx {
+
+void Matrix::setRotate(float degrees, float px, float py)
+{
+  const double rad = degrees * 3.14159265358979323846 / 180.0;
+  float sinV = float(std::sin(rad));
+  float cosV = float(std::cos(rad));
+
+  // Avoid small errors for multiples of 90 degrees (as SkMatrix does)
+  if (std::fabs(sinV) < 1.0f / (1 << 12))
+    sinV = 0.0f;
+  if (std::fabs(cosV) < 1.0f / (1 << 12))
+    cosV = 0.0f;
+
+  const float oneMinusCos = 1.0f - cosV;
+  *this = MakeAll(cosV,
+                  -sinV,
+                  sinV * py + oneMinusCos * px,
+                  sinV,
+                  cosV,
+                  -sinV * px + oneMinusCos * py,
+                  0,
+                  0,
+                  1);
+}
+
+Matrix& Matrix::setConcat(const Matrix& a, const Matrix& b)
+{
+  // Calculate the result in a temporary array because "a" or "b" can
+  // be "this".
+  float r[9];
+  for (int row = 0; row < 3; ++row) {
+    const float* ar = a.m_mat + row * 3;
+    for (int col = 0; col < 3; ++col) {
+      r[row * 3 + col] = ar[0] * b.m_mat[col] + ar[1] * b.m_mat[3 + col] +
+                         ar[2] * b.m_mat[6 + col];
+    }
+  }
+  std::copy(r, r + 9, m_mat);
+  return *this;
+}
+
+bool Matrix::invert(Matrix* inverse) const
+{
+  const float* m = m_mat;
+
+  // Fast path for scale + translate matrices
+  if (isScaleTranslate()) {
+    if (m[kMScaleX] == 0 || m[kMScaleY] == 0)
+      return false;
+    if (inverse) {
+      const float invX = 1.0f / m[kMScaleX];
+      const float invY = 1.0f / m[kMScaleY];
+      inverse->setScaleTranslate(invX, invY, -m[kMTransX] * invX, -m[kMTransY] * invY);
+    }
+    return true;
+  }
+
+  // Adjugate matrix / determinant (in double precision)
+  const double a0 = double(m[4]) * m[8] - double(m[5]) * m[7];
+  const double a1 = double(m[5]) * m[6] - double(m[3]) * m[8];
+  const double a2 = double(m[3]) * m[7] - double(m[4]) * m[6];
+  const double det = m[0] * a0 + m[1] * a1 + m[2] * a2;
+  if (det == 0.0 || !std::isfinite(det))
+    return false;
+
+  if (inverse) {
+    const double inv = 1.0 / det;
+    *inverse = MakeAll(float(a0 * inv),
+                       float((double(m[2]) * m[7] - double(m[1]) * m[8]) * inv),
+                       float((double(m[1]) * m[5] - double(m[2]) * m[4]) * inv),
+                       float(a1 * inv),
+                       float((double(m[0]) * m[8] - double(m[2]) * m[6]) * inv),
+                       float((double(m[2]) * m[3] - double(m[0]) * m[5]) * inv),
+                       float(a2 * inv),
+                       float((double(m[1]) * m[6] - double(m[0]) * m[7]) * inv),
+                       float((double(m[0]) * m[4] - double(m[1]) * m[3]) * inv));
+  }
+  return true;
+}
+
+PointF Matrix::mapPoint(const PointF& pt) const
+{
+  PointF result;
+  mapPoints(&result, &pt, 1);
+  return result;
+}
+
+void Matrix::mapPoints(PointF* dst, const PointF* src, int count) const
+{
+  const float* m = m_mat;
+  if (isScaleTranslate()) {
+    for (int i = 0; i < count; ++i) {
+      dst[i].x = src[i].x * m[kMScaleX] + m[kMTransX];
+      dst[i].y = src[i].y * m[kMScaleY] + m[kMTransY];
+    }
+  }
+  else if (!hasPerspective()) {
+    for (int i = 0; i < count; ++i) {
+      const float x = src[i].x;
+      const float y = src[i].y;
+      dst[i].x = x * m[kMScaleX] + y * m[kMSkewX] + m[kMTransX];
+      dst[i].y = x * m[kMSkewY] + y * m[kMScaleY] + m[kMTransY];
+    }
+  }
+  else {
+    for (int i = 0; i < count; ++i) {
+      const float x = src[i].x;
+      const float y = src[i].y;
+      float w = x * m[kMPersp0] + y * m[kMPersp1] + m[kMPersp2];
+      if (w != 0.0f)
+        w = 1.0f / w;
+      dst[i].x = (x * m[kMScaleX] + y * m[kMSkewX] + m[kMTransX]) * w;
+      dst[i].y = (x * m[kMSkewY] + y * m[kMScaleY] + m[kMTransY]) * w;
+    }
+  }
+}
+
+RectF Matrix::mapRect(const RectF& src) const
+{
+  if (isScaleTranslate()) {
+    const float x1 = src.x * m_mat[kMScaleX] + m_mat[kMTransX];
+    const float y1 = src.y * m_mat[kMScaleY] + m_mat[kMTransY];
+    const float x2 = (src.x + src.w) * m_mat[kMScaleX] + m_mat[kMTransX];
+    const float y2 = (src.y + src.h) * m_mat[kMScaleY] + m_mat[kMTransY];
+    return RectF(std::min(x1, x2), std::min(y1, y2), std::fabs(x2 - x1), std::fabs(y2 - y1));
+  }
+
+  PointF pts[4] = {
+    PointF(src.x, src.y),
+    PointF(src.x + src.w, src.y),
+    PointF(src.x + src.w, src.y + src.h),
+    PointF(src.x, src.y + src.h),
+  };
+  mapPoints(pts, pts, 4);
+
+  float x1 = pts[0].x, y1 = pts[0].y;
+  float x2 = x1, y2 = y1;
+  for (int i = 1; i < 4; ++i) {
+    x1 = std::min(x1, pts[i].x);
+    y1 = std::min(y1, pts[i].y);
+    x2 = std::max(x2, pts[i].x);
+    y2 = std::max(y2, pts[i].y);
+  }
+  return RectF(x1, y1, x2 - x1, y2 - y1);
+}
+
+} // namespace gfx
@@ -1,5 +1,5 @@
 // LAF Gfx Library
-// Copyright (c) 2020-2024  Igara Studio S.A.
+// Copyright (c) 2020-2025  Igara Studio S.A.
 //
 // This file is released under the terms of the MIT license.
 // Read LICENSE.txt for more information.
@@ -8,17 +8,37 @@
 #define GFX_MATRIX_NONE_H_INCLUDED
 #pragma once
 
+#include "gfx/point.h"
 #include "gfx/rect.h"
 
 namespace gfx {
 
+// 3x3 matrix for 2D transformations (the same layout and semantics
+// as SkMatrix) used when we don't compile with Skia.
+//
+//   | scaleX  skewX  transX |
+//   | skewY   scaleY transY |
+//   | pers0   pers1  pers2  |
+//
 class Matrix {
 public:
-  Matrix() {}
+  enum {
+    kMScaleX = 0,
+    kMSkewX,
+    kMTransX,
+    kMSkewY,
+    kMScaleY,
+    kMTransY,
+    kMPersp0,
+    kMPersp1,
+    kMPersp2,
+  };
 
-  static Matrix MakeScale(float sx, float sy) { return Matrix(); }
-  static Matrix MakeScale(float scale) { return Matrix(); }
-  static Matrix MakeTrans(float x, float y) { return Matrix(); }
+  constexpr Matrix() : m_mat{ 1, 0, 0, 0, 1, 0, 0, 0, 1 } {}
+
+  static Matrix MakeScale(float sx, float sy) { return MakeAll(sx, 0, 0, 0, sy, 0, 0, 0, 1); }
+  static Matrix MakeScale(float scale) { return MakeScale(scale, scale); }
+  static Matrix MakeTrans(float x, float y) { return MakeAll(1, 0, x, 0, 1, y, 0, 0, 1); }
   static Matrix MakeAll(float scaleX,
                         float skewX,
                         float transX,
@@ -29,38 +49,91 @@ public:
                         float pers1,
                         float pers2)
   {
-    return Matrix();
+    Matrix m;
+    m.m_mat[kMScaleX] = scaleX;
+    m.m_mat[kMSkewX] = skewX;
+    m.m_mat[kMTransX] = transX;
+    m.m_mat[kMSkewY] = skewY;
+    m.m_mat[kMScaleY] = scaleY;
+    m.m_mat[kMTransY] = transY;
+    m.m_mat[kMPersp0] = pers0;
+    m.m_mat[kMPersp1] = pers1;
+    m.m_mat[kMPersp2] = pers2;
+    return m;
+  }
+
+  Matrix& reset() { return setIdentity(); }
+
+  bool isIdentity() const { return isTranslate() && m_mat[kMTransX] == 0 && m_mat[kMTransY] == 0; }
+  bool isScaleTranslate() const
+  {
+    return (m_mat[kMSkewX] == 0 && m_mat[kMSkewY] == 0 && !hasPerspective());
+  }
+  bool isTranslate() const
+  {
+    return (isScaleTranslate() && m_mat[kMScaleX] == 1 && m_mat[kMScaleY] == 1);
+  }
+  bool hasPerspective() const
+  {
+    return (m_mat[kMPersp0] != 0 || m_mat[kMPersp1] != 0 || m_mat[kMPersp2] != 1);
+  }
+
+  float getScaleX() const { return m_mat[kMScaleX]; }
+  float getScaleY() const { return m_mat[kMScaleY]; }
+  float getSkewY() const { return m_mat[kMSkewY]; }
+  float getSkewX() const { return m_mat[kMSkewX]; }
+  float getTranslateX() const { return m_mat[kMTransX]; }
+  float getTranslateY() const { return m_mat[kMTransY]; }
+  float getPerspX() const { return m_mat[kMPersp0]; }
+  float getPerspY() const { return m_mat[kMPersp1]; }
+
+  float operator[](int index) const { return m_mat[index]; }
+
+  Matrix& setIdentity()
+  {
+    *this = Matrix();
+    return *this;
+  }
+
+  Matrix& setTranslate(float dx, float dy)
+  {
+    *this = MakeTrans(dx, dy);
+    return *this;
   }
 
-  Matrix& reset() { return *this; }
-  bool isIdentity() const { return true; }
-  bool isScaleTranslate() const { return false; }
-  bool isTranslate() const { return false; }
-
-  float getScaleX() const { return 1.0f; }
-  float getScaleY() const { return 1.0f; }
-  float getSkewY() const { return 0.0f; }
-  float getSkewX() const { return 0.0f; }
-  float getTranslateX() const { return 0.0f; }
-  float getTranslateY() const { return 0.0f; }
-  float getPerspX() const { return 0.0f; }
-  float getPerspY() const { return 0.0f; }
-
-  Matrix& setIdentity() { return *this; }
-  Matrix& setTranslate(float dx, float dy) { return *this; }
-  void setScale(float sx, float sy, float px, float py) {}
-  void setScale(float sx, float sy) {}
-  void setRotate(float degrees, float px, float py) {}
-  void setRotate(float degrees) {}
-  void setScaleTranslate(float sx, float sy, float tx, float ty) {}
-  Matrix& preTranslate(float dx, float dy) { return *this; }
-  Matrix& postTranslate(float dx, float dy) { return *this; }
-
-  Matrix& setConcat(const Matrix& a, const Matrix& b) { return *this; }
-  Matrix& preConcat(const Matrix& other) { return *this; }
-  Matrix& postConcat(const Matrix& other) { return *this; }
-
-  RectF mapRect(const RectF& src) const { return RectF(); }
+  void setScale(float sx, float sy, float px, float py)
+  {
+    *this = MakeAll(sx, 0, px - sx * px, 0, sy, py - sy * py, 0, 0, 1);
+  }
+
+  void setScale(float sx, float sy) { *this = MakeScale(sx, sy); }
+  void setRotate(float degrees, float px, float py);
+  void setRotate(float degrees) { setRotate(degrees, 0, 0); }
+
+  void setScaleTranslate(float sx, float sy, float tx, float ty)
+  {
+    *this = MakeAll(sx, 0, tx, 0, sy, ty, 0, 0, 1);
+  }
+
+  Matrix& preTranslate(float dx, float dy) { return preConcat(MakeTrans(dx, dy)); }
+  Matrix& postTranslate(float dx, float dy) { return postConcat(MakeTrans(dx, dy)); }
+
+  // this = a * b
+  Matrix& setConcat(const Matrix& a, const Matrix& b);
+  // this = this * other
+  Matrix& preConcat(const Matrix& other) { return setConcat(*this, other); }
+  // this = other * this
+  Matrix& postConcat(const Matrix& other) { return setConcat(other, *this); }
+
+  // Returns false if the matrix cannot be inverted.
+  bool invert(Matrix* inverse) const;
+
+  PointF mapPoint(const PointF& pt) const;
+  void mapPoints(PointF* dst, const PointF* src, int count) const;
+  RectF mapRect(const RectF& src) const;
+
+private:
+  float m_mat[9];
 };
 
 } // namespace gfx
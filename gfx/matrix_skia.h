@@ -1,5 +1,5 @@
 // LAF Gfx Library
-// Copyright (c) 2020-2023  Igara Studio S.A.
+// Copyright (c) 2020-2025  Igara Studio S.A.
 //
 // This file is released under the terms of the MIT license.
 // Read LICENSE.txt for more information.
@@ -50,6 +50,7 @@ public:
   bool isIdentity() const { return m_skMatrix.isIdentity(); }
   bool isScaleTranslate() const { return m_skMatrix.isScaleTranslate(); }
   bool isTranslate() const { return m_skMatrix.isTranslate(); }
+  bool hasPerspective() const { return m_skMatrix.hasPerspective(); }
 
   float getScaleX() const { return m_skMatrix.getScaleX(); }
   float getScaleY() const { return m_skMatrix.getScaleY(); }
@@ -115,6 +116,23 @@ public:
     return *this;
   }
 
+  bool invert(Matrix* inverse) const
+  {
+    return m_skMatrix.invert(inverse ? &inverse->m_skMatrix : nullptr);
+  }
+
+  PointF mapPoint(const PointF& pt) const
+  {
+    const SkPoint dst = m_skMatrix.mapXY(pt.x, pt.y);
+    return PointF(dst.x(), dst.y());
+  }
+
+  void mapPoints(PointF* dst, const PointF* src, int count) const
+  {
+    for (int i = 0; i < count; ++i)
+      dst[i] = mapPoint(src[i]);
+  }
+
   RectF mapRect(const RectF& src) const
   {
     SkRect dst;
@@ -0,0 +1,135 @@
+// LAF Gfx Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <gtest/gtest.h>
+
+#include "gfx/matrix.h"
+#include "gfx/point.h"
+#include "gfx/rect.h"
+
+using namespace gfx;
+
+#define EXPECT_POINTF_NEAR(expected, actual)                                                       \
+  {                                                                                                \
+    const PointF e = (expected);                                                                   \
+    const PointF a = (actual);                                                                     \
+    EXPECT_NEAR(e.x, a.x, 1e-4);                                                                   \
+    EXPECT_NEAR(e.y, a.y, 1e-4);                                                                   \
+  }
+
+TEST(Matrix, Identity)
+{
+  Matrix m;
+  EXPECT_TRUE(m.isIdentity());
+  EXPECT_TRUE(m.isTranslate());
+  EXPECT_TRUE(m.isScaleTranslate());
+  EXPECT_EQ(PointF(3, 4), m.mapPoint(PointF(3, 4)));
+  EXPECT_EQ(RectF(1, 2, 3, 4), m.mapRect(RectF(1, 2, 3, 4)));
+
+  m = Matrix::MakeTrans(10, 20);
+  EXPECT_FALSE(m.isIdentity());
+  EXPECT_TRUE(m.isTranslate());
+  m.reset();
+  EXPECT_TRUE(m.isIdentity());
+}
+
+TEST(Matrix, ScaleTranslate)
+{
+  Matrix m = Matrix::MakeScale(2, 3);
+  EXPECT_FALSE(m.isTranslate());
+  EXPECT_TRUE(m.isScaleTranslate());
+  EXPECT_EQ(2.0f, m.getScaleX());
+  EXPECT_EQ(3.0f, m.getScaleY());
+  EXPECT_EQ(RectF(2, 3, 6, 9), m.mapRect(RectF(1, 1, 3, 3)));
+
+  m.postTranslate(10, 20);
+  EXPECT_EQ(PointF(12, 23), m.mapPoint(PointF(1, 1)));
+
+  m = Matrix::MakeScale(2, 3);
+  m.preTranslate(10, 20);
+  EXPECT_EQ(PointF(22, 63), m.mapPoint(PointF(1, 1)));
+
+  // Negative scales produce a rect with positive size
+  m = Matrix::MakeScale(-1, -1);
+  EXPECT_EQ(RectF(-4, -6, 3, 4), m.mapRect(RectF(1, 2, 3, 4)));
+
+  m.setScale(2, 2, 10, 10);
+  EXPECT_EQ(PointF(10, 10), m.mapPoint(PointF(10, 10)));
+  EXPECT_EQ(PointF(12, 14), m.mapPoint(PointF(11, 12)));
+}
+
+TEST(Matrix, Rotate)
+{
+  Matrix m;
+  m.setRotate(90);
+  EXPECT_FALSE(m.isScaleTranslate());
+  EXPECT_POINTF_NEAR(PointF(0, 1), m.mapPoint(PointF(1, 0)));
+  EXPECT_POINTF_NEAR(PointF(-1, 0), m.mapPoint(PointF(0, 1)));
+
+  m.setRotate(180, 5, 5);
+  EXPECT_POINTF_NEAR(PointF(10, 10), m.mapPoint(PointF(0, 0)));
+
+  m.setRotate(45);
+  const RectF rc = m.mapRect(RectF(0, 0, 10, 10));
+  EXPECT_NEAR(-7.0710678, rc.x, 1e-4);
+  EXPECT_NEAR(0.0, rc.y, 1e-4);
+  EXPECT_NEAR(14.142135, rc.w, 1e-4);
+  EXPECT_NEAR(14.142135, rc.h, 1e-4);
+}
+
+TEST(Matrix, Concat)
+{
+  const Matrix scale = Matrix::MakeScale(2);
+  const Matrix trans = Matrix::MakeTrans(5, 7);
+
+  // setConcat(a, b) maps points with b first and then a
+  Matrix m;
+  m.setConcat(scale, trans);
+  EXPECT_EQ(PointF(12, 16), m.mapPoint(PointF(1, 1)));
+  m.setConcat(trans, scale);
+  EXPECT_EQ(PointF(7, 9), m.mapPoint(PointF(1, 1)));
+
+  m = scale;
+  m.preConcat(trans);
+  EXPECT_EQ(PointF(12, 16), m.mapPoint(PointF(1, 1)));
+
+  m = scale;
+  m.postConcat(trans);
+  EXPECT_EQ(PointF(7, 9), m.mapPoint(PointF(1, 1)));
+}
+
+TEST(Matrix, Invert)
+{
+  Matrix inv;
+  EXPECT_FALSE(Matrix::MakeScale(0, 1).invert(&inv));
+
+  Matrix m = Matrix::MakeAll(2, 1, 5, 0.5f, 3, -2, 0, 0, 1);
+  ASSERT_TRUE(m.invert(&inv));
+  const PointF pt(13, -17);
+  EXPECT_POINTF_NEAR(pt, inv.mapPoint(m.mapPoint(pt)));
+
+  m = Matrix::MakeScale(4, 2);
+  m.postTranslate(8, 6);
+  ASSERT_TRUE(m.invert(&inv));
+  EXPECT_POINTF_NEAR(PointF(0, 0), inv.mapPoint(PointF(8, 6)));
+}
+
+TEST(Matrix, Perspective)
+{
+  const Matrix m = Matrix::MakeAll(1, 0, 0, 0, 1, 0, 0.5f, 0, 1);
+  EXPECT_FALSE(m.isScaleTranslate());
+  EXPECT_POINTF_NEAR(PointF(1, 1), m.mapPoint(PointF(2, 2)));
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
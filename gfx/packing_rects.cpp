@@ -1,5 +1,5 @@
 // LAF Gfx Library
-// Copyright (C) 2019-2023  Igara Studio S.A.
+// Copyright (C) 2019-2025  Igara Studio S.A.
 // Copyright (C) 2001-2014 David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -11,6 +11,7 @@
 
 #include "gfx/packing_rects.h"
 
+#include "base/arena.h"
 #include "gfx/region.h"
 #include "gfx/size.h"
 
@@ -84,8 +85,12 @@ bool PackingRects::pack(const Size& size, base::task_token& token)
 {
   m_bounds = Rect(size).shrink(m_borderPadding);
 
-  // We cannot sort m_rects because we want to
-  std::vector<Rect*> rectPtrs(m_rects.size());
+  // We cannot sort m_rects because we want to keep the original
+  // order, so we sort pointers in a temporary vector (allocated from
+  // the per-thread arena as pack() is called several times from
+  // bestFit()).
+  const base::arena_scope scope;
+  std::vector<Rect*, base::arena_allocator<Rect*>> rectPtrs(m_rects.size(), nullptr, scope.get());
   int i = 0;
   for (auto& rc : m_rects)
     rectPtrs[i++] = &rc;
@@ -0,0 +1,235 @@
+// LAF Gfx Library
+// Copyright (c) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "gfx/path.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace gfx {
+
+namespace {
+
+// Distance from the end points to the control points of a cubic
+// Bézier to approximate a quarter of a circle of radius 1.
+constexpr float kCircleKappa = 0.5522847498f;
+
+// Adds the extrema (the roots of the derivative) of one coordinate of
+// a cubic Bézier to the [lo, hi] range.
+void cubic_extrema(const float p0,
+                   const float p1,
+                   const float p2,
+                   const float p3,
+                   float& lo,
+                   float& hi)
+{
+  // B'(t)/3 = a*t^2 + b*t + c
+  const double a = -p0 + 3.0 * p1 - 3.0 * p2 + p3;
+  const double b = 2.0 * (p0 - 2.0 * p1 + p2);
+  const double c = p1 - p0;
+
+  double roots[2];
+  int n = 0;
+  if (std::fabs(a) < 1e-12) {
+    if (std::fabs(b) > 1e-12)
+      roots[n++] = -c / b;
+  }
+  else {
+    const double disc = b * b - 4.0 * a * c;
+    if (disc >= 0.0) {
+      const double sq = std::sqrt(disc);
+      roots[n++] = (-b + sq) / (2.0 * a);
+      roots[n++] = (-b - sq) / (2.0 * a);
+    }
+  }
+
+  for (int i = 0; i < n; ++i) {
+    const double t = roots[i];
+    if (t <= 0.0 || t >= 1.0)
+      continue;
+    const double mt = 1.0 - t;
+    const float v = float(mt * mt * mt * p0 + 3.0 * mt * mt * t * p1 + 3.0 * mt * t * t * p2 +
+                          t * t * t * p3);
+    lo = std::min(lo, v);
+    hi = std::max(hi, v);
+  }
+}
+
+} // anonymous namespace
+
+Path& Path::moveTo(float x, float y)
+{
+  // Consecutive moveTo() calls replace the previous point (as SkPath)
+  if (!m_verbs.empty() && m_verbs.back() == Verb::Move) {
+    m_points.back() = PointF(x, y);
+  }
+  else {
+    m_lastMove = int(m_points.size());
+    m_verbs.push_back(Verb::Move);
+    m_points.push_back(PointF(x, y));
+  }
+  return *this;
+}
+
+Path& Path::lineTo(float x, float y)
+{
+  injectMoveToIfNeeded();
+  m_verbs.push_back(Verb::Line);
+  m_points.push_back(PointF(x, y));
+  return *this;
+}
+
+Path& Path::cubicTo(float dx1, float dy1, float dx2, float dy2, float dx3, float dy3)
+{
+  injectMoveToIfNeeded();
+  m_verbs.push_back(Verb::Cubic);
+  m_points.push_back(PointF(dx1, dy1));
+  m_points.push_back(PointF(dx2, dy2));
+  m_points.push_back(PointF(dx3, dy3));
+  return *this;
+}
+
+Path& Path::oval(const Rect& rc)
+{
+  const float rx = rc.w / 2.0f;
+  const float ry = rc.h / 2.0f;
+  const float cx = rc.x + rx;
+  const float cy = rc.y + ry;
+  const float kx = rx * kCircleKappa;
+  const float ky = ry * kCircleKappa;
+
+  // Clockwise (in screen coordinates) starting from the right side
+  moveTo(cx + rx, cy);
+  cubicTo(cx + rx, cy + ky, cx + kx, cy + ry, cx, cy + ry);
+  cubicTo(cx - kx, cy + ry, cx - rx, cy + ky, cx - rx, cy);
+  cubicTo(cx - rx, cy - ky, cx - kx, cy - ry, cx, cy - ry);
+  cubicTo(cx + kx, cy - ry, cx + rx, cy - ky, cx + rx, cy);
+  return close();
+}
+
+Path& Path::rect(const Rect& rc)
+{
+  const float x1 = float(rc.x);
+  const float y1 = float(rc.y);
+  const float x2 = float(rc.x2());
+  const float y2 = float(rc.y2());
+  moveTo(x1, y1);
+  lineTo(x2, y1);
+  lineTo(x2, y2);
+  lineTo(x1, y2);
+  return close();
+}
+
+Path& Path::roundedRect(const Rect& rc, float rx, float ry)
+{
+  // Same 0.5 offset used in the Skia implementation (path_skia.h)
+  const float x1 = rc.x + 0.5f;
+  const float y1 = rc.y + 0.5f;
+  const float x2 = x1 + rc.w;
+  const float y2 = y1 + rc.h;
+
+  rx = std::clamp(rx, 0.0f, rc.w / 2.0f);
+  ry = std::clamp(ry, 0.0f, rc.h / 2.0f);
+  if (rx <= 0.0f || ry <= 0.0f) {
+    moveTo(x1, y1);
+    lineTo(x2, y1);
+    lineTo(x2, y2);
+    lineTo(x1, y2);
+    return close();
+  }
+
+  const float kx = rx * kCircleKappa;
+  const float ky = ry * kCircleKappa;
+  moveTo(x1 + rx, y1);
+  lineTo(x2 - rx, y1);
+  cubicTo(x2 - rx + kx, y1, x2, y1 + ry - ky, x2, y1 + ry);
+  lineTo(x2, y2 - ry);
+  cubicTo(x2, y2 - ry + ky, x2 - rx + kx, y2, x2 - rx, y2);
+  lineTo(x1 + rx, y2);
+  cubicTo(x1 + rx - kx, y2, x1, y2 - ry + ky, x1, y2 - ry);
+  lineTo(x1, y1 + ry);
+  cubicTo(x1, y1 + ry - ky, x1 + rx - kx, y1, x1 + rx, y1);
+  return close();
+}
+
+Path& Path::close()
+{
+  if (!m_verbs.empty() && m_verbs.back() != Verb::Close)
+    m_verbs.push_back(Verb::Close);
+  return *this;
+}
+
+void Path::offset(float dx, float dy, Path* dst) const
+{
+  if (dst != this)
+    *dst = *this;
+  for (PointF& pt : dst->m_points) {
+    pt.x += dx;
+    pt.y += dy;
+  }
+}
+
+void Path::transform(const Matrix& matrix, Path* dst)
+{
+  if (dst != this)
+    *dst = *this;
+  if (!dst->m_points.empty())
+    matrix.mapPoints(dst->m_points.data(), dst->m_points.data(), int(dst->m_points.size()));
+}
+
+RectF Path::bounds() const
+{
+  if (isEmpty())
+    return RectF();
+
+  float x1 = m_points[0].x, y1 = m_points[0].y;
+  float x2 = x1, y2 = y1;
+  auto add = [&](const PointF& pt) {
+    x1 = std::min(x1, pt.x);
+    y1 = std::min(y1, pt.y);
+    x2 = std::max(x2, pt.x);
+    y2 = std::max(y2, pt.y);
+  };
+
+  // Tight bounds: on-curve points and cubic extrema (not control points)
+  const PointF* pt = m_points.data();
+  for (const Verb verb : m_verbs) {
+    switch (verb) {
+      case Verb::Move:
+      case Verb::Line:
+        add(*pt);
+        ++pt;
+        break;
+      case Verb::Cubic: {
+        const PointF& p0 = pt[-1];
+        add(pt[2]);
+        cubic_extrema(p0.x, pt[0].x, pt[1].x, pt[2].x, x1, x2);
+        cubic_extrema(p0.y, pt[0].y, pt[1].y, pt[2].y, y1, y2);
+        pt += 3;
+        break;
+      }
+      case Verb::Close: break;
+    }
+  }
+  return RectF(x1, y1, x2 - x1, y2 - y1);
+}
+
+void Path::injectMoveToIfNeeded()
+{
+  if (m_verbs.empty()) {
+    moveTo(0.0f, 0.0f);
+  }
+  else if (m_verbs.back() == Verb::Close) {
+    const PointF pt = m_points[m_lastMove];
+    moveTo(pt.x, pt.y);
+  }
+}
+
+} // namespace gfx
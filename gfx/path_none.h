@@ -1,5 +1,5 @@
 // LAF Gfx Library
-// Copyright (c) 2020-2023  Igara Studio S.A.
+// Copyright (c) 2020-2025  Igara Studio S.A.
 //
 // This file is released under the terms of the MIT license.
 // Read LICENSE.txt for more information.
@@ -8,33 +8,78 @@
 #define GFX_PATH_NONE_H_INCLUDED
 #pragma once
 
+#include "gfx/matrix.h"
 #include "gfx/point.h"
 #include "gfx/rect.h"
 
-namespace gfx {
+#include <cstdint>
+#include <vector>
 
-class Matrix;
+namespace gfx {
 
+// Path implementation used when we don't compile with Skia. It's a
+// list of verbs (move/line/cubic/close) and their points, which can
+// be rasterized with gfx::PathRasterizer.
 class Path {
 public:
+  enum class Verb : uint8_t { Move, Line, Cubic, Close };
+  enum class FillType : uint8_t { Winding, EvenOdd };
+
   Path() {}
-  Path& reset() { return *this; }
-  Path& rewind() { return *this; }
-  bool isEmpty() const { return true; }
-  Path& moveTo(float x, float y) { return *this; }
-  Path& moveTo(const Point& p) { return *this; }
-  Path& lineTo(float x, float y) { return *this; }
-  Path& lineTo(const Point& p) { return *this; }
-  Path& cubicTo(float dx1, float dy1, float dx2, float dy2, float dx3, float dy3) { return *this; }
-  Path& oval(const Rect& rc) { return *this; }
-  Path& rect(const Rect& rc) { return *this; }
-  Path& roundedRect(const Rect& rc, float rx, float ry) { return *this; }
-  Path& close() { return *this; }
-  void offset(float dx, float dy, Path* dst) const {}
-  void offset(float dx, float dy) {}
-  void transform(const Matrix& matrix, Path* dst) {}
-  void transform(const Matrix& matrix) {}
-  RectF bounds() const { return RectF(); }
+
+  Path& reset()
+  {
+    m_verbs = std::vector<Verb>();
+    m_points = std::vector<PointF>();
+    m_lastMove = -1;
+    return *this;
+  }
+
+  // Like reset() but keeps the allocated memory.
+  Path& rewind()
+  {
+    m_verbs.clear();
+    m_points.clear();
+    m_lastMove = -1;
+    return *this;
+  }
+
+  bool isEmpty() const { return m_verbs.empty(); }
+
+  FillType fillType() const { return m_fillType; }
+  void fillType(const FillType fillType) { m_fillType = fillType; }
+
+  Path& moveTo(float x, float y);
+  Path& moveTo(const Point& p) { return moveTo(float(p.x), float(p.y)); }
+  Path& lineTo(float x, float y);
+  Path& lineTo(const Point& p) { return lineTo(float(p.x), float(p.y)); }
+  Path& cubicTo(float dx1, float dy1, float dx2, float dy2, float dx3, float dy3);
+  Path& oval(const Rect& rc);
+  Path& rect(const Rect& rc);
+  Path& roundedRect(const Rect& rc, float rx, float ry);
+  Path& close();
+
+  void offset(float dx, float dy, Path* dst) const;
+  void offset(float dx, float dy) { offset(dx, dy, this); }
+  void transform(const Matrix& matrix, Path* dst);
+  void transform(const Matrix& matrix) { transform(matrix, this); }
+  RectF bounds() const;
+
+  // Raw access to verbs and points. Move and Line verbs use one
+  // point, Cubic verbs use three points (two control points and the
+  // end point), and Close doesn't use points.
+  const std::vector<Verb>& verbs() const { return m_verbs; }
+  const std::vector<PointF>& points() const { return m_points; }
+
+private:
+  void injectMoveToIfNeeded();
+
+  std::vector<Verb> m_verbs;
+  std::vector<PointF> m_points;
+  // Index in m_points of the last moveTo() point (-1 if there is no
+  // moveTo() yet)
+  int m_lastMove = -1;
+  FillType m_fillType = FillType::Winding;
 };
 
 } // namespace gfx
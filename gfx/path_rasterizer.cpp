@@ -0,0 +1,583 @@
+// LAF Gfx Library
+// Copyright (c) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "gfx/path_rasterizer.h"
+
+#include "base/debug.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <limits>
+
+namespace gfx {
+
+namespace {
+
+// Maximum distance (in pixels) between a curve and its flattened
+// version.
+constexpr float kTolerance = 0.1f;
+
+// Same default miter limit as SkPaint
+constexpr float kMiterLimit = 4.0f;
+
+// Maximum number of lines to approximate one cubic curve
+constexpr int kMaxCubicLines = 256;
+
+inline bool same_point(const PointF& a, const PointF& b)
+{
+  return (a.x == b.x && a.y == b.y);
+}
+
+inline float length(const float x, const float y)
+{
+  return std::sqrt(x * x + y * y);
+}
+
+// Signed area (x2) of a polygon, positive if it's clockwise in
+// screen coordinates.
+float signed_area(const PointF* pts, const int count)
+{
+  float area = 0.0f;
+  for (int i = 0, j = count - 1; i < count; j = i++)
+    area += pts[j].x * pts[i].y - pts[i].x * pts[j].y;
+  return area;
+}
+
+} // anonymous namespace
+
+PathRasterizer::PathRasterizer()
+{
+  reset(Rect());
+}
+
+void PathRasterizer::reset(const Rect& clip)
+{
+  m_clip = clip;
+  m_edges.clear();
+  m_minY = std::numeric_limits<float>::max();
+  m_maxY = std::numeric_limits<float>::lowest();
+  m_fillType = Path::FillType::Winding;
+}
+
+void PathRasterizer::addPath(const Path& path, const Matrix& matrix)
+{
+  m_fillType = path.fillType();
+
+  flatten(path, &matrix, kTolerance);
+  for (const Polyline& poly : m_polylines)
+    addPolygon(&m_polyPoints[poly.begin], poly.end - poly.begin);
+}
+
+void PathRasterizer::addStroke(const Path& path, const Matrix& matrix, float strokeWidth)
+{
+  m_fillType = Path::FillType::Winding;
+
+  // Approximated scale of the matrix to convert the tolerance and
+  // the hairline width from pixels to path coordinates.
+  const float scale = std::max(length(matrix.getScaleX(), matrix.getSkewY()),
+                               length(matrix.getSkewX(), matrix.getScaleY()));
+  if (scale <= 0.0f || !std::isfinite(scale))
+    return;
+
+  const float halfWidth = (strokeWidth > 0.0f ? strokeWidth : 1.0f / scale) / 2.0f;
+
+  // The stroke is created in path coordinates (so non-uniform scales
+  // produce the expected result), and then each polygon is
+  // transformed to device coordinates.
+  flatten(path, nullptr, kTolerance / scale);
+  for (const Polyline& poly : m_polylines)
+    strokePolyline(poly, halfWidth, matrix);
+}
+
+void PathRasterizer::addPolygon(const PointF* pts, int count)
+{
+  if (count < 3)
+    return;
+  for (int i = 0, j = count - 1; i < count; j = i++)
+    addLine(pts[j], pts[i]);
+}
+
+Rect PathRasterizer::bounds() const
+{
+  if (m_edges.empty())
+    return Rect();
+
+  float minX = std::numeric_limits<float>::max();
+  float maxX = std::numeric_limits<float>::lowest();
+  for (const Edge& e : m_edges) {
+    minX = std::min(minX, std::min(e.x0, e.x1));
+    maxX = std::max(maxX, std::max(e.x0, e.x1));
+  }
+
+  const int x1 = int(std::floor(minX));
+  const int y1 = std::max(0, int(std::floor(m_minY)));
+  const int x2 = int(std::ceil(maxX)) + 1;
+  const int y2 = std::min(m_clip.h, int(std::ceil(m_maxY)));
+  return Rect(m_clip.x + x1, m_clip.y + y1, x2 - x1, y2 - y1).createIntersection(m_clip);
+}
+
+void PathRasterizer::rasterize(const SpanFunc& func)
+{
+  if (m_edges.empty() || m_clip.isEmpty())
+    return;
+
+  const int w = m_clip.w;
+  m_cells.assign(w + 2, 0.0f);
+  m_coverage.resize(w);
+  m_active.clear();
+
+  std::sort(m_edges.begin(), m_edges.end(), [](const Edge& a, const Edge& b) {
+    return a.y0 < b.y0;
+  });
+
+  const int nedges = int(m_edges.size());
+  const int yBegin = std::max(0, int(std::floor(m_minY)));
+  const int yEnd = std::min(m_clip.h, int(std::ceil(m_maxY)));
+  int next = 0;
+
+  for (int y = yBegin; y < yEnd; ++y) {
+    const float fy = float(y);
+
+    // Update the list of active edges
+    m_active.erase(std::remove_if(m_active.begin(),
+                                  m_active.end(),
+                                  [this, fy](const int i) { return m_edges[i].y1 <= fy; }),
+                   m_active.end());
+    for (; next < nedges && m_edges[next].y0 < fy + 1.0f; ++next) {
+      if (m_edges[next].y1 > fy)
+        m_active.push_back(next);
+    }
+    if (m_active.empty()) {
+      if (next == nedges)
+        break;
+      // Jump to the row of the next edge
+      y = std::max(y, int(std::floor(m_edges[next].y0)) - 1);
+      continue;
+    }
+
+    // Accumulate the area of each edge in the cells of this row
+    m_minCell = INT_MAX;
+    m_maxCell = -1;
+    for (const int i : m_active) {
+      const Edge& e = m_edges[i];
+      const float ya = std::max(e.y0, fy);
+      const float yb = std::min(e.y1, fy + 1.0f);
+      if (yb <= ya)
+        continue;
+
+      const float xa = std::clamp(e.x0 + (ya - e.y0) * e.dxdy, 0.0f, float(w));
+      const float xb = std::clamp(e.x0 + (yb - e.y0) * e.dxdy, 0.0f, float(w));
+      accumulate(xa, xb, (yb - ya) * e.dir);
+    }
+    if (m_maxCell < 0)
+      continue;
+
+    // Prefix sum of the cells to get the coverage of each pixel. The
+    // total sum of a row is zero, so pixels after m_maxCell are not
+    // covered.
+    const int x1 = m_minCell;
+    const int x2 = std::min(m_maxCell + 1, w);
+    const float* cells = m_cells.data();
+    uint8_t* cov = m_coverage.data();
+    float acc = 0.0f;
+    uint8_t c = 0;
+    int first = -1;
+    int last = -1;
+    for (int x = x1; x < x2;) {
+      acc += cells[x];
+      c = coverage(acc);
+      cov[x++] = c;
+
+      // Cells without edges have the same coverage as the previous
+      // one (e.g. the inside of the shape)
+      const int runBegin = x;
+      while (x < x2 && cells[x] == 0.0f)
+        ++x;
+      if (x > runBegin)
+        std::fill(cov + runBegin, cov + x, c);
+
+      if (c) {
+        if (first < 0)
+          first = runBegin - 1;
+        last = x - 1;
+      }
+    }
+    std::fill(m_cells.begin() + x1, m_cells.begin() + m_maxCell + 1, 0.0f);
+
+    if (first >= 0)
+      func(m_clip.x + first, m_clip.y + y, last - first + 1, &m_coverage[first]);
+  }
+}
+
+void PathRasterizer::addLine(PointF p0, PointF p1)
+{
+  // Relative to the clip origin
+  float ax = p0.x - m_clip.x;
+  float ay = p0.y - m_clip.y;
+  float bx = p1.x - m_clip.x;
+  float by = p1.y - m_clip.y;
+  const float w = float(m_clip.w);
+
+  if (ay == by || !std::isfinite(ax + ay + bx + by))
+    return;
+  if (std::max(ay, by) <= 0.0f || std::min(ay, by) >= float(m_clip.h))
+    return;
+
+  // Edges outside the clip cover everything at their right side, so
+  // they are converted to vertical edges at x=0 or x=w (edges at x=w
+  // don't cover visible pixels but they are needed to know where
+  // each row ends).
+  if (ax <= 0.0f && bx <= 0.0f) {
+    addEdge(0.0f, ay, 0.0f, by);
+    return;
+  }
+  if (ax >= w && bx >= w) {
+    addEdge(w, ay, w, by);
+    return;
+  }
+  if (ax < 0.0f || bx < 0.0f) {
+    const float ty = ay + (0.0f - ax) * (by - ay) / (bx - ax);
+    if (ax < 0.0f) {
+      addEdge(0.0f, ay, 0.0f, ty);
+      ax = 0.0f;
+      ay = ty;
+    }
+    else {
+      addEdge(0.0f, ty, 0.0f, by);
+      bx = 0.0f;
+      by = ty;
+    }
+  }
+  if (ax > w || bx > w) {
+    const float ty = ay + (w - ax) * (by - ay) / (bx - ax);
+    if (ax > w) {
+      addEdge(w, ay, w, ty);
+      ax = w;
+      ay = ty;
+    }
+    else {
+      addEdge(w, ty, w, by);
+      bx = w;
+      by = ty;
+    }
+  }
+  addEdge(ax, ay, bx, by);
+}
+
+void PathRasterizer::addEdge(float x0, float y0, float x1, float y1)
+{
+  if (y0 == y1)
+    return;
+
+  Edge e;
+  if (y0 < y1) {
+    e = Edge{ x0, y0, x1, y1, 0.0f, 1.0f };
+  }
+  else {
+    e = Edge{ x1, y1, x0, y0, 0.0f, -1.0f };
+  }
+  e.dxdy = (e.x1 - e.x0) / (e.y1 - e.y0);
+  m_edges.push_back(e);
+
+  m_minY = std::min(m_minY, e.y0);
+  m_maxY = std::max(m_maxY, e.y1);
+}
+
+void PathRasterizer::flatten(const Path& path, const Matrix* matrix, const float tolerance)
+{
+  m_polyPoints.clear();
+  m_polylines.clear();
+
+  int begin = -1;
+  auto map = [matrix](const PointF& pt) -> PointF {
+    return (matrix ? matrix->mapPoint(pt) : pt);
+  };
+  auto addPoint = [this, &begin](const PointF& pt) {
+    if (begin < 0 || !same_point(m_polyPoints.back(), pt))
+      m_polyPoints.push_back(pt);
+  };
+  auto endPolyline = [this, &begin](const bool closed) {
+    if (begin < 0)
+      return;
+    int end = int(m_polyPoints.size());
+    if (closed && end - begin > 1 && same_point(m_polyPoints[end - 1], m_polyPoints[begin])) {
+      m_polyPoints.pop_back();
+      --end;
+    }
+    m_polylines.push_back(Polyline{ begin, end, closed });
+    begin = -1;
+  };
+
+  auto addCubic = [this, addPoint, tolerance](const PointF& p1,
+                                              const PointF& p2,
+                                              const PointF& p3) {
+    ASSERT(!m_polyPoints.empty());
+    const PointF p0 = m_polyPoints.back();
+
+    // The flattening error of n uniform steps is bounded by
+    // 3/4 * max|second difference| / n^2
+    const float dd = std::max(length(p0.x - 2 * p1.x + p2.x, p0.y - 2 * p1.y + p2.y),
+                              length(p1.x - 2 * p2.x + p3.x, p1.y - 2 * p2.y + p3.y));
+    const int n = std::clamp(int(std::ceil(std::sqrt(0.75f * dd / tolerance))),
+                             1,
+                             kMaxCubicLines);
+    for (int i = 1; i < n; ++i) {
+      const float t = float(i) / n;
+      const float mt = 1.0f - t;
+      const float a = mt * mt * mt;
+      const float b = 3.0f * mt * mt * t;
+      const float c = 3.0f * mt * t * t;
+      const float d = t * t * t;
+      addPoint(PointF(a * p0.x + b * p1.x + c * p2.x + d * p3.x,
+                      a * p0.y + b * p1.y + c * p2.y + d * p3.y));
+    }
+    addPoint(p3);
+  };
+
+#if LAF_SKIA
+  // Quadratic curves (w=1) and conics (used by SkPath for ovals and
+  // rounded rectangles) are only generated by SkPath.
+  auto addConic = [this, addPoint, tolerance](const PointF& p1,
+                                              const PointF& p2,
+                                              const float w) {
+    ASSERT(!m_polyPoints.empty());
+    const PointF p0 = m_polyPoints.back();
+
+    // The flattening error of a quadratic curve with n uniform steps
+    // is |second difference| / (4*n^2), conics with w > 1 are more
+    // curved.
+    const float dd = length(p0.x - 2 * p1.x + p2.x, p0.y - 2 * p1.y + p2.y) * std::max(w, 1.0f);
+    const int n = std::clamp(int(std::ceil(std::sqrt(0.25f * dd / tolerance))),
+                             1,
+                             kMaxCubicLines);
+    for (int i = 1; i < n; ++i) {
+      const float t = float(i) / n;
+      const float mt = 1.0f - t;
+      const float a = mt * mt;
+      const float b = 2.0f * w * mt * t;
+      const float c = t * t;
+      const float d = a + b + c;
+      addPoint(PointF((a * p0.x + b * p1.x + c * p2.x) / d, (a * p0.y + b * p1.y + c * p2.y) / d));
+    }
+    addPoint(p2);
+  };
+  auto pointF = [](const SkPoint& pt) { return PointF(pt.x(), pt.y()); };
+
+  SkPath::Iter iter(path.skPath(), false);
+  SkPoint pts[4];
+  SkPath::Verb verb;
+  while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+    switch (verb) {
+      case SkPath::kMove_Verb:
+        endPolyline(false);
+        begin = int(m_polyPoints.size());
+        m_polyPoints.push_back(map(pointF(pts[0])));
+        break;
+
+      case SkPath::kLine_Verb: addPoint(map(pointF(pts[1]))); break;
+
+      case SkPath::kQuad_Verb:
+        addConic(map(pointF(pts[1])), map(pointF(pts[2])), 1.0f);
+        break;
+
+      case SkPath::kConic_Verb:
+        addConic(map(pointF(pts[1])), map(pointF(pts[2])), iter.conicWeight());
+        break;
+
+      case SkPath::kCubic_Verb:
+        addCubic(map(pointF(pts[1])), map(pointF(pts[2])), map(pointF(pts[3])));
+        break;
+
+      case SkPath::kClose_Verb: endPolyline(true); break;
+
+      default: break;
+    }
+  }
+#else
+  const PointF* pt = path.points().data();
+  for (const Path::Verb verb : path.verbs()) {
+    switch (verb) {
+      case Path::Verb::Move:
+        endPolyline(false);
+        begin = int(m_polyPoints.size());
+        m_polyPoints.push_back(map(*pt));
+        ++pt;
+        break;
+
+      case Path::Verb::Line:
+        addPoint(map(*pt));
+        ++pt;
+        break;
+
+      case Path::Verb::Cubic:
+        addCubic(map(pt[0]), map(pt[1]), map(pt[2]));
+        pt += 3;
+        break;
+
+      case Path::Verb::Close: endPolyline(true); break;
+    }
+  }
+#endif
+  endPolyline(false);
+}
+
+void PathRasterizer::strokePolyline(const Polyline& poly,
+                                    const float halfWidth,
+                                    const Matrix& matrix)
+{
+  const int n = poly.end - poly.begin;
+  if (n < 2)
+    return;
+
+  const PointF* pts = &m_polyPoints[poly.begin];
+  const int segments = (poly.closed ? n : n - 1);
+
+  // One quad for each segment (all polygons are added with the same
+  // orientation, so they are merged with the non-zero winding rule)
+  for (int i = 0; i < segments; ++i) {
+    const PointF& a = pts[i];
+    const PointF& b = pts[(i + 1) % n];
+    const float len = length(b.x - a.x, b.y - a.y);
+    if (len == 0.0f)
+      continue;
+    const float nx = -(b.y - a.y) / len * halfWidth;
+    const float ny = (b.x - a.x) / len * halfWidth;
+    const PointF quad[4] = {
+      PointF(a.x + nx, a.y + ny),
+      PointF(b.x + nx, b.y + ny),
+      PointF(b.x - nx, b.y - ny),
+      PointF(a.x - nx, a.y - ny),
+    };
+    addTransformedPolygon(matrix, quad, 4);
+  }
+
+  // Miter joins (or bevel joins if the miter limit is exceeded)
+  const int v0 = (poly.closed ? 0 : 1);
+  const int v1 = (poly.closed ? n : n - 1);
+  for (int v = v0; v < v1; ++v) {
+    const PointF& prev = pts[(v + n - 1) % n];
+    const PointF& cur = pts[v];
+    const PointF& next = pts[(v + 1) % n];
+
+    const float len0 = length(cur.x - prev.x, cur.y - prev.y);
+    const float len1 = length(next.x - cur.x, next.y - cur.y);
+    if (len0 == 0.0f || len1 == 0.0f)
+      continue;
+
+    const float d0x = (cur.x - prev.x) / len0;
+    const float d0y = (cur.y - prev.y) / len0;
+    const float d1x = (next.x - cur.x) / len1;
+    const float d1y = (next.y - cur.y) / len1;
+    const float cross = d0x * d1y - d0y * d1x;
+    const float dot = d0x * d1x + d0y * d1y;
+    if (std::fabs(cross) < 1e-6f)
+      continue;
+
+    // Normals at the outer side of the turn
+    const float s = (cross > 0.0f ? -halfWidth : halfWidth);
+    const float n0x = -d0y * s;
+    const float n0y = d0x * s;
+    const float n1x = -d1y * s;
+    const float n1y = d1x * s;
+
+    const PointF a(cur.x + n0x, cur.y + n0y);
+    const PointF b(cur.x + n1x, cur.y + n1y);
+
+    // The miter length is 1/cos(theta/2) (theta = angle between
+    // normals), and 1+cos(theta) = 2*cos(theta/2)^2.
+    if (1.0f + dot >= 2.0f / (kMiterLimit * kMiterLimit)) {
+      const float k = 1.0f / (1.0f + dot);
+      const PointF m(cur.x + (n0x + n1x) * k, cur.y + (n0y + n1y) * k);
+      const PointF join[4] = { cur, a, m, b };
+      addTransformedPolygon(matrix, join, 4);
+    }
+    else {
+      const PointF join[3] = { cur, a, b };
+      addTransformedPolygon(matrix, join, 3);
+    }
+  }
+}
+
+void PathRasterizer::addTransformedPolygon(const Matrix& matrix, const PointF* pts, int count)
+{
+  ASSERT(count <= 4);
+  PointF dst[4];
+  matrix.mapPoints(dst, pts, count);
+  if (signed_area(dst, count) < 0.0f)
+    std::reverse(dst, dst + count);
+  addPolygon(dst, count);
+}
+
+// Adds the signed area covered by a line from (xa, row top) to (xb,
+// row bottom) with height "d" to the cells of the current row. The
+// cell at the left of the line receives the partial area and the
+// cell after the line receives the rest (so the prefix sum of all
+// cells at the right of the line is "d").
+void PathRasterizer::accumulate(const float xa, const float xb, const float d)
+{
+  const float x0 = std::min(xa, xb);
+  const float x1 = std::max(xa, xb);
+  const float x0floor = std::floor(x0);
+  const int x0i = int(x0floor);
+  const float x1ceil = std::ceil(x1);
+  const int x1i = int(x1ceil);
+  float* cells = m_cells.data();
+
+  if (x1i <= x0i + 1) {
+    // The line is inside one cell
+    const float xmf = 0.5f * (xa + xb) - x0floor;
+    cells[x0i] += d - d * xmf;
+    cells[x0i + 1] += d * xmf;
+    m_maxCell = std::max(m_maxCell, x0i + 1);
+  }
+  else {
+    const float s = 1.0f / (x1 - x0);
+    const float x0f = x0 - x0floor;
+    const float a0 = 0.5f * s * (1.0f - x0f) * (1.0f - x0f);
+    const float x1f = x1 - x1ceil + 1.0f;
+    const float am = 0.5f * s * x1f * x1f;
+
+    cells[x0i] += d * a0;
+    if (x1i == x0i + 2) {
+      cells[x0i + 1] += d * (1.0f - a0 - am);
+    }
+    else {
+      const float a1 = s * (1.5f - x0f);
+      cells[x0i + 1] += d * (a1 - a0);
+      for (int x = x0i + 2; x < x1i - 1; ++x)
+        cells[x] += d * s;
+      const float a2 = a1 + float(x1i - x0i - 3) * s;
+      cells[x1i - 1] += d * (1.0f - a2 - am);
+    }
+    cells[x1i] += d * am;
+    m_maxCell = std::max(m_maxCell, x1i);
+  }
+  m_minCell = std::min(m_minCell, x0i);
+}
+
+uint8_t PathRasterizer::coverage(float area) const
+{
+  area = std::fabs(area);
+  if (m_fillType == Path::FillType::EvenOdd) {
+    area = std::fmod(area, 2.0f);
+    if (area > 1.0f)
+      area = 2.0f - area;
+  }
+  else {
+    area = std::min(area, 1.0f);
+  }
+
+  if (!m_antialias)
+    return (area >= 0.5f ? 255 : 0);
+  return uint8_t(area * 255.0f + 0.5f);
+}
+
+} // namespace gfx
@@ -0,0 +1,126 @@
+// LAF Gfx Library
+// Copyright (c) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef GFX_PATH_RASTERIZER_H_INCLUDED
+#define GFX_PATH_RASTERIZER_H_INCLUDED
+#pragma once
+
+#include "gfx/matrix.h"
+#include "gfx/path.h"
+#include "gfx/point.h"
+#include "gfx/rect.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace gfx {
+
+// Anti-aliased scanline rasterizer for gfx::Path used by the "none"
+// backend. With Skia, SkCanvas does this work, but the rasterizer is
+// compiled anyway to compare both (see path_rasterizer_tests.cpp and
+// the laf-benchmarks).
+//
+// Paths are flattened to line edges in device space. Then each
+// scanline accumulates the exact signed area covered by its active
+// edges in a row of cells, and a prefix sum of those cells gives the
+// coverage of each pixel. Only rows and columns touched by edges are
+// visited, so the memory used is proportional to the clip width and
+// the number of edges (not to the clip area).
+//
+// Usage:
+//
+//   gfx::PathRasterizer rasterizer;
+//   rasterizer.reset(clipBounds);
+//   rasterizer.addPath(path, matrix);
+//   rasterizer.rasterize([](int x, int y, int len, const uint8_t* coverage) {
+//     // blend the color with the given coverage in pixels [x, x+len) of row y
+//   });
+//
+class PathRasterizer {
+public:
+  // Called for each scanline with coverage in [x, x+len). Coverage
+  // values are 0-255 (the span can contain zeros in the middle).
+  using SpanFunc = std::function<void(int x, int y, int len, const uint8_t* coverage)>;
+
+  PathRasterizer();
+
+  // Removes all edges and sets the clipping bounds in device
+  // coordinates (pixels outside the clip are never generated).
+  void reset(const Rect& clip);
+  const Rect& clip() const { return m_clip; }
+
+  // Without antialiasing, each pixel is fully covered or not covered
+  // at all (when less than half of its area is covered).
+  bool antialias() const { return m_antialias; }
+  void antialias(const bool state) { m_antialias = state; }
+
+  // The fill type is taken from the last added path (strokes always
+  // use the non-zero winding rule).
+  Path::FillType fillType() const { return m_fillType; }
+  void fillType(const Path::FillType fillType) { m_fillType = fillType; }
+
+  // Adds the edges to fill the given path transformed by the matrix.
+  void addPath(const Path& path, const Matrix& matrix = Matrix());
+
+  // Adds the edges to stroke the given path with butt caps and miter
+  // joins (like SkPaint defaults). The stroke width is in path
+  // coordinates (it's transformed by the matrix too), a width <= 0
+  // draws a 1 pixel hairline.
+  void addStroke(const Path& path, const Matrix& matrix, float strokeWidth);
+
+  // Adds a closed polygon in device coordinates.
+  void addPolygon(const PointF* pts, int count);
+
+  bool isEmpty() const { return m_edges.empty(); }
+
+  // Bounds of the pixels that can be touched by rasterize().
+  Rect bounds() const;
+
+  // Generates the coverage spans (from top to bottom) for all added
+  // edges. Edges are kept, so rasterize() can be called again.
+  void rasterize(const SpanFunc& func);
+
+private:
+  struct Edge {
+    // Relative to the clip origin, always y0 < y1
+    float x0, y0, x1, y1;
+    float dxdy;
+    float dir; // +1 (downwards) or -1 (upwards)
+  };
+
+  // A flattened contour in m_polyPoints
+  struct Polyline {
+    int begin, end;
+    bool closed;
+  };
+
+  void addLine(PointF p0, PointF p1);
+  void addEdge(float x0, float y0, float x1, float y1);
+  void flatten(const Path& path, const Matrix* matrix, float tolerance);
+  void strokePolyline(const Polyline& poly, float halfWidth, const Matrix& matrix);
+  void addTransformedPolygon(const Matrix& matrix, const PointF* pts, int count);
+  void accumulate(float xa, float xb, float d);
+  uint8_t coverage(float area) const;
+
+  Rect m_clip;
+  bool m_antialias = true;
+  Path::FillType m_fillType = Path::FillType::Winding;
+  std::vector<Edge> m_edges;
+  float m_minY, m_maxY;
+
+  // Scratch buffers reused between calls
+  std::vector<PointF> m_polyPoints;
+  std::vector<Polyline> m_polylines;
+  std::vector<float> m_cells;
+  std::vector<uint8_t> m_coverage;
+  std::vector<int> m_active;
+  int m_minCell, m_maxCell;
+};
+
+} // namespace gfx
+
+#endif
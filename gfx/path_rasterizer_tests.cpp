@@ -0,0 +1,408 @@
+// LAF Gfx Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <gtest/gtest.h>
+
+#include "gfx/matrix.h"
+#include "gfx/path.h"
+#include "gfx/path_rasterizer.h"
+
+#if LAF_SKIA
+  #include "include/core/SkBitmap.h"
+  #include "include/core/SkCanvas.h"
+  #include "include/core/SkPaint.h"
+#endif
+
+#include <cmath>
+#include <vector>
+
+using namespace gfx;
+
+namespace {
+
+// Rasterizes the edges in an 8-bit coverage mask of the clip size.
+class Mask {
+public:
+  Mask(PathRasterizer& rasterizer) : m_rc(rasterizer.clip()), m_data(m_rc.w * m_rc.h, 0)
+  {
+    rasterizer.rasterize([this](int x, int y, int len, const uint8_t* coverage) {
+      ASSERT_TRUE(m_rc.contains(Rect(x, y, len, 1)));
+      std::copy(coverage, coverage + len, &m_data[(y - m_rc.y) * m_rc.w + x - m_rc.x]);
+    });
+  }
+
+  int at(int x, int y) const { return m_data[(y - m_rc.y) * m_rc.w + x - m_rc.x]; }
+
+  // Total covered area in pixels
+  double area() const
+  {
+    double sum = 0.0;
+    for (const uint8_t v : m_data)
+      sum += v / 255.0;
+    return sum;
+  }
+
+private:
+  Rect m_rc;
+  std::vector<uint8_t> m_data;
+};
+
+// Winding number of the closed polygon around the given point.
+int winding_number(const std::vector<PointF>& poly, const float x, const float y)
+{
+  int winding = 0;
+  for (size_t i = 0; i < poly.size(); ++i) {
+    const PointF& a = poly[i];
+    const PointF& b = poly[(i + 1) % poly.size()];
+    if ((a.y <= y) != (b.y <= y)) {
+      const float t = (y - a.y) / (b.y - a.y);
+      if (x < a.x + t * (b.x - a.x))
+        winding += (a.y < b.y ? 1 : -1);
+    }
+  }
+  return winding;
+}
+
+// Reference coverage of the pixel (x, y) computed with 16x16 samples.
+int reference_coverage(const std::vector<PointF>& poly,
+                       const Path::FillType fillType,
+                       const int x,
+                       const int y)
+{
+  constexpr int kSamples = 16;
+  int inside = 0;
+  for (int v = 0; v < kSamples; ++v) {
+    for (int u = 0; u < kSamples; ++u) {
+      const int w = winding_number(poly,
+                                   x + (u + 0.5f) / kSamples,
+                                   y + (v + 0.5f) / kSamples);
+      if (fillType == Path::FillType::EvenOdd ? (w & 1) : (w != 0))
+        ++inside;
+    }
+  }
+  return (inside * 255 + kSamples * kSamples / 2) / (kSamples * kSamples);
+}
+
+} // anonymous namespace
+
+TEST(Path, Basics)
+{
+  Path path;
+  EXPECT_TRUE(path.isEmpty());
+  EXPECT_EQ(RectF(), path.bounds());
+
+  path.moveTo(1, 2).lineTo(5, 2).lineTo(5, 8).close();
+  EXPECT_FALSE(path.isEmpty());
+  EXPECT_EQ(RectF(1, 2, 4, 6), path.bounds());
+
+  path.offset(10, 10);
+  EXPECT_EQ(RectF(11, 12, 4, 6), path.bounds());
+
+  path.transform(Matrix::MakeScale(2));
+  EXPECT_EQ(RectF(22, 24, 8, 12), path.bounds());
+
+  path.rewind();
+  EXPECT_TRUE(path.isEmpty());
+}
+
+TEST(Path, TightBounds)
+{
+  Path path;
+  path.oval(Rect(10, 20, 30, 40));
+  const RectF bounds = path.bounds();
+  EXPECT_NEAR(10.0, bounds.x, 1e-4);
+  EXPECT_NEAR(20.0, bounds.y, 1e-4);
+  EXPECT_NEAR(30.0, bounds.w, 1e-4);
+  EXPECT_NEAR(40.0, bounds.h, 1e-4);
+
+  // Control points are outside the curve
+  path.rewind();
+  path.moveTo(0, 0).cubicTo(0, 10, 10, 10, 10, 0);
+  EXPECT_NEAR(7.5, path.bounds().h, 1e-4);
+}
+
+TEST(PathRasterizer, IntegerRect)
+{
+  Path path;
+  path.rect(Rect(2, 3, 4, 5));
+
+  PathRasterizer rasterizer;
+  rasterizer.reset(Rect(0, 0, 10, 10));
+  rasterizer.addPath(path);
+  EXPECT_EQ(Rect(2, 3, 5, 5), rasterizer.bounds());
+
+  Mask mask(rasterizer);
+  for (int y = 0; y < 10; ++y) {
+    for (int x = 0; x < 10; ++x) {
+      const bool inside = (x >= 2 && x < 6 && y >= 3 && y < 8);
+      EXPECT_EQ(inside ? 255 : 0, mask.at(x, y)) << x << "," << y;
+    }
+  }
+}
+
+TEST(PathRasterizer, HalfPixelRect)
+{
+  Path path;
+  path.moveTo(1.5f, 1.5f).lineTo(4.5f, 1.5f).lineTo(4.5f, 3).lineTo(1.5f, 3).close();
+
+  PathRasterizer rasterizer;
+  rasterizer.reset(Rect(0, 0, 8, 8));
+  rasterizer.addPath(path);
+
+  Mask mask(rasterizer);
+  EXPECT_EQ(64, mask.at(1, 1));
+  EXPECT_EQ(128, mask.at(2, 1));
+  EXPECT_EQ(128, mask.at(1, 2));
+  EXPECT_EQ(255, mask.at(2, 2));
+  EXPECT_EQ(128, mask.at(4, 2));
+  EXPECT_EQ(0, mask.at(5, 2));
+  EXPECT_EQ(0, mask.at(2, 3));
+  EXPECT_NEAR(4.5, mask.area(), 0.02);
+
+  rasterizer.antialias(false);
+  Mask aliased(rasterizer);
+  EXPECT_EQ(0, aliased.at(1, 1));
+  EXPECT_EQ(255, aliased.at(1, 2));
+}
+
+TEST(PathRasterizer, CircleArea)
+{
+  Path path;
+  path.oval(Rect(10, 10, 80, 80));
+
+  PathRasterizer rasterizer;
+  rasterizer.reset(Rect(0, 0, 100, 100));
+  rasterizer.addPath(path);
+
+  Mask mask(rasterizer);
+  // The flattened circle is a bit smaller than the real one
+  EXPECT_NEAR(M_PI * 40 * 40, mask.area(), 25.0);
+  EXPECT_EQ(255, mask.at(50, 50));
+  EXPECT_EQ(0, mask.at(12, 12));
+}
+
+TEST(PathRasterizer, SupersampledReference)
+{
+  // A hexagon, a pentagram (self-intersecting, so the fill type
+  // matters) and a random polygon, compared pixel by pixel with a
+  // supersampled reference.
+  std::vector<PointF> hexagon, star, random;
+  for (int i = 0; i < 6; ++i) {
+    const double angle = 0.2 + i * M_PI / 3.0;
+    hexagon.push_back(PointF(32 + 27.5 * std::cos(angle), 32 + 27.5 * std::sin(angle)));
+  }
+  for (int i = 0; i < 5; ++i) {
+    const double angle = 0.3 + i * 4.0 * M_PI / 5.0;
+    star.push_back(PointF(32 + 28 * std::cos(angle), 32 + 28 * std::sin(angle)));
+  }
+  uint32_t seed = 1;
+  for (int i = 0; i < 12; ++i) {
+    seed = seed * 1103515245 + 12345;
+    const float x = float((seed >> 8) % 6400) / 100.0f;
+    seed = seed * 1103515245 + 12345;
+    const float y = float((seed >> 8) % 6400) / 100.0f;
+    random.push_back(PointF(x, y));
+  }
+
+  for (const auto* poly : { &hexagon, &star, &random }) {
+    for (const auto fillType : { Path::FillType::Winding, Path::FillType::EvenOdd }) {
+      Path path;
+      path.fillType(fillType);
+      path.moveTo((*poly)[0].x, (*poly)[0].y);
+      for (size_t i = 1; i < poly->size(); ++i)
+        path.lineTo((*poly)[i].x, (*poly)[i].y);
+      path.close();
+
+      PathRasterizer rasterizer;
+      rasterizer.reset(Rect(0, 0, 64, 64));
+      rasterizer.addPath(path);
+      Mask mask(rasterizer);
+
+      // Pixels where edges cross are approximated (the signed areas
+      // of all edges are accumulated, like other analytic coverage
+      // rasterizers do), so we limit the number of those pixels and
+      // the mean error.
+      int outliers = 0;
+      double sumDiff = 0.0;
+      for (int y = 0; y < 64; ++y) {
+        for (int x = 0; x < 64; ++x) {
+          const int diff = std::abs(mask.at(x, y) - reference_coverage(*poly, fillType, x, y));
+          if (diff > 12)
+            ++outliers;
+          sumDiff += diff;
+        }
+      }
+      EXPECT_GE(poly == &hexagon ? 0 : 16, outliers);
+      EXPECT_GE(0.5, sumDiff / (64 * 64));
+    }
+  }
+}
+
+TEST(PathRasterizer, FillTypes)
+{
+  // Two nested squares with the same orientation
+  Path path;
+  path.rect(Rect(0, 0, 10, 10));
+  path.rect(Rect(3, 3, 4, 4));
+
+  PathRasterizer rasterizer;
+  rasterizer.reset(Rect(0, 0, 10, 10));
+  rasterizer.addPath(path);
+  EXPECT_EQ(255, Mask(rasterizer).at(5, 5));
+
+  path.fillType(Path::FillType::EvenOdd);
+  rasterizer.reset(Rect(0, 0, 10, 10));
+  rasterizer.addPath(path);
+  Mask mask(rasterizer);
+  EXPECT_EQ(0, mask.at(5, 5));
+  EXPECT_EQ(255, mask.at(1, 1));
+  EXPECT_NEAR(100 - 16, mask.area(), 0.01);
+}
+
+TEST(PathRasterizer, Clipping)
+{
+  // A triangle partially outside the clip at all sides
+  Path path;
+  path.moveTo(-20, -10).lineTo(40, 5).lineTo(-5, 30).close();
+
+  // Rasterize with a big clip to compare with a small clip
+  PathRasterizer rasterizer;
+  rasterizer.reset(Rect(-30, -30, 100, 100));
+  rasterizer.addPath(path);
+  Mask big(rasterizer);
+
+  rasterizer.reset(Rect(2, 1, 10, 12));
+  rasterizer.addPath(path);
+  Mask small(rasterizer);
+
+  for (int y = 1; y < 13; ++y)
+    for (int x = 2; x < 12; ++x)
+      EXPECT_NEAR(big.at(x, y), small.at(x, y), 1) << x << "," << y;
+}
+
+TEST(PathRasterizer, Transform)
+{
+  Path path;
+  path.rect(Rect(0, 0, 2, 3));
+
+  PathRasterizer rasterizer;
+  rasterizer.reset(Rect(0, 0, 20, 20));
+  Matrix m = Matrix::MakeScale(2);
+  m.postTranslate(4, 5);
+  rasterizer.addPath(path, m);
+  EXPECT_EQ(Rect(4, 5, 5, 6), rasterizer.bounds());
+
+  Mask mask(rasterizer);
+  EXPECT_NEAR(24.0, mask.area(), 0.01);
+  EXPECT_EQ(255, mask.at(4, 5));
+  EXPECT_EQ(0, mask.at(8, 5));
+
+  // Rotated 45 degrees the area is the same
+  rasterizer.reset(Rect(0, 0, 20, 20));
+  m.setRotate(45, 10, 10);
+  path.offset(8, 8);
+  rasterizer.addPath(path, m);
+  EXPECT_NEAR(6.0, Mask(rasterizer).area(), 0.05);
+}
+
+TEST(PathRasterizer, Stroke)
+{
+  // Horizontal line with a stroke of 2 pixels centered at y=5
+  Path path;
+  path.moveTo(2, 5).lineTo(8, 5);
+
+  PathRasterizer rasterizer;
+  rasterizer.reset(Rect(0, 0, 10, 10));
+  rasterizer.addStroke(path, Matrix(), 2.0f);
+  Mask mask(rasterizer);
+  EXPECT_NEAR(12.0, mask.area(), 0.01);
+  EXPECT_EQ(255, mask.at(2, 4));
+  EXPECT_EQ(255, mask.at(7, 5));
+  EXPECT_EQ(0, mask.at(8, 5));
+
+  // Closed square stroke: the corners are covered by miter joins
+  path.rewind();
+  path.rect(Rect(2, 2, 6, 6));
+  rasterizer.reset(Rect(0, 0, 10, 10));
+  rasterizer.addStroke(path, Matrix(), 2.0f);
+  Mask square(rasterizer);
+  EXPECT_NEAR(8 * 8 - 4 * 4, square.area(), 0.01);
+  EXPECT_EQ(255, square.at(1, 1));
+  EXPECT_EQ(0, square.at(5, 5));
+
+  // Hairline
+  path.rewind();
+  path.moveTo(0, 11).lineTo(20, 11);
+  rasterizer.reset(Rect(0, 0, 10, 10));
+  rasterizer.addStroke(path, Matrix::MakeScale(0.5f), 0.0f);
+  EXPECT_NEAR(10.0, Mask(rasterizer).area(), 0.01);
+}
+
+#if LAF_SKIA
+
+TEST(PathRasterizer, SkCanvasReference)
+{
+  // Curves (SkPath uses conics for ovals and rounded rectangles) and
+  // a stroke with miter joins, compared pixel by pixel with the
+  // SkCanvas output.
+  Path fill;
+  fill.oval(Rect(4, 4, 56, 40));
+  fill.roundedRect(Rect(8, 30, 48, 28), 6, 6);
+
+  Path stroke;
+  stroke.moveTo(3, 60).lineTo(30, 5).lineTo(60, 50).cubicTo(40, 60, 20, 40, 10, 62);
+
+  for (const float strokeWidth : { 0.0f, 3.0f }) {
+    const Path& path = (strokeWidth > 0.0f ? stroke : fill);
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::MakeA8(64, 64));
+    bitmap.eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas canvas(bitmap);
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    if (strokeWidth > 0.0f) {
+      paint.setStyle(SkPaint::kStroke_Style);
+      paint.setStrokeWidth(strokeWidth);
+    }
+    canvas.drawPath(path.skPath(), paint);
+
+    PathRasterizer rasterizer;
+    rasterizer.reset(Rect(0, 0, 64, 64));
+    if (strokeWidth > 0.0f)
+      rasterizer.addStroke(path, Matrix(), strokeWidth);
+    else
+      rasterizer.addPath(path);
+    Mask mask(rasterizer);
+
+    // SkCanvas coverage is supersampled, so we accept small
+    // differences in edge pixels.
+    int outliers = 0;
+    double sumDiff = 0.0;
+    for (int y = 0; y < 64; ++y) {
+      for (int x = 0; x < 64; ++x) {
+        const int diff = std::abs(mask.at(x, y) - int(*bitmap.getAddr8(x, y)));
+        if (diff > 32)
+          ++outliers;
+        sumDiff += diff;
+      }
+    }
+    EXPECT_GE(16, outliers) << "strokeWidth=" << strokeWidth;
+    EXPECT_GE(2.0, sumDiff / (64 * 64)) << "strokeWidth=" << strokeWidth;
+  }
+}
+
+#endif // LAF_SKIA
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
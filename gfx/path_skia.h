@@ -1,5 +1,5 @@
 // LAF Gfx Library
-// Copyright (c) 2020-2023  Igara Studio S.A.
+// Copyright (c) 2020-2025  Igara Studio S.A.
 //
 // This file is released under the terms of the MIT license.
 // Read LICENSE.txt for more information.
@@ -14,12 +14,16 @@
 
 #include "include/core/SkPath.h"
 
+#include <cstdint>
+
 namespace gfx {
 
 // Simple wrapper for SkPath
 // TODO add missing methods for curves
 class Path {
 public:
+  enum class FillType : uint8_t { Winding, EvenOdd };
+
   Path() {}
 
   Path& reset()
@@ -36,6 +40,18 @@ public:
 
   bool isEmpty() const { return m_skPath.isEmpty(); }
 
+  FillType fillType() const
+  {
+    return (m_skPath.getFillType() == SkPathFillType::kEvenOdd ? FillType::EvenOdd :
+                                                                  FillType::Winding);
+  }
+
+  void fillType(const FillType fillType)
+  {
+    m_skPath.setFillType(fillType == FillType::EvenOdd ? SkPathFillType::kEvenOdd :
+                                                         SkPathFillType::kWinding);
+  }
+
   Path& moveTo(float x, float y)
   {
     m_skPath.moveTo(x, y);
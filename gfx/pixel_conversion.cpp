@@ -0,0 +1,288 @@
+// LAF Gfx Library
+// Copyright (c) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "gfx/pixel_conversion.h"
+
+#include "base/simd.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace gfx {
+
+namespace {
+
+constexpr uint32_t kAlphaMask = 0xff000000;
+
+// Reciprocals to unpremultiply without divisions:
+//   (c * table[a] + 0x8000) >> 16 == round(c * 255 / a)
+// for all c and a in [0, 255] (exhaustively verified by the tests).
+struct UnpremulTable {
+  uint32_t recip[256];
+
+  UnpremulTable()
+  {
+    recip[0] = 0;
+    for (int a = 1; a < 256; ++a)
+      recip[a] = (255u << 16) / a + 1;
+  }
+};
+
+const UnpremulTable g_unpremul;
+
+inline uint32_t mul_un8(const uint32_t c, const uint32_t a)
+{
+  const uint32_t t = c * a + 128;
+  return (t + (t >> 8)) >> 8;
+}
+
+inline uint32_t premultiply_pixel(const uint32_t c)
+{
+  const uint32_t a = c >> 24;
+  if (a == 255)
+    return c;
+  if (a == 0)
+    return 0;
+  return (a << 24) | (mul_un8((c >> 16) & 0xff, a) << 16) | (mul_un8((c >> 8) & 0xff, a) << 8) |
+         mul_un8(c & 0xff, a);
+}
+
+inline uint32_t unpremultiply_pixel(const uint32_t c)
+{
+  const uint32_t a = c >> 24;
+  if (a == 255)
+    return c;
+  if (a == 0)
+    return 0;
+  const uint32_t r = g_unpremul.recip[a];
+  const uint32_t c0 = std::min<uint32_t>(255, ((c & 0xff) * r + 0x8000) >> 16);
+  const uint32_t c1 = std::min<uint32_t>(255, (((c >> 8) & 0xff) * r + 0x8000) >> 16);
+  const uint32_t c2 = std::min<uint32_t>(255, (((c >> 16) & 0xff) * r + 0x8000) >> 16);
+  return (a << 24) | (c2 << 16) | (c1 << 8) | c0;
+}
+
+inline int mask_shift(uint32_t mask)
+{
+  int shift = 0;
+  for (; mask && !(mask & 1); mask >>= 1)
+    ++shift;
+  return shift;
+}
+
+#if LAF_NEON
+// Returns true if all lanes are 0xffffffff (vminvq_u32() is only
+// available on arm64)
+inline bool all_lanes(const uint32x4_t m)
+{
+  const uint32x2_t t = vand_u32(vget_low_u32(m), vget_high_u32(m));
+  return (vget_lane_u32(t, 0) & vget_lane_u32(t, 1)) != 0;
+}
+#endif
+
+} // anonymous namespace
+
+void swizzle_rb(const uint32_t* src, uint32_t* dst, const int n)
+{
+  int i = 0;
+
+#if LAF_SSE2
+  const __m128i agMask = _mm_set1_epi32(0xff00ff00);
+  const __m128i rbMask = _mm_set1_epi32(0x00ff00ff);
+  for (; i + 4 <= n; i += 4) {
+    const __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+    const __m128i rb = _mm_and_si128(v, rbMask);
+    const __m128i br = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+    _mm_storeu_si128((__m128i*)(dst + i), _mm_or_si128(_mm_and_si128(v, agMask), br));
+  }
+#elif LAF_NEON
+  const uint32x4_t agMask = vdupq_n_u32(0xff00ff00);
+  const uint32x4_t rbMask = vdupq_n_u32(0x00ff00ff);
+  for (; i + 4 <= n; i += 4) {
+    const uint32x4_t v = vld1q_u32(src + i);
+    const uint32x4_t rb = vandq_u32(v, rbMask);
+    const uint32x4_t br = vreinterpretq_u32_u16(vrev32q_u16(vreinterpretq_u16_u32(rb)));
+    vst1q_u32(dst + i, vorrq_u32(vandq_u32(v, agMask), br));
+  }
+#endif
+
+  for (; i < n; ++i) {
+    const uint32_t c = src[i];
+    dst[i] = (c & 0xff00ff00) | ((c >> 16) & 0xff) | ((c & 0xff) << 16);
+  }
+}
+
+void premultiply_alpha(const uint32_t* src, uint32_t* dst, const int n)
+{
+  int i = 0;
+
+#if LAF_SSE2
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i half = _mm_set1_epi16(128);
+  const __m128i alphaMask = _mm_set1_epi32(kAlphaMask);
+  // Multiplies 2 pixels (8 x 16-bit components) by their alpha
+  auto mul = [zero, half](const __m128i v) {
+    __m128i a = _mm_shufflelo_epi16(v, _MM_SHUFFLE(3, 3, 3, 3));
+    a = _mm_shufflehi_epi16(a, _MM_SHUFFLE(3, 3, 3, 3));
+    const __m128i t = _mm_add_epi16(_mm_mullo_epi16(v, a), half);
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+  };
+  for (; i + 4 <= n; i += 4) {
+    const __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+    const __m128i lo = mul(_mm_unpacklo_epi8(v, zero));
+    const __m128i hi = mul(_mm_unpackhi_epi8(v, zero));
+    const __m128i r = _mm_packus_epi16(lo, hi);
+    // Keep the original alpha
+    _mm_storeu_si128((__m128i*)(dst + i),
+                     _mm_or_si128(_mm_andnot_si128(alphaMask, r), _mm_and_si128(v, alphaMask)));
+  }
+#elif LAF_NEON
+  const uint16x8_t half = vdupq_n_u16(128);
+  auto mul = [half](const uint8x8_t c, const uint8x8_t a) {
+    const uint16x8_t t = vaddq_u16(vmull_u8(c, a), half);
+    return vshrn_n_u16(vaddq_u16(t, vshrq_n_u16(t, 8)), 8);
+  };
+  for (; i + 8 <= n; i += 8) {
+    uint8x8x4_t v = vld4_u8((const uint8_t*)(src + i));
+    v.val[0] = mul(v.val[0], v.val[3]);
+    v.val[1] = mul(v.val[1], v.val[3]);
+    v.val[2] = mul(v.val[2], v.val[3]);
+    vst4_u8((uint8_t*)(dst + i), v);
+  }
+#endif
+
+  for (; i < n; ++i)
+    dst[i] = premultiply_pixel(src[i]);
+}
+
+void unpremultiply_alpha(const uint32_t* src, uint32_t* dst, const int n)
+{
+  int i = 0;
+
+#if LAF_SSE2
+  // Groups of opaque or fully transparent pixels (the most common
+  // case) are converted 4 pixels at a time
+  const __m128i alphaMask = _mm_set1_epi32(kAlphaMask);
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 4 <= n; i += 4) {
+    const __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+    const __m128i a = _mm_and_si128(v, alphaMask);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi32(a, alphaMask)) == 0xffff)
+      _mm_storeu_si128((__m128i*)(dst + i), v);
+    else if (_mm_movemask_epi8(_mm_cmpeq_epi32(a, zero)) == 0xffff)
+      _mm_storeu_si128((__m128i*)(dst + i), zero);
+    else {
+      for (int j = i; j < i + 4; ++j)
+        dst[j] = unpremultiply_pixel(src[j]);
+    }
+  }
+#elif LAF_NEON
+  const uint32x4_t alphaMask = vdupq_n_u32(kAlphaMask);
+  const uint32x4_t zero = vdupq_n_u32(0);
+  for (; i + 4 <= n; i += 4) {
+    const uint32x4_t v = vld1q_u32(src + i);
+    const uint32x4_t a = vandq_u32(v, alphaMask);
+    if (all_lanes(vceqq_u32(a, alphaMask)))
+      vst1q_u32(dst + i, v);
+    else if (all_lanes(vceqq_u32(a, zero)))
+      vst1q_u32(dst + i, zero);
+    else {
+      for (int j = i; j < i + 4; ++j)
+        dst[j] = unpremultiply_pixel(src[j]);
+    }
+  }
+#endif
+
+  for (; i < n; ++i)
+    dst[i] = unpremultiply_pixel(src[i]);
+}
+
+//////////////////////////////////////////////////////////////////////
+// PixelUnpacker
+
+PixelUnpacker::PixelUnpacker(const int bitsPerPixel, const PixelMasks& masks)
+  : m_bytesPerPixel(bitsPerPixel / 8)
+  , m_valid(bitsPerPixel == 16 || bitsPerPixel == 24 || bitsPerPixel == 32)
+{
+  initChannel(m_r, masks.r);
+  initChannel(m_g, masks.g);
+  initChannel(m_b, masks.b);
+  initChannel(m_a, masks.a);
+
+  for (const Channel* ch : { &m_r, &m_g, &m_b, &m_a }) {
+    if (ch->bits > 16)
+      m_valid = false;
+  }
+
+  const bool noAlpha = (masks.a == 0);
+  m_rgba = (bitsPerPixel == 32 && masks.r == 0xff && masks.g == 0xff00 && masks.b == 0xff0000 &&
+            (noAlpha || masks.a == kAlphaMask));
+  m_bgra = (bitsPerPixel == 32 && masks.r == 0xff0000 && masks.g == 0xff00 && masks.b == 0xff &&
+            (noAlpha || masks.a == kAlphaMask));
+}
+
+// static
+void PixelUnpacker::initChannel(Channel& ch, const uint32_t mask)
+{
+  ch.mask = mask;
+  ch.shift = mask_shift(mask);
+  ch.bits = 0;
+  for (uint32_t m = (mask >> ch.shift); m & 1; m >>= 1)
+    ++ch.bits;
+
+  if (ch.bits > 0 && ch.bits != 8 && ch.bits <= 16) {
+    const uint32_t max = (1u << ch.bits) - 1;
+    ch.table.resize(max + 1);
+    for (uint32_t v = 0; v <= max; ++v)
+      ch.table[v] = uint8_t((v * 255 + max / 2) / max);
+  }
+}
+
+// static
+inline uint32_t PixelUnpacker::get(const Channel& ch, const uint32_t value, const uint32_t missing)
+{
+  if (ch.bits == 0)
+    return missing;
+  const uint32_t v = (value & ch.mask) >> ch.shift;
+  return (ch.bits == 8 ? v : ch.table[v]);
+}
+
+void PixelUnpacker::unpack(const uint8_t* src, uint32_t* dst, const int n) const
+{
+  if (!m_valid)
+    return;
+
+  if (m_rgba || m_bgra) {
+    if (m_rgba) {
+      if (src != (const uint8_t*)dst)
+        std::memcpy(dst, src, 4 * n);
+    }
+    else {
+      swizzle_rb((const uint32_t*)src, dst, n);
+    }
+    if (m_a.bits == 0) {
+      for (int i = 0; i < n; ++i)
+        dst[i] |= kAlphaMask;
+    }
+    return;
+  }
+
+  for (int i = 0; i < n; ++i, src += m_bytesPerPixel) {
+    uint32_t value;
+    switch (m_bytesPerPixel) {
+      case 2:  value = src[0] | (src[1] << 8); break;
+      case 3:  value = src[0] | (src[1] << 8) | (src[2] << 16); break;
+      default: value = src[0] | (src[1] << 8) | (src[2] << 16) | (uint32_t(src[3]) << 24); break;
+    }
+    dst[i] = get(m_r, value, 0) | (get(m_g, value, 0) << 8) | (get(m_b, value, 0) << 16) |
+             (get(m_a, value, 255) << 24);
+  }
+}
+
+} // namespace gfx
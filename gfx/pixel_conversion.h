@@ -0,0 +1,83 @@
+// LAF Gfx Library
+// Copyright (c) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef GFX_PIXEL_CONVERSION_H_INCLUDED
+#define GFX_PIXEL_CONVERSION_H_INCLUDED
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace gfx {
+
+// Row-oriented pixel conversion kernels (with SSE2/NEON versions
+// when they're available). All functions convert "n" pixels, and
+// "src" and "dst" can point to the same buffer.
+
+// Bit masks of the RGBA components of 16, 24, or 32-bit pixels. A
+// component can use from 1 to 16 bits. Pixels without alpha mask are
+// opaque.
+struct PixelMasks {
+  uint32_t r = 0x000000ff;
+  uint32_t g = 0x0000ff00;
+  uint32_t b = 0x00ff0000;
+  uint32_t a = 0xff000000;
+
+  bool operator==(const PixelMasks& o) const
+  {
+    return r == o.r && g == o.g && b == o.b && a == o.a;
+  }
+  bool operator!=(const PixelMasks& o) const { return !operator==(o); }
+};
+
+// Swaps the R and B components, i.e. converts RGBA (gfx::Color
+// layout) to BGRA and vice versa.
+void swizzle_rb(const uint32_t* src, uint32_t* dst, int n);
+
+// Premultiplies/unpremultiplies the color components by the alpha
+// (which must be in the most significant byte, e.g. RGBA or BGRA).
+// Both functions round to the nearest integer:
+//
+//   premultiply:   c' = round(c * a / 255)
+//   unpremultiply: c' = min(255, round(c * 255 / a)), or 0 if a = 0
+//
+void premultiply_alpha(const uint32_t* src, uint32_t* dst, int n);
+void unpremultiply_alpha(const uint32_t* src, uint32_t* dst, int n);
+
+// Converts 16, 24, or 32-bit pixels (little-endian) with the given
+// component masks to straight RGBA (gfx::Color layout), scaling each
+// component to 8 bits with rounding (e.g. 5-bit 31 -> 255). Create
+// it once per image and call unpack() for each row.
+class PixelUnpacker {
+public:
+  PixelUnpacker(int bitsPerPixel, const PixelMasks& masks);
+
+  // Returns false if the format is not supported.
+  bool isValid() const { return m_valid; }
+
+  void unpack(const uint8_t* src, uint32_t* dst, int n) const;
+
+private:
+  struct Channel {
+    uint32_t mask = 0;
+    int shift = 0;
+    int bits = 0;
+    std::vector<uint8_t> table; // For components != 8 bits
+  };
+
+  static void initChannel(Channel& ch, uint32_t mask);
+  static uint32_t get(const Channel& ch, uint32_t value, uint32_t missing);
+
+  int m_bytesPerPixel;
+  Channel m_r, m_g, m_b, m_a;
+  bool m_valid;
+  bool m_rgba;  // Same layout as gfx::Color
+  bool m_bgra;  // Swapped R/B
+};
+
+} // namespace gfx
+
+#endif
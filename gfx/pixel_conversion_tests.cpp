@@ -0,0 +1,172 @@
+// LAF Gfx Library
+// Copyright (c) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <gtest/gtest.h>
+
+#include "gfx/color.h"
+#include "gfx/pixel_conversion.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace gfx;
+
+// All combinations of a component value and alpha (the number of
+// pixels is not a multiple of 4/8 to test the scalar tails too).
+static std::vector<uint32_t> all_pixels()
+{
+  std::vector<uint32_t> pixels;
+  for (uint32_t a = 0; a < 256; ++a)
+    for (uint32_t c = 0; c < 256; ++c)
+      pixels.push_back(rgba(c, 255 - c, c / 2, a));
+  pixels.push_back(rgba(1, 2, 3, 4));
+  pixels.push_back(rgba(5, 6, 7, 255));
+  pixels.push_back(rgba(8, 9, 10, 0));
+  return pixels;
+}
+
+TEST(PixelConversion, SwizzleRB)
+{
+  std::vector<uint32_t> src = all_pixels();
+  std::vector<uint32_t> dst(src.size());
+  swizzle_rb(src.data(), dst.data(), int(src.size()));
+  for (size_t i = 0; i < src.size(); ++i) {
+    EXPECT_EQ(getb(src[i]), getr(dst[i]));
+    EXPECT_EQ(getg(src[i]), getg(dst[i]));
+    EXPECT_EQ(getr(src[i]), getb(dst[i]));
+    EXPECT_EQ(geta(src[i]), geta(dst[i]));
+  }
+
+  // In-place
+  swizzle_rb(dst.data(), dst.data(), int(dst.size()));
+  EXPECT_EQ(src, dst);
+}
+
+TEST(PixelConversion, Premultiply)
+{
+  std::vector<uint32_t> src = all_pixels();
+  std::vector<uint32_t> dst(src.size());
+  premultiply_alpha(src.data(), dst.data(), int(src.size()));
+
+  auto mul = [](int c, int a) { return (c * a + 127) / 255; };
+  for (size_t i = 0; i < src.size(); ++i) {
+    const int a = geta(src[i]);
+    ASSERT_EQ(rgba(mul(getr(src[i]), a), mul(getg(src[i]), a), mul(getb(src[i]), a), a), dst[i])
+      << "pixel " << i;
+  }
+}
+
+TEST(PixelConversion, Unpremultiply)
+{
+  std::vector<uint32_t> src = all_pixels();
+  std::vector<uint32_t> dst(src.size());
+  unpremultiply_alpha(src.data(), dst.data(), int(src.size()));
+
+  auto div = [](int c, int a) { return (a == 0 ? 0 : std::min(255, (c * 255 + a / 2) / a)); };
+  for (size_t i = 0; i < src.size(); ++i) {
+    const int a = geta(src[i]);
+    ASSERT_EQ(rgba(div(getr(src[i]), a), div(getg(src[i]), a), div(getb(src[i]), a), a), dst[i])
+      << "pixel " << i;
+  }
+
+  // Unpremultiplying and premultiplying again must give the same
+  // premultiplied pixels
+  std::vector<uint32_t> back(dst.size());
+  premultiply_alpha(src.data(), dst.data(), int(src.size()));
+  unpremultiply_alpha(dst.data(), back.data(), int(dst.size()));
+  premultiply_alpha(back.data(), back.data(), int(back.size()));
+  EXPECT_EQ(dst, back);
+}
+
+TEST(PixelConversion, Unpack32)
+{
+  const uint32_t src[5] = { 0x11223344, 0x55667788, 0x99aabbcc, 0xddeeff00, 0x01020304 };
+  uint32_t dst[5];
+
+  PixelUnpacker rgba32(32, PixelMasks());
+  ASSERT_TRUE(rgba32.isValid());
+  rgba32.unpack((const uint8_t*)src, dst, 5);
+  EXPECT_TRUE(std::equal(src, src + 5, dst));
+
+  PixelMasks bgr;
+  bgr.r = 0xff0000;
+  bgr.b = 0xff;
+  bgr.a = 0;
+  PixelUnpacker bgrx32(32, bgr);
+  bgrx32.unpack((const uint8_t*)src, dst, 5);
+  EXPECT_EQ(0xff443322, dst[0]);
+  EXPECT_EQ(0xff040302, dst[4]);
+
+  // Non-standard layout (ARGB in the most significant bits)
+  PixelMasks argb;
+  argb.a = 0xff;
+  argb.r = 0xff00;
+  argb.g = 0xff0000;
+  argb.b = 0xff000000;
+  PixelUnpacker argb32(32, argb);
+  argb32.unpack((const uint8_t*)src, dst, 1);
+  EXPECT_EQ(rgba(0x33, 0x22, 0x11, 0x44), dst[0]);
+}
+
+TEST(PixelConversion, Unpack24)
+{
+  // Exactly 2 pixels, the last one must not be read as 4 bytes
+  const uint8_t src[6] = { 1, 2, 3, 4, 5, 6 };
+  uint32_t dst[2];
+  PixelMasks masks;
+  masks.a = 0;
+  PixelUnpacker unpacker(24, masks);
+  ASSERT_TRUE(unpacker.isValid());
+  unpacker.unpack(src, dst, 2);
+  EXPECT_EQ(rgba(1, 2, 3, 255), dst[0]);
+  EXPECT_EQ(rgba(4, 5, 6, 255), dst[1]);
+}
+
+TEST(PixelConversion, Unpack16)
+{
+  PixelMasks rgb565;
+  rgb565.r = 0xf800;
+  rgb565.g = 0x07e0;
+  rgb565.b = 0x001f;
+  rgb565.a = 0;
+  PixelUnpacker unpacker(16, rgb565);
+  ASSERT_TRUE(unpacker.isValid());
+
+  const uint16_t src[4] = { 0xffff, 0x0000, 0xf800, 0x0410 };
+  uint32_t dst[4];
+  unpacker.unpack((const uint8_t*)src, dst, 4);
+  EXPECT_EQ(rgba(255, 255, 255, 255), dst[0]);
+  EXPECT_EQ(rgba(0, 0, 0, 255), dst[1]);
+  EXPECT_EQ(rgba(255, 0, 0, 255), dst[2]);
+  EXPECT_EQ(rgba(0, 130, 16 * 255 / 31 + 1, 255), dst[3]); // Rounded
+
+  PixelMasks argb1555;
+  argb1555.a = 0x8000;
+  argb1555.r = 0x7c00;
+  argb1555.g = 0x03e0;
+  argb1555.b = 0x001f;
+  PixelUnpacker unpacker1555(16, argb1555);
+  const uint16_t src1555[2] = { 0x7fff, 0x8000 };
+  unpacker1555.unpack((const uint8_t*)src1555, dst, 2);
+  EXPECT_EQ(rgba(255, 255, 255, 0), dst[0]);
+  EXPECT_EQ(rgba(0, 0, 0, 255), dst[1]);
+}
+
+TEST(PixelConversion, InvalidFormats)
+{
+  EXPECT_FALSE(PixelUnpacker(8, PixelMasks()).isValid());
+  EXPECT_FALSE(PixelUnpacker(64, PixelMasks()).isValid());
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
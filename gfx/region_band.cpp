@@ -0,0 +1,417 @@
+// LAF Gfx Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "gfx/region.h"
+
+#include "base/debug.h"
+#include "gfx/point.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace gfx {
+
+using details::Box;
+
+Region::Region() : m_extents{ 0, 0, 0, 0 }
+{
+}
+
+Region::Region(const Region& copy)
+  : m_boxes(copy.m_boxes)
+  , m_bands(copy.m_bands)
+  , m_extents(copy.m_extents)
+{
+}
+
+Region::Region(const Rect& rect) : m_extents{ 0, 0, 0, 0 }
+{
+  operator=(rect);
+}
+
+Region::~Region()
+{
+}
+
+Region& Region::operator=(const Rect& rect)
+{
+  clear();
+  if (!rect.isEmpty()) {
+    m_extents = Box{ rect.x, rect.y, rect.x2(), rect.y2() };
+    m_boxes.push_back(m_extents);
+    m_bands.push_back(Band{ rect.y, rect.y2(), 0, 1 });
+  }
+  return *this;
+}
+
+Region& Region::operator=(const Region& copy)
+{
+  if (this != &copy) {
+    // Vector assignments reuse the already allocated memory
+    m_boxes = copy.m_boxes;
+    m_bands = copy.m_bands;
+    m_extents = copy.m_extents;
+  }
+  return *this;
+}
+
+Region::iterator Region::begin()
+{
+  iterator it;
+  it.m_ptr = m_boxes.data();
+  return it;
+}
+
+Region::iterator Region::end()
+{
+  iterator it;
+  it.m_ptr = m_boxes.data() + m_boxes.size();
+  return it;
+}
+
+Region::const_iterator Region::begin() const
+{
+  const_iterator it;
+  it.m_ptr = m_boxes.data();
+  return it;
+}
+
+Region::const_iterator Region::end() const
+{
+  const_iterator it;
+  it.m_ptr = m_boxes.data() + m_boxes.size();
+  return it;
+}
+
+Rect Region::bounds() const
+{
+  return Rect(m_extents.x1,
+              m_extents.y1,
+              m_extents.x2 - m_extents.x1,
+              m_extents.y2 - m_extents.y1);
+}
+
+void Region::clear()
+{
+  m_boxes.clear();
+  m_bands.clear();
+  m_extents = Box{ 0, 0, 0, 0 };
+}
+
+void Region::offset(int dx, int dy)
+{
+  if (isEmpty())
+    return;
+
+  for (Box& box : m_boxes) {
+    box.x1 += dx;
+    box.y1 += dy;
+    box.x2 += dx;
+    box.y2 += dy;
+  }
+  for (Band& band : m_bands) {
+    band.y1 += dy;
+    band.y2 += dy;
+  }
+  m_extents.x1 += dx;
+  m_extents.y1 += dy;
+  m_extents.x2 += dx;
+  m_extents.y2 += dy;
+}
+
+void Region::offset(const PointT<int>& delta)
+{
+  offset(delta.x, delta.y);
+}
+
+Region& Region::createIntersection(const Region& a, const Region& b)
+{
+  if (a.isEmpty() || b.isEmpty() || a.m_extents.x2 <= b.m_extents.x1 ||
+      b.m_extents.x2 <= a.m_extents.x1 || a.m_extents.y2 <= b.m_extents.y1 ||
+      b.m_extents.y2 <= a.m_extents.y1) {
+    clear();
+  }
+  else if (a.isRect() && b.isRect()) {
+    operator=(a.bounds().createIntersection(b.bounds()));
+  }
+  else {
+    combine(a, b, Op::Intersection);
+  }
+  return *this;
+}
+
+Region& Region::createUnion(const Region& a, const Region& b)
+{
+  if (a.isEmpty())
+    operator=(b);
+  else if (b.isEmpty())
+    operator=(a);
+  else if (a.isRect() && a.contains(b.bounds()) == In)
+    operator=(a);
+  else if (b.isRect() && b.contains(a.bounds()) == In)
+    operator=(b);
+  else
+    combine(a, b, Op::Union);
+  return *this;
+}
+
+Region& Region::createSubtraction(const Region& a, const Region& b)
+{
+  if (a.isEmpty() || (b.isRect() && b.contains(a.bounds()) == In)) {
+    clear();
+  }
+  else if (b.isEmpty() || a.m_extents.x2 <= b.m_extents.x1 || b.m_extents.x2 <= a.m_extents.x1 ||
+           a.m_extents.y2 <= b.m_extents.y1 || b.m_extents.y2 <= a.m_extents.y1) {
+    operator=(a);
+  }
+  else {
+    combine(a, b, Op::Subtraction);
+  }
+  return *this;
+}
+
+bool Region::contains(const PointT<int>& pt) const
+{
+  if (isEmpty() || pt.x < m_extents.x1 || pt.x >= m_extents.x2 || pt.y < m_extents.y1 ||
+      pt.y >= m_extents.y2)
+    return false;
+
+  auto band = std::upper_bound(m_bands.begin(),
+                               m_bands.end(),
+                               pt.y,
+                               [](const int y, const Band& band) { return y < band.y2; });
+  if (band == m_bands.end() || band->y1 > pt.y)
+    return false;
+
+  const Box* boxBegin = m_boxes.data() + band->begin;
+  const Box* boxEnd = m_boxes.data() + band->end;
+  const Box* box = std::upper_bound(boxBegin, boxEnd, pt.x, [](const int x, const Box& box) {
+    return x < box.x2;
+  });
+  return (box != boxEnd && box->x1 <= pt.x);
+}
+
+Region::Overlap Region::contains(const Rect& rect) const
+{
+  const int x1 = rect.x;
+  const int y1 = rect.y;
+  const int x2 = rect.x2();
+  const int y2 = rect.y2();
+
+  if (isEmpty() || rect.isEmpty() || x2 <= m_extents.x1 || x1 >= m_extents.x2 ||
+      y2 <= m_extents.y1 || y1 >= m_extents.y2)
+    return Out;
+
+  // Fast path for simple rectangular regions
+  if (isRect()) {
+    if (x1 >= m_extents.x1 && y1 >= m_extents.y1 && x2 <= m_extents.x2 && y2 <= m_extents.y2)
+      return In;
+    return Part;
+  }
+
+  bool partIn = false;
+  bool partOut = false;
+  int y = y1;
+
+  // First band that ends after the rect top
+  auto band = std::upper_bound(m_bands.begin(),
+                               m_bands.end(),
+                               y1,
+                               [](const int y, const Band& band) { return y < band.y2; });
+  for (; band != m_bands.end() && band->y1 < y2; ++band) {
+    // There is a vertical gap between bands
+    if (band->y1 > y)
+      partOut = true;
+    y = band->y2;
+
+    const Box* boxBegin = m_boxes.data() + band->begin;
+    const Box* boxEnd = m_boxes.data() + band->end;
+    const Box* box = std::upper_bound(boxBegin, boxEnd, x1, [](const int x, const Box& box) {
+      return x < box.x2;
+    });
+    if (box != boxEnd && box->x1 < x2) {
+      partIn = true;
+      if (box->x1 > x1 || box->x2 < x2)
+        partOut = true;
+    }
+    else {
+      partOut = true;
+    }
+
+    if (partIn && partOut)
+      return Part;
+  }
+  if (y < y2)
+    partOut = true;
+
+  if (partIn)
+    return (partOut ? Part : In);
+  return Out;
+}
+
+void Region::combine(const Region& a, const Region& b, const Op op)
+{
+  // The result is generated in these per-thread buffers (which keep
+  // their capacity between operations) because "a" or "b" can be
+  // "this" region. Then it's copied to m_boxes/m_bands (reusing
+  // their capacity too).
+  static thread_local std::vector<Box> boxes;
+  static thread_local std::vector<Band> bands;
+  boxes.clear();
+  bands.clear();
+
+  // Adds a band [y1, y2) with the result of the operation of two
+  // sets of spans (boxes of "a" and "b" in the same band).
+  auto addBand = [op](const int y1,
+                      const int y2,
+                      const Box* pa,
+                      const Box* aEnd,
+                      const Box* pb,
+                      const Box* bEnd) {
+    const uint32_t begin = uint32_t(boxes.size());
+    bool inA = false;
+    bool inB = false;
+    bool inside = false;
+    int start = 0;
+
+    while (true) {
+      if (op != Op::Union && pa == aEnd)
+        break;
+      if (op == Op::Intersection && pb == bEnd)
+        break;
+
+      const int xa = (pa != aEnd ? (inA ? pa->x2 : pa->x1) : INT_MAX);
+      const int xb = (pb != bEnd ? (inB ? pb->x2 : pb->x1) : INT_MAX);
+      if (xa == INT_MAX && xb == INT_MAX)
+        break;
+
+      const int x = std::min(xa, xb);
+      if (xa == x) {
+        if (inA)
+          ++pa;
+        inA = !inA;
+      }
+      if (xb == x) {
+        if (inB)
+          ++pb;
+        inB = !inB;
+      }
+
+      bool nowInside;
+      switch (op) {
+        case Op::Intersection: nowInside = (inA && inB); break;
+        case Op::Union:        nowInside = (inA || inB); break;
+        case Op::Subtraction:  nowInside = (inA && !inB); break;
+      }
+      if (nowInside != inside) {
+        if (nowInside)
+          start = x;
+        else
+          boxes.push_back(Box{ start, y1, x, y2 });
+        inside = nowInside;
+      }
+    }
+    ASSERT(!inside);
+
+    const uint32_t end = uint32_t(boxes.size());
+    if (begin == end)
+      return;
+
+    // Coalesce with the previous band if it has the same spans
+    if (!bands.empty()) {
+      Band& prev = bands.back();
+      if (prev.y2 == y1 && prev.end - prev.begin == end - begin &&
+          std::equal(boxes.begin() + prev.begin,
+                     boxes.begin() + prev.end,
+                     boxes.begin() + begin,
+                     [](const Box& p, const Box& q) { return p.x1 == q.x1 && p.x2 == q.x2; })) {
+        for (uint32_t i = prev.begin; i < prev.end; ++i)
+          boxes[i].y2 = y2;
+        prev.y2 = y2;
+        boxes.resize(begin);
+        return;
+      }
+    }
+    bands.push_back(Band{ y1, y2, begin, end });
+  };
+
+  const Box* aBoxes = a.m_boxes.data();
+  const Box* bBoxes = b.m_boxes.data();
+  const size_t na = a.m_bands.size();
+  const size_t nb = b.m_bands.size();
+  size_t ia = 0;
+  size_t ib = 0;
+
+  int y = INT_MAX;
+  if (na > 0)
+    y = a.m_bands[0].y1;
+  if (nb > 0)
+    y = std::min(y, b.m_bands[0].y1);
+
+  while (true) {
+    // Skip bands that end before the current y
+    while (ia < na && a.m_bands[ia].y2 <= y)
+      ++ia;
+    while (ib < nb && b.m_bands[ib].y2 <= y)
+      ++ib;
+    if (ia == na && (ib == nb || op != Op::Union))
+      break;
+    if (ib == nb && op == Op::Intersection)
+      break;
+
+    const Band* bandA = (ia < na ? &a.m_bands[ia] : nullptr);
+    const Band* bandB = (ib < nb ? &b.m_bands[ib] : nullptr);
+    const bool inA = (bandA && bandA->y1 <= y);
+    const bool inB = (bandB && bandB->y1 <= y);
+
+    // Next y where something changes
+    int yNext = INT_MAX;
+    if (bandA)
+      yNext = std::min(yNext, inA ? bandA->y2 : bandA->y1);
+    if (bandB)
+      yNext = std::min(yNext, inB ? bandB->y2 : bandB->y1);
+
+    const bool needed = (op == Op::Intersection ? (inA && inB) :
+                         op == Op::Subtraction  ? inA :
+                                                  (inA || inB));
+    if (needed) {
+      addBand(y,
+              yNext,
+              (inA ? aBoxes + bandA->begin : nullptr),
+              (inA ? aBoxes + bandA->end : nullptr),
+              (inB ? bBoxes + bandB->begin : nullptr),
+              (inB ? bBoxes + bandB->end : nullptr));
+    }
+    y = yNext;
+  }
+
+  m_boxes.assign(boxes.begin(), boxes.end());
+  m_bands.assign(bands.begin(), bands.end());
+  updateExtents();
+}
+
+void Region::updateExtents()
+{
+  if (m_bands.empty()) {
+    m_extents = Box{ 0, 0, 0, 0 };
+    return;
+  }
+
+  m_extents.y1 = m_bands.front().y1;
+  m_extents.y2 = m_bands.back().y2;
+  m_extents.x1 = INT_MAX;
+  m_extents.x2 = INT_MIN;
+  for (const Band& band : m_bands) {
+    m_extents.x1 = std::min(m_extents.x1, m_boxes[band.begin].x1);
+    m_extents.x2 = std::max(m_extents.x2, m_boxes[band.end - 1].x2);
+  }
+}
+
+} // namespace gfx
@@ -0,0 +1,148 @@
+// LAF Gfx Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef GFX_REGION_BAND_H_INCLUDED
+#define GFX_REGION_BAND_H_INCLUDED
+#pragma once
+
+#include "gfx/rect.h"
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace gfx {
+
+template<typename T>
+class PointT;
+
+class Region;
+
+namespace details {
+
+struct Box {
+  int32_t x1, y1, x2, y2;
+};
+
+template<typename T>
+class RegionIterator {
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T*;
+  using reference = T&;
+
+  RegionIterator() : m_ptr(nullptr) {}
+  RegionIterator(const RegionIterator& o) : m_ptr(o.m_ptr) {}
+  template<typename T2>
+  RegionIterator(const RegionIterator<T2>& o) : m_ptr(o.m_ptr)
+  {
+  }
+  RegionIterator& operator=(const RegionIterator& o)
+  {
+    m_ptr = o.m_ptr;
+    return *this;
+  }
+  RegionIterator& operator++()
+  {
+    ++m_ptr;
+    return *this;
+  }
+  RegionIterator operator++(int)
+  {
+    RegionIterator o(*this);
+    ++m_ptr;
+    return o;
+  }
+  bool operator==(const RegionIterator& o) const { return m_ptr == o.m_ptr; }
+  bool operator!=(const RegionIterator& o) const { return m_ptr != o.m_ptr; }
+  reference operator*()
+  {
+    m_rect.x = m_ptr->x1;
+    m_rect.y = m_ptr->y1;
+    m_rect.w = m_ptr->x2 - m_ptr->x1;
+    m_rect.h = m_ptr->y2 - m_ptr->y1;
+    return m_rect;
+  }
+
+private:
+  const Box* m_ptr;
+  mutable Rect m_rect;
+  template<typename>
+  friend class RegionIterator;
+  friend class ::gfx::Region;
+};
+
+} // namespace details
+
+// Self-contained implementation of gfx::Region (without Skia or
+// Pixman). The region is a list of non-overlapping boxes sorted in
+// Y-X order and grouped in horizontal bands: all boxes in a band
+// have the same y1/y2, and two adjacent bands never have the same
+// set of horizontal spans (they are coalesced in one band).
+class Region {
+public:
+  enum Overlap { Out, In, Part };
+
+  using iterator = details::RegionIterator<Rect>;
+  using const_iterator = details::RegionIterator<const Rect>;
+
+  Region();
+  Region(const Region& copy);
+  explicit Region(const Rect& rect);
+  Region& operator=(const Rect& rect);
+  Region& operator=(const Region& copy);
+  ~Region();
+
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  bool isEmpty() const { return m_boxes.empty(); }
+  bool isRect() const { return m_boxes.size() == 1; }
+  bool isComplex() const { return m_boxes.size() > 1; }
+  std::size_t size() const { return m_boxes.size(); }
+  Rect bounds() const;
+
+  void clear();
+
+  void offset(int dx, int dy);
+  void offset(const PointT<int>& delta);
+
+  Region& createIntersection(const Region& a, const Region& b);
+  Region& createUnion(const Region& a, const Region& b);
+  Region& createSubtraction(const Region& a, const Region& b);
+
+  bool contains(const PointT<int>& pt) const;
+  Overlap contains(const Rect& rect) const;
+
+  Region& operator+=(const Region& b) { return createUnion(*this, b); }
+  Region& operator|=(const Region& b) { return createUnion(*this, b); }
+  Region& operator&=(const Region& b) { return createIntersection(*this, b); }
+  Region& operator-=(const Region& b) { return createSubtraction(*this, b); }
+
+private:
+  enum class Op { Intersection, Union, Subtraction };
+
+  // A horizontal band of boxes, [begin, end) are indexes in m_boxes.
+  struct Band {
+    int32_t y1, y2;
+    uint32_t begin, end;
+  };
+
+  void combine(const Region& a, const Region& b, Op op);
+  void updateExtents();
+
+  std::vector<details::Box> m_boxes;
+  std::vector<Band> m_bands;
+  details::Box m_extents;
+};
+
+} // namespace gfx
+
+#endif
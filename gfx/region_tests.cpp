@@ -1,5 +1,5 @@
 // LAF Gfx Library
-// Copyright (C) 2019-2021  Igara Studio S.A.
+// Copyright (C) 2019-2025  Igara Studio S.A.
 // Copyright (C) 2001-2016 David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -17,6 +17,9 @@
   #include "gfx/rect_io.h"
   #include "gfx/region.h"
 
+  #include <cstdlib>
+  #include <vector>
+
 using namespace std;
 using namespace gfx;
 
@@ -123,6 +126,121 @@ TEST(Region, Iterators)
   EXPECT_EQ(2, c);
 }
 
+TEST(Region, Intersection)
+{
+  Region a(Rect(0, 0, 10, 10));
+  Region b(Rect(5, 5, 10, 10));
+  Region c;
+  c.createIntersection(a, b);
+  ASSERT_EQ(1, c.size());
+  EXPECT_EQ(Rect(5, 5, 5, 5), c.bounds());
+
+  c.createIntersection(a, Region(Rect(20, 20, 5, 5)));
+  EXPECT_TRUE(c.isEmpty());
+
+  // L-shape & rect
+  a.createUnion(a, Region(Rect(0, 10, 20, 10)));
+  c.createIntersection(a, Region(Rect(5, 5, 10, 10)));
+  EXPECT_EQ(Rect(5, 5, 10, 10), c.bounds());
+  EXPECT_EQ(2, c.size());
+}
+
+TEST(Region, Subtraction)
+{
+  Region a(Rect(0, 0, 30, 30));
+  a.createSubtraction(a, Region(Rect(10, 10, 10, 10)));
+  EXPECT_EQ(Rect(0, 0, 30, 30), a.bounds());
+  EXPECT_EQ(4, a.size()); // Top, left, right, bottom
+  EXPECT_FALSE(a.contains(Point(15, 15)));
+  EXPECT_TRUE(a.contains(Point(5, 15)));
+  EXPECT_TRUE(a.contains(Point(25, 15)));
+
+  a.createSubtraction(a, Region(Rect(0, 0, 30, 30)));
+  EXPECT_TRUE(a.isEmpty());
+}
+
+TEST(Region, ContainsRect)
+{
+  Region a(Rect(0, 0, 30, 30));
+  a.createSubtraction(a, Region(Rect(10, 10, 10, 10)));
+
+  EXPECT_EQ(Region::In, a.contains(Rect(0, 0, 10, 30)));
+  EXPECT_EQ(Region::In, a.contains(Rect(0, 0, 30, 10)));
+  EXPECT_EQ(Region::In, a.contains(Rect(20, 5, 10, 20)));
+  EXPECT_EQ(Region::Part, a.contains(Rect(5, 5, 10, 10)));
+  EXPECT_EQ(Region::Part, a.contains(Rect(0, 0, 30, 30)));
+  EXPECT_EQ(Region::Part, a.contains(Rect(25, 25, 10, 10)));
+  EXPECT_EQ(Region::Out, a.contains(Rect(10, 10, 10, 10)));
+  EXPECT_EQ(Region::Out, a.contains(Rect(12, 12, 2, 2)));
+  EXPECT_EQ(Region::Out, a.contains(Rect(40, 0, 10, 10)));
+
+  // Vertical gap between two bands
+  Region b(Rect(0, 0, 10, 10));
+  b.createUnion(b, Region(Rect(0, 20, 10, 10)));
+  EXPECT_EQ(Region::Part, b.contains(Rect(0, 5, 10, 20)));
+  EXPECT_EQ(Region::Out, b.contains(Rect(0, 10, 10, 10)));
+}
+
+// Compares random operations against a simple bitmap implementation
+TEST(Region, RandomOperations)
+{
+  const int W = 64, H = 64;
+  using Bitmap = std::vector<bool>;
+
+  auto toBitmap = [](const Region& rgn) {
+    Bitmap bmp(W * H, false);
+    for (const Rect& rc : rgn) {
+      for (int y = rc.y; y < rc.y2(); ++y)
+        for (int x = rc.x; x < rc.x2(); ++x) {
+          EXPECT_FALSE(bmp[y * W + x]) << "Overlapping rectangles";
+          bmp[y * W + x] = true;
+        }
+    }
+    return bmp;
+  };
+  auto randomRect = []() {
+    const int x = std::rand() % W, y = std::rand() % H;
+    return Rect(x, y, 1 + std::rand() % (W - x), 1 + std::rand() % (H - y));
+  };
+
+  std::srand(1);
+  for (int i = 0; i < 200; ++i) {
+    Region a, b;
+    for (int j = 0; j < 5; ++j) {
+      a.createUnion(a, Region(randomRect()));
+      b.createUnion(b, Region(randomRect()));
+    }
+    const Bitmap ba = toBitmap(a);
+    const Bitmap bb = toBitmap(b);
+
+    Region u, n, s;
+    u.createUnion(a, b);
+    n.createIntersection(a, b);
+    s.createSubtraction(a, b);
+    const Bitmap bu = toBitmap(u);
+    const Bitmap bn = toBitmap(n);
+    const Bitmap bs = toBitmap(s);
+    for (int k = 0; k < W * H; ++k) {
+      ASSERT_EQ(ba[k] || bb[k], bu[k]);
+      ASSERT_EQ(ba[k] && bb[k], bn[k]);
+      ASSERT_EQ(ba[k] && !bb[k], bs[k]);
+    }
+
+    for (int k = 0; k < W * H; ++k)
+      ASSERT_EQ(ba[k], a.contains(Point(k % W, k / W)));
+
+    const Rect rc = randomRect();
+    int in = 0;
+    for (int y = rc.y; y < rc.y2(); ++y)
+      for (int x = rc.x; x < rc.x2(); ++x)
+        in += (ba[y * W + x] ? 1 : 0);
+    const Region::Overlap expected = (in == 0         ? Region::Out :
+                                      in == rc.w * rc.h ? Region::In :
+                                                          Region::Part);
+    ASSERT_EQ(expected, a.contains(rc));
+  }
+}
+
 #endif // LAF_WITH_REGION
 
 int main(int argc, char** argv)
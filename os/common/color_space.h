@@ -0,0 +1,65 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OS_COMMON_COLOR_SPACE_H
+#define OS_COMMON_COLOR_SPACE_H
+#pragma once
+
+#include "base/debug.h"
+#include "gfx/color_space_converter.h"
+#include "os/color_space.h"
+
+namespace os {
+
+// Color space/conversion implemented with gfx::ColorSpaceConverter
+// (CPU color management for backends without Skia).
+class CommonColorSpace : public ColorSpace {
+public:
+  CommonColorSpace(const gfx::ColorSpaceRef& gfxcs) : m_gfxcs(gfxcs)
+  {
+    if (m_gfxcs->name().empty())
+      m_gfxcs->setName(m_gfxcs->type() == gfx::ColorSpace::None ? "None" : "Custom Profile");
+  }
+
+  const gfx::ColorSpaceRef& gfxColorSpace() const override { return m_gfxcs; }
+
+  bool isSRGB() const override
+  {
+    return (m_gfxcs->type() == gfx::ColorSpace::sRGB &&
+            m_gfxcs->flags() == gfx::ColorSpace::NoFlags);
+  }
+
+private:
+  gfx::ColorSpaceRef m_gfxcs;
+};
+
+class CommonColorSpaceConversion : public ColorSpaceConversion {
+public:
+  CommonColorSpaceConversion(const gfx::ColorSpaceConverterRef& converter)
+    : m_converter(converter)
+  {
+    ASSERT(m_converter);
+  }
+
+  bool convertRgba(uint32_t* dst, const uint32_t* src, int n) override
+  {
+    m_converter->convertRgba8(dst, src, n);
+    return true;
+  }
+
+  bool convertGray(uint8_t* dst, const uint8_t* src, int n) override
+  {
+    m_converter->convertGray8(dst, src, n);
+    return true;
+  }
+
+private:
+  gfx::ColorSpaceConverterRef m_converter;
+};
+
+} // namespace os
+
+#endif
@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2021  Igara Studio S.A.
+// Copyright (C) 2021-2025  Igara Studio S.A.
 // Copyright (C) 2018  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -17,13 +17,45 @@
   #include "os/x11/event_queue.h"
 #endif
 
+#include "os/event.h"
+#include "os/file_watcher.h"
+
 namespace os {
 
 EventQueueImpl g_queue;
 
+// Queue that replaces the platform-specific one (see
+// set_event_queue_instance()).
+static EventQueue* g_replacement = nullptr;
+
 EventQueue* EventQueue::instance()
 {
+  if (g_replacement)
+    return g_replacement;
   return &g_queue;
 }
 
+void set_event_queue_instance(EventQueue* queue)
+{
+  g_replacement = queue;
+}
+
+void queue_file_changes(const base::FileChanges& changes)
+{
+  base::paths files;
+  std::vector<base::FileChange::Type> types;
+  files.reserve(changes.size());
+  types.reserve(changes.size());
+  for (const base::FileChange& change : changes) {
+    files.push_back(change.path);
+    types.push_back(change.type);
+  }
+
+  Event ev;
+  ev.setType(Event::FilesChanged);
+  ev.setFiles(files);
+  ev.setFileChangeTypes(types);
+  queue_event(ev);
+}
+
 } // namespace os
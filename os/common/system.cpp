@@ -13,9 +13,18 @@
 
 #if CLIP_ENABLE_IMAGE
   #include "clip/clip.h"
+  #include "gfx/pixel_conversion.h"
 #endif
 
 #include "base/debug.h"
+#include "base/thread_pool.h"
+#include "gfx/size.h"
+#include "os/event.h"
+#include "os/scaled_surface_cache.h"
+#include "os/surface.h"
+
+#include <algorithm>
+#include <thread>
 
 namespace os {
 
@@ -94,85 +103,96 @@ KeyModifiers CommonSystem::keyModifiers()
                   (isKeyPressed(kKeyLWin) || isKeyPressed(kKeyRWin) ? kKeyWinModifier : 0));
 }
 
-#if CLIP_ENABLE_IMAGE
-
-void get_rgba32(const clip::image_spec& spec,
-                const uint8_t* scanlineAddr,
-                int* r,
-                int* g,
-                int* b,
-                int* a)
+void CommonSystem::loadSurfaceAsync(const char* filename,
+                                    const gfx::Size& targetSize,
+                                    LoadSurfaceCallback&& callback)
 {
-  uint32_t c = *((uint32_t*)scanlineAddr);
-  if (spec.alpha_mask)
-    *a = ((c & spec.alpha_mask) >> spec.alpha_shift);
-  else
-    *a = 255;
-  // The source image is in straight-alpha and makeRgbaSurface returns a
-  // surface using premultiplied-alpha so we have to premultiply the
-  // source values.
-  *r = ((c & spec.red_mask) >> spec.red_shift) * (*a) / 255;
-  *g = ((c & spec.green_mask) >> spec.green_shift) * (*a) / 255;
-  *b = ((c & spec.blue_mask) >> spec.blue_shift) * (*a) / 255;
+  ASSERT(callback);
+
+  const std::lock_guard lock(m_decodeMutex);
+  if (!m_decodePool) {
+    // Leave one core for the main thread, and limit the number of
+    // concurrent decodes (each one can use a lot of memory).
+    const int n = int(std::thread::hardware_concurrency()) - 1;
+    m_decodePool = std::make_unique<base::thread_pool>(std::clamp(n, 1, 4));
+  }
+
+  m_decodePool->execute(
+    [this, filename = std::string(filename), targetSize, callback = std::move(callback)]() {
+      SurfaceRef surface = decodeSurface(filename, targetSize);
+
+      Event ev;
+      ev.setType(Event::Callback);
+      ev.setCallback([callback, surface] { callback(surface); });
+      queue_event(ev);
+    });
 }
 
-void get_rgba24(const clip::image_spec& spec,
-                const uint8_t* scanlineAddr,
-                int* r,
-                int* g,
-                int* b,
-                int* a)
+void CommonSystem::stopDecoding()
 {
-  uint32_t c = *((uint32_t*)scanlineAddr);
-  *r = ((c & spec.red_mask) >> spec.red_shift);
-  *g = ((c & spec.green_mask) >> spec.green_shift);
-  *b = ((c & spec.blue_mask) >> spec.blue_shift);
-  *a = 255;
+  const std::lock_guard lock(m_decodeMutex);
+  m_decodePool.reset();
 }
 
-void get_rgba16(const clip::image_spec& spec,
-                const uint8_t* scanlineAddr,
-                int* r,
-                int* g,
-                int* b,
-                int* a)
+SurfaceRef CommonSystem::decodeSurface(const std::string& filename, const gfx::Size& targetSize)
 {
-  uint16_t c = *((uint16_t*)scanlineAddr);
-  *r = (((c & spec.red_mask) >> spec.red_shift) * 255) / (spec.red_mask >> spec.red_shift);
-  *g = (((c & spec.green_mask) >> spec.green_shift) * 255) / (spec.green_mask >> spec.green_shift);
-  *b = (((c & spec.blue_mask) >> spec.blue_shift) * 255) / (spec.blue_mask >> spec.blue_shift);
-  *a = 255;
+  SurfaceRef surface = loadSurface(filename.c_str());
+  if (!surface || targetSize.w <= 0 || targetSize.h <= 0)
+    return surface;
+
+  const int w = surface->width();
+  const int h = surface->height();
+  float scale = std::min(float(targetSize.w) / w, float(targetSize.h) / h);
+  if (scale >= 1.0f)
+    return surface;
+
+  // Avoid a 0 width/height in images with a very large aspect ratio
+  scale = std::max(scale, 1.0f / std::min(w, h));
+  return surface->applyScale(scale, Sampling(Sampling::Filter::Linear, Sampling::Mipmap::Linear));
 }
 
+#if CLIP_ENABLE_IMAGE
+
 SurfaceRef CommonSystem::makeSurface(const clip::image& image)
 {
   const clip::image_spec spec = image.spec();
 
-  if (spec.bits_per_pixel != 32 && spec.bits_per_pixel != 24 && spec.bits_per_pixel != 16)
+  gfx::PixelMasks masks;
+  masks.r = spec.red_mask;
+  masks.g = spec.green_mask;
+  masks.b = spec.blue_mask;
+  masks.a = spec.alpha_mask;
+  const gfx::PixelUnpacker unpacker(int(spec.bits_per_pixel), masks);
+  if (!unpacker.isValid())
     return nullptr;
 
   SurfaceRef surface = ((System*)this)->makeRgbaSurface(spec.width, spec.height);
   SurfaceFormatData sfd;
   surface->getFormat(&sfd);
 
-  // Select color components retrieval function.
-  void (*get_rgba)(const clip::image_spec&, const uint8_t*, int*, int*, int*, int*);
-  switch (spec.bits_per_pixel) {
-    case 32: get_rgba = get_rgba32; break;
-    case 24: get_rgba = get_rgba24; break;
-    case 16: get_rgba = get_rgba16; break;
-  }
+  const bool rgba = (sfd.redShift == 0 && sfd.greenShift == 8 && sfd.blueShift == 16 &&
+                     sfd.alphaShift == 24);
+  const bool bgra = (sfd.redShift == 16 && sfd.greenShift == 8 && sfd.blueShift == 0 &&
+                     sfd.alphaShift == 24);
 
   for (int v = 0; v < spec.height; ++v) {
     uint32_t* dst = (uint32_t*)surface->getData(0, v);
     const uint8_t* src = ((uint8_t*)image.data()) + v * spec.bytes_per_row;
-    for (int u = 0; u < spec.width; ++u, ++dst) {
-      int r, g, b, a;
-      get_rgba(spec, src, &r, &g, &b, &a);
-      *dst = (r << sfd.redShift) | (g << sfd.greenShift) | (b << sfd.blueShift) |
-             (a << sfd.alphaShift);
 
-      src += (spec.bits_per_pixel / 8);
+    // The source image is in straight-alpha and makeRgbaSurface
+    // returns a surface using premultiplied-alpha so we have to
+    // premultiply the source values.
+    unpacker.unpack(src, dst, int(spec.width));
+    gfx::premultiply_alpha(dst, dst, int(spec.width));
+
+    if (bgra)
+      gfx::swizzle_rb(dst, dst, int(spec.width));
+    else if (!rgba) {
+      for (int u = 0; u < int(spec.width); ++u) {
+        const gfx::Color c = dst[u];
+        dst[u] = (gfx::getr(c) << sfd.redShift) | (gfx::getg(c) << sfd.greenShift) |
+                 (gfx::getb(c) << sfd.blueShift) | (gfx::geta(c) << sfd.alphaShift);
+      }
     }
   }
 
@@ -194,6 +214,12 @@ SurfaceRef CommonSystem::makeSurface(const clip::image& image)
 // ~SystemWin (or other platform-specific System implementations).
 void CommonSystem::destroyInstance()
 {
+  // Wait the images that are being decoded while the derived class
+  // is still alive (as decodeSurface() is virtual). This is done
+  // even if this isn't the main instance (e.g. a System::makeNone()
+  // used in tests).
+  stopDecoding();
+
   // destroyInstance() can be called multiple times by derived
   // classes.
   if (g_instance != this) {
@@ -216,6 +242,10 @@ void CommonSystem::destroyInstance()
   //      EventQueue::instance() comment on laf/os/event_queue.h).
   eventQueue()->clearEvents();
 
+  // Cached scaled surfaces could depend on the system (e.g. GPU
+  // resources).
+  ScaledSurfaceCache::instance()->clear();
+
   g_instance = nullptr;
 }
 
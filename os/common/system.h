@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2019-2024  Igara Studio S.A.
+// Copyright (C) 2019-2025  Igara Studio S.A.
 // Copyright (C) 2012-2018  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -9,12 +9,25 @@
 #define OS_COMMON_SYSTEM_H
 #pragma once
 
+#include "os/common/color_space.h"
 #include "os/event_queue.h"
 #include "os/menus.h"
 #include "os/system.h"
 
+#include <memory>
+#include <mutex>
+
+namespace base {
+class thread_pool;
+}
+
 namespace os {
 
+// Replaces the queue returned by EventQueue::instance() (e.g. the
+// headless NoneSystem uses its own queue), or restores the
+// platform-specific queue if "queue" is nullptr.
+void set_event_queue_instance(EventQueue* queue);
+
 class CommonSystem : public System {
 public:
   CommonSystem();
@@ -53,6 +66,9 @@ public:
   Ref<Surface> makeRgbaSurface(int, int, const os::ColorSpaceRef&) override { return nullptr; }
   Ref<Surface> loadSurface(const char*) override { return nullptr; }
   Ref<Surface> loadRgbaSurface(const char*) override { return nullptr; }
+  void loadSurfaceAsync(const char* filename,
+                        const gfx::Size& targetSize,
+                        LoadSurfaceCallback&& callback) override;
   Ref<Cursor> makeCursor(const Surface*, const gfx::Point&, int) override { return nullptr; }
   bool isKeyPressed(KeyScancode) override { return false; }
   int getUnicodeFromScancode(KeyScancode) override { return 0; }
@@ -60,12 +76,26 @@ public:
   gfx::Point mousePosition() const override { return gfx::Point(0, 0); }
   void setMousePosition(const gfx::Point&) override {}
   gfx::Color getColorFromScreen(const gfx::Point&) const override { return gfx::ColorNone; }
-  void listColorSpaces(std::vector<os::ColorSpaceRef>&) override {}
-  os::ColorSpaceRef makeColorSpace(const gfx::ColorSpaceRef&) override { return nullptr; }
-  Ref<ColorSpaceConversion> convertBetweenColorSpace(const os::ColorSpaceRef&,
-                                                     const os::ColorSpaceRef&) override
+
+  // Color management in the CPU (SkiaSystem overrides these functions)
+  void listColorSpaces(std::vector<os::ColorSpaceRef>& list) override
+  {
+    list.push_back(makeColorSpace(gfx::ColorSpace::MakeNone()));
+    list.push_back(makeColorSpace(gfx::ColorSpace::MakeSRGB()));
+  }
+  os::ColorSpaceRef makeColorSpace(const gfx::ColorSpaceRef& cs) override
   {
-    return nullptr;
+    return os::make_ref<CommonColorSpace>(cs);
+  }
+  Ref<ColorSpaceConversion> convertBetweenColorSpace(const os::ColorSpaceRef& src,
+                                                     const os::ColorSpaceRef& dst) override
+  {
+    ASSERT(src);
+    ASSERT(dst);
+    auto converter = gfx::ColorSpaceConverter::Make(src->gfxColorSpace(), dst->gfxColorSpace());
+    if (!converter)
+      return nullptr;
+    return os::make_ref<CommonColorSpaceConversion>(converter);
   }
   void setWindowsColorSpace(const os::ColorSpaceRef&) override {}
   os::ColorSpaceRef windowsColorSpace() override { return nullptr; }
@@ -73,8 +103,27 @@ public:
 protected:
   void destroyInstance();
 
+  // Waits the images that are being decoded by loadSurfaceAsync()
+  // (pending ones are discarded). It's called from
+  // destroyInstance(), but classes that override decodeSurface() or
+  // loadSurface() must call it from their own destructor (before
+  // their members are destroyed).
+  void stopDecoding();
+
+  // Called from a background thread by loadSurfaceAsync() to load
+  // the file. The default implementation uses loadSurface() and
+  // scales the surface down with applyScale() if needed, backends
+  // can override it to decode the image directly in a smaller
+  // resolution.
+  virtual Ref<Surface> decodeSurface(const std::string& filename, const gfx::Size& targetSize);
+
 private:
   std::string m_appName;
+
+  // Threads to decode images in loadSurfaceAsync(), created the
+  // first time it's needed.
+  std::mutex m_decodeMutex;
+  std::unique_ptr<base::thread_pool> m_decodePool;
 };
 
 } // namespace os
@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2024  Igara Studio S.A.
+// Copyright (C) 2024-2025  Igara Studio S.A.
 //
 // This file is released under the terms of the MIT license.
 // Read LICENSE.txt for more information.
@@ -19,4 +19,19 @@ std::string Event::unicodeCharAsUtf8() const
   return base::codepoint_to_utf8(m_unicodeChar);
 }
 
+bool Event::mergeMouseMove(const Event& next)
+{
+  if (m_type != MouseMove || next.m_type != MouseMove || m_pointerSamples.empty() ||
+      next.m_pointerSamples.empty() || m_window != next.m_window ||
+      m_pointerType != next.m_pointerType || m_modifiers != next.m_modifiers) {
+    return false;
+  }
+
+  PointerSamples samples = std::move(m_pointerSamples);
+  samples.insert(samples.end(), next.m_pointerSamples.begin(), next.m_pointerSamples.end());
+  *this = next;
+  m_pointerSamples = std::move(samples);
+  return true;
+}
+
 } // namespace os
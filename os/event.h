@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2019-2024  Igara Studio S.A.
+// Copyright (C) 2019-2025  Igara Studio S.A.
 // Copyright (C) 2012-2018  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -10,7 +10,9 @@
 #pragma once
 
 #include "base/codepoint.h"
+#include "base/file_watcher.h"
 #include "base/paths.h"
+#include "base/time.h"
 #include "gfx/point.h"
 #include "gfx/size.h"
 #include "os/keys.h"
@@ -19,12 +21,27 @@
 
 #include <functional>
 #include <string>
+#include <vector>
 
 #pragma push_macro("None")
 #undef None // Undefine the X11 None macro
 
 namespace os {
 
+// A sample of a stylus/pen received from the platform. Pointer
+// events can contain several samples (see Event::pointerSamples()).
+struct PointerSample {
+  gfx::PointF position; // Position in the window (in window scale)
+  float pressure = 0.0f;
+  // Tilt of the stylus in each axis from -1.0 to +1.0 (0 = perpendicular)
+  float tiltX = 0.0f;
+  float tiltY = 0.0f;
+  // Time in milliseconds (in the same clock as base::current_tick())
+  base::tick_t time = 0;
+};
+
+using PointerSamples = std::vector<PointerSample>;
+
 class Event {
 public:
   enum Type {
@@ -62,6 +79,12 @@ public:
     // Pinch gesture with fingers to zoom in/out
     TouchMagnify,
     Callback,
+
+    // Some watched files were created/modified/deleted (see
+    // os::queue_file_changes() and base::FileWatcher). The changed
+    // paths are in files() and the kind of each change in
+    // fileChangeTypes().
+    FilesChanged,
   };
 
   enum MouseButton {
@@ -86,12 +109,15 @@ public:
     , m_button(NoneButton)
     , m_magnification(0.0f)
     , m_pressure(0.0f)
+    , m_time(0)
   {
   }
 
   Type type() const { return m_type; }
   const WindowRef& window() const { return m_window; }
   const base::paths& files() const { return m_files; }
+  // Type of change of each path in files() for FilesChanged events.
+  const std::vector<base::FileChange::Type>& fileChangeTypes() const { return m_fileChangeTypes; }
   // TODO Rename this to virtualKey(), which is the real
   // meaning. Then we need another kind of "scan code" with the
   // position in the keyboard, which might be useful to identify
@@ -116,9 +142,28 @@ public:
   float magnification() const { return m_magnification; }
   float pressure() const { return m_pressure; }
 
+  // Samples of the stylus in Mouse events (only on X11 at the
+  // moment, it's empty in other platforms or for regular mice). The
+  // last sample is the one of this event, and the previous ones are
+  // intermediate samples (for high-rate tablets) received since the
+  // last MouseMove delivered by getEvent(), which are merged in just
+  // one MouseMove event (see mergeMouseMove()). E.g. a brush engine
+  // can process all samples instead of just the event position.
+  const PointerSamples& pointerSamples() const { return m_pointerSamples; }
+
+  // Time when the event was generated in milliseconds (in the same
+  // clock as base::current_tick()), or 0 if it's unknown (platforms
+  // don't fill this field yet, only the headless event queue of the
+  // "none" backend, see os::NoneEventQueue).
+  base::tick_t time() const { return m_time; }
+
   void setType(Type type) { m_type = type; }
   void setWindow(const WindowRef& window) { m_window = window; }
   void setFiles(const base::paths& files) { m_files = files; }
+  void setFileChangeTypes(const std::vector<base::FileChange::Type>& types)
+  {
+    m_fileChangeTypes = types;
+  }
   void setCallback(std::function<void()>&& func) { m_callback = std::move(func); }
 
   void setScancode(KeyScancode scancode) { m_scancode = scancode; }
@@ -133,6 +178,16 @@ public:
   void setButton(MouseButton button) { m_button = button; }
   void setMagnification(float magnification) { m_magnification = magnification; }
   void setPressure(float pressure) { m_pressure = pressure; }
+  void setTime(base::tick_t time) { m_time = time; }
+  void setPointerSamples(PointerSamples&& samples) { m_pointerSamples = std::move(samples); }
+  void addPointerSample(const PointerSample& sample) { m_pointerSamples.push_back(sample); }
+
+  // Merges the "next" MouseMove event into this one (which must be
+  // a previous MouseMove not yet delivered), keeping the pointer
+  // samples of both events. Returns false if the events cannot be
+  // merged (e.g. they are not pointer samples of the same window,
+  // pointer type, and modifiers).
+  bool mergeMouseMove(const Event& next);
 
   void execCallback()
   {
@@ -144,6 +199,7 @@ private:
   Type m_type;
   WindowRef m_window;
   base::paths m_files;
+  std::vector<base::FileChange::Type> m_fileChangeTypes;
   std::function<void()> m_callback;
   KeyScancode m_scancode;
   KeyModifiers m_modifiers;
@@ -161,6 +217,10 @@ private:
 
   // Pressure of stylus used in mouse-like events
   float m_pressure;
+
+  base::tick_t m_time;
+
+  PointerSamples m_pointerSamples;
 };
 
 } // namespace os
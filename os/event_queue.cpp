@@ -0,0 +1,174 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "os/event_queue.h"
+
+#include "base/debug.h"
+#include "os/event.h"
+
+#include <algorithm>
+
+namespace os {
+
+struct EventQueue::Timer {
+  TimerId id;
+  base::tick_t interval; // Milliseconds
+  base::tick_t tolerance;
+  base::tick_t deadline;
+  bool repeat;
+  // False when the timer is removed (or when the callback of a
+  // one-shot timer is executed).
+  bool active = true;
+  // True when the Event::Callback is queued but wasn't executed yet.
+  bool pending = false;
+  // True when a one-shot timer is already queued.
+  bool fired = false;
+  TimerCallback callback;
+};
+
+EventQueue::~EventQueue()
+{
+  // Queued Event::Callback of these timers will do nothing
+  for (auto& timer : m_timers)
+    timer->active = false;
+}
+
+void EventQueue::getEvent(Event& ev, double timeout)
+{
+  const base::tick_t startTick = currentTick();
+  queueExpiredTimers(startTick);
+
+  while (true) {
+    double wait = timeout;
+    bool waitTimer = false;
+
+    if (const base::tick_t timerTick = nextTimersTick()) {
+      const base::tick_t now = currentTick();
+      const double untilTimer = (timerTick > now ? double(timerTick - now) / 1000.0 : 0.0);
+      if (timeout == kWithoutTimeout) {
+        wait = untilTimer;
+        waitTimer = true;
+      }
+      else {
+        const double remaining = std::max(0.0, timeout - double(now - startTick) / 1000.0);
+        wait = std::min(untilTimer, remaining);
+        waitTimer = (untilTimer < remaining);
+      }
+    }
+
+    onGetEvent(ev, wait);
+    if (ev.type() != Event::None)
+      return;
+
+    // Timers that expired while we were waiting
+    if (queueExpiredTimers(currentTick())) {
+      onGetEvent(ev, 0.0);
+      return;
+    }
+
+    // The wait was interrupted before the timer deadline (e.g. a
+    // platform message that doesn't generate an os::Event), or the
+    // given timeout was reached.
+    if (!waitTimer)
+      return;
+  }
+}
+
+TimerId EventQueue::addTimer(const double interval,
+                             const bool repeat,
+                             TimerCallback&& callback,
+                             const double tolerance)
+{
+  ASSERT(callback);
+
+  auto timer = std::make_shared<Timer>();
+  timer->id = m_nextTimerId++;
+  if (m_nextTimerId == 0) // Skip the invalid ID
+    m_nextTimerId = 1;
+  timer->interval = std::max<base::tick_t>(1, base::tick_t(interval * 1000.0));
+  timer->tolerance = base::tick_t(std::max(0.0, tolerance) * 1000.0);
+  timer->deadline = currentTick() + timer->interval;
+  timer->repeat = repeat;
+  timer->callback = std::move(callback);
+  m_timers.push_back(timer);
+  return timer->id;
+}
+
+void EventQueue::removeTimer(const TimerId id)
+{
+  auto it = std::find_if(m_timers.begin(), m_timers.end(), [id](const TimerPtr& timer) {
+    return timer->id == id;
+  });
+  if (it != m_timers.end()) {
+    (*it)->active = false;
+    m_timers.erase(it);
+  }
+}
+
+bool EventQueue::queueExpiredTimers(const base::tick_t now)
+{
+  if (m_timers.empty())
+    return false;
+
+  // Remove executed one-shot timers
+  m_timers.erase(std::remove_if(m_timers.begin(),
+                                m_timers.end(),
+                                [](const TimerPtr& timer) { return !timer->active; }),
+                 m_timers.end());
+
+  bool queued = false;
+  for (auto& timer : m_timers) {
+    if (timer->fired || timer->deadline > now)
+      continue;
+
+    if (timer->repeat) {
+      // Skip the missed deadlines (we call the callback just once)
+      timer->deadline += timer->interval * ((now - timer->deadline) / timer->interval + 1);
+    }
+    else {
+      timer->fired = true;
+    }
+
+    // Don't accumulate callbacks of the same timer if the app is busy
+    if (timer->pending)
+      continue;
+
+    timer->pending = true;
+
+    Event ev;
+    ev.setType(Event::Callback);
+    ev.setCallback([timer] {
+      timer->pending = false;
+      if (!timer->active)
+        return;
+      if (!timer->repeat)
+        timer->active = false;
+      timer->callback();
+    });
+    queueEvent(ev);
+    queued = true;
+  }
+  return queued;
+}
+
+base::tick_t EventQueue::nextTimersTick() const
+{
+  base::tick_t tick = 0;
+  for (const auto& timer : m_timers) {
+    if (timer->fired || !timer->active)
+      continue;
+    const base::tick_t t = timer->deadline + timer->tolerance;
+    if (tick == 0 || t < tick)
+      tick = t;
+  }
+  return tick;
+}
+
+} // namespace os
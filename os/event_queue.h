@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2021  Igara Studio S.A.
+// Copyright (C) 2021-2025  Igara Studio S.A.
 // Copyright (C) 2012-2018  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -9,19 +9,35 @@
 #define OS_EVENT_QUEUE_H_INCLUDED
 #pragma once
 
+#include "base/time.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
 namespace os {
 
 class Event;
 
+using TimerId = uint32_t; // 0 is an invalid timer
+using TimerCallback = std::function<void()>;
+using FdCallback = std::function<void(int fd)>;
+
 class EventQueue {
 public:
   static constexpr const double kWithoutTimeout = -1.0;
 
-  virtual ~EventQueue() {}
+  virtual ~EventQueue();
 
   // Wait for a new event. We can specify a timeout in seconds to
   // limit the time of wait for the next event.
-  virtual void getEvent(Event& ev, double timeout = kWithoutTimeout) = 0;
+  //
+  // The wait ends earlier if a timer expires (see addTimer()), in
+  // that case an Event::Callback event is returned to call the timer
+  // callback. So an app that uses timers instead of polling
+  // getEvent() with a short timeout doesn't wake up while it's idle.
+  void getEvent(Event& ev, double timeout = kWithoutTimeout);
 
   // Adds a new event in the queue to be processed by
   // getEvent(). It's used by each platform to convert
@@ -36,6 +52,36 @@ public:
   // alive.
   virtual void clearEvents() = 0;
 
+  // Adds a timer that calls the given callback each "interval"
+  // seconds (or just one time if "repeat" is false). The callback is
+  // called from the main thread when the Event::Callback event
+  // returned by getEvent() is executed (Event::execCallback()).
+  //
+  // "tolerance" is the time in seconds that the timer can be
+  // delayed, so timers with close deadlines are coalesced in the
+  // same wake up (e.g. 10% of the interval for a caret blink).
+  //
+  // Timers must be added/removed from the main thread (the one
+  // that calls getEvent()).
+  virtual TimerId addTimer(double interval,
+                           bool repeat,
+                           TimerCallback&& callback,
+                           double tolerance = 0.0);
+
+  // Removes the timer, its callback will not be called anymore
+  // (even if an Event::Callback for the timer is already queued).
+  virtual void removeTimer(TimerId id);
+
+  // Calls the callback from the main thread (with an
+  // Event::Callback) each time the given file descriptor has data
+  // to read (or it's closed). The callback must read the available
+  // data, and it's not called again until the previous
+  // Event::Callback was executed. Returns false if the platform
+  // cannot wait file descriptors in its event loop (only X11
+  // supports this at the moment).
+  virtual bool addFdWatch(int fd, FdCallback&& callback) { return false; }
+  virtual void removeFdWatch(int fd) {}
+
   // Deprecated old method. We should remove this line after some
   // releases. It's here to avoid calling getEvent(Event&, double)
   // even when we use a bool 2nd argument.
@@ -46,6 +92,29 @@ public:
   // file is queued in application:openFile:, code which is executed
   // before the user's main() code.
   static EventQueue* instance();
+
+protected:
+  // Platform-specific implementation of getEvent() (the given
+  // timeout already includes the deadline of the next timer).
+  virtual void onGetEvent(Event& ev, double timeout) = 0;
+
+  // Clock used for timers in milliseconds.
+  virtual base::tick_t currentTick() const { return base::current_tick(); }
+
+private:
+  struct Timer;
+  using TimerPtr = std::shared_ptr<Timer>;
+
+  // Queues an Event::Callback for each expired timer, returns true
+  // if some event was queued.
+  bool queueExpiredTimers(base::tick_t now);
+
+  // Time (in CPU ticks) when we have to wake up to process the next
+  // timer(s), or 0 if there are no timers.
+  base::tick_t nextTimersTick() const;
+
+  std::vector<TimerPtr> m_timers;
+  TimerId m_nextTimerId = 1;
 };
 
 inline void queue_event(const Event& ev)
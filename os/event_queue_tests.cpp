@@ -0,0 +1,166 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <gtest/gtest.h>
+
+#if !LAF_SKIA
+
+  #include "os/event.h"
+  #include "os/none/event_queue.h"
+
+  #include <string>
+
+using namespace os;
+
+namespace {
+
+// Returns the next event executing it if it's a callback
+Event::Type next_event(NoneEventQueue& queue, double timeout)
+{
+  Event ev;
+  queue.getEvent(ev, timeout);
+  if (ev.type() == Event::Callback)
+    ev.execCallback();
+  return ev.type();
+}
+
+} // anonymous namespace
+
+TEST(EventQueue, OneShotTimer)
+{
+  NoneEventQueue queue;
+  int calls = 0;
+  const TimerId id = queue.addTimer(0.1, false, [&] { ++calls; });
+  EXPECT_NE(0, id);
+
+  // Not expired yet
+  EXPECT_EQ(Event::None, next_event(queue, 0.05));
+  EXPECT_EQ(50, queue.now());
+  EXPECT_EQ(0, calls);
+
+  // The wait is shortened to the timer deadline
+  EXPECT_EQ(Event::Callback, next_event(queue, 10.0));
+  EXPECT_EQ(100, queue.now());
+  EXPECT_EQ(1, calls);
+
+  // Without timers getEvent() doesn't wait
+  EXPECT_EQ(Event::None, next_event(queue, EventQueue::kWithoutTimeout));
+  EXPECT_EQ(100, queue.now());
+  EXPECT_EQ(1, calls);
+}
+
+TEST(EventQueue, RepeatingTimer)
+{
+  NoneEventQueue queue;
+  int calls = 0;
+  const TimerId id = queue.addTimer(0.1, true, [&] { ++calls; });
+
+  for (int i = 1; i <= 3; ++i) {
+    EXPECT_EQ(Event::Callback, next_event(queue, EventQueue::kWithoutTimeout));
+    EXPECT_EQ(100 * i, queue.now());
+    EXPECT_EQ(i, calls);
+  }
+
+  // Missed deadlines call the callback just one time
+  queue.advance(350);
+  EXPECT_EQ(Event::Callback, next_event(queue, 0.0));
+  EXPECT_EQ(Event::None, next_event(queue, 0.0));
+  EXPECT_EQ(4, calls);
+  EXPECT_EQ(Event::Callback, next_event(queue, EventQueue::kWithoutTimeout));
+  EXPECT_EQ(700, queue.now());
+  EXPECT_EQ(5, calls);
+
+  queue.removeTimer(id);
+  EXPECT_EQ(Event::None, next_event(queue, 1.0));
+  EXPECT_EQ(1700, queue.now());
+  EXPECT_EQ(5, calls);
+}
+
+TEST(EventQueue, RemoveQueuedTimer)
+{
+  NoneEventQueue queue;
+  int calls = 0;
+  const TimerId id = queue.addTimer(0.1, false, [&] { ++calls; });
+
+  Event ev;
+  queue.getEvent(ev, 1.0);
+  EXPECT_EQ(Event::Callback, ev.type());
+
+  // The timer callback is not called if the timer was removed after
+  // its Event::Callback was queued.
+  queue.removeTimer(id);
+  ev.execCallback();
+  EXPECT_EQ(0, calls);
+}
+
+TEST(EventQueue, RemoveFromCallback)
+{
+  NoneEventQueue queue;
+  int calls = 0;
+  TimerId id = 0;
+  id = queue.addTimer(0.1, true, [&] {
+    ++calls;
+    queue.removeTimer(id);
+  });
+
+  EXPECT_EQ(Event::Callback, next_event(queue, 1.0));
+  EXPECT_EQ(Event::None, next_event(queue, 1.0));
+  EXPECT_EQ(1, calls);
+}
+
+TEST(EventQueue, CoalescedTimers)
+{
+  NoneEventQueue queue;
+  std::string calls;
+  queue.addTimer(0.1, false, [&] { calls += "a"; }, 0.05);
+  queue.addTimer(0.12, false, [&] { calls += "b"; }, 0.05);
+  queue.addTimer(0.3, false, [&] { calls += "c"; });
+
+  // "a" can be delayed until 150, so both "a" and "b" are called in
+  // the same wake up
+  EXPECT_EQ(Event::Callback, next_event(queue, EventQueue::kWithoutTimeout));
+  EXPECT_EQ(Event::Callback, next_event(queue, 0.0));
+  EXPECT_EQ(150, queue.now());
+  EXPECT_EQ("ab", calls);
+
+  EXPECT_EQ(Event::Callback, next_event(queue, EventQueue::kWithoutTimeout));
+  EXPECT_EQ(300, queue.now());
+  EXPECT_EQ("abc", calls);
+}
+
+TEST(EventQueue, QueuedEventsFirst)
+{
+  NoneEventQueue queue;
+  int calls = 0;
+  queue.addTimer(0.1, false, [&] { ++calls; });
+
+  Event ev;
+  ev.setType(Event::KeyDown);
+  queue.queueEvent(ev);
+
+  EXPECT_EQ(Event::KeyDown, next_event(queue, EventQueue::kWithoutTimeout));
+  EXPECT_EQ(0, queue.now());
+  EXPECT_EQ(Event::Callback, next_event(queue, EventQueue::kWithoutTimeout));
+  EXPECT_EQ(1, calls);
+}
+
+TEST(EventQueue, FdWatchNotSupported)
+{
+  NoneEventQueue queue;
+  EXPECT_FALSE(queue.addFdWatch(0, [](int) {}));
+}
+
+#endif // !LAF_SKIA
+
+int app_main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
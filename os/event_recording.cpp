@@ -0,0 +1,598 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "os/event_recording.h"
+
+#include "base/debug.h"
+#include "base/serialization.h"
+#include "os/common/system.h"
+#include "os/system.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <istream>
+#include <ostream>
+
+namespace os {
+
+using namespace base::serialization;
+using namespace base::serialization::little_endian;
+
+namespace {
+
+// Event log format:
+//
+//   "LAFE" magic number + version (uint8)
+//   For each event:
+//     Event::Type (uint8)
+//     Milliseconds since the previous event (varint)
+//     Window ID (varint, 0 = no window)
+//     Fields mask (varint) with the fields that are not the default
+//     Fields (in the order of the mask bits)
+//
+// Varints are 7 bits per byte (LEB128), signed values use zigzag
+// encoding. Pointer samples are stored as a count (varint) and the
+// position, pressure and tilt (floats) of each sample, with its time
+// relative to the event time (signed varint).
+constexpr uint8_t kMagic[4] = { 'L', 'A', 'F', 'E' };
+constexpr uint8_t kVersion = 2;
+
+// Limits to detect corrupted logs before allocating memory.
+constexpr uint64_t kMaxFiles = 65536;
+constexpr uint64_t kMaxPathLength = 65536;
+constexpr uint64_t kMaxPointerSamples = 65536;
+
+enum Field {
+  kPosition = 1 << 0,
+  kScancode = 1 << 1,
+  kModifiers = 1 << 2,
+  kUnicodeChar = 1 << 3,
+  kRepeat = 1 << 4,
+  kWheelDelta = 1 << 5,
+  kPointerType = 1 << 6,
+  kButton = 1 << 7,
+  kMagnification = 1 << 8,
+  kPressure = 1 << 9,
+  kDeadKey = 1 << 10,
+  kPreciseWheel = 1 << 11,
+  kFiles = 1 << 12,
+  kFileChangeTypes = 1 << 13,
+  kPointerSamples = 1 << 14,
+};
+
+void write_varint(std::ostream& os, uint64_t value)
+{
+  while (value >= 0x80) {
+    write8(os, uint8_t(value | 0x80));
+    value >>= 7;
+  }
+  write8(os, uint8_t(value));
+}
+
+uint64_t read_varint(std::istream& is)
+{
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    const int byte = is.get();
+    if (byte == EOF)
+      break;
+    value |= uint64_t(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0)
+      break;
+  }
+  return value;
+}
+
+void write_sint(std::ostream& os, int value)
+{
+  write_varint(os, (uint32_t(value) << 1) ^ uint32_t(value >> 31));
+}
+
+int read_sint(std::istream& is)
+{
+  const uint32_t v = uint32_t(read_varint(is));
+  return int(v >> 1) ^ -int(v & 1);
+}
+
+void write_point(std::ostream& os, const gfx::Point& pt)
+{
+  write_sint(os, pt.x);
+  write_sint(os, pt.y);
+}
+
+gfx::Point read_point(std::istream& is)
+{
+  const int x = read_sint(is);
+  const int y = read_sint(is);
+  return gfx::Point(x, y);
+}
+
+// Upper limit (in seconds) of the given histogram bucket.
+double bucket_limit(const int i)
+{
+  return std::ldexp(1.0, i) / 1000000.0;
+}
+
+} // anonymous namespace
+
+//////////////////////////////////////////////////////////////////////
+// LatencyHistogram
+
+void LatencyHistogram::add(const double seconds)
+{
+  const double usecs = std::max(0.0, seconds * 1000000.0);
+  int i = 0;
+  while (i < kBuckets - 1 && usecs >= std::ldexp(1.0, i))
+    ++i;
+
+  ++m_buckets[i];
+  ++m_count;
+  m_sum += seconds;
+  m_max = std::max(m_max, seconds);
+}
+
+double LatencyHistogram::percentile(const double p) const
+{
+  if (m_count == 0)
+    return 0.0;
+
+  const int n = std::max(1, int(std::ceil(std::clamp(p, 0.0, 1.0) * m_count)));
+  int accum = 0;
+  for (int i = 0; i < kBuckets; ++i) {
+    accum += m_buckets[i];
+    if (accum >= n)
+      return std::min(bucket_limit(i), m_max);
+  }
+  return m_max;
+}
+
+//////////////////////////////////////////////////////////////////////
+// EventRecorder
+
+EventRecorder::EventRecorder(std::ostream& os) : m_os(os), m_queue(EventQueue::instance())
+{
+  m_os.write((const char*)kMagic, sizeof(kMagic));
+  write8(m_os, kVersion);
+
+  set_event_queue_instance(this);
+}
+
+EventRecorder::~EventRecorder()
+{
+  ASSERT(EventQueue::instance() == this);
+  set_event_queue_instance(m_queue);
+  m_os.flush();
+}
+
+void EventRecorder::onGetEvent(Event& ev, double timeout)
+{
+  m_queue->getEvent(ev, timeout);
+  if (ev.type() != Event::None && ev.type() != Event::Callback)
+    record(ev);
+}
+
+void EventRecorder::queueEvent(const Event& ev)
+{
+  m_queue->queueEvent(ev);
+}
+
+void EventRecorder::clearEvents()
+{
+  m_queue->clearEvents();
+}
+
+TimerId EventRecorder::addTimer(const double interval,
+                                const bool repeat,
+                                TimerCallback&& callback,
+                                const double tolerance)
+{
+  return m_queue->addTimer(interval, repeat, std::move(callback), tolerance);
+}
+
+void EventRecorder::removeTimer(const TimerId id)
+{
+  m_queue->removeTimer(id);
+}
+
+bool EventRecorder::addFdWatch(const int fd, FdCallback&& callback)
+{
+  return m_queue->addFdWatch(fd, std::move(callback));
+}
+
+void EventRecorder::removeFdWatch(const int fd)
+{
+  m_queue->removeFdWatch(fd);
+}
+
+void EventRecorder::record(const Event& ev)
+{
+  // Platforms don't fill the event time yet
+  const base::tick_t time = (ev.time() ? ev.time() : base::current_tick());
+  const base::tick_t delta = (m_recordedEvents > 0 && time > m_lastTime ? time - m_lastTime : 0);
+  m_lastTime = std::max(m_lastTime, time);
+
+  int mask = 0;
+  if (ev.position() != gfx::Point(0, 0))
+    mask |= kPosition;
+  if (ev.scancode() != kKeyNil)
+    mask |= kScancode;
+  if (ev.modifiers() != kKeyUninitializedModifier)
+    mask |= kModifiers;
+  if (ev.unicodeChar() != 0)
+    mask |= kUnicodeChar;
+  if (ev.repeat() != 0)
+    mask |= kRepeat;
+  if (ev.wheelDelta() != gfx::Point(0, 0))
+    mask |= kWheelDelta;
+  if (ev.pointerType() != PointerType::Unknown)
+    mask |= kPointerType;
+  if (ev.button() != Event::NoneButton)
+    mask |= kButton;
+  if (ev.magnification() != 0.0f)
+    mask |= kMagnification;
+  if (ev.pressure() != 0.0f)
+    mask |= kPressure;
+  if (ev.isDeadKey())
+    mask |= kDeadKey;
+  if (ev.preciseWheel())
+    mask |= kPreciseWheel;
+  if (!ev.files().empty())
+    mask |= kFiles;
+  if (!ev.fileChangeTypes().empty())
+    mask |= kFileChangeTypes;
+  if (!ev.pointerSamples().empty())
+    mask |= kPointerSamples;
+
+  write8(m_os, uint8_t(ev.type()));
+  write_varint(m_os, delta);
+  write_varint(m_os, windowId(ev.window().get()));
+  write_varint(m_os, mask);
+
+  if (mask & kPosition)
+    write_point(m_os, ev.position());
+  if (mask & kScancode)
+    write_varint(m_os, ev.scancode());
+  if (mask & kModifiers)
+    write_varint(m_os, ev.modifiers());
+  if (mask & kUnicodeChar)
+    write_varint(m_os, ev.unicodeChar());
+  if (mask & kRepeat)
+    write_varint(m_os, ev.repeat());
+  if (mask & kWheelDelta)
+    write_point(m_os, ev.wheelDelta());
+  if (mask & kPointerType)
+    write8(m_os, uint8_t(ev.pointerType()));
+  if (mask & kButton)
+    write8(m_os, uint8_t(ev.button()));
+  if (mask & kMagnification)
+    write_float(m_os, ev.magnification());
+  if (mask & kPressure)
+    write_float(m_os, ev.pressure());
+  if (mask & kFiles) {
+    write_varint(m_os, ev.files().size());
+    for (const std::string& file : ev.files()) {
+      write_varint(m_os, file.size());
+      m_os.write(file.data(), file.size());
+    }
+  }
+  if (mask & kFileChangeTypes) {
+    write_varint(m_os, ev.fileChangeTypes().size());
+    for (const base::FileChange::Type type : ev.fileChangeTypes())
+      write8(m_os, uint8_t(type));
+  }
+  if (mask & kPointerSamples) {
+    const PointerSamples& samples = ev.pointerSamples();
+    const size_t n = std::min<size_t>(samples.size(), kMaxPointerSamples);
+    write_varint(m_os, n);
+    for (size_t i = 0; i < n; ++i) {
+      const PointerSample& sample = samples[i];
+      write_float(m_os, sample.position.x);
+      write_float(m_os, sample.position.y);
+      write_float(m_os, sample.pressure);
+      write_float(m_os, sample.tiltX);
+      write_float(m_os, sample.tiltY);
+      const int64_t dt = int64_t(sample.time) - int64_t(time);
+      write_sint(m_os, int(std::clamp<int64_t>(dt, INT_MIN, INT_MAX)));
+    }
+  }
+
+  ++m_recordedEvents;
+}
+
+int EventRecorder::windowId(Window* window)
+{
+  if (!window)
+    return 0;
+
+  auto it = m_windowIds.find(window->id());
+  if (it != m_windowIds.end())
+    return it->second;
+
+  const int id = int(m_windowIds.size()) + 1;
+  m_windowIds[window->id()] = id;
+  return id;
+}
+
+//////////////////////////////////////////////////////////////////////
+// EventPlayer
+
+EventPlayer::EventPlayer(std::istream& is, const Timing timing)
+  : m_queue(EventQueue::instance())
+  , m_timing(timing)
+{
+  m_valid = read(is);
+  if (!m_valid)
+    m_events.clear();
+
+  set_event_queue_instance(this);
+  m_chrono.reset();
+}
+
+EventPlayer::~EventPlayer()
+{
+  ASSERT(EventQueue::instance() == this);
+  set_event_queue_instance(m_queue);
+}
+
+void EventPlayer::setWindow(const int id, const WindowRef& window)
+{
+  ASSERT(id > 0);
+  if (id <= 0)
+    return;
+
+  if (id > int(m_windows.size()))
+    m_windows.resize(id);
+  m_windows[id - 1] = window;
+}
+
+std::string EventPlayer::report() const
+{
+  static const char* kNames[] = { "None",       "CloseApp",   "CloseWindow", "ResizeWindow",
+                                  "DropFiles",  "MouseEnter", "MouseLeave",  "MouseMove",
+                                  "MouseDown",  "MouseUp",    "MouseWheel",  "MouseDoubleClick",
+                                  "KeyDown",    "KeyUp",      "TouchMagnify", "Callback",
+                                  "FilesChanged" };
+  static_assert(std::size(kNames) == Event::FilesChanged + 1);
+
+  std::string result;
+  char buf[256];
+  auto addLine = [&](const char* name, const LatencyHistogram& h) {
+    std::snprintf(buf,
+                  sizeof(buf),
+                  "%-16s %7d  mean %9.3f ms  p50 < %9.3f ms  p90 < %9.3f ms  "
+                  "p99 < %9.3f ms  max %9.3f ms\n",
+                  name,
+                  h.count(),
+                  h.mean() * 1000.0,
+                  h.percentile(0.5) * 1000.0,
+                  h.percentile(0.9) * 1000.0,
+                  h.percentile(0.99) * 1000.0,
+                  h.max() * 1000.0);
+    result += buf;
+  };
+
+  for (int type = 0; type < int(m_latencyByType.size()); ++type) {
+    if (m_latencyByType[type].count() > 0)
+      addLine(kNames[type], m_latencyByType[type]);
+  }
+  addLine("Total", m_latency);
+  return result;
+}
+
+void EventPlayer::onGetEvent(Event& ev, double timeout)
+{
+  // The previous replayed event was handled
+  if (m_inFlight) {
+    const double latency = m_chrono.elapsed() - m_current.queuedAt;
+    m_latency.add(latency);
+    m_latencyByType[m_events[m_current.index].event.type()].add(latency);
+    m_inFlight = false;
+    ++m_handled;
+  }
+
+  queueDueEvents();
+
+  // Don't wait more than the time of the next event to replay
+  if (m_timing == Timing::Original && m_pending.empty() && m_next < totalEvents()) {
+    const double wait = std::max(0.0, m_events[m_next].time - m_chrono.elapsed());
+    if (timeout == kWithoutTimeout || wait < timeout)
+      timeout = wait;
+  }
+
+  m_queue->getEvent(ev, timeout);
+
+  if (isPending(ev)) {
+    m_current = m_pending.front();
+    m_pending.pop_front();
+    m_inFlight = true;
+  }
+}
+
+void EventPlayer::queueEvent(const Event& ev)
+{
+  m_queue->queueEvent(ev);
+}
+
+void EventPlayer::clearEvents()
+{
+  m_queue->clearEvents();
+  m_pending.clear();
+}
+
+TimerId EventPlayer::addTimer(const double interval,
+                              const bool repeat,
+                              TimerCallback&& callback,
+                              const double tolerance)
+{
+  return m_queue->addTimer(interval, repeat, std::move(callback), tolerance);
+}
+
+void EventPlayer::removeTimer(const TimerId id)
+{
+  m_queue->removeTimer(id);
+}
+
+bool EventPlayer::addFdWatch(const int fd, FdCallback&& callback)
+{
+  return m_queue->addFdWatch(fd, std::move(callback));
+}
+
+void EventPlayer::removeFdWatch(const int fd)
+{
+  m_queue->removeFdWatch(fd);
+}
+
+bool EventPlayer::read(std::istream& is)
+{
+  uint8_t magic[sizeof(kMagic)];
+  is.read((char*)magic, sizeof(magic));
+  if (!is || !std::equal(magic, magic + sizeof(magic), kMagic) || read8(is) != kVersion)
+    return false;
+
+  base::tick_t time = 0;
+  while (true) {
+    const int type = is.get();
+    if (type == EOF)
+      break;
+    if (type > Event::FilesChanged)
+      return false;
+
+    time += read_varint(is);
+    Entry entry;
+    entry.windowId = int(read_varint(is));
+    entry.time = double(time) / 1000.0;
+
+    Event& ev = entry.event;
+    ev.setType(Event::Type(type));
+    // Time relative to the first event, used to identify the event
+    // when it's received (0 is reserved for events without time)
+    ev.setTime(time + 1);
+
+    const int mask = int(read_varint(is));
+    if (mask & kPosition)
+      ev.setPosition(read_point(is));
+    if (mask & kScancode)
+      ev.setScancode(KeyScancode(read_varint(is)));
+    if (mask & kModifiers)
+      ev.setModifiers(KeyModifiers(read_varint(is)));
+    if (mask & kUnicodeChar)
+      ev.setUnicodeChar(base::codepoint_t(read_varint(is)));
+    if (mask & kRepeat)
+      ev.setRepeat(int(read_varint(is)));
+    if (mask & kWheelDelta)
+      ev.setWheelDelta(read_point(is));
+    if (mask & kPointerType)
+      ev.setPointerType(PointerType(read8(is)));
+    if (mask & kButton)
+      ev.setButton(Event::MouseButton(read8(is)));
+    if (mask & kMagnification)
+      ev.setMagnification(read_float(is));
+    if (mask & kPressure)
+      ev.setPressure(read_float(is));
+    ev.setDeadKey(mask & kDeadKey ? true : false);
+    ev.setPreciseWheel(mask & kPreciseWheel ? true : false);
+    if (mask & kFiles) {
+      const uint64_t n = read_varint(is);
+      if (!is || n > kMaxFiles)
+        return false;
+
+      base::paths files(n);
+      for (std::string& file : files) {
+        const uint64_t length = read_varint(is);
+        if (!is || length > kMaxPathLength)
+          return false;
+
+        file.resize(length);
+        is.read(file.data(), file.size());
+      }
+      ev.setFiles(files);
+    }
+    if (mask & kFileChangeTypes) {
+      const uint64_t n = read_varint(is);
+      if (!is || n > kMaxFiles)
+        return false;
+
+      std::vector<base::FileChange::Type> types(n);
+      for (base::FileChange::Type& type : types) {
+        const uint8_t value = read8(is);
+        if (value > uint8_t(base::FileChange::Type::Overflow))
+          return false;
+        type = base::FileChange::Type(value);
+      }
+      ev.setFileChangeTypes(types);
+    }
+    if (mask & kPointerSamples) {
+      const uint64_t n = read_varint(is);
+      if (!is || n > kMaxPointerSamples)
+        return false;
+
+      PointerSamples samples(n);
+      for (PointerSample& sample : samples) {
+        sample.position.x = read_float(is);
+        sample.position.y = read_float(is);
+        sample.pressure = read_float(is);
+        sample.tiltX = read_float(is);
+        sample.tiltY = read_float(is);
+        // In the same clock as the event time
+        const int64_t dt = read_sint(is);
+        sample.time = base::tick_t(std::max<int64_t>(0, int64_t(ev.time()) + dt));
+      }
+      ev.setPointerSamples(std::move(samples));
+    }
+
+    if (!is)
+      return false;
+    m_events.push_back(std::move(entry));
+  }
+  return true;
+}
+
+void EventPlayer::queueDueEvents()
+{
+  while (m_next < totalEvents()) {
+    if (m_timing == Timing::AsFastAsPossible) {
+      // One event at a time
+      if (m_inFlight || !m_pending.empty())
+        break;
+    }
+    else if (m_events[m_next].time > m_chrono.elapsed()) {
+      break;
+    }
+
+    Event ev = m_events[m_next].event;
+    const int id = m_events[m_next].windowId;
+    if (id > 0) {
+      if (id <= int(m_windows.size()) && m_windows[id - 1])
+        ev.setWindow(m_windows[id - 1]);
+      else if (auto* system = System::rawInstance())
+        ev.setWindow(AddRef(system->defaultWindow()));
+    }
+
+    m_pending.push_back(Pending{ m_next, m_chrono.elapsed() });
+    m_queue->queueEvent(ev);
+    ++m_next;
+  }
+}
+
+bool EventPlayer::isPending(const Event& ev) const
+{
+  if (m_pending.empty())
+    return false;
+
+  // Events are received in the same order they were queued
+  const Event& replayed = m_events[m_pending.front().index].event;
+  return (ev.type() == replayed.type() && ev.time() == replayed.time() &&
+          ev.position() == replayed.position() && ev.scancode() == replayed.scancode() &&
+          ev.button() == replayed.button());
+}
+
+} // namespace os
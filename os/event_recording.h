@@ -0,0 +1,177 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OS_EVENT_RECORDING_H_INCLUDED
+#define OS_EVENT_RECORDING_H_INCLUDED
+#pragma once
+
+#include "base/chrono.h"
+#include "base/disable_copying.h"
+#include "os/event.h"
+#include "os/event_queue.h"
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace os {
+
+// Histogram of latencies with power of two buckets (in
+// microseconds, the last bucket includes everything >= 2^30us).
+class LatencyHistogram {
+public:
+  static constexpr int kBuckets = 32;
+
+  void add(double seconds);
+
+  int count() const { return m_count; }
+  double mean() const { return (m_count ? m_sum / m_count : 0.0); }
+  double max() const { return m_max; }
+
+  // Returns an upper bound (in seconds) of the given percentile
+  // (0.0-1.0), i.e. the upper limit of the bucket that contains it.
+  double percentile(double p) const;
+
+private:
+  std::array<int, kBuckets> m_buckets = {};
+  int m_count = 0;
+  double m_sum = 0.0;
+  double m_max = 0.0;
+};
+
+// Records all events that are returned by EventQueue::getEvent() in
+// a compact binary log (see EventPlayer to replay it).
+//
+// While the recorder is alive it replaces EventQueue::instance()
+// (forwarding all calls to the previous queue, including timers), so
+// it must be created after the os::System and destroyed before it.
+// Callback events cannot be recorded (they're skipped), and windows
+// of the recorded events are kept alive while the recorder exists.
+class EventRecorder : public EventQueue {
+public:
+  explicit EventRecorder(std::ostream& os);
+  ~EventRecorder();
+
+  void queueEvent(const Event& ev) override;
+  void clearEvents() override;
+  TimerId addTimer(double interval,
+                   bool repeat,
+                   TimerCallback&& callback,
+                   double tolerance) override;
+  void removeTimer(TimerId id) override;
+  bool addFdWatch(int fd, FdCallback&& callback) override;
+  void removeFdWatch(int fd) override;
+
+  int recordedEvents() const { return m_recordedEvents; }
+
+protected:
+  void onGetEvent(Event& ev, double timeout) override;
+
+private:
+  void record(const Event& ev);
+  int windowId(Window* window);
+
+  std::ostream& m_os;
+  EventQueue* m_queue;
+  base::tick_t m_lastTime = 0;
+  int m_recordedEvents = 0;
+  // Windows are identified by the order they appear in the log
+  // (0 = event without window). They are mapped by Window::id() and
+  // not by their address, because a new window can reuse the address
+  // of a destroyed one.
+  std::unordered_map<uint32_t, int> m_windowIds;
+
+  DISABLE_COPYING(EventRecorder);
+};
+
+// Replays an event log created by EventRecorder queueing its events
+// in the previous EventQueue::instance() (with the original timing,
+// or as fast as possible, i.e. one event each time the previous one
+// is handled), measuring the latency of each replayed event: the time
+// since it's queued until the app calls getEvent() again.
+//
+// Like EventRecorder, it replaces EventQueue::instance() while it's
+// alive.
+class EventPlayer : public EventQueue {
+public:
+  enum class Timing {
+    Original,
+    AsFastAsPossible,
+  };
+
+  EventPlayer(std::istream& is, Timing timing);
+  ~EventPlayer();
+
+  // Returns false if the log couldn't be read.
+  bool isValid() const { return m_valid; }
+
+  // Windows of the replayed events by their ID in the log (starting
+  // from 1). Events of unknown windows are sent to
+  // System::defaultWindow().
+  void setWindow(int id, const WindowRef& window);
+
+  int totalEvents() const { return int(m_events.size()); }
+  int playedEvents() const { return m_handled; }
+  bool isFinished() const { return (m_handled == totalEvents()); }
+
+  const LatencyHistogram& latency() const { return m_latency; }
+  const LatencyHistogram& latency(Event::Type type) const { return m_latencyByType[type]; }
+
+  // Human readable latencies by event type.
+  std::string report() const;
+
+  void queueEvent(const Event& ev) override;
+  void clearEvents() override;
+  TimerId addTimer(double interval,
+                   bool repeat,
+                   TimerCallback&& callback,
+                   double tolerance) override;
+  void removeTimer(TimerId id) override;
+  bool addFdWatch(int fd, FdCallback&& callback) override;
+  void removeFdWatch(int fd) override;
+
+protected:
+  void onGetEvent(Event& ev, double timeout) override;
+
+private:
+  struct Entry {
+    Event event; // With the time relative to the first event
+    int windowId;
+    double time; // Seconds since the first event
+  };
+  struct Pending {
+    int index; // Index in m_events
+    double queuedAt;
+  };
+
+  bool read(std::istream& is);
+  void queueDueEvents();
+  bool isPending(const Event& ev) const;
+
+  EventQueue* m_queue;
+  Timing m_timing;
+  bool m_valid = false;
+  std::vector<Entry> m_events;
+  std::vector<WindowRef> m_windows;
+  base::Chrono m_chrono;
+  int m_next = 0;    // Next event to queue
+  int m_handled = 0; // Replayed events that were already handled
+  std::deque<Pending> m_pending; // Queued but not yet received
+  bool m_inFlight = false;       // m_current is being handled
+  Pending m_current;
+  LatencyHistogram m_latency;
+  std::array<LatencyHistogram, Event::FilesChanged + 1> m_latencyByType;
+
+  DISABLE_COPYING(EventPlayer);
+};
+
+} // namespace os
+
+#endif
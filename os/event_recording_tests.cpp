@@ -0,0 +1,271 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <gtest/gtest.h>
+
+#include "os/event_recording.h"
+
+#include <sstream>
+
+using namespace os;
+
+TEST(LatencyHistogram, Percentiles)
+{
+  LatencyHistogram h;
+  EXPECT_EQ(0, h.count());
+  EXPECT_EQ(0.0, h.percentile(0.5));
+
+  for (int i = 0; i < 90; ++i)
+    h.add(0.000100); // 100us -> [64us, 128us) bucket
+  for (int i = 0; i < 10; ++i)
+    h.add(0.010); // 10ms -> [8192us, 16384us) bucket
+
+  EXPECT_EQ(100, h.count());
+  EXPECT_NEAR(0.00109, h.mean(), 1e-9);
+  EXPECT_EQ(0.010, h.max());
+  EXPECT_EQ(0.000128, h.percentile(0.5));
+  EXPECT_EQ(0.000128, h.percentile(0.9));
+  EXPECT_EQ(0.010, h.percentile(0.99)); // Limited to the max
+}
+
+#if !LAF_SKIA
+
+  #include "os/none/system.h"
+  #include "os/none/window.h"
+  #include "os/system.h"
+
+TEST(EventPlayer, InvalidLog)
+{
+  SystemRef system = System::makeNone();
+  std::istringstream is("not an event log");
+  EventPlayer player(is, EventPlayer::Timing::AsFastAsPossible);
+  EXPECT_FALSE(player.isValid());
+  EXPECT_EQ(0, player.totalEvents());
+  EXPECT_TRUE(player.isFinished());
+}
+
+TEST(EventPlayer, CorruptLog)
+{
+  SystemRef system = System::makeNone();
+
+  // Header + a FilesChanged event without window with the kFiles field
+  const std::string header("LAFE\x02\x10\x00\x00\x80\x20", 10);
+  const std::string huge("\xff\xff\xff\xff\xff\xff\xff\xff\x01", 9);
+
+  for (const std::string& data : {
+         header + huge,                   // Too many files
+         header + "\x01" + huge,          // Too long path
+         header + "\x01\x05" + "a.t",     // Truncated path
+         header.substr(0, header.size() - 1), // Truncated mask
+       }) {
+    std::istringstream is(data);
+    EventPlayer player(is, EventPlayer::Timing::AsFastAsPossible);
+    EXPECT_FALSE(player.isValid());
+    EXPECT_EQ(0, player.totalEvents());
+  }
+
+  // The same event with a valid file is accepted
+  std::istringstream is(header + "\x01\x05" + "a.txt");
+  EventPlayer player(is, EventPlayer::Timing::AsFastAsPossible);
+  EXPECT_TRUE(player.isValid());
+  EXPECT_EQ(1, player.totalEvents());
+}
+
+TEST(EventRecording, RecordAndReplay)
+{
+  std::stringstream log;
+  {
+    SystemRef system = System::makeNone();
+    auto none = static_cast<NoneSystem*>(system.get());
+    NoneEventQueue* queue = none->noneEventQueue();
+    WindowRef windowRef = system->makeWindow(WindowSpec(64, 32));
+    auto window = static_cast<NoneWindow*>(windowRef.get());
+
+    EventRecorder recorder(log);
+    EXPECT_EQ(&recorder, EventQueue::instance());
+
+    queue->setNow(1000);
+    window->injectMouse(Event::MouseMove, gfx::Point(-5, 6));
+    queue->advance(16);
+    window->injectKey(Event::KeyDown, kKeyA, 'a');
+    queue->advance(100);
+    window->injectWheel(gfx::Point(7, 8), gfx::Point(0, -3), true);
+
+    Event filesChanged;
+    filesChanged.setType(Event::FilesChanged);
+    filesChanged.setFiles({ "a.txt", "b.txt" });
+    filesChanged.setFileChangeTypes({ base::FileChange::Type::Deleted,
+                                      base::FileChange::Type::Modified });
+    queue_event(filesChanged);
+
+    // Callbacks are not recorded
+    Event callback;
+    callback.setType(Event::Callback);
+    callback.setCallback([] {});
+    queue_event(callback);
+
+    Event ev;
+    for (int i = 0; i < 5; ++i)
+      recorder.getEvent(ev, 0.0);
+    EXPECT_EQ(4, recorder.recordedEvents());
+  }
+
+  SystemRef system = System::makeNone();
+  auto none = static_cast<NoneSystem*>(system.get());
+  WindowRef window = system->makeWindow(WindowSpec(64, 32));
+
+  EventPlayer player(log, EventPlayer::Timing::AsFastAsPossible);
+  ASSERT_TRUE(player.isValid());
+  EXPECT_EQ(&player, EventQueue::instance());
+  EXPECT_EQ(4, player.totalEvents());
+  player.setWindow(1, window);
+
+  Event ev;
+  EventQueue* events = EventQueue::instance();
+  events->getEvent(ev);
+  EXPECT_EQ(Event::MouseMove, ev.type());
+  EXPECT_EQ(window, ev.window());
+  EXPECT_EQ(gfx::Point(-5, 6), ev.position());
+  EXPECT_EQ(kKeyNoneModifier, ev.modifiers());
+  // Only one event is queued at a time
+  EXPECT_TRUE(none->noneEventQueue()->isEmpty());
+  EXPECT_EQ(0, player.playedEvents());
+
+  events->getEvent(ev);
+  EXPECT_EQ(Event::KeyDown, ev.type());
+  EXPECT_EQ(kKeyA, ev.scancode());
+  EXPECT_EQ('a', ev.unicodeChar());
+  EXPECT_EQ(1, player.playedEvents());
+
+  events->getEvent(ev);
+  EXPECT_EQ(Event::MouseWheel, ev.type());
+  EXPECT_EQ(gfx::Point(7, 8), ev.position());
+  EXPECT_EQ(gfx::Point(0, -3), ev.wheelDelta());
+  EXPECT_TRUE(ev.preciseWheel());
+  // Relative times are preserved (+1 as 0 means "no time")
+  EXPECT_EQ(117, ev.time());
+  EXPECT_FALSE(player.isFinished());
+
+  events->getEvent(ev);
+  EXPECT_EQ(Event::FilesChanged, ev.type());
+  EXPECT_EQ(base::paths({ "a.txt", "b.txt" }), ev.files());
+  ASSERT_EQ(2, ev.fileChangeTypes().size());
+  EXPECT_EQ(base::FileChange::Type::Deleted, ev.fileChangeTypes()[0]);
+  EXPECT_EQ(base::FileChange::Type::Modified, ev.fileChangeTypes()[1]);
+
+  events->getEvent(ev, 0.0);
+  EXPECT_EQ(Event::None, ev.type());
+  EXPECT_TRUE(player.isFinished());
+  EXPECT_EQ(4, player.latency().count());
+  EXPECT_EQ(1, player.latency(Event::KeyDown).count());
+  EXPECT_EQ(0, player.latency(Event::KeyUp).count());
+  EXPECT_NE(std::string::npos, player.report().find("MouseWheel"));
+}
+
+TEST(EventRecording, PointerSamples)
+{
+  std::stringstream log;
+  {
+    SystemRef system = System::makeNone();
+    auto none = static_cast<NoneSystem*>(system.get());
+    EventRecorder recorder(log);
+
+    Event ev;
+    ev.setType(Event::MouseEnter);
+    none->noneEventQueue()->setNow(1000);
+    queue_event(ev);
+
+    ev.setType(Event::MouseMove);
+    ev.setPointerType(PointerType::Pen);
+    for (int i = 0; i < 3; ++i) {
+      PointerSample sample;
+      sample.position = gfx::PointF(1.5f + i, 4.25f);
+      sample.pressure = 0.25f * (i + 1);
+      sample.tiltX = -0.5f;
+      sample.tiltY = 0.125f * i;
+      sample.time = 1040 + 4 * i;
+      ev.addPointerSample(sample);
+    }
+    none->noneEventQueue()->setNow(1050);
+    queue_event(ev);
+
+    for (int i = 0; i < 2; ++i)
+      recorder.getEvent(ev, 0.0);
+    EXPECT_EQ(2, recorder.recordedEvents());
+  }
+
+  SystemRef system = System::makeNone();
+  EventPlayer player(log, EventPlayer::Timing::AsFastAsPossible);
+  ASSERT_TRUE(player.isValid());
+
+  Event ev;
+  EventQueue::instance()->getEvent(ev);
+  EXPECT_EQ(Event::MouseEnter, ev.type());
+  EXPECT_TRUE(ev.pointerSamples().empty());
+
+  EventQueue::instance()->getEvent(ev);
+  EXPECT_EQ(Event::MouseMove, ev.type());
+  EXPECT_EQ(PointerType::Pen, ev.pointerType());
+  ASSERT_EQ(3, ev.pointerSamples().size());
+  // Sample times are relative to the replayed event time (+1 as 0
+  // means "no time")
+  EXPECT_EQ(51, ev.time());
+  for (int i = 0; i < 3; ++i) {
+    const PointerSample& sample = ev.pointerSamples()[i];
+    EXPECT_EQ(gfx::PointF(1.5f + i, 4.25f), sample.position);
+    EXPECT_EQ(0.25f * (i + 1), sample.pressure);
+    EXPECT_EQ(-0.5f, sample.tiltX);
+    EXPECT_EQ(0.125f * i, sample.tiltY);
+    EXPECT_EQ(41 + 4 * i, sample.time);
+  }
+}
+
+TEST(EventRecording, WindowIds)
+{
+  std::stringstream log;
+  {
+    SystemRef system = System::makeNone();
+    EventRecorder recorder(log);
+    Event ev;
+
+    // Each window has its own ID even if the first window is
+    // destroyed before the second one is created
+    for (int i = 0; i < 2; ++i) {
+      WindowRef window = system->makeWindow(WindowSpec(64, 32));
+      static_cast<NoneWindow*>(window.get())->injectMouse(Event::MouseMove, gfx::Point(i, 0));
+      recorder.getEvent(ev, 0.0);
+      ev = Event();
+    }
+    EXPECT_EQ(2, recorder.recordedEvents());
+  }
+
+  SystemRef system = System::makeNone();
+  WindowRef window1 = system->makeWindow(WindowSpec(64, 32));
+  WindowRef window2 = system->makeWindow(WindowSpec(64, 32));
+
+  EventPlayer player(log, EventPlayer::Timing::AsFastAsPossible);
+  ASSERT_TRUE(player.isValid());
+  player.setWindow(1, window1);
+  player.setWindow(2, window2);
+
+  Event ev;
+  EventQueue::instance()->getEvent(ev);
+  EXPECT_EQ(window1, ev.window());
+  EventQueue::instance()->getEvent(ev);
+  EXPECT_EQ(window2, ev.window());
+}
+
+#endif // !LAF_SKIA
+
+int app_main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,103 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <gtest/gtest.h>
+
+#include "base/concurrent_queue.h"
+#include "os/event.h"
+
+using namespace os;
+
+namespace {
+
+Event make_pen_event(Event::Type type, float x, float y, float pressure, base::tick_t time)
+{
+  PointerSample sample;
+  sample.position = gfx::PointF(x, y);
+  sample.pressure = pressure;
+  sample.time = time;
+
+  Event ev;
+  ev.setType(type);
+  ev.setPointerType(PointerType::Pen);
+  ev.setModifiers(kKeyNoneModifier);
+  ev.setPosition(gfx::Point(sample.position));
+  ev.setPressure(pressure);
+  ev.addPointerSample(sample);
+  return ev;
+}
+
+void queue_event(base::concurrent_queue<Event>& queue, const Event& ev)
+{
+  queue.push_or_merge(ev, [](Event& last, const Event& next) { return last.mergeMouseMove(next); });
+}
+
+} // anonymous namespace
+
+TEST(Event, MergeMouseMove)
+{
+  base::concurrent_queue<Event> queue;
+  queue_event(queue, make_pen_event(Event::MouseDown, 1, 1, 0.1f, 10));
+  queue_event(queue, make_pen_event(Event::MouseMove, 2, 2, 0.2f, 11));
+  queue_event(queue, make_pen_event(Event::MouseMove, 3.5f, 3, 0.3f, 12));
+  queue_event(queue, make_pen_event(Event::MouseMove, 4, 4, 0.4f, 13));
+  EXPECT_EQ(2, queue.size());
+
+  Event ev;
+  ASSERT_TRUE(queue.try_pop(ev));
+  EXPECT_EQ(Event::MouseDown, ev.type());
+  EXPECT_EQ(1, ev.pointerSamples().size());
+
+  // The MouseMove is the last one with all samples
+  ASSERT_TRUE(queue.try_pop(ev));
+  EXPECT_EQ(Event::MouseMove, ev.type());
+  EXPECT_EQ(gfx::Point(4, 4), ev.position());
+  EXPECT_EQ(0.4f, ev.pressure());
+  ASSERT_EQ(3, ev.pointerSamples().size());
+  EXPECT_EQ(gfx::PointF(2, 2), ev.pointerSamples()[0].position);
+  EXPECT_EQ(gfx::PointF(3.5f, 3), ev.pointerSamples()[1].position);
+  EXPECT_EQ(0.3f, ev.pointerSamples()[1].pressure);
+  EXPECT_EQ(13, ev.pointerSamples()[2].time);
+
+  // A delivered event is not modified anymore
+  queue_event(queue, make_pen_event(Event::MouseMove, 5, 5, 0.5f, 14));
+  EXPECT_EQ(3, ev.pointerSamples().size());
+  EXPECT_EQ(1, queue.size());
+}
+
+TEST(Event, DontMergeMouseMove)
+{
+  Event a = make_pen_event(Event::MouseMove, 1, 1, 0.1f, 10);
+
+  // Different modifiers
+  Event b = make_pen_event(Event::MouseMove, 2, 2, 0.2f, 11);
+  b.setModifiers(kKeyShiftModifier);
+  EXPECT_FALSE(a.mergeMouseMove(b));
+
+  // Different pointer
+  b = make_pen_event(Event::MouseMove, 2, 2, 0.2f, 11);
+  b.setPointerType(PointerType::Eraser);
+  EXPECT_FALSE(a.mergeMouseMove(b));
+
+  // Mouse events without samples
+  Event c;
+  c.setType(Event::MouseMove);
+  EXPECT_FALSE(a.mergeMouseMove(c));
+  EXPECT_FALSE(c.mergeMouseMove(a));
+
+  EXPECT_EQ(1, a.pointerSamples().size());
+  EXPECT_EQ(gfx::Point(1, 1), a.position());
+}
+
+int app_main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,28 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OS_FILE_WATCHER_H_INCLUDED
+#define OS_FILE_WATCHER_H_INCLUDED
+#pragma once
+
+#include "base/file_watcher.h"
+
+namespace os {
+
+// Queues an Event::FilesChanged event with the paths and the type of
+// change of each item of the given batch of changes (an empty path
+// means that some changes were lost, see
+// base::FileChange::Type::Overflow). It can be used directly as the
+// callback of a base::FileWatcher to process file changes in the UI
+// thread:
+//
+//   base::FileWatcher watcher(os::queue_file_changes);
+//
+void queue_file_changes(const base::FileChanges& changes);
+
+} // namespace os
+
+#endif
@@ -0,0 +1,163 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <gtest/gtest.h>
+
+#if !LAF_SKIA
+
+  #include "base/thread.h"
+  #include "os/event.h"
+  #include "os/event_queue.h"
+  #include "os/none/surface.h"
+  #include "os/none/system.h"
+
+  #include <atomic>
+  #include <cstdio>
+  #include <map>
+  #include <string>
+  #include <thread>
+
+using namespace os;
+
+namespace {
+
+// Blocks the decoding threads until it's released
+struct Blocker {
+  std::atomic<bool> blocked = true;
+  std::atomic<int> waiting = 0;
+  std::atomic<bool> destroyed = false; // The TestSystem was destroyed
+};
+
+// Loads surfaces of the size specified in the filename ("WxH")
+class TestSystem : public NoneSystem {
+public:
+  ~TestSystem()
+  {
+    // loadSurface() can be running in other threads
+    stopDecoding();
+    if (blocker)
+      blocker->destroyed = true;
+  }
+
+  SurfaceRef loadSurface(const char* filename) override
+  {
+    ++loads;
+    EXPECT_NE(mainThread, std::this_thread::get_id());
+
+    if (blocker) {
+      ++blocker->waiting;
+      while (blocker->blocked)
+        base::this_thread::sleep_for(0.001);
+      EXPECT_FALSE(blocker->destroyed);
+    }
+
+    int w = 0, h = 0;
+    if (std::sscanf(filename, "%dx%d", &w, &h) != 2)
+      return nullptr;
+    return os::make_ref<NoneSurface>(w, h, nullptr);
+  }
+
+  std::thread::id mainThread = std::this_thread::get_id();
+  std::atomic<int> loads = 0;
+  Blocker* blocker = nullptr;
+};
+
+// Processes events until "n" callbacks were called (or a timeout)
+void process_callbacks(System* system, const int n, int& called)
+{
+  for (int i = 0; i < 500 && called < n; ++i) {
+    Event ev;
+    system->eventQueue()->getEvent(ev);
+    if (ev.type() == Event::Callback)
+      ev.execCallback();
+    else
+      base::this_thread::sleep_for(0.01);
+  }
+}
+
+} // anonymous namespace
+
+TEST(LoadSurfaceAsync, Callbacks)
+{
+  auto system = make_ref<TestSystem>();
+  const std::thread::id mainThread = std::this_thread::get_id();
+
+  std::map<std::string, gfx::Size> sizes;
+  int called = 0;
+  auto load = [&](const char* filename, const gfx::Size& targetSize) {
+    system->loadSurfaceAsync(filename,
+                             targetSize,
+                             [&, fn = std::string(filename)](const SurfaceRef& sur) {
+                               EXPECT_EQ(mainThread, std::this_thread::get_id());
+                               sizes[fn] = (sur ? sur->bounds().size() : gfx::Size(-1, -1));
+                               ++called;
+                             });
+  };
+
+  load("200x100", gfx::Size());
+  load("200x100 fit", gfx::Size(50, 50));
+  load("10x20 small", gfx::Size(50, 50)); // Not scaled up
+  load("1000x2 thin", gfx::Size(100, 100));
+  load("invalid", gfx::Size(50, 50));
+
+  // Callbacks are called only when events are processed
+  process_callbacks(system.get(), 5, called);
+  EXPECT_EQ(5, called);
+  EXPECT_EQ(5, system->loads);
+
+  EXPECT_EQ(gfx::Size(200, 100), sizes["200x100"]);
+  EXPECT_EQ(gfx::Size(50, 25), sizes["200x100 fit"]);
+  EXPECT_EQ(gfx::Size(10, 20), sizes["10x20 small"]);
+  EXPECT_EQ(gfx::Size(500, 1), sizes["1000x2 thin"]);
+  EXPECT_EQ(gfx::Size(-1, -1), sizes["invalid"]);
+}
+
+TEST(LoadSurfaceAsync, DestroySystem)
+{
+  Blocker blocker;
+  int called = 0;
+
+  auto system = make_ref<TestSystem>();
+  system->blocker = &blocker;
+  for (int i = 0; i < 100; ++i)
+    system->loadSurfaceAsync("64x64", gfx::Size(), [&called](const SurfaceRef&) { ++called; });
+
+  // Destroy the system while some decodes are running (they are
+  // released a little later from other thread)
+  while (blocker.waiting == 0)
+    base::this_thread::sleep_for(0.001);
+  std::thread releaser([&blocker] {
+    base::this_thread::sleep_for(0.05);
+    blocker.blocked = false;
+  });
+  system.reset();
+  releaser.join();
+
+  // Running decodes were waited, pending ones were discarded
+  EXPECT_LT(blocker.waiting, 100);
+
+  // Callbacks are never called after the system is destroyed
+  for (int i = 0; i < 10; ++i) {
+    Event ev;
+    EventQueue::instance()->getEvent(ev, 0.0);
+    if (ev.type() == Event::Callback)
+      ev.execCallback();
+    base::this_thread::sleep_for(0.01);
+  }
+  EXPECT_EQ(0, called);
+}
+
+#endif // !LAF_SKIA
+
+int app_main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,49 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "os/none/event_queue.h"
+
+namespace os {
+
+void NoneEventQueue::onGetEvent(Event& ev, double timeout)
+{
+  ev.setWindow(nullptr);
+
+  if (m_events.try_pop(ev)) {
+    // The virtual clock never goes backward
+    base::tick_t now = m_now;
+    while (ev.time() > now && !m_now.compare_exchange_weak(now, ev.time())) {
+    }
+    return;
+  }
+
+  ev.setType(Event::None);
+  if (timeout > 0.0)
+    advance(base::tick_t(timeout * 1000.0));
+}
+
+void NoneEventQueue::queueEvent(const Event& ev)
+{
+  if (ev.time() == 0) {
+    Event copy(ev);
+    copy.setTime(m_now);
+    m_events.push(copy);
+  }
+  else {
+    m_events.push(ev);
+  }
+}
+
+void NoneEventQueue::clearEvents()
+{
+  m_events.clear();
+}
+
+} // namespace os
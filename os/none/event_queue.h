@@ -0,0 +1,57 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OS_NONE_EVENT_QUEUE_H_INCLUDED
+#define OS_NONE_EVENT_QUEUE_H_INCLUDED
+#pragma once
+
+#include "base/concurrent_queue.h"
+#include "base/time.h"
+#include "os/event.h"
+#include "os/event_queue.h"
+
+#include <atomic>
+
+namespace os {
+
+// Headless event queue (without a platform-specific event loop) used
+// by the "none" backend to run UI loops in a deterministic way: all
+// events are injected with queueEvent() (e.g. from NoneWindow
+// functions) and stamped with the time of a virtual clock that is
+// only advanced explicitly (or when events with a future time are
+// received).
+class NoneEventQueue : public EventQueue {
+public:
+  // Events without time (Event::time() == 0) are stamped with the
+  // current virtual time.
+  void queueEvent(const Event& ev) override;
+  void clearEvents() override;
+
+  bool isEmpty() const { return m_events.empty(); }
+  size_t size() const { return m_events.size(); }
+
+  // Virtual clock in milliseconds (starts at 0).
+  base::tick_t now() const { return m_now; }
+  void setNow(base::tick_t now) { m_now = now; }
+  void advance(base::tick_t msecs) { m_now += msecs; }
+
+protected:
+  // Never waits for new events: if the queue is empty an
+  // Event::None is returned and the virtual clock is advanced
+  // "timeout" seconds (if it's not kWithoutTimeout).
+  void onGetEvent(Event& ev, double timeout) override;
+
+  // Timers use the virtual clock
+  base::tick_t currentTick() const override { return m_now; }
+
+private:
+  base::concurrent_queue<Event> m_events;
+  std::atomic<base::tick_t> m_now = 0;
+};
+
+} // namespace os
+
+#endif
@@ -0,0 +1,44 @@
+// LAF OS Library
+// Copyright (c) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OS_NONE_SCREEN_H
+#define OS_NONE_SCREEN_H
+#pragma once
+
+#include "os/screen.h"
+
+namespace os {
+
+// Virtual screen for headless windows (its bounds/workarea can be
+// changed to test different screen configurations).
+class NoneScreen : public Screen {
+public:
+  NoneScreen(const gfx::Rect& bounds, const os::ColorSpaceRef& colorSpace)
+    : m_bounds(bounds)
+    , m_workarea(bounds)
+    , m_colorSpace(colorSpace)
+  {
+  }
+
+  bool isMainScreen() const override { return true; }
+  gfx::Rect bounds() const override { return m_bounds; }
+  gfx::Rect workarea() const override { return m_workarea; }
+  os::ColorSpaceRef colorSpace() const override { return m_colorSpace; }
+  void* nativeHandle() const override { return nullptr; }
+
+  void setBounds(const gfx::Rect& bounds) { m_bounds = bounds; }
+  void setWorkarea(const gfx::Rect& workarea) { m_workarea = workarea; }
+  void setColorSpace(const os::ColorSpaceRef& colorSpace) { m_colorSpace = colorSpace; }
+
+private:
+  gfx::Rect m_bounds;
+  gfx::Rect m_workarea;
+  os::ColorSpaceRef m_colorSpace;
+};
+
+} // namespace os
+
+#endif
@@ -0,0 +1,1174 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "os/none/surface.h"
+
+#include "base/debug.h"
+#include "base/exception.h"
+#include "gfx/clip.h"
+#include "gfx/color_space_converter.h"
+#include "gfx/path.h"
+#include "gfx/pixel_conversion.h"
+#include "os/paint.h"
+#include "os/sampling.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace os {
+
+namespace {
+
+//////////////////////////////////////////////////////////////////////
+// Premultiplied pixels
+
+inline int mul_un8(const int a, const int b)
+{
+  const int t = a * b + 0x80;
+  return ((t >> 8) + t) >> 8;
+}
+
+// Multiplies the four components of a pixel by a/255
+inline uint32_t scale_pixel(const uint32_t c, const int a)
+{
+  uint32_t rb = (c & 0x00ff00ff) * a + 0x00800080;
+  rb = ((rb + ((rb >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+  uint32_t ag = ((c >> 8) & 0x00ff00ff) * a + 0x00800080;
+  ag = (ag + ((ag >> 8) & 0x00ff00ff)) & 0xff00ff00;
+  return rb | ag;
+}
+
+inline uint32_t premultiply(const gfx::Color c)
+{
+  const int a = gfx::geta(c);
+  if (a == 255)
+    return c;
+  if (a == 0)
+    return 0;
+  return gfx::rgba(mul_un8(gfx::getr(c), a), mul_un8(gfx::getg(c), a), mul_un8(gfx::getb(c), a), a);
+}
+
+inline gfx::Color unpremultiply(const uint32_t c)
+{
+  const int a = gfx::geta(c);
+  if (a == 255)
+    return c;
+  if (a == 0)
+    return 0;
+  return gfx::rgba(std::min(255, (gfx::getr(c) * 255 + a / 2) / a),
+                   std::min(255, (gfx::getg(c) * 255 + a / 2) / a),
+                   std::min(255, (gfx::getb(c) * 255 + a / 2) / a),
+                   a);
+}
+
+inline uint32_t src_over(const uint32_t s, const uint32_t d)
+{
+  return s + scale_pixel(d, 255 - (s >> 24));
+}
+
+// Returns "d" when cov=0 and "r" when cov=255
+inline uint32_t lerp_pixel(const uint32_t d, const uint32_t r, const int cov)
+{
+  return scale_pixel(r, cov) + scale_pixel(d, 255 - cov);
+}
+
+// Generic blend of premultiplied pixels. Blend modes that aren't
+// supported yet (Overlay, ColorDodge, ColorBurn, HardLight,
+// SoftLight, and the non-separable modes) are drawn as SrcOver.
+uint32_t blend_pixel(const BlendMode mode, const uint32_t s, const uint32_t d)
+{
+  switch (mode) {
+    case BlendMode::Clear:   return 0;
+    case BlendMode::Src:     return s;
+    case BlendMode::Dst:     return d;
+    case BlendMode::SrcOver: return src_over(s, d);
+    case BlendMode::DstOver: return src_over(d, s);
+    case BlendMode::SrcIn:   return scale_pixel(s, d >> 24);
+    case BlendMode::DstIn:   return scale_pixel(d, s >> 24);
+    case BlendMode::SrcOut:  return scale_pixel(s, 255 - (d >> 24));
+    case BlendMode::DstOut:  return scale_pixel(d, 255 - (s >> 24));
+    case BlendMode::SrcATop:
+    case BlendMode::DstATop:
+    case BlendMode::Xor:
+    case BlendMode::Plus:
+    case BlendMode::Modulate:
+    case BlendMode::Screen:
+    case BlendMode::Darken:
+    case BlendMode::Lighten:
+    case BlendMode::Difference:
+    case BlendMode::Exclusion:
+    case BlendMode::Multiply: break;
+    default:                 return src_over(s, d);
+  }
+
+  const int sa = s >> 24;
+  const int da = d >> 24;
+  auto channel = [mode, sa, da](const int sc, const int dc) -> int {
+    switch (mode) {
+      case BlendMode::SrcATop:    return mul_un8(sc, da) + mul_un8(dc, 255 - sa);
+      case BlendMode::DstATop:    return mul_un8(dc, sa) + mul_un8(sc, 255 - da);
+      case BlendMode::Xor:        return mul_un8(sc, 255 - da) + mul_un8(dc, 255 - sa);
+      case BlendMode::Plus:       return sc + dc;
+      case BlendMode::Modulate:   return mul_un8(sc, dc);
+      case BlendMode::Screen:     return sc + dc - mul_un8(sc, dc);
+      case BlendMode::Darken:     return sc + dc - std::max(mul_un8(sc, da), mul_un8(dc, sa));
+      case BlendMode::Lighten:    return sc + dc - std::min(mul_un8(sc, da), mul_un8(dc, sa));
+      case BlendMode::Difference: return sc + dc - 2 * std::min(mul_un8(sc, da), mul_un8(dc, sa));
+      case BlendMode::Exclusion:  return sc + dc - 2 * mul_un8(sc, dc);
+      case BlendMode::Multiply:
+        return mul_un8(sc, 255 - da) + mul_un8(dc, 255 - sa) + mul_un8(sc, dc);
+      default: return sc;
+    }
+  };
+
+  int a;
+  switch (mode) {
+    case BlendMode::Darken:
+    case BlendMode::Lighten:
+    case BlendMode::Difference:
+    case BlendMode::Exclusion:
+    case BlendMode::Multiply:   a = sa + da - mul_un8(sa, da); break;
+    default:                    a = channel(sa, da); break;
+  }
+  a = std::clamp(a, 0, 255);
+  return gfx::rgba(std::clamp(channel(gfx::getr(s), gfx::getr(d)), 0, a),
+                   std::clamp(channel(gfx::getg(s), gfx::getg(d)), 0, a),
+                   std::clamp(channel(gfx::getb(s), gfx::getb(d)), 0, a),
+                   a);
+}
+
+// Blends a premultiplied "color" in "n" pixels with the given
+// coverage (nullptr = fully covered).
+void blend_span(uint32_t* d, const int n, const uint32_t color, const uint8_t* cov, BlendMode mode)
+{
+  if (mode == BlendMode::SrcOver) {
+    if (!cov) {
+      if ((color >> 24) == 255)
+        std::fill(d, d + n, color);
+      else {
+        for (int i = 0; i < n; ++i)
+          d[i] = src_over(color, d[i]);
+      }
+    }
+    else {
+      for (int i = 0; i < n; ++i) {
+        if (const int c = cov[i])
+          d[i] = src_over(c == 255 ? color : scale_pixel(color, c), d[i]);
+      }
+    }
+  }
+  else if (mode == BlendMode::Src && !cov) {
+    std::fill(d, d + n, color);
+  }
+  else {
+    for (int i = 0; i < n; ++i) {
+      const int c = (cov ? cov[i] : 255);
+      if (c == 0)
+        continue;
+      const uint32_t r = blend_pixel(mode, color, d[i]);
+      d[i] = (c == 255 ? r : lerp_pixel(d[i], r, c));
+    }
+  }
+}
+
+// Blends "n" premultiplied source pixels
+void blend_row(uint32_t* d, const uint32_t* s, const int n, const uint8_t* cov, BlendMode mode)
+{
+  for (int i = 0; i < n; ++i) {
+    const int c = (cov ? cov[i] : 255);
+    if (c == 0)
+      continue;
+    uint32_t r;
+    switch (mode) {
+      case BlendMode::Src:     r = s[i]; break;
+      case BlendMode::SrcOver: r = src_over(s[i], d[i]); break;
+      default:                 r = blend_pixel(mode, s[i], d[i]); break;
+    }
+    d[i] = (c == 255 ? r : lerp_pixel(d[i], r, c));
+  }
+}
+
+// Bilinear interpolation of premultiplied pixels (weights in [0, 256])
+inline uint32_t bilinear(const uint32_t p00,
+                         const uint32_t p10,
+                         const uint32_t p01,
+                         const uint32_t p11,
+                         const int wx,
+                         const int wy)
+{
+  auto lerp = [](const uint32_t a, const uint32_t b, const int w) -> uint32_t {
+    const uint32_t rb = ((a & 0x00ff00ff) * (256 - w) + (b & 0x00ff00ff) * w) >> 8;
+    const uint32_t ag = (((a >> 8) & 0x00ff00ff) * (256 - w) + ((b >> 8) & 0x00ff00ff) * w);
+    return (rb & 0x00ff00ff) | (ag & 0xff00ff00);
+  };
+  return lerp(lerp(p00, p10, wx), lerp(p01, p11, wx), wy);
+}
+
+gfx::Path make_circle_path(const float cx, const float cy, const float r)
+{
+  // Four cubic Bézier curves (same constant as Skia)
+  const float k = r * 0.5522847498f;
+  gfx::Path path;
+  path.moveTo(cx + r, cy);
+  path.cubicTo(cx + r, cy + k, cx + k, cy + r, cx, cy + r);
+  path.cubicTo(cx - k, cy + r, cx - r, cy + k, cx - r, cy);
+  path.cubicTo(cx - r, cy - k, cx - k, cy - r, cx, cy - r);
+  path.cubicTo(cx + k, cy - r, cx + r, cy - k, cx + r, cy);
+  path.close();
+  return path;
+}
+
+gfx::Path make_rect_path(const gfx::RectF& rc)
+{
+  gfx::Path path;
+  path.moveTo(rc.x, rc.y);
+  path.lineTo(rc.x2(), rc.y);
+  path.lineTo(rc.x2(), rc.y2());
+  path.lineTo(rc.x, rc.y2());
+  path.close();
+  return path;
+}
+
+// Rounds the edges of a device rectangle (like Skia does to fill
+// non-antialiased rectangles)
+gfx::Rect round_rect(const gfx::RectF& rc)
+{
+  const int x1 = int(std::floor(rc.x + 0.5f));
+  const int y1 = int(std::floor(rc.y + 0.5f));
+  const int x2 = int(std::floor(rc.x2() + 0.5f));
+  const int y2 = int(std::floor(rc.y2() + 0.5f));
+  return gfx::Rect(x1, y1, x2 - x1, y2 - y1);
+}
+
+bool is_integral(const gfx::RectF& rc)
+{
+  return (rc.x == std::floor(rc.x) && rc.y == std::floor(rc.y) && rc.w == std::floor(rc.w) &&
+          rc.h == std::floor(rc.h));
+}
+
+// Converts the non-antialiased spans of a rasterized path to a
+// gfx::Region (rows with the same spans are joined in one band).
+class RegionBuilder {
+public:
+  void addRow(const int y, const int x, const int len, const uint8_t* cov)
+  {
+    if (m_hasRow && y != m_y)
+      commitRow();
+    m_y = y;
+    m_hasRow = true;
+
+    for (int i = 0; i < len;) {
+      if (cov[i] == 0) {
+        ++i;
+        continue;
+      }
+      const int begin = i;
+      while (i < len && cov[i])
+        ++i;
+      m_row.push_back(x + begin);
+      m_row.push_back(x + i);
+    }
+  }
+
+  gfx::Region finish()
+  {
+    if (m_hasRow)
+      commitRow();
+    flush();
+    return std::move(m_region);
+  }
+
+private:
+  void commitRow()
+  {
+    if (m_bandH > 0 && m_y == m_bandY + m_bandH && m_row == m_band) {
+      ++m_bandH;
+    }
+    else {
+      flush();
+      m_band.swap(m_row);
+      m_bandY = m_y;
+      m_bandH = 1;
+    }
+    m_row.clear();
+  }
+
+  void flush()
+  {
+    for (size_t i = 0; i + 1 < m_band.size(); i += 2)
+      m_region |= gfx::Region(gfx::Rect(m_band[i], m_bandY, m_band[i + 1] - m_band[i], m_bandH));
+    m_band.clear();
+    m_bandH = 0;
+  }
+
+  gfx::Region m_region;
+  std::vector<int> m_row;
+  std::vector<int> m_band;
+  int m_y = 0;
+  bool m_hasRow = false;
+  int m_bandY = 0;
+  int m_bandH = 0;
+};
+
+gfx::ColorSpaceConverterRef make_converter(const ColorSpaceRef& from, const ColorSpaceRef& to)
+{
+  if (!from || !to || from.get() == to.get())
+    return nullptr;
+  auto converter = gfx::ColorSpaceConverter::Make(from->gfxColorSpace(), to->gfxColorSpace());
+  if (converter && converter->isIdentity())
+    return nullptr;
+  return converter;
+}
+
+// Rec. 709 luma from a straight (not premultiplied) color
+inline uint8_t luma(const gfx::Color c)
+{
+  return uint8_t((54 * gfx::getr(c) + 183 * gfx::getg(c) + 19 * gfx::getb(c) + 128) >> 8);
+}
+
+} // anonymous namespace
+
+// static
+Surface::ColorChannelsOrder Surface::getNativeColorChannelsOrder()
+{
+  return ColorChannelsOrder::RGB;
+}
+
+NoneSurface::NoneSurface(const int width,
+                         const int height,
+                         const os::ColorSpaceRef& cs,
+                         const bool opaque)
+  : m_width(width)
+  , m_height(height)
+  , m_opaque(opaque)
+  , m_colorSpace(cs)
+  , m_lock(0)
+{
+  ASSERT(width > 0);
+  ASSERT(height > 0);
+
+  m_buffer.reset(new (std::nothrow) uint32_t[size_t(width) * height]);
+  if (!m_buffer)
+    throw base::Exception("Cannot create surface");
+
+  m_pixels = m_buffer.get();
+  m_stride = width;
+  std::fill(m_pixels, m_pixels + size_t(width) * height, 0);
+  m_state.clip = gfx::Region(bounds());
+}
+
+NoneSurface::NoneSurface(const NoneSurface* parent, const gfx::Rect& rc)
+  : m_width(rc.w)
+  , m_height(rc.h)
+  , m_opaque(parent->m_opaque)
+  , m_buffer(parent->m_buffer)
+  , m_pixels(parent->row(rc.y) + rc.x)
+  , m_stride(parent->m_stride)
+  , m_colorSpace(parent->m_colorSpace)
+  , m_lock(0)
+{
+  m_state.clip = gfx::Region(bounds());
+}
+
+NoneSurface::~NoneSurface()
+{
+  ASSERT(m_lock == 0);
+}
+
+int NoneSurface::getSaveCount() const
+{
+  return int(m_savedStates.size()) + 1;
+}
+
+gfx::Rect NoneSurface::getClipBounds() const
+{
+  return m_state.clip.bounds();
+}
+
+void NoneSurface::saveClip()
+{
+  save();
+}
+
+void NoneSurface::restoreClip()
+{
+  restore();
+}
+
+bool NoneSurface::clipRect(const gfx::Rect& rc)
+{
+  if (m_state.matrix.isScaleTranslate()) {
+    const gfx::Rect dev = round_rect(m_state.matrix.mapRect(gfx::RectF(rc)));
+    if (dev.isEmpty())
+      m_state.clip.clear();
+    else
+      m_state.clip &= gfx::Region(dev);
+  }
+  else {
+    clipPath(make_rect_path(gfx::RectF(rc)));
+  }
+  return !m_state.clip.isEmpty();
+}
+
+void NoneSurface::clipPath(const gfx::Path& path)
+{
+  m_rasterizer.reset(getClipBounds());
+  m_rasterizer.antialias(false);
+  m_rasterizer.addPath(path, m_state.matrix);
+  m_rasterizer.fillType(path.fillType());
+
+  RegionBuilder builder;
+  m_rasterizer.rasterize([&builder](int x, int y, int len, const uint8_t* cov) {
+    builder.addRow(y, x, len, cov);
+  });
+  m_state.clip &= builder.finish();
+}
+
+void NoneSurface::clipRegion(const gfx::Region& region)
+{
+  // Like SkCanvas::clipRegion(), the region is in device coordinates
+  m_state.clip &= region;
+}
+
+void NoneSurface::save()
+{
+  m_savedStates.push_back(m_state);
+}
+
+void NoneSurface::concat(const gfx::Matrix& matrix)
+{
+  m_state.matrix.preConcat(matrix);
+}
+
+void NoneSurface::setMatrix(const gfx::Matrix& matrix)
+{
+  m_state.matrix = matrix;
+}
+
+void NoneSurface::resetMatrix()
+{
+  m_state.matrix.reset();
+}
+
+void NoneSurface::restore()
+{
+  if (m_savedStates.empty())
+    return;
+  m_state = std::move(m_savedStates.back());
+  m_savedStates.pop_back();
+}
+
+gfx::Matrix NoneSurface::matrix() const
+{
+  return m_state.matrix;
+}
+
+void NoneSurface::lock()
+{
+  ASSERT(m_lock >= 0);
+  ++m_lock;
+}
+
+void NoneSurface::unlock()
+{
+  ASSERT(m_lock > 0);
+  // Pixels could be modified with getData()
+  if (--m_lock == 0)
+    resetGenerationId();
+}
+
+SurfaceRef NoneSurface::onApplyScale(const float scaleFactor, const Sampling& sampling)
+{
+  auto result = os::make_ref<NoneSurface>(int(m_width * scaleFactor),
+                                          int(m_height * scaleFactor),
+                                          m_colorSpace,
+                                          m_opaque);
+  result->drawImage(this,
+                    gfx::RectF(bounds()),
+                    gfx::RectF(result->bounds()),
+                    sampling,
+                    BlendMode::Src,
+                    255,
+                    gfx::ColorNone);
+  return result;
+}
+
+SurfaceRef NoneSurface::makeSubsurface(const gfx::Rect& rc)
+{
+  if (rc.isEmpty() || !bounds().contains(rc))
+    return nullptr;
+  return SurfaceRef(new NoneSurface(this, rc));
+}
+
+void NoneSurface::clear()
+{
+  // Like SkCanvas::clear(), only the clipping region is cleared
+  addDeviceDamage(m_state.clip.bounds());
+  for (const gfx::Rect& rc : m_state.clip) {
+    for (int y = rc.y; y < rc.y2(); ++y)
+      std::fill(row(y) + rc.x, row(y) + rc.x2(), 0);
+  }
+}
+
+uint8_t* NoneSurface::getData(int x, int y) const
+{
+  return (uint8_t*)(row(y) + x);
+}
+
+void NoneSurface::getFormat(SurfaceFormatData* formatData) const
+{
+  formatData->format = kRgbaSurfaceFormat;
+  formatData->bitsPerPixel = 32;
+  formatData->redShift = gfx::ColorRShift;
+  formatData->greenShift = gfx::ColorGShift;
+  formatData->blueShift = gfx::ColorBShift;
+  formatData->alphaShift = gfx::ColorAShift;
+  formatData->redMask = gfx::ColorRMask;
+  formatData->greenMask = gfx::ColorGMask;
+  formatData->blueMask = gfx::ColorBMask;
+  formatData->alphaMask = gfx::ColorAMask;
+  formatData->pixelAlpha = (m_opaque ? PixelAlpha::kOpaque : PixelAlpha::kPremultiplied);
+}
+
+gfx::Color NoneSurface::getPixel(int x, int y) const
+{
+  if (x < 0 || y < 0 || x >= m_width || y >= m_height)
+    return 0;
+
+  uint32_t c = row(y)[x];
+  if (m_opaque)
+    c |= gfx::ColorAMask;
+  return unpremultiply(c);
+}
+
+void NoneSurface::putPixel(gfx::Color color, int x, int y)
+{
+  // Like SkiaSurface::putPixel() for bitmaps, the matrix and the
+  // clipping region are ignored.
+  if (x < 0 || y < 0 || x >= m_width || y >= m_height)
+    return;
+
+  row(y)[x] = premultiply(color);
+  addDeviceDamage(gfx::Rect(x, y, 1, 1));
+}
+
+bool NoneSurface::readPixels(const gfx::Rect& rc,
+                             void* dst,
+                             const size_t rowBytes,
+                             const PixelFormat format,
+                             const PixelAlpha alpha,
+                             const ColorSpaceRef& colorSpace) const
+{
+  const gfx::Rect area = rc.createIntersection(bounds());
+  if (area.isEmpty())
+    return false;
+
+  const int bpp = bytes_per_pixel(format);
+  const auto converter = make_converter(m_colorSpace, colorSpace);
+  std::vector<uint32_t> buf(area.w);
+  std::vector<uint16_t> half;
+  if (format == PixelFormat::kRgbaF16)
+    half.resize(4 * area.w);
+
+  for (int y = area.y; y < area.y2(); ++y) {
+    const uint32_t* src = row(y) + area.x;
+    uint8_t* out = (uint8_t*)dst + (y - rc.y) * rowBytes + (area.x - rc.x) * bpp;
+
+    // Fast path: same pixel format (or just swapped R/B)
+    if (!converter && !m_opaque && alpha == PixelAlpha::kPremultiplied) {
+      if (format == PixelFormat::kRgba8888) {
+        std::memcpy(out, src, 4 * area.w);
+        continue;
+      }
+      if (format == PixelFormat::kBgra8888) {
+        gfx::swizzle_rb(src, (uint32_t*)out, area.w);
+        continue;
+      }
+    }
+
+    // Straight colors in the surface color space
+    if (m_opaque) {
+      for (int i = 0; i < area.w; ++i)
+        buf[i] = src[i] | gfx::ColorAMask;
+    }
+    else
+      gfx::unpremultiply_alpha(src, buf.data(), area.w);
+
+    if (format == PixelFormat::kRgbaF16) {
+      for (int i = 0; i < area.w; ++i) {
+        const gfx::Color c = buf[i];
+        const float a = (alpha == PixelAlpha::kOpaque ? 1.0f : gfx::geta(c) / 255.0f);
+        half[4 * i + 0] = gfx::ColorSpaceConverter::FloatToHalf(gfx::getr(c) / 255.0f);
+        half[4 * i + 1] = gfx::ColorSpaceConverter::FloatToHalf(gfx::getg(c) / 255.0f);
+        half[4 * i + 2] = gfx::ColorSpaceConverter::FloatToHalf(gfx::getb(c) / 255.0f);
+        half[4 * i + 3] = gfx::ColorSpaceConverter::FloatToHalf(a);
+      }
+      if (converter)
+        converter->convertRgbaF16(half.data(), half.data(), area.w);
+      if (alpha == PixelAlpha::kPremultiplied) {
+        for (int i = 0; i < area.w; ++i) {
+          const float a = gfx::ColorSpaceConverter::HalfToFloat(half[4 * i + 3]);
+          for (int j = 0; j < 3; ++j) {
+            half[4 * i + j] = gfx::ColorSpaceConverter::FloatToHalf(
+              gfx::ColorSpaceConverter::HalfToFloat(half[4 * i + j]) * a);
+          }
+        }
+      }
+      std::memcpy(out, half.data(), 8 * area.w);
+      continue;
+    }
+
+    if (converter)
+      converter->convertRgba8(buf.data(), buf.data(), area.w);
+
+    switch (format) {
+      case PixelFormat::kRgba8888:
+      case PixelFormat::kBgra8888:
+        switch (alpha) {
+          case PixelAlpha::kOpaque:
+            for (int i = 0; i < area.w; ++i)
+              buf[i] |= gfx::ColorAMask;
+            break;
+          case PixelAlpha::kPremultiplied:
+            gfx::premultiply_alpha(buf.data(), buf.data(), area.w);
+            break;
+          case PixelAlpha::kStraight: break;
+        }
+        if (format == PixelFormat::kRgba8888)
+          std::memcpy(out, buf.data(), 4 * area.w);
+        else
+          gfx::swizzle_rb(buf.data(), (uint32_t*)out, area.w);
+        break;
+      case PixelFormat::kAlpha8:
+        for (int i = 0; i < area.w; ++i)
+          out[i] = (alpha == PixelAlpha::kOpaque ? 255 : gfx::geta(buf[i]));
+        break;
+      case PixelFormat::kGray8:
+        for (int i = 0; i < area.w; ++i)
+          out[i] = luma(buf[i]);
+        break;
+      default: break;
+    }
+  }
+  return true;
+}
+
+bool NoneSurface::writePixels(const gfx::Rect& rc,
+                              const void* src,
+                              const size_t rowBytes,
+                              const PixelFormat format,
+                              const PixelAlpha alpha,
+                              const ColorSpaceRef& colorSpace)
+{
+  const gfx::Rect area = rc.createIntersection(bounds());
+  if (area.isEmpty())
+    return false;
+
+  addDeviceDamage(area);
+
+  const int bpp = bytes_per_pixel(format);
+  const auto converter = make_converter(colorSpace, m_colorSpace);
+  std::vector<uint32_t> buf(area.w);
+  std::vector<uint16_t> half;
+  if (format == PixelFormat::kRgbaF16)
+    half.resize(4 * area.w);
+
+  for (int y = area.y; y < area.y2(); ++y) {
+    const uint8_t* in = (const uint8_t*)src + (y - rc.y) * rowBytes + (area.x - rc.x) * bpp;
+    uint32_t* dst = row(y) + area.x;
+
+    if (!converter && alpha == PixelAlpha::kPremultiplied) {
+      if (format == PixelFormat::kRgba8888) {
+        std::memcpy(dst, in, 4 * area.w);
+        continue;
+      }
+      if (format == PixelFormat::kBgra8888) {
+        gfx::swizzle_rb((const uint32_t*)in, dst, area.w);
+        continue;
+      }
+    }
+
+    if (format == PixelFormat::kRgbaF16) {
+      std::memcpy(half.data(), in, 8 * area.w);
+      for (int i = 0; i < area.w; ++i) {
+        float a = gfx::ColorSpaceConverter::HalfToFloat(half[4 * i + 3]);
+        if (alpha == PixelAlpha::kOpaque)
+          a = 1.0f;
+        else if (alpha == PixelAlpha::kPremultiplied && a > 0.0f) {
+          for (int j = 0; j < 3; ++j) {
+            half[4 * i + j] = gfx::ColorSpaceConverter::FloatToHalf(
+              gfx::ColorSpaceConverter::HalfToFloat(half[4 * i + j]) / a);
+          }
+        }
+        half[4 * i + 3] = gfx::ColorSpaceConverter::FloatToHalf(a);
+      }
+      if (converter)
+        converter->convertRgbaF16(half.data(), half.data(), area.w);
+      for (int i = 0; i < area.w; ++i) {
+        int c[4];
+        for (int j = 0; j < 4; ++j) {
+          const float v = gfx::ColorSpaceConverter::HalfToFloat(half[4 * i + j]);
+          c[j] = int(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+        dst[i] = premultiply(gfx::rgba(c[0], c[1], c[2], c[3]));
+      }
+      continue;
+    }
+
+    // Straight colors in the given color space
+    switch (format) {
+      case PixelFormat::kRgba8888:
+      case PixelFormat::kBgra8888:
+        if (format == PixelFormat::kRgba8888)
+          std::memcpy(buf.data(), in, 4 * area.w);
+        else
+          gfx::swizzle_rb((const uint32_t*)in, buf.data(), area.w);
+
+        if (alpha == PixelAlpha::kOpaque) {
+          for (int i = 0; i < area.w; ++i)
+            buf[i] |= gfx::ColorAMask;
+        }
+        else if (alpha == PixelAlpha::kPremultiplied)
+          gfx::unpremultiply_alpha(buf.data(), buf.data(), area.w);
+        break;
+      case PixelFormat::kAlpha8:
+        for (int i = 0; i < area.w; ++i)
+          buf[i] = gfx::rgba(0, 0, 0, in[i]);
+        break;
+      case PixelFormat::kGray8:
+        for (int i = 0; i < area.w; ++i)
+          buf[i] = gfx::rgba(in[i], in[i], in[i]);
+        break;
+      default: std::fill(buf.begin(), buf.end(), 0); break;
+    }
+
+    if (converter && format != PixelFormat::kAlpha8)
+      converter->convertRgba8(buf.data(), buf.data(), area.w);
+
+    gfx::premultiply_alpha(buf.data(), dst, area.w);
+  }
+  return true;
+}
+
+void NoneSurface::drawLine(const float x0,
+                           const float y0,
+                           const float x1,
+                           const float y1,
+                           const Paint& paint)
+{
+  gfx::Path path;
+  path.moveTo(x0, y0);
+  path.lineTo(x1, y1);
+
+  m_rasterizer.reset(getClipBounds());
+  m_rasterizer.antialias(paint.antialias());
+  m_rasterizer.addStroke(path, m_state.matrix, paint.strokeWidth());
+  fillRasterizer(paint);
+}
+
+void NoneSurface::drawRect(const gfx::RectF& rc, const Paint& paint)
+{
+  // Fast path for filled rectangles aligned to pixels
+  if (paint.style() == Paint::Fill && m_state.matrix.isScaleTranslate()) {
+    const gfx::RectF dev = m_state.matrix.mapRect(rc);
+    if (!paint.antialias() || is_integral(dev)) {
+      fillDeviceRect(round_rect(dev), paint.color(), paint.blendMode());
+      return;
+    }
+  }
+  fillPath(make_rect_path(rc), paint);
+}
+
+void NoneSurface::drawCircle(const float cx, const float cy, const float radius, const Paint& paint)
+{
+  fillPath(make_circle_path(cx, cy, radius), paint);
+}
+
+void NoneSurface::drawPath(const gfx::Path& path, const Paint& paint)
+{
+  fillPath(path, paint);
+}
+
+void NoneSurface::blitTo(Surface* dst,
+                         int srcx,
+                         int srcy,
+                         int dstx,
+                         int dsty,
+                         int width,
+                         int height) const
+{
+  static_cast<NoneSurface*>(dst)->drawImage(this,
+                                            gfx::RectF(srcx, srcy, width, height),
+                                            gfx::RectF(dstx, dsty, width, height),
+                                            Sampling(),
+                                            BlendMode::Src,
+                                            255,
+                                            gfx::ColorNone);
+}
+
+void NoneSurface::scrollTo(const gfx::Rect& rc, int dx, int dy)
+{
+  gfx::Clip clip(rc.x + dx, rc.y + dy, rc);
+  if (!clip.clip(m_width, m_height, m_width, m_height))
+    return;
+
+  int srcY = clip.src.y;
+  int dstY = clip.dst.y;
+  int delta = 1;
+  if (dy > 0) {
+    srcY += clip.size.h - 1;
+    dstY += clip.size.h - 1;
+    delta = -1;
+  }
+  for (int v = 0; v < clip.size.h; ++v, srcY += delta, dstY += delta) {
+    std::memmove(row(dstY) + clip.dst.x,
+                 row(srcY) + clip.src.x,
+                 sizeof(uint32_t) * clip.size.w);
+  }
+  addDeviceDamage(gfx::Rect(clip.dst, clip.size));
+}
+
+void NoneSurface::drawSurface(const Surface* src, int dstx, int dsty)
+{
+  drawImage(static_cast<const NoneSurface*>(src),
+            gfx::RectF(0, 0, src->width(), src->height()),
+            gfx::RectF(dstx, dsty, src->width(), src->height()),
+            Sampling(),
+            BlendMode::Src,
+            255,
+            gfx::ColorNone);
+}
+
+void NoneSurface::drawSurface(const Surface* src,
+                              const gfx::Rect& srcRect,
+                              const gfx::Rect& dstRect,
+                              const Sampling& sampling,
+                              const os::Paint* paint)
+{
+  drawImage(static_cast<const NoneSurface*>(src),
+            gfx::RectF(srcRect),
+            gfx::RectF(dstRect),
+            sampling,
+            (paint ? paint->blendMode() : BlendMode::Src),
+            (paint ? gfx::geta(paint->color()) : 255),
+            gfx::ColorNone);
+}
+
+void NoneSurface::drawRgbaSurface(const Surface* src, int dstx, int dsty)
+{
+  drawImage(static_cast<const NoneSurface*>(src),
+            gfx::RectF(0, 0, src->width(), src->height()),
+            gfx::RectF(dstx, dsty, src->width(), src->height()),
+            Sampling(),
+            BlendMode::SrcOver,
+            255,
+            gfx::ColorNone);
+}
+
+void NoneSurface::drawRgbaSurface(const Surface* src,
+                                  int srcx,
+                                  int srcy,
+                                  int dstx,
+                                  int dsty,
+                                  int w,
+                                  int h)
+{
+  drawImage(static_cast<const NoneSurface*>(src),
+            gfx::RectF(srcx, srcy, w, h),
+            gfx::RectF(dstx, dsty, w, h),
+            Sampling(),
+            BlendMode::SrcOver,
+            255,
+            gfx::ColorNone);
+}
+
+void NoneSurface::drawColoredRgbaSurface(const Surface* src,
+                                         gfx::Color fg,
+                                         gfx::Color bg,
+                                         const gfx::Clip& clip)
+{
+  const gfx::RectF dstRect(clip.dst.x, clip.dst.y, clip.size.w, clip.size.h);
+
+  if (gfx::geta(bg) > 0) {
+    Paint paint;
+    paint.color(bg);
+    paint.style(Paint::Fill);
+    drawRect(dstRect, paint);
+  }
+
+  drawImage(static_cast<const NoneSurface*>(src),
+            gfx::RectF(clip.src.x, clip.src.y, clip.size.w, clip.size.h),
+            dstRect,
+            Sampling(),
+            BlendMode::SrcOver,
+            255,
+            fg);
+}
+
+void NoneSurface::drawSurfaceNine(os::Surface* surface,
+                                  const gfx::Rect& src,
+                                  const gfx::Rect& center,
+                                  const gfx::Rect& dst,
+                                  const bool drawCenter,
+                                  const os::Paint* paint)
+{
+  const gfx::Color tint = (paint && paint->color() != gfx::ColorNone ? paint->color() :
+                                                                      gfx::ColorNone);
+
+  // Columns/rows of the source and destination rectangles
+  const int sx[4] = { src.x, src.x + center.x, src.x + center.x2(), src.x2() };
+  const int sy[4] = { src.y, src.y + center.y, src.y + center.y2(), src.y2() };
+  const int left = center.x;
+  const int right = src.w - center.x2();
+  const int top = center.y;
+  const int bottom = src.h - center.y2();
+  const int dx[4] = { dst.x, dst.x + left, std::max(dst.x + left, dst.x2() - right), dst.x2() };
+  const int dy[4] = { dst.y, dst.y + top, std::max(dst.y + top, dst.y2() - bottom), dst.y2() };
+
+  for (int j = 0; j < 3; ++j) {
+    for (int i = 0; i < 3; ++i) {
+      if (i == 1 && j == 1 && !drawCenter)
+        continue;
+
+      const gfx::RectF srcPart(sx[i], sy[j], sx[i + 1] - sx[i], sy[j + 1] - sy[j]);
+      const gfx::RectF dstPart(dx[i], dy[j], dx[i + 1] - dx[i], dy[j + 1] - dy[j]);
+      drawImage(static_cast<const NoneSurface*>(surface),
+                srcPart,
+                dstPart,
+                Sampling(),
+                BlendMode::SrcOver,
+                255,
+                tint);
+    }
+  }
+}
+
+void NoneSurface::fillRasterizer(const Paint& paint)
+{
+  const uint32_t color = premultiply(paint.color());
+  const BlendMode mode = paint.blendMode();
+  addDeviceDamage(m_rasterizer.bounds());
+
+  if (m_state.clip.isRect()) {
+    // The rasterizer is already clipped to the clip bounds
+    m_rasterizer.rasterize([this, color, mode](int x, int y, int len, const uint8_t* cov) {
+      blend_span(row(y) + x, len, color, cov, mode);
+    });
+  }
+  else if (!m_state.clip.isEmpty()) {
+    m_rasterizer.rasterize([this, color, mode](int x, int y, int len, const uint8_t* cov) {
+      for (const gfx::Rect& rc : m_state.clip) {
+        if (y < rc.y || y >= rc.y2())
+          continue;
+        const int x0 = std::max(x, rc.x);
+        const int x1 = std::min(x + len, rc.x2());
+        if (x0 < x1)
+          blend_span(row(y) + x0, x1 - x0, color, cov + (x0 - x), mode);
+      }
+    });
+  }
+}
+
+void NoneSurface::fillPath(const gfx::Path& path, const Paint& paint)
+{
+  const Paint::Style style = paint.style();
+
+  // StrokeAndFill is drawn in two passes (so the fill and the stroke
+  // can use different winding directions).
+  if (style == Paint::Fill || style == Paint::StrokeAndFill) {
+    m_rasterizer.reset(getClipBounds());
+    m_rasterizer.antialias(paint.antialias());
+    m_rasterizer.addPath(path, m_state.matrix);
+    m_rasterizer.fillType(path.fillType());
+    fillRasterizer(paint);
+  }
+  if (style == Paint::Stroke || style == Paint::StrokeAndFill) {
+    m_rasterizer.reset(getClipBounds());
+    m_rasterizer.antialias(paint.antialias());
+    m_rasterizer.addStroke(path, m_state.matrix, paint.strokeWidth());
+    fillRasterizer(paint);
+  }
+}
+
+void NoneSurface::fillDeviceRect(const gfx::Rect& rc,
+                                 const gfx::Color color,
+                                 const BlendMode blendMode)
+{
+  if (rc.isEmpty())
+    return;
+
+  addDeviceDamage(rc.createIntersection(getClipBounds()));
+
+  const uint32_t premul = premultiply(color);
+  for (const gfx::Rect& clip : m_state.clip) {
+    const gfx::Rect area = clip.createIntersection(rc);
+    for (int y = area.y; y < area.y2(); ++y)
+      blend_span(row(y) + area.x, area.w, premul, nullptr, blendMode);
+  }
+}
+
+void NoneSurface::drawImage(const NoneSurface* src,
+                            const gfx::RectF& srcRect,
+                            const gfx::RectF& dstRect,
+                            const Sampling& sampling,
+                            const BlendMode blendMode,
+                            const int alpha,
+                            const gfx::Color tint)
+{
+  if (!src || srcRect.isEmpty() || dstRect.isEmpty() || m_state.clip.isEmpty())
+    return;
+
+  // Drawing a surface in itself (e.g. blitTo() to scroll), we make a
+  // copy of the source pixels first.
+  Ref<NoneSurface> copy;
+  if (src == this) {
+    copy = os::make_ref<NoneSurface>(m_width, m_height, m_colorSpace, m_opaque);
+    for (int y = 0; y < m_height; ++y)
+      std::copy(row(y), row(y) + m_width, copy->row(y));
+    src = copy.get();
+  }
+
+  // Matrix from source pixels to device pixels
+  gfx::Matrix m = m_state.matrix;
+  m.preTranslate(dstRect.x, dstRect.y);
+  m.preConcat(gfx::Matrix::MakeScale(dstRect.w / srcRect.w, dstRect.h / srcRect.h));
+  m.preTranslate(-srcRect.x, -srcRect.y);
+
+  const gfx::RectF devF = m.mapRect(srcRect);
+  const int devX1 = int(std::floor(devF.x));
+  const int devY1 = int(std::floor(devF.y));
+  const gfx::Rect dev = gfx::Rect(devX1,
+                                  devY1,
+                                  int(std::ceil(devF.x2())) - devX1,
+                                  int(std::ceil(devF.y2())) - devY1)
+                          .createIntersection(getClipBounds());
+
+  // Source pixels that can be sampled
+  const int srcX1 = int(std::floor(srcRect.x));
+  const int srcY1 = int(std::floor(srcRect.y));
+  const gfx::Rect srcBounds = gfx::Rect(srcX1,
+                                        srcY1,
+                                        int(std::ceil(srcRect.x2())) - srcX1,
+                                        int(std::ceil(srcRect.y2())) - srcY1)
+                                .createIntersection(src->bounds());
+  if (dev.isEmpty() || srcBounds.isEmpty())
+    return;
+
+  addDeviceDamage(dev);
+
+  const bool opaqueSrc = src->isOpaque();
+  const uint32_t premulTint = (tint != gfx::ColorNone ? premultiply(tint) : 0);
+  auto modulate = [opaqueSrc, premulTint, tint, alpha](uint32_t p) -> uint32_t {
+    if (opaqueSrc)
+      p |= gfx::ColorAMask;
+    if (tint != gfx::ColorNone)
+      p = scale_pixel(premulTint, p >> 24);
+    if (alpha < 255)
+      p = scale_pixel(p, alpha);
+    return p;
+  };
+  const bool needsModulate = (opaqueSrc || tint != gfx::ColorNone || alpha < 255);
+
+  std::vector<uint32_t> buf(dev.w);
+
+  // Fast path: just an integer translation
+  const float tx = m[gfx::Matrix::kMTransX];
+  const float ty = m[gfx::Matrix::kMTransY];
+  if (m.isTranslate() && tx == std::floor(tx) && ty == std::floor(ty)) {
+    const int dx = int(tx);
+    const int dy = int(ty);
+    const gfx::Rect area = dev.createIntersection(gfx::Rect(srcBounds).offset(dx, dy));
+    for (const gfx::Rect& clip : m_state.clip) {
+      const gfx::Rect rc = clip.createIntersection(area);
+      for (int y = rc.y; y < rc.y2(); ++y) {
+        const uint32_t* s = src->row(y - dy) + (rc.x - dx);
+        uint32_t* d = row(y) + rc.x;
+        if (!needsModulate && blendMode == BlendMode::Src) {
+          std::memcpy(d, s, sizeof(uint32_t) * rc.w);
+        }
+        else {
+          for (int i = 0; i < rc.w; ++i)
+            buf[i] = (needsModulate ? modulate(s[i]) : s[i]);
+          blend_row(d, buf.data(), rc.w, nullptr, blendMode);
+        }
+      }
+    }
+    return;
+  }
+
+  gfx::Matrix inv;
+  if (!m.invert(&inv))
+    return;
+
+  const bool linear = (sampling.filter == Sampling::Filter::Linear || sampling.useCubic ||
+                       sampling.mipmap != Sampling::Mipmap::None);
+  const bool perspective = inv.hasPerspective();
+  const float du = inv[gfx::Matrix::kMScaleX];
+  const float dv = inv[gfx::Matrix::kMSkewY];
+  const int sx1 = srcBounds.x, sx2 = srcBounds.x2() - 1;
+  const int sy1 = srcBounds.y, sy2 = srcBounds.y2() - 1;
+  std::vector<uint8_t> cov(dev.w);
+
+  for (const gfx::Rect& clip : m_state.clip) {
+    const gfx::Rect rc = clip.createIntersection(dev);
+    for (int y = rc.y; y < rc.y2(); ++y) {
+      gfx::PointF p = inv.mapPoint(gfx::PointF(rc.x + 0.5f, y + 0.5f));
+      for (int i = 0; i < rc.w; ++i) {
+        if (perspective)
+          p = inv.mapPoint(gfx::PointF(rc.x + i + 0.5f, y + 0.5f));
+        else if (i > 0) {
+          p.x += du;
+          p.y += dv;
+        }
+
+        // Only pixels with the center inside the source rectangle
+        if (p.x < srcRect.x || p.y < srcRect.y || p.x >= srcRect.x2() || p.y >= srcRect.y2()) {
+          cov[i] = 0;
+          continue;
+        }
+
+        uint32_t c;
+        if (linear) {
+          const float fx = float(p.x) - 0.5f;
+          const float fy = float(p.y) - 0.5f;
+          const float x0f = std::floor(fx);
+          const float y0f = std::floor(fy);
+          const int wx = int((fx - x0f) * 256.0f);
+          const int wy = int((fy - y0f) * 256.0f);
+          const int x0 = std::clamp(int(x0f), sx1, sx2);
+          const int x1 = std::clamp(int(x0f) + 1, sx1, sx2);
+          const int y0 = std::clamp(int(y0f), sy1, sy2);
+          const int y1 = std::clamp(int(y0f) + 1, sy1, sy2);
+          const uint32_t* r0 = src->row(y0);
+          const uint32_t* r1 = src->row(y1);
+          uint32_t p00 = r0[x0], p10 = r0[x1], p01 = r1[x0], p11 = r1[x1];
+          if (opaqueSrc) {
+            p00 |= gfx::ColorAMask;
+            p10 |= gfx::ColorAMask;
+            p01 |= gfx::ColorAMask;
+            p11 |= gfx::ColorAMask;
+          }
+          c = bilinear(p00, p10, p01, p11, wx, wy);
+        }
+        else {
+          const int x = std::clamp(int(std::floor(p.x)), sx1, sx2);
+          const int y = std::clamp(int(std::floor(p.y)), sy1, sy2);
+          c = src->row(y)[x];
+        }
+        buf[i] = (needsModulate ? modulate(c) : c);
+        cov[i] = 255;
+      }
+      blend_row(row(y) + rc.x, buf.data(), rc.w, cov.data(), blendMode);
+    }
+  }
+}
+
+} // namespace os
@@ -0,0 +1,162 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OS_NONE_SURFACE_H_INCLUDED
+#define OS_NONE_SURFACE_H_INCLUDED
+#pragma once
+
+#include "base/disable_copying.h"
+#include "gfx/matrix.h"
+#include "gfx/path_rasterizer.h"
+#include "gfx/region.h"
+#include "os/surface.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace os {
+
+// Raster surface in the CPU for the "none" backend (without Skia).
+//
+// Pixels are premultiplied RGBA with the gfx::Color layout, paths
+// are rasterized with gfx::PathRasterizer, and the clipping region
+// is a gfx::Region in device coordinates. Color spaces are only used
+// in readPixels()/writePixels() (drawing functions don't convert
+// colors between surfaces).
+class NoneSurface final : public Surface {
+public:
+  // Opaque surfaces (the ones created with System::makeSurface())
+  // ignore the alpha channel when they are drawn in other surfaces.
+  NoneSurface(int width, int height, const os::ColorSpaceRef& cs, bool opaque = false);
+  ~NoneSurface();
+
+  // Surface impl
+  int width() const override { return m_width; }
+  int height() const override { return m_height; }
+  const ColorSpaceRef& colorSpace() const override { return m_colorSpace; }
+  bool isDirectToScreen() const override { return false; }
+  void setImmutable() override {}
+  int getSaveCount() const override;
+  gfx::Rect getClipBounds() const override;
+  void saveClip() override;
+  void restoreClip() override;
+  bool clipRect(const gfx::Rect& rc) override;
+  void clipPath(const gfx::Path& path) override;
+  void clipRegion(const gfx::Region& region) override;
+  void save() override;
+  void concat(const gfx::Matrix& matrix) override;
+  void setMatrix(const gfx::Matrix& matrix) override;
+  void resetMatrix() override;
+  void restore() override;
+  gfx::Matrix matrix() const override;
+  void lock() override;
+  void unlock() override;
+
+  void* nativeHandle() override { return (void*)this; }
+
+  void clear() override;
+  uint8_t* getData(int x, int y) const override;
+  void getFormat(SurfaceFormatData* formatData) const override;
+
+  gfx::Color getPixel(int x, int y) const override;
+  void putPixel(gfx::Color color, int x, int y) override;
+
+  bool readPixels(const gfx::Rect& rc,
+                  void* dst,
+                  size_t rowBytes,
+                  PixelFormat format,
+                  PixelAlpha alpha,
+                  const ColorSpaceRef& colorSpace) const override;
+  bool writePixels(const gfx::Rect& rc,
+                   const void* src,
+                   size_t rowBytes,
+                   PixelFormat format,
+                   PixelAlpha alpha,
+                   const ColorSpaceRef& colorSpace) override;
+
+  void drawLine(float x0, float y0, float x1, float y1, const Paint& paint) override;
+  void drawRect(const gfx::RectF& rc, const Paint& paint) override;
+  void drawCircle(float cx, float cy, float radius, const Paint& paint) override;
+  void drawPath(const gfx::Path& path, const Paint& paint) override;
+
+  void blitTo(Surface* dst, int srcx, int srcy, int dstx, int dsty, int width, int height)
+    const override;
+  void scrollTo(const gfx::Rect& rc, int dx, int dy) override;
+  void drawSurface(const Surface* src, int dstx, int dsty) override;
+  void drawSurface(const Surface* src,
+                   const gfx::Rect& srcRect,
+                   const gfx::Rect& dstRect,
+                   const Sampling& sampling,
+                   const os::Paint* paint) override;
+  void drawRgbaSurface(const Surface* src, int dstx, int dsty) override;
+  void drawRgbaSurface(const Surface* src, int srcx, int srcy, int dstx, int dsty, int w, int h)
+    override;
+  void drawColoredRgbaSurface(const Surface* src,
+                              gfx::Color fg,
+                              gfx::Color bg,
+                              const gfx::Clip& clip) override;
+  void drawSurfaceNine(os::Surface* surface,
+                       const gfx::Rect& src,
+                       const gfx::Rect& center,
+                       const gfx::Rect& dst,
+                       bool drawCenter,
+                       const os::Paint* paint) override;
+
+  SurfaceRef makeSubsurface(const gfx::Rect& rc) override;
+
+  bool isOpaque() const { return m_opaque; }
+  uint32_t* row(int y) const { return m_pixels + size_t(y) * m_stride; }
+
+protected:
+  SurfaceRef onApplyScale(float scaleFactor, const Sampling& sampling) override;
+
+private:
+  // Creates a surface that shares the "rc" pixels of "parent".
+  NoneSurface(const NoneSurface* parent, const gfx::Rect& rc);
+
+  struct State {
+    gfx::Matrix matrix;
+    gfx::Region clip;
+  };
+
+  // Fills the edges added to m_rasterizer with the paint color.
+  void fillRasterizer(const Paint& paint);
+  void fillPath(const gfx::Path& path, const Paint& paint);
+  void fillDeviceRect(const gfx::Rect& rc, gfx::Color color, BlendMode blendMode);
+
+  // Draws the "srcRect" of "src" in "dstRect" (transformed by the
+  // current matrix). "alpha" modulates the source pixels, and
+  // "tint" (if it's not ColorNone) replaces the RGB components of
+  // the source pixels (a kSrcIn color filter).
+  void drawImage(const NoneSurface* src,
+                 const gfx::RectF& srcRect,
+                 const gfx::RectF& dstRect,
+                 const Sampling& sampling,
+                 BlendMode blendMode,
+                 int alpha,
+                 gfx::Color tint);
+
+  int m_width;
+  int m_height;
+  bool m_opaque;
+  // Pixels can be shared with other surfaces (see makeSubsurface())
+  std::shared_ptr<uint32_t[]> m_buffer;
+  uint32_t* m_pixels;
+  int m_stride; // In pixels
+  ColorSpaceRef m_colorSpace;
+  State m_state;
+  std::vector<State> m_savedStates;
+  gfx::PathRasterizer m_rasterizer;
+  std::atomic<int> m_lock;
+
+  DISABLE_COPYING(NoneSurface);
+};
+
+} // namespace os
+
+#endif
@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (c) 2024  Igara Studio S.A.
+// Copyright (c) 2024-2025  Igara Studio S.A.
 //
 // This file is released under the terms of the MIT license.
 // Read LICENSE.txt for more information.
@@ -8,11 +8,101 @@
   #include "config.h"
 #endif
 
-#include "os/common/system.h"
+#include "os/none/system.h"
+
+#if !LAF_SKIA
+  #include "os/none/surface.h"
+  #include "os/none/window.h"
+
+  #include <algorithm>
+#endif
 
 namespace os {
 
-class NoneSystem : public CommonSystem {};
+#if !LAF_SKIA
+
+NoneSystem::NoneSystem()
+  : m_screen(os::make_ref<NoneScreen>(gfx::Rect(0, 0, 1920, 1080),
+                                      makeColorSpace(gfx::ColorSpace::MakeSRGB())))
+{
+  set_event_queue_instance(&m_queue);
+}
+
+NoneSystem::~NoneSystem()
+{
+  destroyInstance();
+
+  // Destroy all windows referenced by queued events while the
+  // system is alive.
+  m_queue.clearEvents();
+  set_event_queue_instance(nullptr);
+
+  // Windows still referenced by the user cannot access this system
+  // anymore.
+  for (NoneWindow* window : m_windows)
+    window->onSystemDestroyed();
+}
+
+Ref<Surface> NoneSystem::makeSurface(int width, int height, const os::ColorSpaceRef& colorSpace)
+{
+  return os::make_ref<NoneSurface>(width, height, colorSpace, true);
+}
+
+Ref<Surface> NoneSystem::makeRgbaSurface(int width,
+                                         int height,
+                                         const os::ColorSpaceRef& colorSpace)
+{
+  return os::make_ref<NoneSurface>(width, height, colorSpace);
+}
+
+Ref<Window> NoneSystem::makeWindow(const WindowSpec& spec)
+{
+  auto window = os::make_ref<NoneWindow>(this, spec);
+  m_windows.push_back(window.get());
+  if (!m_defaultWindow)
+    m_defaultWindow = window.get();
+  return window;
+}
+
+bool NoneSystem::isKeyPressed(KeyScancode scancode)
+{
+  if (scancode > kKeyNil && scancode < kKeyScancodes)
+    return m_keys[scancode];
+  return false;
+}
+
+void NoneSystem::onInjectEvent(const Event& ev)
+{
+  switch (ev.type()) {
+    case Event::KeyDown:
+    case Event::KeyUp:
+      if (ev.scancode() > kKeyNil && ev.scancode() < kKeyScancodes)
+        m_keys[ev.scancode()] = (ev.type() == Event::KeyDown);
+      break;
+    case Event::MouseEnter:
+    case Event::MouseMove:
+    case Event::MouseDown:
+    case Event::MouseUp:
+    case Event::MouseWheel:
+    case Event::MouseDoubleClick:
+      if (ev.window())
+        m_mousePosition = ev.window()->pointToScreen(ev.position());
+      break;
+    default: break;
+  }
+}
+
+void NoneSystem::onDestroyWindow(NoneWindow* window)
+{
+  if (m_defaultWindow == window)
+    m_defaultWindow = nullptr;
+
+  auto it = std::find(m_windows.begin(), m_windows.end(), window);
+  if (it != m_windows.end())
+    m_windows.erase(it);
+}
+
+#endif // !LAF_SKIA
 
 SystemRef System::makeNone()
 {
@@ -0,0 +1,81 @@
+// LAF OS Library
+// Copyright (c) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OS_NONE_SYSTEM_H
+#define OS_NONE_SYSTEM_H
+#pragma once
+
+#include "os/common/system.h"
+
+#if !LAF_SKIA
+  #include "os/none/event_queue.h"
+  #include "os/none/screen.h"
+
+  #include <array>
+  #include <vector>
+#endif
+
+namespace os {
+
+class NoneWindow;
+
+// System without a platform-specific backend. With the "none"
+// backend (!LAF_SKIA) it can create headless windows (NoneWindow)
+// in a virtual screen, and the events are injected in its own
+// NoneEventQueue (which replaces EventQueue::instance() while this
+// system is alive), so UI loops can be tested/benchmarked without a
+// display server.
+class NoneSystem : public CommonSystem {
+public:
+#if !LAF_SKIA
+  NoneSystem();
+  ~NoneSystem();
+
+  // CPU surfaces to draw without a window (e.g. to render images in
+  // command line tools).
+  Ref<Surface> makeSurface(int width, int height, const os::ColorSpaceRef& colorSpace) override;
+  Ref<Surface> makeRgbaSurface(int width, int height, const os::ColorSpaceRef& colorSpace) override;
+
+  // Headless windows
+  ScreenRef mainScreen() override { return m_screen; }
+  void listScreens(ScreenList& screens) override { screens.push_back(m_screen); }
+  Window* defaultWindow() override { return m_defaultWindow; }
+  Ref<Window> makeWindow(const WindowSpec& spec) override;
+
+  // Keyboard/mouse state from the injected events
+  bool isKeyPressed(KeyScancode scancode) override;
+  gfx::Point mousePosition() const override { return m_mousePosition; }
+  void setMousePosition(const gfx::Point& screenPosition) override
+  {
+    m_mousePosition = screenPosition;
+  }
+
+  // The virtual screen where all windows are located (its bounds
+  // can be modified).
+  NoneScreen* virtualScreen() const { return m_screen.get(); }
+
+  // The queue where events are injected (with its virtual clock).
+  NoneEventQueue* noneEventQueue() { return &m_queue; }
+
+  // Called by NoneWindow
+  void onInjectEvent(const Event& ev);
+  void onDestroyWindow(NoneWindow* window);
+
+private:
+  NoneEventQueue m_queue;
+  Ref<NoneScreen> m_screen;
+  Window* m_defaultWindow = nullptr;
+  // Alive windows, they are detached from the system when it's
+  // destroyed (windows can outlive the system).
+  std::vector<NoneWindow*> m_windows;
+  gfx::Point m_mousePosition;
+  std::array<bool, kKeyScancodes> m_keys = {};
+#endif
+};
+
+} // namespace os
+
+#endif
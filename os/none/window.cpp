@@ -0,0 +1,205 @@
+// LAF OS Library
+// Copyright (c) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "os/none/window.h"
+
+#include "base/debug.h"
+#include "os/event_queue.h"
+#include "os/none/system.h"
+
+#include <algorithm>
+
+namespace os {
+
+NoneWindow::NoneWindow(NoneSystem* system, const WindowSpec& spec)
+  : m_system(system)
+  , m_scale(std::max(1, spec.scale()))
+  , m_transparent(spec.transparent())
+  , m_colorSpace(system->virtualScreen()->colorSpace())
+{
+  const gfx::Rect workarea = system->virtualScreen()->workarea();
+
+  switch (spec.position()) {
+    case WindowSpec::Position::Frame:       m_frame = spec.frame(); break;
+    case WindowSpec::Position::ContentRect: m_frame = spec.contentRect(); break;
+    case WindowSpec::Position::Default:
+    case WindowSpec::Position::Center:
+      m_frame = spec.contentRect();
+      if (m_frame.isEmpty())
+        m_frame = workarea;
+      m_frame.setOrigin(gfx::Point(workarea.x + (workarea.w - m_frame.w) / 2,
+                                   workarea.y + (workarea.h - m_frame.h) / 2));
+      break;
+  }
+  m_frame.w = std::max(1, m_frame.w);
+  m_frame.h = std::max(1, m_frame.h);
+
+  resizeSurface();
+}
+
+NoneWindow::~NoneWindow()
+{
+  if (m_system)
+    m_system->onDestroyWindow(this);
+}
+
+void NoneWindow::setFrame(const gfx::Rect& bounds)
+{
+  const gfx::Size oldSize = m_frame.size();
+  m_frame = bounds;
+  m_frame.w = std::max(1, m_frame.w);
+  m_frame.h = std::max(1, m_frame.h);
+
+  if (oldSize != m_frame.size()) {
+    resizeSurface();
+
+    if (m_system) {
+      Event ev;
+      ev.setType(Event::ResizeWindow);
+      queueEvent(ev);
+    }
+  }
+}
+
+void NoneWindow::setScale(const int scale)
+{
+  ASSERT(scale >= 1);
+  if (m_scale == scale)
+    return;
+
+  m_scale = std::max(1, scale);
+  resizeSurface();
+}
+
+void NoneWindow::invalidateRegion(const gfx::Region& rgn)
+{
+  m_invalidRegion |= rgn;
+}
+
+bool NoneWindow::setCursor(NativeCursor cursor)
+{
+  m_cursor = cursor;
+  return true;
+}
+
+bool NoneWindow::setCursor(const CursorRef& cursor)
+{
+  m_cursor = NativeCursor::Arrow;
+  return (cursor != nullptr);
+}
+
+void NoneWindow::setMousePosition(const gfx::Point& position)
+{
+  if (m_system)
+    m_system->setMousePosition(pointToScreen(position));
+}
+
+os::ScreenRef NoneWindow::screen() const
+{
+  return (m_system ? m_system->mainScreen() : nullptr);
+}
+
+void NoneWindow::setColorSpace(const os::ColorSpaceRef& colorSpace)
+{
+  if (colorSpace)
+    m_colorSpace = colorSpace;
+  else if (m_system)
+    m_colorSpace = m_system->virtualScreen()->colorSpace();
+  resizeSurface();
+}
+
+gfx::Region NoneWindow::takeInvalidRegion()
+{
+  gfx::Region result;
+  std::swap(result, m_invalidRegion);
+  return result;
+}
+
+void NoneWindow::injectMouse(const Event::Type type,
+                             const gfx::Point& pos,
+                             const Event::MouseButton button,
+                             const KeyModifiers modifiers)
+{
+  Event ev;
+  ev.setType(type);
+  ev.setPosition(pos);
+  ev.setButton(button);
+  ev.setPointerType(PointerType::Mouse);
+  injectEvent(ev, modifiers);
+}
+
+void NoneWindow::injectWheel(const gfx::Point& pos,
+                             const gfx::Point& delta,
+                             const bool preciseWheel,
+                             const KeyModifiers modifiers)
+{
+  Event ev;
+  ev.setType(Event::MouseWheel);
+  ev.setPosition(pos);
+  ev.setWheelDelta(delta);
+  ev.setPreciseWheel(preciseWheel);
+  ev.setPointerType(PointerType::Mouse);
+  injectEvent(ev, modifiers);
+}
+
+void NoneWindow::injectKey(const Event::Type type,
+                           const KeyScancode scancode,
+                           const base::codepoint_t unicodeChar,
+                           const KeyModifiers modifiers,
+                           const int repeat)
+{
+  ASSERT(type == Event::KeyDown || type == Event::KeyUp);
+
+  Event ev;
+  ev.setType(type);
+  ev.setScancode(scancode);
+  ev.setUnicodeChar(unicodeChar);
+  ev.setRepeat(repeat);
+  injectEvent(ev, modifiers);
+}
+
+void NoneWindow::injectResize(const gfx::Size& size)
+{
+  setFrame(gfx::Rect(m_frame.origin(), size));
+}
+
+void NoneWindow::injectClose()
+{
+  if (!m_system)
+    return;
+
+  Event ev;
+  ev.setType(Event::CloseWindow);
+  queueEvent(ev);
+}
+
+void NoneWindow::resizeSurface()
+{
+  m_surface = os::make_ref<NoneSurface>(std::max(1, m_frame.w / m_scale),
+                                        std::max(1, m_frame.h / m_scale),
+                                        m_colorSpace,
+                                        !m_transparent);
+}
+
+void NoneWindow::injectEvent(Event& ev, const KeyModifiers modifiers)
+{
+  // The NoneEventQueue was destroyed with the system
+  if (!m_system)
+    return;
+
+  ev.setWindow(AddRef(this));
+  // Update the pressed keys/mouse position before calculating the
+  // modifiers
+  m_system->onInjectEvent(ev);
+  ev.setModifiers(modifiers == kKeyUninitializedModifier ? m_system->keyModifiers() : modifiers);
+  queueEvent(ev);
+}
+
+} // namespace os
@@ -0,0 +1,129 @@
+// LAF OS Library
+// Copyright (c) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OS_NONE_WINDOW_H
+#define OS_NONE_WINDOW_H
+#pragma once
+
+#include "base/disable_copying.h"
+#include "gfx/region.h"
+#include "os/event.h"
+#include "os/none/surface.h"
+#include "os/window.h"
+#include "os/window_spec.h"
+
+namespace os {
+
+class NoneSystem;
+
+// Offscreen window for the "none" backend: it's drawn in a CPU
+// backbuffer (a NoneSurface) and receives only the events that are
+// injected with the inject*() functions.
+class NoneWindow : public Window {
+public:
+  NoneWindow(NoneSystem* system, const WindowSpec& spec);
+  ~NoneWindow();
+
+  gfx::Rect frame() const override { return m_frame; }
+  void setFrame(const gfx::Rect& bounds) override;
+  gfx::Rect contentRect() const override { return m_frame; }
+  gfx::Rect restoredFrame() const override { return m_frame; }
+  int width() const override { return m_frame.w; }
+  int height() const override { return m_frame.h; }
+  int scale() const override { return m_scale; }
+  void setScale(int scale) override;
+  bool isVisible() const override { return m_visible; }
+  void setVisible(bool visible) override { m_visible = visible; }
+  Surface* surface() override { return m_surface.get(); }
+  void invalidateRegion(const gfx::Region& rgn) override;
+
+  bool gpuAcceleration() const override { return false; }
+  void swapBuffers() override {}
+
+  void activate() override {}
+  void maximize() override { m_maximized = true; }
+  void minimize() override { m_minimized = true; }
+  bool isMaximized() const override { return m_maximized; }
+  bool isMinimized() const override { return m_minimized; }
+  bool isTransparent() const override { return m_transparent; }
+  bool isFullscreen() const override { return m_fullscreen; }
+  void setFullscreen(bool state) override { m_fullscreen = state; }
+
+  std::string title() const override { return m_title; }
+  void setTitle(const std::string& title) override { m_title = title; }
+
+  NativeCursor nativeCursor() override { return m_cursor; }
+  bool setCursor(NativeCursor cursor) override;
+  bool setCursor(const CursorRef& cursor) override;
+  void setMousePosition(const gfx::Point& position) override;
+  void captureMouse() override {}
+  void releaseMouse() override {}
+
+  void performWindowAction(WindowAction action, const Event* event) override {}
+  std::string getLayout() override { return std::string(); }
+  void setLayout(const std::string& layout) override {}
+
+  os::ScreenRef screen() const override;
+  os::ColorSpaceRef colorSpace() const override { return m_colorSpace; }
+  void setColorSpace(const os::ColorSpaceRef& colorSpace) override;
+  NativeHandle nativeHandle() const override { return nullptr; }
+
+  // Region invalidated since the last call (i.e. the pixels that
+  // would be presented on the screen). It can be used to measure
+  // how many pixels are presented each frame.
+  gfx::Region takeInvalidRegion();
+
+  // Event injection: events are queued in the NoneEventQueue with
+  // the current time of its virtual clock (advance the clock with
+  // NoneEventQueue::advance() to control the time between events).
+  // Positions are in surface coordinates. If "modifiers" is
+  // kKeyUninitializedModifier the modifiers are calculated from the
+  // pressed keys (injected KeyDown/KeyUp events).
+  void injectMouse(Event::Type type,
+                   const gfx::Point& pos,
+                   Event::MouseButton button = Event::NoneButton,
+                   KeyModifiers modifiers = kKeyUninitializedModifier);
+  void injectWheel(const gfx::Point& pos,
+                   const gfx::Point& delta,
+                   bool preciseWheel = false,
+                   KeyModifiers modifiers = kKeyUninitializedModifier);
+  void injectKey(Event::Type type,
+                 KeyScancode scancode,
+                 base::codepoint_t unicodeChar = 0,
+                 KeyModifiers modifiers = kKeyUninitializedModifier,
+                 int repeat = 0);
+  // Resizes the window (generating an Event::ResizeWindow).
+  void injectResize(const gfx::Size& size);
+  void injectClose();
+
+  // Called by NoneSystem when it's destroyed before this window (the
+  // window keeps working, but injected events are discarded).
+  void onSystemDestroyed() { m_system = nullptr; }
+
+private:
+  void resizeSurface();
+  void injectEvent(Event& ev, KeyModifiers modifiers);
+
+  NoneSystem* m_system; // Nullptr if the system was destroyed
+  gfx::Rect m_frame;
+  int m_scale;
+  bool m_visible = true;
+  bool m_maximized = false;
+  bool m_minimized = false;
+  bool m_fullscreen = false;
+  bool m_transparent;
+  std::string m_title;
+  NativeCursor m_cursor = NativeCursor::Arrow;
+  os::ColorSpaceRef m_colorSpace;
+  Ref<NoneSurface> m_surface;
+  gfx::Region m_invalidRegion;
+
+  DISABLE_COPYING(NoneWindow);
+};
+
+} // namespace os
+
+#endif
@@ -0,0 +1,285 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <gtest/gtest.h>
+
+#if !LAF_SKIA
+
+  #include "gfx/color_space.h"
+  #include "gfx/matrix.h"
+  #include "gfx/path.h"
+  #include "gfx/region.h"
+  #include "os/common/color_space.h"
+  #include "os/none/surface.h"
+  #include "os/paint.h"
+
+  #include <cmath>
+  #include <cstring>
+  #include <vector>
+
+using namespace os;
+
+namespace {
+
+ColorSpaceRef make_cs(const gfx::ColorSpaceRef& gfxcs)
+{
+  return os::make_ref<CommonColorSpace>(gfxcs);
+}
+
+} // anonymous namespace
+
+TEST(NoneSurface, ReadWritePixels)
+{
+  SurfaceRef s = os::make_ref<NoneSurface>(8, 4, nullptr);
+
+  std::vector<gfx::Color> src(8 * 4);
+  for (int i = 0; i < int(src.size()); ++i)
+    src[i] = gfx::rgba(i * 7, 255 - i, i, (i * 16) | 15);
+  EXPECT_TRUE(s->writePixels(s->bounds(), src.data(), 8 * 4));
+  EXPECT_EQ(gfx::geta(src[9]), gfx::geta(s->getPixel(1, 1)));
+
+  // Straight RGBA (premultiplied internally, so there is a small error)
+  std::vector<gfx::Color> dst(8 * 4);
+  EXPECT_TRUE(s->readPixels(s->bounds(), dst.data(), 8 * 4));
+  for (int i = 0; i < int(src.size()); ++i) {
+    const int a = gfx::geta(src[i]);
+    EXPECT_EQ(a, gfx::geta(dst[i]));
+    EXPECT_NEAR(gfx::getr(src[i]), gfx::getr(dst[i]), 255 / a + 1) << i;
+    EXPECT_NEAR(gfx::getg(src[i]), gfx::getg(dst[i]), 255 / a + 1) << i;
+  }
+
+  // BGRA
+  uint32_t bgra = 0;
+  EXPECT_TRUE(
+    s->readPixels(gfx::Rect(7, 3, 1, 1), &bgra, 4, PixelFormat::kBgra8888, PixelAlpha::kStraight));
+  EXPECT_EQ(gfx::getb(dst[31]), gfx::getr(bgra));
+  EXPECT_EQ(gfx::getr(dst[31]), gfx::getb(bgra));
+
+  // Alpha8 of a rectangle partially outside the surface
+  std::vector<uint8_t> alpha(4 * 4, 0);
+  EXPECT_TRUE(s->readPixels(gfx::Rect(6, 2, 4, 4), alpha.data(), 4, PixelFormat::kAlpha8));
+  EXPECT_EQ(gfx::geta(src[2 * 8 + 6]), alpha[0]);
+  EXPECT_EQ(gfx::geta(src[3 * 8 + 7]), alpha[4 + 1]);
+  EXPECT_EQ(0, alpha[2]);
+  EXPECT_EQ(0, alpha[8]);
+
+  // Nothing to read
+  EXPECT_FALSE(s->readPixels(gfx::Rect(8, 0, 2, 2), alpha.data(), 4, PixelFormat::kAlpha8));
+
+  // Premultiplied is copied as it is
+  std::vector<uint32_t> premul(8 * 4);
+  EXPECT_TRUE(s->readPixels(s->bounds(),
+                            premul.data(),
+                            8 * 4,
+                            PixelFormat::kRgba8888,
+                            PixelAlpha::kPremultiplied));
+  EXPECT_EQ(0, std::memcmp(premul.data(), s->getData(0, 0), premul.size() * 4));
+}
+
+TEST(NoneSurface, ReadPixelsWithColorSpace)
+{
+  auto srgb = make_cs(gfx::ColorSpace::MakeSRGB());
+  auto linear = make_cs(gfx::ColorSpace::MakeLinearSRGB());
+  SurfaceRef s = os::make_ref<NoneSurface>(4, 1, srgb);
+
+  const gfx::Color gray[4] = { gfx::rgba(0, 0, 0),
+                               gfx::rgba(128, 128, 128),
+                               gfx::rgba(255, 255, 255),
+                               gfx::rgba(128, 128, 128, 0) };
+  s->writePixels(s->bounds(), gray, 16);
+
+  gfx::Color dst[4];
+  s->readPixels(s->bounds(), dst, 16, PixelFormat::kRgba8888, PixelAlpha::kStraight, linear);
+  EXPECT_EQ(gfx::rgba(0, 0, 0), dst[0]);
+  EXPECT_EQ(gfx::rgba(55, 55, 55), dst[1]);
+  EXPECT_EQ(gfx::rgba(255, 255, 255), dst[2]);
+  EXPECT_EQ(0, gfx::geta(dst[3]));
+
+  // Write linear values (converted to sRGB)
+  s->writePixels(gfx::Rect(0, 0, 2, 1),
+                 dst,
+                 16,
+                 PixelFormat::kRgba8888,
+                 PixelAlpha::kStraight,
+                 linear);
+  EXPECT_EQ(gfx::rgba(128, 128, 128), s->getPixel(1, 0));
+
+  // F16
+  uint16_t half[4 * 4];
+  s->readPixels(s->bounds(), half, 32, PixelFormat::kRgbaF16, PixelAlpha::kStraight, linear);
+  EXPECT_NEAR(0.2158f, gfx::ColorSpaceConverter::HalfToFloat(half[4]), 1e-3);
+  EXPECT_EQ(1.0f, gfx::ColorSpaceConverter::HalfToFloat(half[7]));
+}
+
+TEST(NoneSurface, DrawRectAndClip)
+{
+  SurfaceRef s = os::make_ref<NoneSurface>(10, 10, nullptr);
+  Paint paint;
+  paint.color(gfx::rgba(255, 0, 0));
+  s->drawRect(gfx::Rect(2, 2, 4, 3), paint);
+
+  EXPECT_EQ(gfx::rgba(255, 0, 0), s->getPixel(2, 2));
+  EXPECT_EQ(gfx::rgba(255, 0, 0), s->getPixel(5, 4));
+  EXPECT_EQ(0, s->getPixel(6, 4));
+  EXPECT_EQ(0, s->getPixel(5, 5));
+
+  // Clip + matrix
+  EXPECT_EQ(1, s->getSaveCount());
+  s->save();
+  EXPECT_TRUE(s->clipRect(gfx::Rect(0, 0, 5, 10)));
+  s->concat(gfx::Matrix::MakeTrans(1, 6));
+  EXPECT_EQ(gfx::Rect(0, 0, 5, 10), s->getClipBounds());
+  paint.color(gfx::rgba(0, 0, 255, 128));
+  s->drawRect(gfx::Rect(0, 0, 10, 2), paint);
+  s->restore();
+  EXPECT_EQ(1, s->getSaveCount());
+  EXPECT_EQ(s->bounds(), s->getClipBounds());
+
+  EXPECT_EQ(0, s->getPixel(0, 6));
+  EXPECT_EQ(gfx::rgba(0, 0, 255, 128), s->getPixel(1, 6));
+  EXPECT_EQ(gfx::rgba(0, 0, 255, 128), s->getPixel(4, 7));
+  EXPECT_EQ(0, s->getPixel(5, 7));
+  EXPECT_EQ(0, s->getPixel(4, 8));
+
+  // clear() only clears the clipping region
+  s->clipRect(gfx::Rect(0, 0, 3, 3));
+  s->clear();
+  EXPECT_EQ(0, s->getPixel(2, 2));
+  EXPECT_EQ(gfx::rgba(255, 0, 0), s->getPixel(3, 2));
+}
+
+TEST(NoneSurface, ClipPath)
+{
+  SurfaceRef s = os::make_ref<NoneSurface>(20, 20, nullptr);
+  gfx::Path path;
+  path.moveTo(0, 0);
+  path.lineTo(20, 0);
+  path.lineTo(0, 20);
+  path.close();
+  s->clipPath(path);
+
+  Paint paint;
+  paint.color(gfx::rgba(0, 255, 0));
+  s->drawRect(s->bounds(), paint);
+  EXPECT_EQ(gfx::rgba(0, 255, 0), s->getPixel(0, 0));
+  EXPECT_EQ(gfx::rgba(0, 255, 0), s->getPixel(9, 9));
+  EXPECT_EQ(0, s->getPixel(11, 11));
+  EXPECT_EQ(0, s->getPixel(19, 19));
+}
+
+TEST(NoneSurface, DrawCircle)
+{
+  SurfaceRef s = os::make_ref<NoneSurface>(64, 64, nullptr);
+  Paint paint;
+  paint.antialias(true);
+  paint.color(gfx::rgba(255, 255, 255));
+  s->drawCircle(32, 32, 20, paint);
+
+  // Sum of coverage ~= circle area
+  double area = 0.0;
+  for (int y = 0; y < 64; ++y)
+    for (int x = 0; x < 64; ++x)
+      area += gfx::geta(s->getPixel(x, y)) / 255.0;
+  EXPECT_NEAR(M_PI * 20 * 20, area, 10.0);
+}
+
+TEST(NoneSurface, DrawSurface)
+{
+  SurfaceRef a = os::make_ref<NoneSurface>(2, 2, nullptr);
+  a->putPixel(gfx::rgba(255, 0, 0), 0, 0);
+  a->putPixel(gfx::rgba(0, 255, 0), 1, 0);
+  a->putPixel(gfx::rgba(0, 0, 255, 128), 0, 1);
+
+  SurfaceRef b = os::make_ref<NoneSurface>(8, 8, nullptr);
+  Paint paint;
+  paint.color(gfx::rgba(255, 255, 255));
+  b->drawRect(b->bounds(), paint);
+
+  // Scaled x2 (nearest)
+  b->drawSurface(a.get(), gfx::Rect(0, 0, 2, 2), gfx::Rect(4, 4, 4, 4), Sampling(), nullptr);
+  EXPECT_EQ(gfx::rgba(255, 0, 0), b->getPixel(5, 5));
+  EXPECT_EQ(gfx::rgba(0, 255, 0), b->getPixel(6, 4));
+  EXPECT_EQ(gfx::rgba(0, 0, 255, 128), b->getPixel(4, 7));
+  EXPECT_EQ(0, b->getPixel(7, 7));
+  EXPECT_EQ(gfx::rgba(255, 255, 255), b->getPixel(3, 3));
+
+  // Blended with SrcOver
+  b->drawRgbaSurface(a.get(), 0, 0);
+  EXPECT_EQ(gfx::rgba(255, 0, 0), b->getPixel(0, 0));
+  EXPECT_EQ(gfx::rgba(127, 127, 255), b->getPixel(0, 1));
+  EXPECT_EQ(gfx::rgba(255, 255, 255), b->getPixel(1, 1));
+
+  // Colored alpha
+  b->drawColoredRgbaSurface(a.get(),
+                            gfx::rgba(0, 0, 0),
+                            gfx::ColorNone,
+                            gfx::Clip(2, 0, 0, 0, 2, 2));
+  EXPECT_EQ(gfx::rgba(0, 0, 0), b->getPixel(2, 0));
+  EXPECT_EQ(gfx::rgba(127, 127, 127), b->getPixel(2, 1));
+
+  // Scroll
+  b->scrollTo(gfx::Rect(0, 0, 8, 8), 1, 0);
+  EXPECT_EQ(gfx::rgba(255, 0, 0), b->getPixel(1, 0));
+
+  auto c = b->applyScale(2.0f);
+  EXPECT_EQ(16, c->width());
+  EXPECT_EQ(gfx::rgba(255, 0, 0), c->getPixel(3, 1));
+}
+
+TEST(NoneSurface, DamageTracking)
+{
+  SurfaceRef s = os::make_ref<NoneSurface>(64, 64, nullptr);
+  Paint paint;
+  paint.color(gfx::rgba(255, 0, 0));
+
+  // Disabled by default
+  s->drawRect(gfx::Rect(0, 0, 8, 8), paint);
+  EXPECT_FALSE(s->isDamageTracking());
+  EXPECT_TRUE(s->takeDamage().isEmpty());
+
+  s->setDamageTracking(true);
+  s->drawRect(gfx::Rect(2, 3, 4, 5), paint);
+  s->putPixel(gfx::rgba(0, 0, 0), 40, 40);
+  gfx::Region damage = s->takeDamage();
+  EXPECT_EQ(gfx::Rect(2, 3, 39, 38), damage.bounds());
+  EXPECT_EQ(gfx::Region::In, damage.contains(gfx::Rect(2, 3, 4, 5)));
+  EXPECT_EQ(gfx::Region::Out, damage.contains(gfx::Rect(10, 10, 20, 20)));
+  EXPECT_TRUE(s->takeDamage().isEmpty());
+
+  // Transformed by the matrix and clipped
+  s->save();
+  s->setMatrix(gfx::Matrix::MakeTrans(10, 20));
+  s->clipRect(gfx::Rect(0, 0, 10, 10));
+  s->drawRect(gfx::Rect(5, 5, 100, 100), paint);
+  s->restore();
+  EXPECT_EQ(gfx::Rect(15, 25, 5, 5), s->takeDamage().bounds());
+
+  // Antialiasing/strokes are included
+  paint.antialias(true);
+  paint.style(Paint::Stroke);
+  paint.strokeWidth(2.0f);
+  s->drawCircle(32, 32, 10, paint);
+  EXPECT_EQ(gfx::Region::In, s->takeDamage().contains(gfx::Rect(21, 21, 22, 22)));
+
+  s->scrollTo(gfx::Rect(0, 0, 16, 16), 4, 0);
+  EXPECT_EQ(gfx::Rect(4, 0, 16, 16), s->takeDamage().bounds());
+
+  s->setDamageTracking(false);
+  s->clear();
+  EXPECT_TRUE(s->takeDamage().isEmpty());
+}
+
+#endif // !LAF_SKIA
+
+int app_main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,144 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <gtest/gtest.h>
+
+#if !LAF_SKIA
+
+  #include "gfx/region.h"
+  #include "os/event.h"
+  #include "os/event_queue.h"
+  #include "os/none/system.h"
+  #include "os/none/window.h"
+  #include "os/surface.h"
+
+using namespace os;
+
+TEST(NoneSystem, HeadlessWindow)
+{
+  SystemRef system = System::makeNone();
+  auto none = static_cast<NoneSystem*>(system.get());
+  none->virtualScreen()->setBounds(gfx::Rect(0, 0, 800, 600));
+  none->virtualScreen()->setWorkarea(gfx::Rect(0, 20, 800, 580));
+
+  WindowRef window = system->makeWindow(WindowSpec(200, 100, 2));
+  ASSERT_TRUE(window);
+  EXPECT_EQ(window.get(), system->defaultWindow());
+  EXPECT_EQ(gfx::Rect(300, 260, 200, 100), window->frame());
+  EXPECT_EQ(gfx::Rect(0, 0, 800, 600), window->screen()->bounds());
+  EXPECT_EQ(100, window->surface()->width());
+  EXPECT_EQ(50, window->surface()->height());
+
+  // Presented region
+  auto w = static_cast<NoneWindow*>(window.get());
+  window->invalidateRegion(gfx::Region(gfx::Rect(1, 2, 3, 4)));
+  EXPECT_EQ(gfx::Rect(1, 2, 3, 4), w->takeInvalidRegion().bounds());
+  EXPECT_TRUE(w->takeInvalidRegion().isEmpty());
+
+  window.reset();
+  EXPECT_EQ(nullptr, system->defaultWindow());
+}
+
+TEST(NoneSystem, InjectEvents)
+{
+  SystemRef system = System::makeNone();
+  auto none = static_cast<NoneSystem*>(system.get());
+  NoneEventQueue* queue = none->noneEventQueue();
+  EventQueue* events = system->eventQueue();
+  EXPECT_EQ(queue, events);
+  EXPECT_EQ(queue, EventQueue::instance());
+
+  WindowSpec spec(64, 32);
+  spec.position(WindowSpec::Position::ContentRect);
+  spec.contentRect(gfx::Rect(10, 20, 64, 32));
+  WindowRef windowRef = system->makeWindow(spec);
+  auto window = static_cast<NoneWindow*>(windowRef.get());
+
+  queue->setNow(1000);
+  window->injectMouse(Event::MouseMove, gfx::Point(5, 6));
+  queue->advance(16);
+  window->injectKey(Event::KeyDown, kKeyLShift);
+  window->injectMouse(Event::MouseDown, gfx::Point(7, 8), Event::LeftButton);
+  window->injectKey(Event::KeyUp, kKeyLShift);
+  EXPECT_EQ(gfx::Point(17, 28), system->mousePosition());
+  EXPECT_EQ(4, queue->size());
+
+  Event ev;
+  events->getEvent(ev);
+  EXPECT_EQ(Event::MouseMove, ev.type());
+  EXPECT_EQ(window, ev.window().get());
+  EXPECT_EQ(gfx::Point(5, 6), ev.position());
+  EXPECT_EQ(1000, ev.time());
+  EXPECT_EQ(kKeyNoneModifier, ev.modifiers());
+
+  events->getEvent(ev);
+  EXPECT_EQ(Event::KeyDown, ev.type());
+  EXPECT_EQ(kKeyLShift, ev.scancode());
+
+  events->getEvent(ev);
+  EXPECT_EQ(Event::MouseDown, ev.type());
+  EXPECT_EQ(Event::LeftButton, ev.button());
+  EXPECT_EQ(kKeyShiftModifier, ev.modifiers());
+  EXPECT_EQ(1016, ev.time());
+
+  events->getEvent(ev);
+  EXPECT_EQ(Event::KeyUp, ev.type());
+  EXPECT_FALSE(system->isKeyPressed(kKeyLShift));
+
+  // Empty queue: the virtual clock is advanced with the timeout
+  events->getEvent(ev, 0.5);
+  EXPECT_EQ(Event::None, ev.type());
+  EXPECT_EQ(1516, queue->now());
+
+  // Events with explicit time (in the future) advance the clock
+  Event future;
+  future.setType(Event::Callback);
+  future.setTime(2000);
+  queue_event(future);
+  events->getEvent(ev);
+  EXPECT_EQ(Event::Callback, ev.type());
+  EXPECT_EQ(2000, queue->now());
+
+  // Resize
+  window->injectResize(gfx::Size(100, 50));
+  events->getEvent(ev);
+  EXPECT_EQ(Event::ResizeWindow, ev.type());
+  EXPECT_EQ(100, window->surface()->width());
+  EXPECT_EQ(gfx::Rect(10, 20, 100, 50), window->frame());
+}
+
+TEST(NoneSystem, WindowOutlivesSystem)
+{
+  SystemRef system = System::makeNone();
+  WindowRef window = system->makeWindow(WindowSpec(64, 32));
+  auto w = static_cast<NoneWindow*>(window.get());
+  system.reset();
+
+  // The window doesn't access the destroyed system
+  EXPECT_EQ(nullptr, window->screen());
+  window->setMousePosition(gfx::Point(1, 2));
+  w->injectMouse(Event::MouseMove, gfx::Point(1, 2));
+  w->injectResize(gfx::Size(32, 16));
+  EXPECT_EQ(32, window->surface()->width());
+
+  // No events were queued in the default queue
+  Event ev;
+  EventQueue::instance()->getEvent(ev, 0.0);
+  EXPECT_EQ(Event::None, ev.type());
+  window.reset();
+}
+
+#endif // !LAF_SKIA
+
+int app_main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
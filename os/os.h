@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (c) 2019-2024  Igara Studio S.A.
+// Copyright (c) 2019-2025  Igara Studio S.A.
 // Copyright (c) 2012-2017  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -20,6 +20,7 @@
 #include "os/error.h"
 #include "os/event.h"
 #include "os/event_queue.h"
+#include "os/file_watcher.h"
 #include "os/keys.h"
 #include "os/logger.h"
 #include "os/menus.h"
@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2018-2021  Igara Studio S.A.
+// Copyright (C) 2018-2025  Igara Studio S.A.
 // Copyright (C) 2015-2016  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -21,10 +21,12 @@ class EventQueueOSX : public EventQueue {
 public:
   EventQueueOSX();
 
-  void getEvent(Event& ev, double timeout) override;
   void queueEvent(const Event& ev) override;
   void clearEvents() override;
 
+protected:
+  void onGetEvent(Event& ev, double timeout) override;
+
 private:
   void wakeUpQueue();
 
@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2018-2024  Igara Studio S.A.
+// Copyright (C) 2018-2025  Igara Studio S.A.
 // Copyright (C) 2015-2017  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -22,7 +22,7 @@ EventQueueOSX::EventQueueOSX() : m_sleeping(false)
 {
 }
 
-void EventQueueOSX::getEvent(Event& ev, double timeout)
+void EventQueueOSX::onGetEvent(Event& ev, double timeout)
 {
   // This autoreleasepool is required to release all received NSEvent
   // objects (if this is not used, NSEvents are stored in memory and
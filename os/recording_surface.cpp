@@ -0,0 +1,827 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "os/recording_surface.h"
+
+#include "base/debug.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace os {
+
+namespace details {
+
+enum class Op : uint8_t {
+  // State commands (always replayed)
+  Save,
+  Restore,
+  ClipRect,
+  ClipPath,
+  ClipRegion,
+  Concat,
+  SetMatrix,
+  ResetMatrix,
+
+  // Drawing commands (with non-empty bounds)
+  Clear,
+  PutPixel,
+  WritePixels,
+  ScrollTo,
+  DrawLine,
+  DrawRect,
+  DrawCircle,
+  DrawPath,
+  DrawSurface,
+  DrawSurfaceRect,
+  DrawRgbaSurface,
+  DrawRgbaSurfaceRect,
+  DrawColoredRgbaSurface,
+  DrawSurfaceNine,
+  DrawFunc,
+};
+
+struct Record {
+  Op op;
+  gfx::Rect bounds; // Device coordinates
+};
+
+} // namespace details
+
+namespace {
+
+using details::Op;
+using details::Record;
+
+constexpr uint32_t kNoIndex = std::numeric_limits<uint32_t>::max();
+
+struct MatrixRecord : Record {
+  gfx::Matrix matrix;
+};
+
+struct ClipRectRecord : Record {
+  gfx::Rect rc;
+};
+
+// ClipPath, ClipRegion
+struct IndexRecord : Record {
+  uint32_t index;
+};
+
+struct PutPixelRecord : Record {
+  gfx::Color color;
+  int x, y;
+};
+
+struct WritePixelsRecord : Record {
+  gfx::Rect rc;
+  const uint8_t* data;
+  size_t rowBytes;
+  PixelFormat format;
+  PixelAlpha alpha;
+  uint32_t colorSpace;
+};
+
+struct ScrollToRecord : Record {
+  gfx::Rect rc;
+  int dx, dy;
+};
+
+struct DrawLineRecord : Record {
+  float x0, y0, x1, y1;
+  uint32_t paint;
+};
+
+struct DrawRectRecord : Record {
+  gfx::RectF rc;
+  uint32_t paint;
+};
+
+struct DrawCircleRecord : Record {
+  float cx, cy, radius;
+  uint32_t paint;
+};
+
+struct DrawPathRecord : Record {
+  uint32_t path;
+  uint32_t paint;
+};
+
+// DrawSurface, DrawRgbaSurface, DrawRgbaSurfaceRect
+struct DrawSurfaceRecord : Record {
+  uint32_t surface;
+  int srcx, srcy, dstx, dsty, w, h;
+};
+
+struct DrawSurfaceRectRecord : Record {
+  uint32_t surface;
+  gfx::Rect srcRect;
+  gfx::Rect dstRect;
+  Sampling sampling;
+  uint32_t paint;
+};
+
+struct DrawColoredRgbaSurfaceRecord : Record {
+  uint32_t surface;
+  gfx::Color fg, bg;
+  gfx::Clip clip;
+};
+
+struct DrawSurfaceNineRecord : Record {
+  uint32_t surface;
+  gfx::Rect src, center, dst;
+  bool drawCenter;
+  uint32_t paint;
+};
+
+struct DrawFuncRecord : Record {
+  gfx::RectF localBounds;
+  uint32_t func;
+};
+
+// Smallest integer rectangle that contains "rc".
+gfx::Rect round_out(const gfx::RectF& rc)
+{
+  const int x1 = int(std::floor(rc.x));
+  const int y1 = int(std::floor(rc.y));
+  const int x2 = int(std::ceil(rc.x2()));
+  const int y2 = int(std::ceil(rc.y2()));
+  return gfx::Rect(x1, y1, x2 - x1, y2 - y1);
+}
+
+// Maps "rc" with "matrix" and clips the result to "clip" (avoiding
+// float to int overflows with huge rectangles).
+gfx::Rect map_and_clip(const gfx::Matrix& matrix, const gfx::RectF& rc, const gfx::Rect& clip)
+{
+  gfx::RectF dev = matrix.mapRect(rc);
+  dev &= gfx::RectF(clip);
+  if (dev.isEmpty())
+    return gfx::Rect();
+  return round_out(dev) & clip;
+}
+
+} // anonymous namespace
+
+RecordingSurface::RecordingSurface(int width, int height, const os::ColorSpaceRef& cs)
+  : m_width(width)
+  , m_height(height)
+  , m_colorSpace(cs)
+{
+  m_state.clipBounds = bounds();
+}
+
+RecordingSurface::~RecordingSurface()
+{
+}
+
+template<typename T>
+T* RecordingSurface::addRecord(Op op, const gfx::Rect& bounds)
+{
+  static_assert(std::is_base_of_v<Record, T>);
+  ASSERT(op < Op::Clear || !bounds.isEmpty());
+
+  T* rec = m_arena.make<T>();
+  rec->op = op;
+  rec->bounds = bounds;
+  m_records.push_back(rec);
+  if (!bounds.isEmpty()) {
+    m_drawBounds |= bounds;
+    addDeviceDamage(bounds);
+  }
+  return rec;
+}
+
+gfx::Rect RecordingSurface::deviceBounds(const gfx::RectF& rc, const Paint* paint) const
+{
+  return drawDeviceBounds(rc, paint, m_state.matrix, m_state.clipBounds);
+}
+
+uint32_t RecordingSurface::addPaint(const Paint& paint)
+{
+  m_paints.push_back(paint);
+  return uint32_t(m_paints.size() - 1);
+}
+
+uint32_t RecordingSurface::addSurface(const Surface* surface)
+{
+  ASSERT(surface);
+  ASSERT(surface != this);
+  // Consecutive commands usually use the same source surface
+  // (e.g. glyphs from a sprite sheet).
+  if (!m_surfaces.empty() && m_surfaces.back().get() == surface)
+    return uint32_t(m_surfaces.size() - 1);
+
+  m_surfaces.push_back(base::AddRef(const_cast<Surface*>(surface)));
+  return uint32_t(m_surfaces.size() - 1);
+}
+
+void RecordingSurface::reset()
+{
+  resetGenerationId();
+  m_records.clear();
+  m_paints.clear();
+  m_paths.clear();
+  m_regions.clear();
+  m_surfaces.clear();
+  m_colorSpaces.clear();
+  m_funcs.clear();
+  m_arena.reset();
+
+  m_state.matrix.reset();
+  m_state.clipBounds = bounds();
+  m_savedStates.clear();
+  m_drawBounds = gfx::Rect();
+  m_scrolls = 0;
+}
+
+void RecordingSurface::playback(Surface* dst) const
+{
+  replay(dst, nullptr);
+}
+
+void RecordingSurface::playback(Surface* dst, const gfx::Region& region) const
+{
+  replay(dst, &region);
+}
+
+void RecordingSurface::replay(Surface* dst, const gfx::Region* region) const
+{
+  ASSERT(dst);
+  ASSERT(dst != this);
+  if (m_records.empty() || (region && region->isEmpty()))
+    return;
+
+  // Recorded matrices are relative to the matrix of "dst", and
+  // commands in device coordinates (putPixel(), scrollTo(), etc.)
+  // are moved by its translation.
+  const gfx::Matrix initial = dst->matrix();
+  const bool identity = initial.isIdentity();
+  const gfx::Point devOffset(int(std::round(initial.getTranslateX())),
+                             int(std::round(initial.getTranslateY())));
+  // True if the initial matrix is just an integer translation (e.g.
+  // when a recording is replayed in tiles).
+  const bool intTranslation = (initial.isTranslate() && initial.getTranslateX() == devOffset.x &&
+                               initial.getTranslateY() == devOffset.y);
+
+  const int saveCount = dst->getSaveCount();
+  dst->save();
+  if (region)
+    dst->clipRegion(*region);
+  dst->clipRect(bounds());
+
+  // Used to skip commands outside the region
+  const gfx::Rect regionBounds = (region ? region->bounds() : gfx::Rect());
+  auto culled = [&](const gfx::Rect& bounds) {
+    gfx::Rect rc = bounds;
+    if (intTranslation)
+      rc.offset(devOffset);
+    else if (!identity)
+      rc = round_out(initial.mapRect(gfx::RectF(bounds)));
+    return (!rc.intersects(regionBounds) || region->contains(rc) == gfx::Region::Out);
+  };
+
+  auto paint = [this](uint32_t i) { return (i == kNoIndex ? nullptr : &m_paints[i]); };
+
+  for (const Record* rec : m_records) {
+    if (region && rec->op >= Op::Clear && culled(rec->bounds))
+      continue;
+
+    switch (rec->op) {
+      case Op::Save:    dst->save(); break;
+      case Op::Restore: dst->restore(); break;
+
+      case Op::ClipRect: dst->clipRect(static_cast<const ClipRectRecord*>(rec)->rc); break;
+
+      case Op::ClipPath:
+        dst->clipPath(m_paths[static_cast<const IndexRecord*>(rec)->index]);
+        break;
+
+      case Op::ClipRegion: {
+        const gfx::Region& rgn = m_regions[static_cast<const IndexRecord*>(rec)->index];
+        if (identity) {
+          dst->clipRegion(rgn);
+        }
+        else if (intTranslation) {
+          gfx::Region offsetRgn(rgn);
+          offsetRgn.offset(devOffset);
+          dst->clipRegion(offsetRgn);
+        }
+        else {
+          // The region is in the recording device coordinates, so we
+          // have to transform it with the initial matrix.
+          gfx::Path path;
+          for (const gfx::Rect& rc : rgn)
+            path.rect(rc);
+          const gfx::Matrix m = dst->matrix();
+          dst->setMatrix(initial);
+          dst->clipPath(path);
+          dst->setMatrix(m);
+        }
+        break;
+      }
+
+      case Op::Concat: dst->concat(static_cast<const MatrixRecord*>(rec)->matrix); break;
+
+      case Op::SetMatrix: {
+        gfx::Matrix m = initial;
+        m.preConcat(static_cast<const MatrixRecord*>(rec)->matrix);
+        dst->setMatrix(m);
+        break;
+      }
+
+      case Op::ResetMatrix: dst->setMatrix(initial); break;
+
+      case Op::Clear:       dst->clear(); break;
+
+      case Op::PutPixel:    {
+        const auto* r = static_cast<const PutPixelRecord*>(rec);
+        dst->putPixel(r->color, r->x + devOffset.x, r->y + devOffset.y);
+        break;
+      }
+
+      case Op::WritePixels: {
+        const auto* r = static_cast<const WritePixelsRecord*>(rec);
+        dst->writePixels(gfx::Rect(r->rc).offset(devOffset),
+                         r->data,
+                         r->rowBytes,
+                         r->format,
+                         r->alpha,
+                         (r->colorSpace == kNoIndex ? nullptr : m_colorSpaces[r->colorSpace]));
+        break;
+      }
+
+      case Op::ScrollTo: {
+        const auto* r = static_cast<const ScrollToRecord*>(rec);
+        dst->scrollTo(gfx::Rect(r->rc).offset(devOffset), r->dx, r->dy);
+        break;
+      }
+
+      case Op::DrawLine: {
+        const auto* r = static_cast<const DrawLineRecord*>(rec);
+        dst->drawLine(r->x0, r->y0, r->x1, r->y1, m_paints[r->paint]);
+        break;
+      }
+
+      case Op::DrawRect: {
+        const auto* r = static_cast<const DrawRectRecord*>(rec);
+        dst->drawRect(r->rc, m_paints[r->paint]);
+        break;
+      }
+
+      case Op::DrawCircle: {
+        const auto* r = static_cast<const DrawCircleRecord*>(rec);
+        dst->drawCircle(r->cx, r->cy, r->radius, m_paints[r->paint]);
+        break;
+      }
+
+      case Op::DrawPath: {
+        const auto* r = static_cast<const DrawPathRecord*>(rec);
+        dst->drawPath(m_paths[r->path], m_paints[r->paint]);
+        break;
+      }
+
+      case Op::DrawSurface: {
+        const auto* r = static_cast<const DrawSurfaceRecord*>(rec);
+        dst->drawSurface(m_surfaces[r->surface].get(), r->dstx, r->dsty);
+        break;
+      }
+
+      case Op::DrawSurfaceRect: {
+        const auto* r = static_cast<const DrawSurfaceRectRecord*>(rec);
+        dst->drawSurface(m_surfaces[r->surface].get(),
+                         r->srcRect,
+                         r->dstRect,
+                         r->sampling,
+                         paint(r->paint));
+        break;
+      }
+
+      case Op::DrawRgbaSurface: {
+        const auto* r = static_cast<const DrawSurfaceRecord*>(rec);
+        dst->drawRgbaSurface(m_surfaces[r->surface].get(), r->dstx, r->dsty);
+        break;
+      }
+
+      case Op::DrawRgbaSurfaceRect: {
+        const auto* r = static_cast<const DrawSurfaceRecord*>(rec);
+        dst->drawRgbaSurface(m_surfaces[r->surface].get(),
+                             r->srcx,
+                             r->srcy,
+                             r->dstx,
+                             r->dsty,
+                             r->w,
+                             r->h);
+        break;
+      }
+
+      case Op::DrawColoredRgbaSurface: {
+        const auto* r = static_cast<const DrawColoredRgbaSurfaceRecord*>(rec);
+        dst->drawColoredRgbaSurface(m_surfaces[r->surface].get(), r->fg, r->bg, r->clip);
+        break;
+      }
+
+      case Op::DrawSurfaceNine: {
+        const auto* r = static_cast<const DrawSurfaceNineRecord*>(rec);
+        dst->drawSurfaceNine(m_surfaces[r->surface].get(),
+                             r->src,
+                             r->center,
+                             r->dst,
+                             r->drawCenter,
+                             paint(r->paint));
+        break;
+      }
+
+      case Op::DrawFunc: {
+        const auto* r = static_cast<const DrawFuncRecord*>(rec);
+        dst->drawFunc(r->localBounds, m_funcs[r->func]);
+        break;
+      }
+    }
+  }
+
+  while (dst->getSaveCount() > saveCount)
+    dst->restore();
+}
+
+void RecordingSurface::drawFunc(const gfx::RectF& bounds, const DrawFunc& func)
+{
+  ASSERT(func);
+  const gfx::Rect devBounds = (bounds.isEmpty() ? m_state.clipBounds :
+                                                  deviceBounds(bounds, nullptr));
+  if (devBounds.isEmpty())
+    return;
+
+  m_funcs.push_back(func);
+
+  auto* rec = addRecord<DrawFuncRecord>(Op::DrawFunc, devBounds);
+  rec->localBounds = bounds;
+  rec->func = uint32_t(m_funcs.size() - 1);
+}
+
+int RecordingSurface::getSaveCount() const
+{
+  return int(m_savedStates.size()) + 1;
+}
+
+gfx::Rect RecordingSurface::getClipBounds() const
+{
+  return m_state.clipBounds;
+}
+
+void RecordingSurface::saveClip()
+{
+  save();
+}
+
+void RecordingSurface::restoreClip()
+{
+  restore();
+}
+
+bool RecordingSurface::clipRect(const gfx::Rect& rc)
+{
+  m_state.clipBounds = map_and_clip(m_state.matrix, gfx::RectF(rc), m_state.clipBounds);
+
+  auto* rec = addRecord<ClipRectRecord>(Op::ClipRect);
+  rec->rc = rc;
+  return !m_state.clipBounds.isEmpty();
+}
+
+void RecordingSurface::clipPath(const gfx::Path& path)
+{
+  m_state.clipBounds = map_and_clip(m_state.matrix, path.bounds(), m_state.clipBounds);
+
+  m_paths.push_back(path);
+  auto* rec = addRecord<IndexRecord>(Op::ClipPath);
+  rec->index = uint32_t(m_paths.size() - 1);
+}
+
+void RecordingSurface::clipRegion(const gfx::Region& region)
+{
+  m_state.clipBounds &= region.bounds();
+
+  m_regions.push_back(region);
+  auto* rec = addRecord<IndexRecord>(Op::ClipRegion);
+  rec->index = uint32_t(m_regions.size() - 1);
+}
+
+void RecordingSurface::save()
+{
+  m_savedStates.push_back(m_state);
+  addRecord<Record>(Op::Save);
+}
+
+void RecordingSurface::concat(const gfx::Matrix& matrix)
+{
+  m_state.matrix.preConcat(matrix);
+
+  auto* rec = addRecord<MatrixRecord>(Op::Concat);
+  rec->matrix = matrix;
+}
+
+void RecordingSurface::setMatrix(const gfx::Matrix& matrix)
+{
+  m_state.matrix = matrix;
+
+  auto* rec = addRecord<MatrixRecord>(Op::SetMatrix);
+  rec->matrix = matrix;
+}
+
+void RecordingSurface::resetMatrix()
+{
+  m_state.matrix.reset();
+  addRecord<Record>(Op::ResetMatrix);
+}
+
+void RecordingSurface::restore()
+{
+  if (m_savedStates.empty())
+    return;
+
+  m_state = m_savedStates.back();
+  m_savedStates.pop_back();
+  addRecord<Record>(Op::Restore);
+}
+
+gfx::Matrix RecordingSurface::matrix() const
+{
+  return m_state.matrix;
+}
+
+SurfaceRef RecordingSurface::onApplyScale(float scaleFactor, const Sampling& sampling)
+{
+  // Copy all commands in a new recording with a scale matrix
+  auto result = os::make_ref<RecordingSurface>(int(m_width * scaleFactor),
+                                               int(m_height * scaleFactor),
+                                               m_colorSpace);
+  result->concat(gfx::Matrix::MakeScale(scaleFactor));
+  playback(result.get());
+  return result;
+}
+
+void RecordingSurface::clear()
+{
+  if (!m_state.clipBounds.isEmpty())
+    addRecord<Record>(Op::Clear, m_state.clipBounds);
+}
+
+void RecordingSurface::getFormat(SurfaceFormatData* formatData) const
+{
+  formatData->format = kRgbaSurfaceFormat;
+  formatData->bitsPerPixel = 32;
+  formatData->redShift = gfx::ColorRShift;
+  formatData->greenShift = gfx::ColorGShift;
+  formatData->blueShift = gfx::ColorBShift;
+  formatData->alphaShift = gfx::ColorAShift;
+  formatData->redMask = gfx::ColorRMask;
+  formatData->greenMask = gfx::ColorGMask;
+  formatData->blueMask = gfx::ColorBMask;
+  formatData->alphaMask = gfx::ColorAMask;
+  formatData->pixelAlpha = PixelAlpha::kPremultiplied;
+}
+
+void RecordingSurface::putPixel(gfx::Color color, int x, int y)
+{
+  if (!bounds().contains(gfx::Point(x, y)))
+    return;
+
+  auto* rec = addRecord<PutPixelRecord>(Op::PutPixel, gfx::Rect(x, y, 1, 1));
+  rec->color = color;
+  rec->x = x;
+  rec->y = y;
+}
+
+bool RecordingSurface::writePixels(const gfx::Rect& rc,
+                                   const void* src,
+                                   size_t rowBytes,
+                                   PixelFormat format,
+                                   PixelAlpha alpha,
+                                   const ColorSpaceRef& colorSpace)
+{
+  const gfx::Rect area = rc & bounds();
+  if (area.isEmpty())
+    return false;
+
+  // Copy only the pixels inside the surface bounds
+  const int bpp = bytes_per_pixel(format);
+  const size_t areaRowBytes = size_t(area.w) * bpp;
+  auto* data = static_cast<uint8_t*>(m_arena.allocate(areaRowBytes * area.h));
+  const auto* srcData = static_cast<const uint8_t*>(src) + (area.y - rc.y) * rowBytes +
+                        (area.x - rc.x) * bpp;
+  for (int y = 0; y < area.h; ++y)
+    std::memcpy(data + y * areaRowBytes, srcData + y * rowBytes, areaRowBytes);
+
+  uint32_t cs = kNoIndex;
+  if (colorSpace) {
+    m_colorSpaces.push_back(colorSpace);
+    cs = uint32_t(m_colorSpaces.size() - 1);
+  }
+
+  auto* rec = addRecord<WritePixelsRecord>(Op::WritePixels, area);
+  rec->rc = area;
+  rec->data = data;
+  rec->rowBytes = areaRowBytes;
+  rec->format = format;
+  rec->alpha = alpha;
+  rec->colorSpace = cs;
+  return true;
+}
+
+void RecordingSurface::drawLine(float x0, float y0, float x1, float y1, const Paint& paint)
+{
+  // Lines are always stroked (whatever the paint style is)
+  gfx::RectF rc(gfx::PointF(x0, y0), gfx::PointF(x1, y1));
+  rc.enlarge(std::max(paint.strokeWidth(), 1.0f) / 2.0f);
+
+  const gfx::Rect devBounds = deviceBounds(rc, &paint);
+  if (devBounds.isEmpty())
+    return;
+
+  auto* rec = addRecord<DrawLineRecord>(Op::DrawLine, devBounds);
+  rec->x0 = x0;
+  rec->y0 = y0;
+  rec->x1 = x1;
+  rec->y1 = y1;
+  rec->paint = addPaint(paint);
+}
+
+void RecordingSurface::drawRect(const gfx::RectF& rc, const Paint& paint)
+{
+  const gfx::Rect devBounds = deviceBounds(rc, &paint);
+  if (devBounds.isEmpty())
+    return;
+
+  auto* rec = addRecord<DrawRectRecord>(Op::DrawRect, devBounds);
+  rec->rc = rc;
+  rec->paint = addPaint(paint);
+}
+
+void RecordingSurface::drawCircle(float cx, float cy, float radius, const Paint& paint)
+{
+  const gfx::Rect devBounds =
+    deviceBounds(gfx::RectF(cx - radius, cy - radius, 2 * radius, 2 * radius), &paint);
+  if (devBounds.isEmpty())
+    return;
+
+  auto* rec = addRecord<DrawCircleRecord>(Op::DrawCircle, devBounds);
+  rec->cx = cx;
+  rec->cy = cy;
+  rec->radius = radius;
+  rec->paint = addPaint(paint);
+}
+
+void RecordingSurface::drawPath(const gfx::Path& path, const Paint& paint)
+{
+  const gfx::Rect devBounds = deviceBounds(path.bounds(), &paint);
+  if (devBounds.isEmpty())
+    return;
+
+  m_paths.push_back(path);
+  auto* rec = addRecord<DrawPathRecord>(Op::DrawPath, devBounds);
+  rec->path = uint32_t(m_paths.size() - 1);
+  rec->paint = addPaint(paint);
+}
+
+void RecordingSurface::blitTo(Surface* dst,
+                              int srcx,
+                              int srcy,
+                              int dstx,
+                              int dsty,
+                              int width,
+                              int height) const
+{
+  dst->save();
+  dst->clipRect(gfx::Rect(dstx, dsty, width, height));
+  dst->concat(gfx::Matrix::MakeTrans(float(dstx - srcx), float(dsty - srcy)));
+  playback(dst);
+  dst->restore();
+}
+
+void RecordingSurface::scrollTo(const gfx::Rect& rc, int dx, int dy)
+{
+  // Pixels are moved from "rc" to "rc" + (dx, dy)
+  const gfx::Rect devBounds = (rc | gfx::Rect(rc).offset(dx, dy)) & bounds();
+  if (devBounds.isEmpty())
+    return;
+
+  ++m_scrolls;
+
+  auto* rec = addRecord<ScrollToRecord>(Op::ScrollTo, devBounds);
+  rec->rc = rc;
+  rec->dx = dx;
+  rec->dy = dy;
+}
+
+void RecordingSurface::drawSurface(const Surface* src, int dstx, int dsty)
+{
+  const gfx::Rect devBounds =
+    deviceBounds(gfx::RectF(dstx, dsty, src->width(), src->height()), nullptr);
+  if (devBounds.isEmpty())
+    return;
+
+  auto* rec = addRecord<DrawSurfaceRecord>(Op::DrawSurface, devBounds);
+  rec->surface = addSurface(src);
+  rec->dstx = dstx;
+  rec->dsty = dsty;
+}
+
+void RecordingSurface::drawSurface(const Surface* src,
+                                   const gfx::Rect& srcRect,
+                                   const gfx::Rect& dstRect,
+                                   const Sampling& sampling,
+                                   const os::Paint* paint)
+{
+  const gfx::Rect devBounds = deviceBounds(gfx::RectF(dstRect), nullptr);
+  if (devBounds.isEmpty())
+    return;
+
+  auto* rec = addRecord<DrawSurfaceRectRecord>(Op::DrawSurfaceRect, devBounds);
+  rec->surface = addSurface(src);
+  rec->srcRect = srcRect;
+  rec->dstRect = dstRect;
+  rec->sampling = sampling;
+  rec->paint = (paint ? addPaint(*paint) : kNoIndex);
+}
+
+void RecordingSurface::drawRgbaSurface(const Surface* src, int dstx, int dsty)
+{
+  const gfx::Rect devBounds =
+    deviceBounds(gfx::RectF(dstx, dsty, src->width(), src->height()), nullptr);
+  if (devBounds.isEmpty())
+    return;
+
+  auto* rec = addRecord<DrawSurfaceRecord>(Op::DrawRgbaSurface, devBounds);
+  rec->surface = addSurface(src);
+  rec->dstx = dstx;
+  rec->dsty = dsty;
+}
+
+void RecordingSurface::drawRgbaSurface(const Surface* src,
+                                       int srcx,
+                                       int srcy,
+                                       int dstx,
+                                       int dsty,
+                                       int w,
+                                       int h)
+{
+  const gfx::Rect devBounds = deviceBounds(gfx::RectF(dstx, dsty, w, h), nullptr);
+  if (devBounds.isEmpty())
+    return;
+
+  auto* rec = addRecord<DrawSurfaceRecord>(Op::DrawRgbaSurfaceRect, devBounds);
+  rec->surface = addSurface(src);
+  rec->srcx = srcx;
+  rec->srcy = srcy;
+  rec->dstx = dstx;
+  rec->dsty = dsty;
+  rec->w = w;
+  rec->h = h;
+}
+
+void RecordingSurface::drawColoredRgbaSurface(const Surface* src,
+                                              gfx::Color fg,
+                                              gfx::Color bg,
+                                              const gfx::Clip& clip)
+{
+  const gfx::Rect devBounds = deviceBounds(gfx::RectF(clip.dstBounds()), nullptr);
+  if (devBounds.isEmpty())
+    return;
+
+  auto* rec = addRecord<DrawColoredRgbaSurfaceRecord>(Op::DrawColoredRgbaSurface, devBounds);
+  rec->surface = addSurface(src);
+  rec->fg = fg;
+  rec->bg = bg;
+  rec->clip = clip;
+}
+
+void RecordingSurface::drawSurfaceNine(os::Surface* surface,
+                                       const gfx::Rect& src,
+                                       const gfx::Rect& center,
+                                       const gfx::Rect& dst,
+                                       bool drawCenter,
+                                       const os::Paint* paint)
+{
+  const gfx::Rect devBounds = deviceBounds(gfx::RectF(dst), nullptr);
+  if (devBounds.isEmpty())
+    return;
+
+  auto* rec = addRecord<DrawSurfaceNineRecord>(Op::DrawSurfaceNine, devBounds);
+  rec->surface = addSurface(surface);
+  rec->src = src;
+  rec->center = center;
+  rec->dst = dst;
+  rec->drawCenter = drawCenter;
+  rec->paint = (paint ? addPaint(*paint) : kNoIndex);
+}
+
+} // namespace os
@@ -0,0 +1,209 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OS_RECORDING_SURFACE_H_INCLUDED
+#define OS_RECORDING_SURFACE_H_INCLUDED
+#pragma once
+
+#include "base/arena.h"
+#include "base/disable_copying.h"
+#include "gfx/matrix.h"
+#include "gfx/path.h"
+#include "gfx/region.h"
+#include "os/surface.h"
+
+#include <functional>
+#include <vector>
+
+namespace os {
+
+namespace details {
+enum class Op : uint8_t;
+struct Record;
+} // namespace details
+
+class RecordingSurface;
+using RecordingSurfaceRef = Ref<RecordingSurface>;
+
+// A surface that doesn't have pixels: all drawing functions are
+// recorded in a display list (allocated in a base::arena) to be
+// replayed later on a real surface with playback(). The same
+// recording can be replayed several times, and from any thread
+// (even from several threads at the same time to different
+// surfaces) as long as it's not modified while it's replayed.
+//
+// Each drawing command keeps its bounds in device coordinates
+// (clipped by the clipping region at the moment it was recorded),
+// so commands outside the clipping region are not even recorded,
+// and playback(dst, region) skips the commands outside the given
+// region.
+//
+// Surfaces drawn in a RecordingSurface are referenced (not copied),
+// so their pixels are read when the recording is replayed. A
+// RecordingSurface cannot be used as the source of other surfaces
+// (use playback() or blitTo() instead), and functions that read
+// pixels (getPixel(), getData(), readPixels(), etc.) don't work.
+class RecordingSurface final : public Surface {
+public:
+  RecordingSurface(int width, int height, const os::ColorSpaceRef& cs = nullptr);
+  ~RecordingSurface();
+
+  // Replays the whole recording in "dst" using its current matrix
+  // and clipping region. The state of "dst" (save count, matrix,
+  // and clip) is restored at the end.
+  void playback(Surface* dst) const;
+
+  // Replays only the commands that intersect "region" (in device
+  // coordinates of "dst"), and clips the output to that region.
+  void playback(Surface* dst, const gfx::Region& region) const;
+
+  // Records a function that draws in the real surface when the
+  // recording is replayed (see Surface::drawFunc()). If the
+  // recording is replayed in another RecordingSurface, the function
+  // is recorded again. The function must be thread-safe if the
+  // recording is replayed from other threads.
+  void drawFunc(const gfx::RectF& bounds, const DrawFunc& func) override;
+
+  // Removes all recorded commands (keeping the allocated memory to
+  // be reused) and resets the state (matrix and clip).
+  void reset();
+
+  bool isEmpty() const { return m_records.empty(); }
+  size_t commandCount() const { return m_records.size(); }
+
+  // Union of the bounds of all drawing commands (device coordinates).
+  const gfx::Rect& drawBounds() const { return m_drawBounds; }
+
+  // Returns true if scrollTo() was used. These commands move pixels
+  // between different areas of the surface, so the recording cannot
+  // be replayed in independent tiles.
+  bool hasScrolls() const { return m_scrolls > 0; }
+
+  // Surface impl
+  int width() const override { return m_width; }
+  int height() const override { return m_height; }
+  const ColorSpaceRef& colorSpace() const override { return m_colorSpace; }
+  bool isDirectToScreen() const override { return false; }
+  void setImmutable() override {}
+  int getSaveCount() const override;
+  gfx::Rect getClipBounds() const override;
+  void saveClip() override;
+  void restoreClip() override;
+  bool clipRect(const gfx::Rect& rc) override;
+  void clipPath(const gfx::Path& path) override;
+  void clipRegion(const gfx::Region& region) override;
+  void save() override;
+  void concat(const gfx::Matrix& matrix) override;
+  void setMatrix(const gfx::Matrix& matrix) override;
+  void resetMatrix() override;
+  void restore() override;
+  gfx::Matrix matrix() const override;
+  void lock() override {}
+  void unlock() override {}
+
+  void* nativeHandle() override { return (void*)this; }
+
+  void clear() override;
+  uint8_t* getData(int x, int y) const override { return nullptr; }
+  void getFormat(SurfaceFormatData* formatData) const override;
+
+  gfx::Color getPixel(int x, int y) const override { return gfx::ColorNone; }
+  void putPixel(gfx::Color color, int x, int y) override;
+
+  bool readPixels(const gfx::Rect& rc,
+                  void* dst,
+                  size_t rowBytes,
+                  PixelFormat format,
+                  PixelAlpha alpha,
+                  const ColorSpaceRef& colorSpace) const override
+  {
+    return false;
+  }
+  bool writePixels(const gfx::Rect& rc,
+                   const void* src,
+                   size_t rowBytes,
+                   PixelFormat format,
+                   PixelAlpha alpha,
+                   const ColorSpaceRef& colorSpace) override;
+
+  void drawLine(float x0, float y0, float x1, float y1, const Paint& paint) override;
+  void drawRect(const gfx::RectF& rc, const Paint& paint) override;
+  void drawCircle(float cx, float cy, float radius, const Paint& paint) override;
+  void drawPath(const gfx::Path& path, const Paint& paint) override;
+
+  // Replays the recording in "dst" (moving the (srcx, srcy) point
+  // to (dstx, dsty) and clipping the output to the given size).
+  void blitTo(Surface* dst, int srcx, int srcy, int dstx, int dsty, int width, int height)
+    const override;
+  void scrollTo(const gfx::Rect& rc, int dx, int dy) override;
+  void drawSurface(const Surface* src, int dstx, int dsty) override;
+  void drawSurface(const Surface* src,
+                   const gfx::Rect& srcRect,
+                   const gfx::Rect& dstRect,
+                   const Sampling& sampling,
+                   const os::Paint* paint) override;
+  void drawRgbaSurface(const Surface* src, int dstx, int dsty) override;
+  void drawRgbaSurface(const Surface* src, int srcx, int srcy, int dstx, int dsty, int w, int h)
+    override;
+  void drawColoredRgbaSurface(const Surface* src,
+                              gfx::Color fg,
+                              gfx::Color bg,
+                              const gfx::Clip& clip) override;
+  void drawSurfaceNine(os::Surface* surface,
+                       const gfx::Rect& src,
+                       const gfx::Rect& center,
+                       const gfx::Rect& dst,
+                       bool drawCenter,
+                       const os::Paint* paint) override;
+
+protected:
+  SurfaceRef onApplyScale(float scaleFactor, const Sampling& sampling) override;
+
+private:
+  struct State {
+    gfx::Matrix matrix;
+    gfx::Rect clipBounds; // Conservative bounds of the clip (device coordinates)
+  };
+
+  // Adds a new command to the list. Drawing commands must have
+  // non-empty bounds.
+  template<typename T>
+  T* addRecord(details::Op op, const gfx::Rect& bounds = gfx::Rect());
+
+  // Returns the device bounds of the given local rectangle drawn
+  // with the given paint (clipped to the current clip bounds).
+  gfx::Rect deviceBounds(const gfx::RectF& rc, const Paint* paint) const;
+
+  uint32_t addPaint(const Paint& paint);
+  uint32_t addSurface(const Surface* surface);
+
+  void replay(Surface* dst, const gfx::Region* region) const;
+
+  int m_width;
+  int m_height;
+  ColorSpaceRef m_colorSpace;
+  State m_state;
+  std::vector<State> m_savedStates;
+  gfx::Rect m_drawBounds;
+  int m_scrolls = 0;
+
+  // Commands are allocated in the arena (they are trivially
+  // destructible) and reference non-trivial objects by index.
+  base::arena m_arena;
+  std::vector<const details::Record*> m_records;
+  std::vector<Paint> m_paints;
+  std::vector<gfx::Path> m_paths;
+  std::vector<gfx::Region> m_regions;
+  std::vector<SurfaceRef> m_surfaces;
+  std::vector<ColorSpaceRef> m_colorSpaces;
+  std::vector<DrawFunc> m_funcs;
+
+  DISABLE_COPYING(RecordingSurface);
+};
+
+} // namespace os
+
+#endif
@@ -0,0 +1,227 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <gtest/gtest.h>
+
+#if !LAF_SKIA
+
+  #include "gfx/path.h"
+  #include "gfx/region.h"
+  #include "os/none/surface.h"
+  #include "os/recording_surface.h"
+
+  #include <thread>
+  #include <vector>
+
+using namespace os;
+
+namespace {
+
+// Draws the same thing in a real surface or in a recording.
+void draw_scene(Surface* s)
+{
+  Paint paint;
+  paint.color(gfx::rgba(255, 0, 0));
+  s->drawRect(gfx::Rect(2, 2, 20, 10), paint);
+
+  s->save();
+  s->clipRect(gfx::Rect(0, 0, 16, 32));
+  s->concat(gfx::Matrix::MakeTrans(4, 12));
+  paint.antialias(true);
+  paint.color(gfx::rgba(0, 0, 255, 200));
+  s->drawCircle(8, 8, 6, paint);
+  s->restore();
+
+  gfx::Path path;
+  path.moveTo(20, 20);
+  path.lineTo(30, 20);
+  path.lineTo(25, 30);
+  path.close();
+  paint.color(gfx::rgba(0, 255, 0));
+  s->drawPath(path, paint);
+
+  paint.style(Paint::Stroke);
+  paint.strokeWidth(2.0f);
+  s->drawLine(0, 31, 31, 0, paint);
+}
+
+bool same_pixels(const Surface* a, const Surface* b)
+{
+  for (int y = 0; y < a->height(); ++y)
+    for (int x = 0; x < a->width(); ++x)
+      if (a->getPixel(x, y) != b->getPixel(x, y))
+        return false;
+  return true;
+}
+
+} // anonymous namespace
+
+TEST(RecordingSurface, Playback)
+{
+  SurfaceRef expected = os::make_ref<NoneSurface>(32, 32, nullptr);
+  draw_scene(expected.get());
+
+  auto rec = os::make_ref<RecordingSurface>(32, 32);
+  draw_scene(rec.get());
+  EXPECT_FALSE(rec->isEmpty());
+  EXPECT_EQ(1, rec->getSaveCount());
+  EXPECT_EQ(gfx::Rect(0, 0, 32, 32), rec->getClipBounds());
+
+  // Replay it several times
+  for (int i = 0; i < 2; ++i) {
+    SurfaceRef s = os::make_ref<NoneSurface>(32, 32, nullptr);
+    rec->playback(s.get());
+    EXPECT_EQ(1, s->getSaveCount());
+    EXPECT_TRUE(same_pixels(expected.get(), s.get()));
+  }
+
+  // Replay it from other threads
+  std::vector<SurfaceRef> surfaces;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+    surfaces.push_back(os::make_ref<NoneSurface>(32, 32, nullptr));
+  for (int i = 0; i < 4; ++i)
+    threads.emplace_back([&rec, s = surfaces[i].get()] { rec->playback(s); });
+  for (auto& t : threads)
+    t.join();
+  for (auto& s : surfaces)
+    EXPECT_TRUE(same_pixels(expected.get(), s.get()));
+
+  rec->reset();
+  EXPECT_TRUE(rec->isEmpty());
+  EXPECT_TRUE(rec->drawBounds().isEmpty());
+}
+
+TEST(RecordingSurface, CullOnRecord)
+{
+  auto rec = os::make_ref<RecordingSurface>(32, 32);
+  Paint paint;
+
+  rec->drawRect(gfx::Rect(40, 0, 10, 10), paint);
+  EXPECT_TRUE(rec->isEmpty());
+
+  rec->save();
+  EXPECT_TRUE(rec->clipRect(gfx::Rect(0, 0, 8, 8)));
+  rec->drawRect(gfx::Rect(10, 10, 4, 4), paint);
+  rec->drawRect(gfx::Rect(2, 2, 4, 4), paint);
+  rec->restore();
+  EXPECT_EQ(4, rec->commandCount()); // save + clipRect + drawRect + restore
+  EXPECT_EQ(gfx::Rect(1, 1, 6, 6), rec->drawBounds());
+}
+
+TEST(RecordingSurface, PlaybackRegion)
+{
+  auto rec = os::make_ref<RecordingSurface>(32, 32);
+  Paint paint;
+  paint.color(gfx::rgba(255, 255, 255));
+  rec->drawRect(gfx::Rect(0, 0, 32, 32), paint);
+
+  int calls = 0;
+  rec->drawFunc(gfx::RectF(20, 20, 4, 4), [&calls](Surface*) { ++calls; });
+
+  SurfaceRef s = os::make_ref<NoneSurface>(32, 32, nullptr);
+  gfx::Region region(gfx::Rect(0, 0, 8, 8));
+  region |= gfx::Region(gfx::Rect(24, 0, 8, 8));
+  rec->playback(s.get(), region);
+
+  EXPECT_EQ(0, calls);
+  EXPECT_EQ(gfx::rgba(255, 255, 255), s->getPixel(7, 7));
+  EXPECT_EQ(gfx::rgba(255, 255, 255), s->getPixel(24, 0));
+  EXPECT_EQ(0, s->getPixel(8, 8));
+  EXPECT_EQ(0, s->getPixel(16, 4));
+  EXPECT_EQ(s->bounds(), s->getClipBounds());
+
+  rec->playback(s.get(), gfx::Region(gfx::Rect(16, 16, 16, 16)));
+  EXPECT_EQ(1, calls);
+}
+
+TEST(RecordingSurface, PlaybackWithMatrix)
+{
+  auto rec = os::make_ref<RecordingSurface>(8, 8);
+  Paint paint;
+  paint.color(gfx::rgba(255, 0, 0));
+  rec->setMatrix(gfx::Matrix::MakeTrans(2, 0));
+  rec->drawRect(gfx::Rect(0, 0, 2, 2), paint);
+  rec->resetMatrix();
+  rec->putPixel(gfx::rgba(0, 255, 0), 0, 0);
+  rec->clear(); // Clears only the 8x8 area
+  rec->drawRect(gfx::Rect(0, 0, 2, 2), paint);
+
+  SurfaceRef s = os::make_ref<NoneSurface>(32, 32, nullptr);
+  paint.color(gfx::rgba(0, 0, 255));
+  s->drawRect(s->bounds(), paint);
+
+  // Set matrices are relative to the destination matrix
+  s->concat(gfx::Matrix::MakeTrans(10, 10));
+  rec->playback(s.get());
+  EXPECT_TRUE(s->matrix().isTranslate());
+  EXPECT_EQ(10.0f, s->matrix().getTranslateX());
+
+  EXPECT_EQ(gfx::rgba(255, 0, 0), s->getPixel(10, 10));
+  EXPECT_EQ(0, s->getPixel(12, 10));
+  EXPECT_EQ(0, s->getPixel(17, 17));
+  EXPECT_EQ(gfx::rgba(0, 0, 255), s->getPixel(18, 18));
+  EXPECT_EQ(gfx::rgba(0, 0, 255), s->getPixel(9, 9));
+}
+
+TEST(RecordingSurface, NestedRecording)
+{
+  auto a = os::make_ref<RecordingSurface>(16, 16);
+  auto b = os::make_ref<RecordingSurface>(16, 16);
+
+  Surface* target = nullptr;
+  a->drawFunc(gfx::RectF(), [&target](Surface* s) { target = s; });
+  a->playback(b.get());
+  EXPECT_EQ(nullptr, target);
+  EXPECT_EQ(4, b->commandCount()); // save + clipRect + drawFunc + restore
+
+  SurfaceRef s = os::make_ref<NoneSurface>(16, 16, nullptr);
+  b->playback(s.get());
+  EXPECT_EQ(s.get(), target);
+
+  // Scaled copy
+  Paint paint;
+  paint.color(gfx::rgba(255, 255, 255));
+  a->drawRect(gfx::Rect(1, 1, 2, 2), paint);
+  SurfaceRef c = a->applyScale(2.0f, Sampling());
+  EXPECT_EQ(32, c->width());
+  SurfaceRef d = os::make_ref<NoneSurface>(32, 32, nullptr);
+  static_cast<RecordingSurface*>(c.get())->playback(d.get());
+  EXPECT_EQ(0, d->getPixel(1, 1));
+  EXPECT_EQ(gfx::rgba(255, 255, 255), d->getPixel(2, 2));
+  EXPECT_EQ(gfx::rgba(255, 255, 255), d->getPixel(5, 5));
+  EXPECT_EQ(0, d->getPixel(6, 6));
+}
+
+TEST(RecordingSurface, DamageTracking)
+{
+  auto rec = os::make_ref<RecordingSurface>(64, 64);
+  rec->setDamageTracking(true);
+
+  Paint paint;
+  paint.color(gfx::rgba(255, 0, 0));
+  rec->drawRect(gfx::Rect(8, 8, 4, 4), paint);
+  // Culled commands are not damage
+  rec->drawRect(gfx::Rect(100, 100, 4, 4), paint);
+  EXPECT_EQ(gfx::Rect(7, 7, 6, 6), rec->takeDamage().bounds());
+
+  // The damage is kept when the recording is reset
+  rec->drawRect(gfx::Rect(8, 8, 4, 4), paint);
+  rec->reset();
+  EXPECT_FALSE(rec->takeDamage().isEmpty());
+}
+
+#endif // !LAF_SKIA
+
+int app_main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,176 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "os/scaled_surface_cache.h"
+
+#include <functional>
+
+namespace os {
+
+bool ScaledSurfaceCache::Key::operator==(const Key& other) const
+{
+  return (generationId == other.generationId && scaleFactor == other.scaleFactor &&
+          sampling.useCubic == other.sampling.useCubic &&
+          sampling.cubic.B == other.sampling.cubic.B &&
+          sampling.cubic.C == other.sampling.cubic.C &&
+          sampling.filter == other.sampling.filter && sampling.mipmap == other.sampling.mipmap);
+}
+
+size_t ScaledSurfaceCache::KeyHash::operator()(const Key& key) const
+{
+  size_t h = std::hash<uint32_t>()(key.generationId);
+  auto combine = [&h](const size_t v) { h ^= v + 0x9e3779b9 + (h << 6) + (h >> 2); };
+  combine(std::hash<float>()(key.scaleFactor));
+  combine(std::hash<float>()(key.sampling.cubic.B));
+  combine(std::hash<float>()(key.sampling.cubic.C));
+  combine((key.sampling.useCubic ? 1 : 0) | (int(key.sampling.filter) << 1) |
+          (int(key.sampling.mipmap) << 2));
+  return h;
+}
+
+// static
+ScaledSurfaceCache* ScaledSurfaceCache::instance()
+{
+  // Never destroyed, as surfaces can be destroyed after static
+  // objects (the cache is cleared when the os::System is destroyed).
+  static ScaledSurfaceCache* cache = new ScaledSurfaceCache;
+  return cache;
+}
+
+void ScaledSurfaceCache::setBudget(const size_t bytes)
+{
+  std::vector<SurfaceRef> removed;
+  std::lock_guard lock(m_mutex);
+  m_budget = bytes;
+  evict(removed);
+}
+
+size_t ScaledSurfaceCache::budget() const
+{
+  std::lock_guard lock(m_mutex);
+  return m_budget;
+}
+
+SurfaceRef ScaledSurfaceCache::get(const Surface* source,
+                                   const float scaleFactor,
+                                   const Sampling& sampling)
+{
+  const Key key = { source->generationId(), scaleFactor, sampling };
+
+  std::vector<SurfaceRef> removed;
+  std::lock_guard lock(m_mutex);
+  auto it = m_map.find(key);
+  if (it != m_map.end()) {
+    // The cached surface was modified by someone, we cannot use it.
+    if (it->second->scaled->generationId() != it->second->scaledGenerationId) {
+      erase(it->second, removed);
+    }
+    else {
+      m_entries.splice(m_entries.begin(), m_entries, it->second);
+      ++m_stats.hits;
+      return m_entries.front().scaled;
+    }
+  }
+  ++m_stats.misses;
+  return nullptr;
+}
+
+void ScaledSurfaceCache::add(const Surface* source,
+                             const float scaleFactor,
+                             const Sampling& sampling,
+                             const SurfaceRef& scaled)
+{
+  if (!scaled)
+    return;
+
+  SurfaceFormatData format;
+  scaled->getFormat(&format);
+
+  Entry entry;
+  entry.key = { source->generationId(), scaleFactor, sampling };
+  entry.source = source;
+  entry.scaled = scaled;
+  entry.scaledGenerationId = scaled->generationId();
+  entry.bytes = size_t(scaled->width()) * scaled->height() * (format.bitsPerPixel / 8);
+
+  std::vector<SurfaceRef> removed;
+  std::lock_guard lock(m_mutex);
+  if (entry.bytes > m_budget)
+    return;
+
+  // Remove entries of previous versions of the source surface (and
+  // the same entry if it was already added).
+  for (auto it = m_entries.begin(); it != m_entries.end();) {
+    auto next = std::next(it);
+    if (it->source == source &&
+        (it->key.generationId != entry.key.generationId || it->key == entry.key)) {
+      erase(it, removed);
+    }
+    it = next;
+  }
+
+  m_bytes += entry.bytes;
+  m_entries.push_front(std::move(entry));
+  m_map[m_entries.front().key] = m_entries.begin();
+  evict(removed);
+}
+
+void ScaledSurfaceCache::remove(const Surface* source)
+{
+  std::vector<SurfaceRef> removed;
+  std::lock_guard lock(m_mutex);
+  for (auto it = m_entries.begin(); it != m_entries.end();) {
+    auto next = std::next(it);
+    if (it->source == source)
+      erase(it, removed);
+    it = next;
+  }
+}
+
+void ScaledSurfaceCache::clear()
+{
+  std::vector<SurfaceRef> removed;
+  std::lock_guard lock(m_mutex);
+  while (!m_entries.empty())
+    erase(m_entries.begin(), removed);
+}
+
+ScaledSurfaceCache::Stats ScaledSurfaceCache::stats() const
+{
+  std::lock_guard lock(m_mutex);
+  Stats stats = m_stats;
+  stats.entries = int(m_entries.size());
+  stats.bytes = m_bytes;
+  return stats;
+}
+
+void ScaledSurfaceCache::resetStats()
+{
+  std::lock_guard lock(m_mutex);
+  m_stats = Stats();
+}
+
+void ScaledSurfaceCache::erase(const Entries::iterator it, std::vector<SurfaceRef>& removed)
+{
+  m_bytes -= it->bytes;
+  m_map.erase(it->key);
+  removed.push_back(std::move(it->scaled));
+  m_entries.erase(it);
+}
+
+void ScaledSurfaceCache::evict(std::vector<SurfaceRef>& removed)
+{
+  while (!m_entries.empty() && m_bytes > m_budget) {
+    erase(std::prev(m_entries.end()), removed);
+    ++m_stats.evictions;
+  }
+}
+
+} // namespace os
@@ -0,0 +1,110 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OS_SCALED_SURFACE_CACHE_H_INCLUDED
+#define OS_SCALED_SURFACE_CACHE_H_INCLUDED
+#pragma once
+
+#include "base/disable_copying.h"
+#include "os/sampling.h"
+#include "os/surface.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace os {
+
+// Cache of surfaces created with Surface::applyScale(), keyed by the
+// generation ID of the source surface, the scale factor, and the
+// sampling options. Entries are removed when the source surface is
+// modified or deleted, and the least recently used ones are evicted
+// when the memory budget is exceeded.
+//
+// The cache is disabled by default (its budget is 0). When it's
+// enabled, Surface::applyScale() can return the same surface to
+// different callers, so the returned surfaces must not be modified
+// (if a cached surface is modified anyway, it's removed from the
+// cache the next time it's requested).
+class ScaledSurfaceCache {
+public:
+  struct Stats {
+    int hits = 0;
+    int misses = 0;
+    int evictions = 0; // Entries evicted to keep the memory budget
+    int entries = 0;
+    size_t bytes = 0;
+  };
+
+  static ScaledSurfaceCache* instance();
+
+  // Maximum number of bytes used by all cached surfaces (0 disables
+  // the cache and removes all entries).
+  void setBudget(size_t bytes);
+  size_t budget() const;
+  bool isEnabled() const { return budget() > 0; }
+
+  // Returns the cached "source" surface scaled with the given
+  // parameters, or nullptr if it's not in the cache.
+  SurfaceRef get(const Surface* source, float scaleFactor, const Sampling& sampling);
+
+  // Adds the result of source->applyScale(scaleFactor, sampling).
+  // Entries of previous versions of "source" are removed.
+  void add(const Surface* source,
+           float scaleFactor,
+           const Sampling& sampling,
+           const SurfaceRef& scaled);
+
+  // Removes all the entries of the given source surface.
+  void remove(const Surface* source);
+  void clear();
+
+  Stats stats() const;
+  void resetStats();
+
+private:
+  struct Key {
+    uint32_t generationId;
+    float scaleFactor;
+    Sampling sampling;
+
+    bool operator==(const Key& other) const;
+  };
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+  struct Entry {
+    Key key;
+    const Surface* source; // Only to identify the entries of a surface
+    SurfaceRef scaled;
+    uint32_t scaledGenerationId;
+    size_t bytes;
+  };
+  using Entries = std::list<Entry>;
+
+  ScaledSurfaceCache() = default;
+
+  // Removes the entry, moving its surface to "removed" (so the
+  // surface is destroyed outside the lock).
+  void erase(Entries::iterator it, std::vector<SurfaceRef>& removed);
+  void evict(std::vector<SurfaceRef>& removed);
+
+  mutable std::mutex m_mutex;
+  size_t m_budget = 0;
+  size_t m_bytes = 0;
+  Entries m_entries; // Most recently used first
+  std::unordered_map<Key, Entries::iterator, KeyHash> m_map;
+  Stats m_stats;
+
+  DISABLE_COPYING(ScaledSurfaceCache);
+};
+
+} // namespace os
+
+#endif
@@ -0,0 +1,211 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <gtest/gtest.h>
+
+#if !LAF_SKIA
+
+  #include "os/none/surface.h"
+  #include "os/paint.h"
+  #include "os/scaled_surface_cache.h"
+
+  #include <thread>
+  #include <vector>
+
+using namespace os;
+
+namespace {
+
+SurfaceRef make_surface(const int w, const int h, const gfx::Color color)
+{
+  SurfaceRef s = os::make_ref<NoneSurface>(w, h, nullptr);
+  Paint paint;
+  paint.color(color);
+  s->drawRect(s->bounds(), paint);
+  return s;
+}
+
+class ScaledSurfaceCacheTest : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    cache()->setBudget(1024 * 1024);
+    cache()->resetStats();
+  }
+  void TearDown() override { cache()->setBudget(0); }
+
+  static ScaledSurfaceCache* cache() { return ScaledSurfaceCache::instance(); }
+};
+
+} // anonymous namespace
+
+TEST(Surface, GenerationId)
+{
+  SurfaceRef s = os::make_ref<NoneSurface>(4, 4, nullptr);
+  SurfaceRef t = os::make_ref<NoneSurface>(4, 4, nullptr);
+  const uint32_t id = s->generationId();
+  EXPECT_NE(0, id);
+  EXPECT_EQ(id, s->generationId());
+  EXPECT_NE(id, t->generationId());
+
+  // Reading doesn't change the ID
+  s->getPixel(0, 0);
+  EXPECT_EQ(id, s->generationId());
+
+  s->putPixel(gfx::rgba(255, 0, 0), 0, 0);
+  EXPECT_NE(id, s->generationId());
+
+  // Pixels could be modified with getData() while the surface is
+  // locked
+  const uint32_t id2 = s->generationId();
+  {
+    SurfaceLock lock(s.get());
+    *(uint32_t*)s->getData(0, 0) = 0;
+  }
+  EXPECT_NE(id2, s->generationId());
+}
+
+TEST(Surface, GenerationIdFromThreads)
+{
+  SurfaceRef s = os::make_ref<NoneSurface>(4, 4, nullptr);
+  std::vector<uint32_t> ids(4);
+  std::vector<std::thread> threads;
+  for (uint32_t& id : ids)
+    threads.emplace_back([&s, &id] { id = s->generationId(); });
+  for (std::thread& thread : threads)
+    thread.join();
+
+  // All threads see the same ID
+  for (const uint32_t id : ids)
+    EXPECT_EQ(s->generationId(), id);
+}
+
+TEST(ScaledSurfaceCache, DisabledByDefault)
+{
+  EXPECT_FALSE(ScaledSurfaceCache::instance()->isEnabled());
+
+  SurfaceRef s = make_surface(4, 4, gfx::rgba(255, 0, 0));
+  SurfaceRef a = s->applyScale(2.0f);
+  SurfaceRef b = s->applyScale(2.0f);
+  EXPECT_NE(a, b);
+  EXPECT_EQ(0, ScaledSurfaceCache::instance()->stats().entries);
+}
+
+TEST_F(ScaledSurfaceCacheTest, Hits)
+{
+  SurfaceRef s = make_surface(4, 4, gfx::rgba(255, 0, 0));
+  SurfaceRef a = s->applyScale(2.0f);
+  SurfaceRef b = s->applyScale(2.0f);
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(gfx::rgba(255, 0, 0), a->getPixel(7, 7));
+
+  // Different scale or sampling
+  SurfaceRef c = s->applyScale(3.0f);
+  SurfaceRef d = s->applyScale(2.0f, Sampling(Sampling::Filter::Linear));
+  EXPECT_NE(a, c);
+  EXPECT_NE(a, d);
+  EXPECT_EQ(12, c->width());
+  EXPECT_EQ(d, s->applyScale(2.0f, Sampling(Sampling::Filter::Linear)));
+
+  // Scale 1.0 is never cached
+  EXPECT_EQ(s, s->applyScale(1.0f));
+
+  const ScaledSurfaceCache::Stats stats = cache()->stats();
+  EXPECT_EQ(2, stats.hits);
+  EXPECT_EQ(3, stats.misses);
+  EXPECT_EQ(3, stats.entries);
+  EXPECT_EQ(4 * (8 * 8 + 12 * 12 + 8 * 8), stats.bytes);
+}
+
+TEST_F(ScaledSurfaceCacheTest, SourceChanges)
+{
+  SurfaceRef s = make_surface(4, 4, gfx::rgba(255, 0, 0));
+  SurfaceRef a = s->applyScale(2.0f);
+
+  Paint paint;
+  paint.color(gfx::rgba(0, 0, 255));
+  s->drawRect(s->bounds(), paint);
+
+  // The entry of the old pixels is removed as soon as the source is
+  // modified
+  EXPECT_EQ(0, cache()->stats().entries);
+  EXPECT_EQ(0, cache()->stats().bytes);
+
+  SurfaceRef b = s->applyScale(2.0f);
+  EXPECT_NE(a, b);
+  EXPECT_EQ(gfx::rgba(0, 0, 255), b->getPixel(0, 0));
+  EXPECT_EQ(1, cache()->stats().entries);
+
+  // The source is deleted
+  s.reset();
+  EXPECT_EQ(0, cache()->stats().entries);
+  EXPECT_EQ(0, cache()->stats().bytes);
+}
+
+TEST_F(ScaledSurfaceCacheTest, ModifiedResult)
+{
+  SurfaceRef s = make_surface(4, 4, gfx::rgba(255, 0, 0));
+  SurfaceRef a = s->applyScale(2.0f);
+
+  // Someone modified the scaled surface
+  a->putPixel(gfx::rgba(0, 255, 0), 0, 0);
+
+  SurfaceRef b = s->applyScale(2.0f);
+  EXPECT_NE(a, b);
+  EXPECT_EQ(gfx::rgba(255, 0, 0), b->getPixel(0, 0));
+}
+
+TEST_F(ScaledSurfaceCacheTest, Budget)
+{
+  // Each scaled surface uses 4*8*8 = 256 bytes
+  cache()->setBudget(3 * 256);
+
+  std::vector<SurfaceRef> sources;
+  for (int i = 0; i < 4; ++i)
+    sources.push_back(make_surface(4, 4, gfx::rgba(i, 0, 0)));
+
+  for (int i = 0; i < 3; ++i)
+    (void)sources[i]->applyScale(2.0f);
+  EXPECT_EQ(3, cache()->stats().entries);
+
+  // Use the first one so the second one is the least recently used
+  (void)sources[0]->applyScale(2.0f);
+  (void)sources[3]->applyScale(2.0f);
+
+  ScaledSurfaceCache::Stats stats = cache()->stats();
+  EXPECT_EQ(3, stats.entries);
+  EXPECT_EQ(1, stats.evictions);
+  EXPECT_EQ(3 * 256, stats.bytes);
+
+  cache()->resetStats();
+  (void)sources[0]->applyScale(2.0f);
+  (void)sources[2]->applyScale(2.0f);
+  (void)sources[3]->applyScale(2.0f);
+  (void)sources[1]->applyScale(2.0f);
+  stats = cache()->stats();
+  EXPECT_EQ(3, stats.hits);
+  EXPECT_EQ(1, stats.misses);
+
+  // Surfaces bigger than the budget are not cached
+  SurfaceRef big = make_surface(64, 64, gfx::rgba(0, 0, 0));
+  (void)big->applyScale(2.0f);
+  EXPECT_EQ(3, cache()->stats().entries);
+
+  cache()->setBudget(0);
+  EXPECT_EQ(0, cache()->stats().entries);
+}
+
+#endif // !LAF_SKIA
+
+int app_main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -37,11 +37,19 @@
   #include "src/image/SkSurface_Raster.h"
 #endif
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <stddef.h>
 
 namespace os {
 
+#if SK_SUPPORT_GPU
+// Guards the cached textures of all surfaces (they share the same
+// GrDirectContext).
+static std::mutex g_textureImageMutex;
+#endif
+
 static PixelAlpha from_skia(const SkAlphaType at)
 {
   switch (at) {
@@ -55,6 +63,28 @@ static PixelAlpha from_skia(const SkAlphaType at)
   }
 }
 
+static SkAlphaType to_skia(const PixelAlpha alpha)
+{
+  switch (alpha) {
+    case PixelAlpha::kOpaque:        return kOpaque_SkAlphaType;
+    case PixelAlpha::kPremultiplied: return kPremul_SkAlphaType;
+    case PixelAlpha::kStraight:      return kUnpremul_SkAlphaType;
+  }
+  return kUnknown_SkAlphaType;
+}
+
+static SkColorType to_skia(const PixelFormat format)
+{
+  switch (format) {
+    case PixelFormat::kRgba8888: return kRGBA_8888_SkColorType;
+    case PixelFormat::kBgra8888: return kBGRA_8888_SkColorType;
+    case PixelFormat::kRgbaF16:  return kRGBA_F16_SkColorType;
+    case PixelFormat::kAlpha8:   return kAlpha_8_SkColorType;
+    case PixelFormat::kGray8:    return kGray_8_SkColorType;
+  }
+  return kUnknown_SkColorType;
+}
+
 static SkCanvas::SrcRectConstraint to_constraint(const Paint* paint)
 {
   if (paint && paint->srcEdges() == Paint::SrcEdges::Fast)
@@ -272,14 +302,14 @@ void SkiaSurface::unlock()
   ASSERT(m_lock > 0);
   if (--m_lock == 0) {
     // m_bitmap is always locked
+
+    // Pixels could be modified with getData()
+    resetGenerationId();
   }
 }
 
-SurfaceRef SkiaSurface::applyScale(float scaleFactor, const Sampling& sampling)
+SurfaceRef SkiaSurface::onApplyScale(float scaleFactor, const Sampling& sampling)
 {
-  if (scaleFactor == 1.0f)
-    return AddRef(this);
-
   ASSERT(!m_surface);
 
   SkBitmap result;
@@ -308,6 +338,23 @@ SurfaceRef SkiaSurface::applyScale(float scaleFactor, const Sampling& sampling)
   return resultSurface;
 }
 
+SurfaceRef SkiaSurface::makeSubsurface(const gfx::Rect& rc)
+{
+  // Only raster surfaces (GPU surfaces don't have a bitmap)
+  if (m_surface || m_bitmap.isNull() || rc.isEmpty() || !bounds().contains(rc))
+    return nullptr;
+
+  // The subset shares the SkPixelRef (the pixels) with m_bitmap, and
+  // the new surface will have its own SkCanvas.
+  SkBitmap subset;
+  if (!m_bitmap.extractSubset(&subset, to_skia(rc)))
+    return nullptr;
+
+  auto result = base::make_ref<SkiaSurface>();
+  result->createWithBitmap(std::move(subset), m_colorSpace);
+  return result;
+}
+
 void* SkiaSurface::nativeHandle()
 {
   return (void*)this;
@@ -315,6 +362,7 @@ void* SkiaSurface::nativeHandle()
 
 void SkiaSurface::clear()
 {
+  addDeviceDamage(getClipBounds());
   m_canvas->clear(0);
 }
 
@@ -430,10 +478,15 @@ gfx::Color SkiaSurface::getPixel(int x, int y) const
 void SkiaSurface::putPixel(gfx::Color color, int x, int y)
 {
   if (m_surface) {
+    // drawPoint() maps the point through the canvas matrix
+    addDamage(gfx::RectF(x, y, 1, 1));
     m_paint.setColor(to_skia(color));
     m_canvas->drawPoint(SkIntToScalar(x), SkIntToScalar(y), m_paint);
   }
   else {
+    // The bitmap is modified directly (without matrix or clipping)
+    addDeviceDamage(gfx::Rect(x, y, 1, 1));
+
     // TODO Find a better way to put a pixel in the same color space
     //      as the internal SkPixmap (as Skia expects a sRGB color
     //      in SkBitmap::erase())
@@ -449,12 +502,61 @@ void SkiaSurface::putPixel(gfx::Color color, int x, int y)
   }
 }
 
+bool SkiaSurface::readPixels(const gfx::Rect& rc,
+                             void* dst,
+                             size_t rowBytes,
+                             PixelFormat format,
+                             PixelAlpha alpha,
+                             const ColorSpaceRef& colorSpace) const
+{
+  // Skia converts the whole block of pixels to the given color
+  // type/alpha type/color space at once.
+  const SkImageInfo dstInfo = SkImageInfo::Make(
+    rc.w,
+    rc.h,
+    to_skia(format),
+    (format == PixelFormat::kGray8 ? kOpaque_SkAlphaType : to_skia(alpha)),
+    (colorSpace ? static_cast<const SkiaColorSpace*>(colorSpace.get())->skColorSpace() :
+                  skColorSpace()));
+
+  if (!m_bitmap.isNull())
+    return m_bitmap.readPixels(dstInfo, dst, rowBytes, rc.x, rc.y);
+  return m_canvas->readPixels(dstInfo, dst, rowBytes, rc.x, rc.y);
+}
+
+bool SkiaSurface::writePixels(const gfx::Rect& rc,
+                              const void* src,
+                              size_t rowBytes,
+                              PixelFormat format,
+                              PixelAlpha alpha,
+                              const ColorSpaceRef& colorSpace)
+{
+  const SkImageInfo srcInfo = SkImageInfo::Make(
+    rc.w,
+    rc.h,
+    to_skia(format),
+    (format == PixelFormat::kGray8 ? kOpaque_SkAlphaType : to_skia(alpha)),
+    (colorSpace ? static_cast<const SkiaColorSpace*>(colorSpace.get())->skColorSpace() :
+                  skColorSpace()));
+
+  addDeviceDamage(rc);
+  if (!m_bitmap.isNull())
+    return m_bitmap.writePixels(SkPixmap(srcInfo, src, rowBytes), rc.x, rc.y);
+  return m_canvas->writePixels(srcInfo, src, rowBytes, rc.x, rc.y);
+}
+
 void SkiaSurface::drawLine(const float x0,
                            const float y0,
                            const float x1,
                            const float y1,
                            const Paint& paint)
 {
+  if (isDamageTracking()) {
+    // Lines are always stroked (whatever the paint style is)
+    gfx::RectF rc(gfx::PointF(x0, y0), gfx::PointF(x1, y1));
+    rc.enlarge(std::max(paint.strokeWidth(), 1.0f) / 2.0f);
+    addDamage(rc, &paint);
+  }
   m_canvas->drawLine(x0, y0, x1, y1, paint.skPaint());
 }
 
@@ -463,6 +565,7 @@ void SkiaSurface::drawRect(const gfx::RectF& rc, const Paint& paint)
   if (rc.isEmpty())
     return;
 
+  addDamage(rc, &paint);
   if (paint.style() == Paint::Style::Stroke)
     m_canvas->drawRect(to_skia_fix(rc), paint.skPaint());
   else
@@ -471,11 +574,13 @@ void SkiaSurface::drawRect(const gfx::RectF& rc, const Paint& paint)
 
 void SkiaSurface::drawCircle(const float cx, const float cy, const float radius, const Paint& paint)
 {
+  addDamage(gfx::RectF(cx - radius, cy - radius, 2 * radius, 2 * radius), &paint);
   m_canvas->drawCircle(cx, cy, radius, paint.skPaint());
 }
 
 void SkiaSurface::drawPath(const gfx::Path& path, const Paint& paint)
 {
+  addDamage(path.bounds(), &paint);
   m_canvas->drawPath(path.skPath(), paint.skPaint());
 }
 
@@ -488,6 +593,7 @@ void SkiaSurface::blitTo(Surface* _dst,
                          int height) const
 {
   auto dst = static_cast<SkiaSurface*>(_dst);
+  dst->addDamage(gfx::RectF(dstx, dsty, width, height));
 
   SkRect srcRect = SkRect::MakeXYWH(srcx, srcy, width, height);
   SkRect dstRect = SkRect::Make(SkIRect::MakeXYWH(dstx, dsty, width, height));
@@ -496,8 +602,8 @@ void SkiaSurface::blitTo(Surface* _dst,
   paint.setBlendMode(SkBlendMode::kSrc);
 
 #if SK_SUPPORT_GPU
-  if (auto srcImage = getOrCreateTextureImage()) {
-    dst->m_canvas->drawImageRect(srcImage,
+  if (auto srcImage = getOrCreateTextureImage(dst->m_canvas)) {
+    dst->m_canvas->drawImageRect(srcImage.get(),
                                  srcRect,
                                  dstRect,
                                  SkSamplingOptions(),
@@ -535,6 +641,7 @@ void SkiaSurface::scrollTo(const gfx::Rect& rc, int dx, int dy)
   if (!clip.clip(w, h, w, h))
     return;
 
+  addDeviceDamage(gfx::Rect(clip.dst, clip.size));
   if (m_surface) {
     SurfaceLock lock(this);
     blitTo(this, clip.src.x, clip.src.y, clip.dst.x, clip.dst.y, clip.size.w, clip.size.h);
@@ -667,6 +774,7 @@ void SkiaSurface::drawSurfaceNine(os::Surface* surface,
 {
   SkIRect srcRect = SkIRect::MakeXYWH(src.x, src.y, src.w, src.h);
   SkRect dstRect = SkRect::Make(SkIRect::MakeXYWH(dst.x, dst.y, dst.w, dst.h));
+  addDamage(gfx::RectF(dst));
 
   SkPaint skPaint;
   skPaint.setBlendMode(SkBlendMode::kSrcOver);
@@ -727,8 +835,8 @@ void SkiaSurface::drawSurfaceNine(os::Surface* surface,
   lattice.fColors = nullptr;
 
 #if SK_SUPPORT_GPU
-  if (auto srcImage = ((SkiaSurface*)surface)->getOrCreateTextureImage()) {
-    m_canvas->drawImageLattice(srcImage, lattice, dstRect, SkFilterMode::kNearest, &skPaint);
+  if (auto srcImage = ((SkiaSurface*)surface)->getOrCreateTextureImage(m_canvas)) {
+    m_canvas->drawImageLattice(srcImage.get(), lattice, dstRect, SkFilterMode::kNearest, &skPaint);
     return;
   }
 #endif
@@ -744,10 +852,16 @@ void SkiaSurface::swapBitmap(SkBitmap& other)
   m_bitmap.swap(other);
   delete m_canvas;
   m_canvas = new SkCanvas(m_bitmap);
+  resetGenerationId();
 }
 
 // static
 Ref<Surface> SkiaSurface::loadSurface(const char* filename)
+{
+  return loadSurface(filename, gfx::Size());
+}
+
+Ref<Surface> SkiaSurface::loadSurface(const char* filename, const gfx::Size& targetSize)
 {
   FILE* f = base::open_file_raw(filename, "rb");
   if (!f)
@@ -760,6 +874,22 @@ Ref<Surface> SkiaSurface::loadSurface(const char* filename)
 
   SkImageInfo info =
     codec->getInfo().makeColorType(kN32_SkColorType).makeAlphaType(kPremul_SkAlphaType);
+
+  // Size to fit the image in the target size (keeping the aspect ratio)
+  SkISize fitSize = info.dimensions();
+  if (targetSize.w > 0 && targetSize.h > 0) {
+    const float scale = std::min(float(targetSize.w) / info.width(),
+                                 float(targetSize.h) / info.height());
+    if (scale < 1.0f) {
+      fitSize.set(std::max(1, int(info.width() * scale)), std::max(1, int(info.height() * scale)));
+
+      // Decode directly in a smaller resolution if the codec supports
+      // it (e.g. JPEG can decode 1/2, 1/4, 1/8 of the image), it
+      // returns the original size if it cannot scale.
+      info = info.makeDimensions(codec->getScaledDimensions(scale));
+    }
+  }
+
   SkBitmap bm;
   if (!bm.tryAllocPixels(info))
     return nullptr;
@@ -768,6 +898,17 @@ Ref<Surface> SkiaSurface::loadSurface(const char* filename)
   if (r != SkCodec::kSuccess)
     return nullptr;
 
+  // Resample the decoded image to the exact size
+  if (bm.width() > fitSize.width() || bm.height() > fitSize.height()) {
+    SkBitmap scaled;
+    if (!scaled.tryAllocPixels(info.makeDimensions(fitSize)))
+      return nullptr;
+    if (!bm.pixmap().scalePixels(scaled.pixmap(),
+                                 SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kLinear)))
+      return nullptr;
+    bm.swap(scaled);
+  }
+
   auto sur = make_ref<SkiaSurface>();
   sur->swapBitmap(bm);
   return sur;
@@ -809,10 +950,12 @@ void SkiaSurface::skDrawSurface(const SkiaSurface* src,
                                 const SkPaint& paint,
                                 const SkCanvas::SrcRectConstraint constraint)
 {
+  addDamage(gfx::RectF(dstRect.x(), dstRect.y(), dstRect.width(), dstRect.height()));
+
 #if SK_SUPPORT_GPU
   src->flush();
-  if (auto srcImage = src->getOrCreateTextureImage()) {
-    m_canvas->drawImageRect(srcImage, srcRect, dstRect, sampling, &paint, constraint);
+  if (auto srcImage = src->getOrCreateTextureImage(m_canvas)) {
+    m_canvas->drawImageRect(srcImage.get(), srcRect, dstRect, sampling, &paint, constraint);
     return;
   }
 #endif
@@ -827,21 +970,30 @@ void SkiaSurface::skDrawSurface(const SkiaSurface* src,
 
 #if SK_SUPPORT_GPU
 
-const SkImage* SkiaSurface::getOrCreateTextureImage() const
+sk_sp<SkImage> SkiaSurface::getOrCreateTextureImage(const SkCanvas* dstCanvas) const
 {
+  // Textures are only useful to draw on GPU canvases. Raster
+  // canvases (e.g. the tiles that os::TileRasterizer draws from
+  // other threads) use the bitmap directly, so they never touch the
+  // GrDirectContext or the cached texture.
+  if (!dstCanvas->recordingContext())
+    return nullptr;
+
   // TODO use the GrDirectContext of the specific os::Window
   auto win = System::instance()->defaultWindow();
   if (!win || !win->sk_grCtx())
     return nullptr;
 
+  const std::lock_guard lock(g_textureImageMutex);
+
   // Invalidate the cached texture if the bitmap pixels were modified.
   if (m_cachedGen && m_cachedGen != m_bitmap.getGenerationID())
     m_image.reset();
 
   if (m_image && m_image->isValid(win->sk_grCtx()))
-    return m_image.get();
+    return m_image;
   if (uploadBitmapAsTexture() && m_image && m_image->isValid(win->sk_grCtx()))
-    return m_image.get();
+    return m_image;
   return nullptr;
 }
 
@@ -61,7 +61,7 @@ public:
   gfx::Matrix matrix() const override;
   void lock() override;
   void unlock() override;
-  SurfaceRef applyScale(float scaleFactor, const Sampling& sampling) override;
+  SurfaceRef makeSubsurface(const gfx::Rect& rc) override;
 
   void* nativeHandle() override;
 
@@ -72,6 +72,19 @@ public:
   gfx::Color getPixel(int x, int y) const override;
   void putPixel(gfx::Color color, int x, int y) override;
 
+  bool readPixels(const gfx::Rect& rc,
+                  void* dst,
+                  size_t rowBytes,
+                  PixelFormat format,
+                  PixelAlpha alpha,
+                  const ColorSpaceRef& colorSpace) const override;
+  bool writePixels(const gfx::Rect& rc,
+                   const void* src,
+                   size_t rowBytes,
+                   PixelFormat format,
+                   PixelAlpha alpha,
+                   const ColorSpaceRef& colorSpace) override;
+
   void drawLine(const float x0,
                 const float y0,
                 const float x1,
@@ -120,6 +133,13 @@ public:
 
   static SurfaceRef loadSurface(const char* filename);
 
+  // Loads the image scaled down to fit in "targetSize" (if it's not
+  // empty), using the scaled decoding of the codec when possible.
+  static SurfaceRef loadSurface(const char* filename, const gfx::Size& targetSize);
+
+protected:
+  SurfaceRef onApplyScale(float scaleFactor, const Sampling& sampling) override;
+
 private:
   void skDrawSurface(const Surface* src,
                      const gfx::Clip& clip,
@@ -140,7 +160,7 @@ private:
                      SkCanvas::SrcRectConstraint constraint);
 
 #if SK_SUPPORT_GPU
-  const SkImage* getOrCreateTextureImage() const;
+  sk_sp<SkImage> getOrCreateTextureImage(const SkCanvas* dstCanvas) const;
   bool uploadBitmapAsTexture() const;
 #endif
 
@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2018-2024  Igara Studio S.A.
+// Copyright (C) 2018-2025  Igara Studio S.A.
 // Copyright (C) 2012-2017  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -141,6 +141,12 @@ public:
 
   os::ColorSpaceRef windowsColorSpace() override { return m_windowCS; }
 
+protected:
+  SurfaceRef decodeSurface(const std::string& filename, const gfx::Size& targetSize) override
+  {
+    return SkiaSurface::loadSurface(filename.c_str(), targetSize);
+  }
+
 private:
   SkiaWindow* m_defaultWindow;
   bool m_gpuAcceleration;
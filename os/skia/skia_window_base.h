@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2021-2024  Igara Studio S.A.
+// Copyright (C) 2021-2025  Igara Studio S.A.
 //
 // This file is released under the terms of the MIT license.
 // Read LICENSE.txt for more information.
@@ -11,13 +11,18 @@
 #include "os/event.h"
 #include "os/event_queue.h"
 #include "os/gl/gl_context.h"
+#include "os/recording_surface.h"
 #include "os/skia/skia_gl.h"
 #include "os/skia/skia_surface.h"
 #include "os/system.h"
+#include "os/tile_rasterizer.h"
 #include "os/window.h"
 
 #include "include/core/SkCanvas.h"
 
+#include <algorithm>
+#include <memory>
+
 #if SK_SUPPORT_GPU
   #if LAF_WINDOWS
     #include <windows.h>
@@ -65,6 +70,7 @@ public:
   {
     if (m_surface)
       m_surface.reset();
+    m_pixelPool.reset();
 
     resizeSkiaSurface(this->clientSize());
   }
@@ -109,19 +115,51 @@ public:
 #endif // SK_SUPPORT_GPU
 
     // Raster surface
-    if (!m_surface) {
-      m_surface = make_ref<SkiaSurface>();
+    if (!m_surface)
+      m_surface = makeRasterSurface(newSize);
+    else
+      m_pixelPool.reset();
 
-      if (T::isTransparent())
-        m_surface->createRgba(newSize.w, newSize.h, m_colorSpace);
-      else
-        m_surface->create(newSize.w, newSize.h, m_colorSpace);
-    }
+    updateRecording();
+  }
+
+  bool isLiveResize() const { return m_liveResize; }
+
+  // Must be called when the user starts/finishes resizing the window
+  // interactively. During a live resize the raster backbuffer is a
+  // view of a bigger pixel allocation (with some slack in both
+  // dimensions) that is reused while the new size fits on it. When
+  // the live resize finishes, the backbuffer is shrunk to its exact
+  // size (keeping its pixels).
+  void setLiveResize(const bool state)
+  {
+    if (m_liveResize == state)
+      return;
+
+    m_liveResize = state;
+    if (state || !m_pixelPool || !m_surface)
+      return;
+
+    // Copy the pixels to a new surface of the exact size
+    Ref<SkiaSurface> view = m_surface;
+    m_pixelPool.reset();
+    m_surface = makeRasterSurface(gfx::Size(view->width(), view->height()));
+    view->blitTo(m_surface.get(), 0, 0, 0, 0, view->width(), view->height());
+
+    // Tiles are views of the old surface (the recording can be kept
+    // as the size is the same)
+    if (m_tileRasterizer)
+      m_tileRasterizer->reset();
   }
 
   // Returns the main surface to draw into this window.
   // You must not dispose this surface.
-  Surface* surface() override { return m_surface.get(); }
+  Surface* surface() override
+  {
+    if (m_recording)
+      return m_recording.get();
+    return m_surface.get();
+  }
 
   // Overrides the colorSpace() method to return the cached/stored
   // color space in this instance (instead of asking for the color
@@ -155,7 +193,7 @@ public:
       return;
     }
 
-    auto surface = static_cast<SkiaSurface*>(this->surface());
+    auto surface = backbuffer();
     if (!surface)
       return;
 
@@ -198,7 +236,44 @@ public:
   GrDirectContext* sk_grCtx() const override { return m_gl.grCtx(); }
 #endif
 
+  bool tiledRasterization() const override { return m_tiledRasterization; }
+
+  void setTiledRasterization(bool state) override
+  {
+    if (m_tiledRasterization == state)
+      return;
+
+    m_tiledRasterization = state;
+    if (!state) {
+      // Rasterize the pending commands in the backbuffer
+      if (m_recording && m_surface)
+        m_recording->playback(m_surface.get());
+      m_recording.reset();
+      m_tileRasterizer.reset();
+    }
+    else {
+      updateRecording();
+    }
+  }
+
 protected:
+  // Returns the surface with the pixels to present on the screen
+  // (it's the same as surface() if tiled rasterization is disabled).
+  SkiaSurface* backbuffer() const { return m_surface.get(); }
+
+  // Rasterizes the commands recorded in the RecordingSurface (in
+  // tiled rasterization mode) and returns the part of "rgn" that
+  // must be presented on the screen.
+  gfx::Region flushRecording(const gfx::Region& rgn)
+  {
+    if (!m_recording || !m_surface)
+      return rgn;
+
+    gfx::Region result = m_tileRasterizer->rasterize(m_recording.get(), m_surface.get(), rgn);
+    m_recording->reset();
+    return result;
+  }
+
   void initializeSurface()
   {
     m_initialized = true;
@@ -239,6 +314,58 @@ protected:
 #endif
 
 private:
+  // Minimum extra pixels allocated in each dimension during live
+  // resize (the slack is 25% of the size for big windows)
+  static constexpr int kLiveResizeMinSlack = 128;
+
+  Ref<SkiaSurface> makeRasterSurface(const gfx::Size& size)
+  {
+    const bool transparent = T::isTransparent();
+    auto create = [this, transparent](const gfx::Size& sz) {
+      auto surface = make_ref<SkiaSurface>();
+      if (transparent)
+        surface->createRgba(sz.w, sz.h, m_colorSpace);
+      else
+        surface->create(sz.w, sz.h, m_colorSpace);
+      return surface;
+    };
+
+    if (!m_liveResize) {
+      m_pixelPool.reset();
+      return create(size);
+    }
+
+    if (!m_pixelPool || m_pixelPool->width() < size.w || m_pixelPool->height() < size.h) {
+      // Release the old allocation before creating the new one
+      m_pixelPool.reset();
+      m_pixelPool = create(gfx::Size(size.w + std::max(kLiveResizeMinSlack, size.w / 4),
+                                     size.h + std::max(kLiveResizeMinSlack, size.h / 4)));
+    }
+
+    SurfaceRef view = m_pixelPool->makeSubsurface(gfx::Rect(gfx::Point(0, 0), size));
+    if (!view)
+      return create(size);
+    return AddRef(static_cast<SkiaSurface*>(view.get()));
+  }
+
+  // Creates the RecordingSurface for tiled rasterization (only for
+  // raster backbuffers).
+  void updateRecording()
+  {
+    if (!m_tiledRasterization || !m_surface || m_backend != Backend::NONE) {
+      m_recording.reset();
+      return;
+    }
+
+    if (!m_tileRasterizer)
+      m_tileRasterizer = std::make_unique<TileRasterizer>();
+    m_tileRasterizer->reset();
+
+    m_recording = make_ref<RecordingSurface>(m_surface->width(),
+                                             m_surface->height(),
+                                             m_colorSpace);
+  }
+
 #if SK_SUPPORT_GPU
   void detachGpuContext()
   {
@@ -255,7 +382,15 @@ private:
   // window is created, it send a first resize event.)
   bool m_initialized;
   Ref<SkiaSurface> m_surface;
+  // Pixels of m_surface during live resize (m_surface is a view of
+  // its top-left corner)
+  Ref<SkiaSurface> m_pixelPool;
+  bool m_liveResize = false;
   os::ColorSpaceRef m_colorSpace;
+  // Tiled rasterization mode
+  bool m_tiledRasterization = false;
+  Ref<RecordingSurface> m_recording;
+  std::unique_ptr<TileRasterizer> m_tileRasterizer;
 };
 
 } // namespace os
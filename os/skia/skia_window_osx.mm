@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2018-2022  Igara Studio S.A.
+// Copyright (C) 2018-2025  Igara Studio S.A.
 // Copyright (C) 2012-2018  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -68,8 +68,13 @@ void SkiaWindowOSX::setFullscreen(bool state)
   WindowOSX::setFullscreen(state);
 }
 
-void SkiaWindowOSX::invalidateRegion(const gfx::Region& rgn)
+void SkiaWindowOSX::invalidateRegion(const gfx::Region& _rgn)
 {
+  // In tiled rasterization mode, present only the tiles that changed
+  const gfx::Region rgn = flushRecording(_rgn);
+  if (rgn.isEmpty())
+    return;
+
   switch (backend()) {
     case Backend::NONE:
       @autoreleasepool {
@@ -155,6 +160,8 @@ void SkiaWindowOSX::onStartResizing()
 {
   if (++m_resizingCount > 1)
     return;
+
+  setLiveResize(true);
 }
 
 void SkiaWindowOSX::onResizing(gfx::Size& size)
@@ -172,6 +179,8 @@ void SkiaWindowOSX::onEndResizing()
   if (--m_resizingCount > 0)
     return;
 
+  setLiveResize(false);
+
   // Generate the resizing display event for the user.
   SystemRef system = System::instance();
   ASSERT(system);
@@ -203,7 +212,7 @@ void SkiaWindowOSX::paintGC(const gfx::RectF& rect)
   NSRect viewBounds = m_nsWindow.contentView.bounds;
   float scale = this->scale();
 
-  SkiaSurface* surface = static_cast<SkiaSurface*>(this->surface());
+  SkiaSurface* surface = backbuffer();
   if (!surface->isValid())
     return;
 
@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2019-2022  Igara Studio S.A.
+// Copyright (C) 2019-2025  Igara Studio S.A.
 // Copyright (C) 2012-2018  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -49,8 +49,13 @@ void SkiaWindowWin::onPaint(HDC hdc)
   }
 }
 
-void SkiaWindowWin::invalidateRegion(const gfx::Region& rgn)
+void SkiaWindowWin::invalidateRegion(const gfx::Region& _rgn)
 {
+  // In tiled rasterization mode, present only the tiles that changed
+  const gfx::Region rgn = flushRecording(_rgn);
+  if (rgn.isEmpty())
+    return;
+
   if (!isTransparent())
     return WindowWin::invalidateRegion(rgn);
 
@@ -58,7 +63,7 @@ void SkiaWindowWin::invalidateRegion(const gfx::Region& rgn)
   // UpdateLayeredWindowIndirect() because we want to present the RGBA
   // surface as the window surface with alpha per pixel.
 
-  SkiaSurface* surface = static_cast<SkiaSurface*>(this->surface());
+  SkiaSurface* surface = backbuffer();
   ASSERT(surface);
 
   if (!surface || !surface->isValid())
@@ -70,11 +75,14 @@ void SkiaWindowWin::invalidateRegion(const gfx::Region& rgn)
   const int s = scale();
   const int sw = bitmap.width() * s;
   const int sh = bitmap.height() * s;
+  // Rows can be bigger than the bitmap width (e.g. during live
+  // resize the backbuffer is a view of a bigger allocation)
+  const int stride = int(bitmap.rowBytes() / bitmap.bytesPerPixel());
 
   HWND hwnd = (HWND)nativeHandle();
   HDC hdc = GetDC(nullptr);
   HBITMAP hbmpScaled = CreateCompatibleBitmap(hdc, sw, sh);
-  HBITMAP hbmp = CreateBitmap(w, h, 1, 32, (void*)bitmap.getPixels());
+  HBITMAP hbmp = CreateBitmap(stride, h, 1, 32, (void*)bitmap.getPixels());
   HDC srcHdcScaled = CreateCompatibleDC(hdc);
   HDC srcHdc = CreateCompatibleDC(hdc);
   SelectObject(srcHdcScaled, hbmpScaled);
@@ -129,7 +137,7 @@ void SkiaWindowWin::paintHDC(HDC hdc)
     return;
   }
 
-  SkiaSurface* surface = static_cast<SkiaSurface*>(this->surface());
+  SkiaSurface* surface = backbuffer();
   ASSERT(surface);
 
   // It looks like the surface can be nullptr here from a WM_PAINT
@@ -142,14 +150,16 @@ void SkiaWindowWin::paintHDC(HDC hdc)
   BITMAPINFO bmi;
   memset(&bmi, 0, sizeof(bmi));
   bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-  bmi.bmiHeader.biWidth = bitmap.width();
+  // The DIB width is the row stride (the backbuffer can be a view of
+  // a bigger allocation during live resize)
+  bmi.bmiHeader.biWidth = int(bitmap.rowBytes() / bitmap.bytesPerPixel());
   bmi.bmiHeader.biHeight = -bitmap.height();
   bmi.bmiHeader.biPlanes = 1;
   bmi.bmiHeader.biBitCount = 32;
   bmi.bmiHeader.biCompression = BI_RGB;
   bmi.bmiHeader.biSizeImage = 0;
 
-  ASSERT(bitmap.width() * bitmap.bytesPerPixel() == bitmap.rowBytes());
+  ASSERT(bitmap.rowBytes() % bitmap.bytesPerPixel() == 0);
 
   int ret = StretchDIBits(hdc,
                           0,
@@ -170,11 +180,13 @@ void SkiaWindowWin::paintHDC(HDC hdc)
 void SkiaWindowWin::onStartResizing()
 {
   m_resizing = true;
+  setLiveResize(true);
 }
 
 void SkiaWindowWin::onEndResizing()
 {
   m_resizing = false;
+  setLiveResize(false);
 
   Event ev;
   ev.setType(Event::ResizeWindow);
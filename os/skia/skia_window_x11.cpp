@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2020-2022  Igara Studio S.A.
+// Copyright (C) 2020-2025  Igara Studio S.A.
 // Copyright (C) 2016-2018  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -11,6 +11,8 @@
 
 #include "os/skia/skia_window_x11.h"
 
+#include "base/debug.h"
+#include "gfx/integer_scale.h"
 #include "gfx/size.h"
 #include "os/event.h"
 #include "os/event_queue.h"
@@ -39,7 +41,7 @@ bool convert_skia_bitmap_to_ximage(const SkBitmap& bitmap, XImage& image)
   image.bitmap_bit_order = LSBFirst;
   image.bitmap_pad = bpp;
   image.depth = (bitmap.alphaType() == kPremul_SkAlphaType ? 32 : 24);
-  image.bytes_per_line = bitmap.rowBytes() - 4 * bitmap.width();
+  image.bytes_per_line = int(bitmap.rowBytes());
   image.bits_per_pixel = bpp;
 
   return (XInitImage(&image) ? true : false);
@@ -55,6 +57,47 @@ SkiaWindowX11::SkiaWindowX11(const WindowSpec& spec) : Base(X11::instance()->dis
   initColorSpace();
 }
 
+SkiaWindowX11::~SkiaWindowX11()
+{
+  if (m_settleTimer)
+    EventQueue::instance()->removeTimer(m_settleTimer);
+}
+
+void SkiaWindowX11::invalidateRegion(const gfx::Region& rgn)
+{
+  if (!tiledRasterization())
+    return WindowX11::invalidateRegion(rgn);
+
+  // Present only the tiles that changed
+  const gfx::Region dirty = flushRecording(rgn);
+  for (const gfx::Rect& rc : dirty)
+    WindowX11::invalidateRegion(gfx::Region(rc));
+}
+
+void SkiaWindowX11::onResize(const gfx::Size& sz)
+{
+  // X11 doesn't notify when the user starts/finishes resizing the
+  // window, so consecutive resize events are considered a live
+  // resize (which finishes when there are no more resizes in
+  // kLiveResizeTimeout milliseconds).
+  const base::tick_t now = base::current_tick();
+  if (m_lastResizeTick && now - m_lastResizeTick < kLiveResizeTimeout)
+    setLiveResize(true);
+  m_lastResizeTick = now;
+
+  Base::onResize(sz);
+
+  // Restart the timer to finish the live resize (we cannot wait the
+  // next onPaint() as it might not come if the app is idle)
+  EventQueue* queue = EventQueue::instance();
+  if (m_settleTimer)
+    queue->removeTimer(m_settleTimer);
+  m_settleTimer = queue->addTimer(kLiveResizeTimeout / 1000.0, false, [this] {
+    m_settleTimer = 0;
+    setLiveResize(false);
+  });
+}
+
 void SkiaWindowX11::onPaint(const gfx::Rect& rc)
 {
 #if SK_SUPPORT_GPU
@@ -62,7 +105,7 @@ void SkiaWindowX11::onPaint(const gfx::Rect& rc)
     return;
 #endif
 
-  auto surface = static_cast<SkiaSurface*>(this->surface());
+  auto surface = backbuffer();
   const SkBitmap& bitmap = surface->bitmap();
 
   int scale = this->scale();
@@ -73,35 +116,45 @@ void SkiaWindowX11::onPaint(const gfx::Rect& rc)
     }
   }
   else {
-    SkBitmap scaled;
-    const SkImageInfo info =
-      SkImageInfo::Make(rc.w, rc.h, bitmap.info().colorType(), bitmap.info().alphaType());
-
-    // Increase m_buffer for "scaled" pixels if needed.
-    const size_t rowBytes = info.minRowBytes();
-    const size_t requiredSize = info.computeByteSize(rowBytes);
+    // Only the part of the dirty rect that is inside the scaled
+    // backbuffer
+    const gfx::Rect bounds =
+      rc.createIntersection(gfx::Rect(0, 0, bitmap.width() * scale, bitmap.height() * scale));
+    if (bounds.isEmpty())
+      return;
+    ASSERT(bitmap.bytesPerPixel() == 4);
+
+    // Reuse m_buffer between frames (it's resized only when a bigger
+    // dirty rect is painted).
+    const size_t requiredSize = size_t(bounds.w) * bounds.h;
     if (requiredSize > m_buffer.size())
       m_buffer.resize(requiredSize);
 
-    if (scaled.installPixels(info, (void*)m_buffer.data(), rowBytes)) {
-      SkPaint paint;
-      paint.setBlendMode(SkBlendMode::kSrc);
-
-      SkCanvas canvas(scaled);
-      SkRect srcRect = SkRect::Make(
-        SkIRect::MakeXYWH(rc.x / scale, rc.y / scale, rc.w / scale, rc.h / scale));
-      SkRect dstRect = SkRect::Make(SkIRect::MakeXYWH(0, 0, rc.w, rc.h));
-      canvas.drawImageRect(SkImages::RasterFromPixmap(bitmap.pixmap(), nullptr, nullptr),
-                           srcRect,
-                           dstRect,
-                           SkSamplingOptions(),
-                           &paint,
-                           SkCanvas::kStrict_SrcRectConstraint);
-
-      XImage image;
-      if (convert_skia_bitmap_to_ximage(scaled, image)) {
-        XPutImage(x11display(), x11window(), gc(), &image, 0, 0, rc.x, rc.y, rc.w, rc.h);
-      }
+    // Nearest-neighbor upscaling of the dirty rect directly in the
+    // buffer that is sent to the X server.
+    gfx::integer_upscale((const uint32_t*)bitmap.getPixels(),
+                         int(bitmap.rowBytes() / 4),
+                         m_buffer.data(),
+                         bounds.w,
+                         bounds,
+                         scale);
+
+    SkBitmap scaled;
+    const SkImageInfo info =
+      SkImageInfo::Make(bounds.w, bounds.h, bitmap.info().colorType(), bitmap.info().alphaType());
+    XImage image;
+    if (scaled.installPixels(info, (void*)m_buffer.data(), 4 * bounds.w) &&
+        convert_skia_bitmap_to_ximage(scaled, image)) {
+      XPutImage(x11display(),
+                x11window(),
+                gc(),
+                &image,
+                0,
+                0,
+                bounds.x,
+                bounds.y,
+                bounds.w,
+                bounds.h);
     }
   }
 }
@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2021-2022  Igara Studio S.A.
+// Copyright (C) 2021-2025  Igara Studio S.A.
 // Copyright (C) 2016-2018  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -10,7 +10,9 @@
 #pragma once
 
 #include "base/disable_copying.h"
+#include "base/time.h"
 #include "gfx/size.h"
+#include "os/event_queue.h"
 #include "os/gl/gl_context_glx.h"
 #include "os/native_cursor.h"
 #include "os/skia/skia_window_base.h"
@@ -24,14 +26,27 @@ namespace os {
 class SkiaWindowX11 : public SkiaWindowBase<WindowX11> {
 public:
   SkiaWindowX11(const WindowSpec& spec);
+  ~SkiaWindowX11();
 
   std::string getLayout() override { return ""; }
   void setLayout(const std::string& layout) override {}
 
+  void invalidateRegion(const gfx::Region& rgn) override;
+
 private:
+  // Milliseconds between resize events to consider them a live resize
+  static constexpr base::tick_t kLiveResizeTimeout = 250;
+
+  void onResize(const gfx::Size& sz) override;
   void onPaint(const gfx::Rect& rc) override;
 
-  std::vector<uint8_t> m_buffer;
+  // Scaled pixels of the dirty rect (when scale() > 1)
+  std::vector<uint32_t> m_buffer;
+
+  base::tick_t m_lastResizeTick = 0;
+
+  // One-shot timer that finishes the live resize
+  TimerId m_settleTimer = 0;
 
   DISABLE_COPYING(SkiaWindowX11);
 };
@@ -0,0 +1,148 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "os/surface.h"
+
+#include "gfx/matrix.h"
+#include "gfx/region.h"
+#include "os/scaled_surface_cache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace os {
+
+namespace {
+
+std::atomic<uint32_t> g_nextGenerationId(1);
+
+} // anonymous namespace
+
+Surface::~Surface()
+{
+  if (m_scaleCached)
+    ScaledSurfaceCache::instance()->remove(this);
+}
+
+SurfaceRef Surface::applyScale(const float scaleFactor, const Sampling& sampling)
+{
+  if (scaleFactor == 1.0f)
+    return AddRef(this);
+
+  ScaledSurfaceCache* cache = ScaledSurfaceCache::instance();
+  if (!cache->isEnabled())
+    return onApplyScale(scaleFactor, sampling);
+
+  if (SurfaceRef scaled = cache->get(this, scaleFactor, sampling))
+    return scaled;
+
+  SurfaceRef scaled = onApplyScale(scaleFactor, sampling);
+  m_scaleCached = true;
+  cache->add(this, scaleFactor, sampling, scaled);
+  return scaled;
+}
+
+uint32_t Surface::generationId() const
+{
+  uint32_t id = m_generationId.load(std::memory_order_acquire);
+  while (id == 0) {
+    const uint32_t newId = g_nextGenerationId++;
+    if (newId == 0) // Skip 0 on overflow
+      continue;
+
+    // If other thread assigned an ID first, we use that one
+    if (m_generationId.compare_exchange_strong(id, newId))
+      return newId;
+  }
+  return id;
+}
+
+void Surface::resetGenerationId()
+{
+  // Usually several drawing functions are called without asking
+  // for the ID in between.
+  if (m_generationId.load(std::memory_order_relaxed) == 0)
+    return;
+
+  // Scaled versions of the previous pixels cannot be used anymore
+  if (m_generationId.exchange(0) != 0 && m_scaleCached.exchange(false))
+    ScaledSurfaceCache::instance()->remove(this);
+}
+
+void Surface::setDamageTracking(const bool state)
+{
+  if (state) {
+    if (!m_damage)
+      m_damage = std::make_unique<gfx::Region>();
+  }
+  else {
+    m_damage.reset();
+  }
+}
+
+gfx::Region Surface::takeDamage()
+{
+  gfx::Region result;
+  if (m_damage)
+    std::swap(result, *m_damage);
+  return result;
+}
+
+void Surface::addDamage(const gfx::RectF& rc, const Paint* paint)
+{
+  resetGenerationId();
+  if (m_damage)
+    addDeviceDamage(drawDeviceBounds(rc, paint, matrix(), getClipBounds()));
+}
+
+void Surface::addDeviceDamage(const gfx::Rect& rc)
+{
+  resetGenerationId();
+  if (!m_damage)
+    return;
+
+  const gfx::Rect area = rc.createIntersection(bounds());
+  // Usually the same area is modified several times (e.g. the
+  // background and then the text of a widget).
+  if (area.isEmpty() || m_damage->contains(area) == gfx::Region::In)
+    return;
+
+  *m_damage |= gfx::Region(area);
+}
+
+// static
+gfx::Rect Surface::drawDeviceBounds(gfx::RectF rc,
+                                    const Paint* paint,
+                                    const gfx::Matrix& matrix,
+                                    const gfx::Rect& clipBounds)
+{
+  if (paint && paint->style() != Paint::Fill) {
+    // Half of the stroke width multiplied by the default miter limit (4)
+    rc.enlarge(std::max(paint->strokeWidth(), 1.0f) * 2.0f);
+  }
+  // One extra pixel for antialiasing
+  rc.enlarge(1.0f);
+
+  gfx::RectF dev = matrix.mapRect(rc);
+  dev &= gfx::RectF(clipBounds);
+  if (dev.isEmpty())
+    return gfx::Rect();
+
+  // Smallest integer rectangle that contains "dev" (clipped again to
+  // avoid float to int overflows with huge rectangles)
+  const int x1 = int(std::floor(dev.x));
+  const int y1 = int(std::floor(dev.y));
+  const int x2 = int(std::ceil(dev.x2()));
+  const int y2 = int(std::ceil(dev.y2()));
+  return gfx::Rect(x1, y1, x2 - x1, y2 - y1) & clipBounds;
+}
+
+} // namespace os
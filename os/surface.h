@@ -20,6 +20,10 @@
 #include "os/sampling.h"
 #include "os/surface_format.h"
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
 
 namespace gfx {
@@ -38,11 +42,13 @@ using SurfaceRef = Ref<Surface>;
 
 class Surface : public RefCount {
 public:
+  using DrawFunc = std::function<void(Surface* surface)>;
+
   enum class ColorChannelsOrder { RGB, BGR };
 
   static ColorChannelsOrder getNativeColorChannelsOrder();
 
-  virtual ~Surface() {}
+  virtual ~Surface();
   virtual int width() const = 0;
   virtual int height() const = 0;
   gfx::Rect bounds() const { return gfx::Rect(0, 0, width(), height()); }
@@ -79,6 +85,30 @@ public:
   virtual gfx::Color getPixel(int x, int y) const = 0;
   virtual void putPixel(gfx::Color color, int x, int y) = 0;
 
+  // Reads/writes all the pixels of the "rc" area at once (use these
+  // functions instead of calling getPixel()/putPixel() for each
+  // pixel). The buffer contains "rc.h" rows of "rowBytes" bytes with
+  // pixels in the given format/alpha type. Pixels of "rc" outside the
+  // surface bounds are not read/written. Returns false if nothing
+  // was read/written.
+  //
+  // If "colorSpace" is not nullptr, pixels are converted from the
+  // surface color space to "colorSpace" (readPixels) or from
+  // "colorSpace" to the surface color space (writePixels).
+  // Matrix and clipping region are ignored.
+  virtual bool readPixels(const gfx::Rect& rc,
+                          void* dst,
+                          size_t rowBytes,
+                          PixelFormat format = PixelFormat::kRgba8888,
+                          PixelAlpha alpha = PixelAlpha::kStraight,
+                          const ColorSpaceRef& colorSpace = nullptr) const = 0;
+  virtual bool writePixels(const gfx::Rect& rc,
+                           const void* src,
+                           size_t rowBytes,
+                           PixelFormat format = PixelFormat::kRgba8888,
+                           PixelAlpha alpha = PixelAlpha::kStraight,
+                           const ColorSpaceRef& colorSpace = nullptr) = 0;
+
   virtual void drawLine(float x0, float y0, float x1, float y1, const os::Paint& paint) = 0;
 
   void drawLine(const int x0, const int y0, const int x1, const int y1, const os::Paint& paint)
@@ -146,12 +176,89 @@ public:
                                bool drawCenter,
                                const os::Paint* paint) = 0;
 
+  // Calls a function that draws in this surface with the specific
+  // API of its backend (e.g. text::draw_text() uses the SkCanvas of
+  // a SkiaSurface). "bounds" are in local coordinates (empty bounds
+  // means that the function can draw in the whole clipping region).
+  // The function is called immediately, but surfaces without pixels
+  // can keep it to call it later with the real surface (see
+  // RecordingSurface), so it shouldn't capture references to
+  // temporary data. It must add the modified area to the damage
+  // region (see addDamage()).
+  virtual void drawFunc(const gfx::RectF& bounds, const DrawFunc& func) { func(this); }
+
   // Returns the same surface if scaleFactor == 1.0 or a new scaled
-  // surface.
+  // surface. If the ScaledSurfaceCache is enabled, the scaled surface
+  // can be a cached one shared with other callers (so it must not be
+  // modified).
+  [[nodiscard]]
+  SurfaceRef applyScale(float scaleFactor, const Sampling& sampling = {});
+
+  // Returns a new surface that shares the pixels of the "rc" area of
+  // this surface, with its own matrix and clipping region (so each
+  // subsurface can be used to draw from a different thread). Returns
+  // nullptr if it's not supported (e.g. GPU surfaces).
   [[nodiscard]]
-  virtual SurfaceRef applyScale(float scaleFactor, const Sampling& sampling = {}) = 0;
+  virtual SurfaceRef makeSubsurface(const gfx::Rect& rc) { return nullptr; }
 
   virtual void* nativeHandle() = 0;
+
+  // Damage tracking: when it's enabled, each drawing function adds
+  // the area of the surface it modifies to a damage region (in
+  // device coordinates, i.e. transformed by the current matrix and
+  // clipped by the clip bounds). The region is conservative, it
+  // includes stroke/antialiasing borders. takeDamage() returns the
+  // accumulated region and clears it, e.g. to call
+  // Window::invalidateRegion() with exactly that region (see
+  // Window::invalidateDamage()).
+  void setDamageTracking(bool state);
+  bool isDamageTracking() const { return m_damage != nullptr; }
+  gfx::Region takeDamage();
+
+  // Adds an area to the damage region (only if damage tracking is
+  // enabled). Use these functions when the pixels are modified
+  // without the Surface API (e.g. with getData() or nativeHandle()).
+  // "rc" is in local coordinates (it's transformed by the current
+  // matrix), "deviceRc" is in surface pixels.
+  void addDamage(const gfx::RectF& rc, const Paint* paint = nullptr);
+  void addDeviceDamage(const gfx::Rect& deviceRc);
+
+  // Unique ID of the current pixels of this surface (it's never 0).
+  // A new ID is generated when the surface is modified, i.e. after
+  // addDamage()/addDeviceDamage() are called (all drawing functions
+  // call them), or after the last unlock() (as the pixels could be
+  // modified with getData()). Pixels modified through a subsurface
+  // don't change the ID of the parent surface.
+  uint32_t generationId() const;
+
+protected:
+  // Creates a new surface with this one scaled (scaleFactor is
+  // never 1.0).
+  virtual SurfaceRef onApplyScale(float scaleFactor, const Sampling& sampling) = 0;
+
+  // Generates a new generationId() for pixels that are replaced
+  // without drawing functions (e.g. a new bitmap). Scaled versions
+  // of the previous pixels are removed from the ScaledSurfaceCache.
+  void resetGenerationId();
+
+  // Returns the bounds in device coordinates of "rc" drawn with the
+  // given paint, the given matrix, and clipped to "clipBounds".
+  static gfx::Rect drawDeviceBounds(gfx::RectF rc,
+                                    const Paint* paint,
+                                    const gfx::Matrix& matrix,
+                                    const gfx::Rect& clipBounds);
+
+private:
+  // Damage region (nullptr if damage tracking is disabled)
+  std::unique_ptr<gfx::Region> m_damage;
+
+  // 0 when a new generation ID must be assigned (the ID can be
+  // requested from other threads, e.g. by the ScaledSurfaceCache).
+  mutable std::atomic<uint32_t> m_generationId = 0;
+
+  // True if this surface was added as a source in the
+  // ScaledSurfaceCache.
+  std::atomic<bool> m_scaleCached = false;
 };
 
 class SurfaceLock {
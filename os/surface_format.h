@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2024  Igara Studio S.A.
+// Copyright (C) 2024-2025  Igara Studio S.A.
 // Copyright (C) 2012-2013  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -23,6 +23,28 @@ enum class PixelAlpha {
   kStraight,
 };
 
+// Pixel layout of the buffers used in Surface::readPixels() and
+// Surface::writePixels().
+enum class PixelFormat {
+  kRgba8888, // R, G, B, A bytes (same as gfx::Color in little-endian)
+  kBgra8888, // B, G, R, A bytes
+  kRgbaF16,  // R, G, B, A half floats (8 bytes per pixel)
+  kAlpha8,   // Only alpha
+  kGray8,    // Only luminance (without alpha)
+};
+
+inline int bytes_per_pixel(const PixelFormat format)
+{
+  switch (format) {
+    case PixelFormat::kRgba8888:
+    case PixelFormat::kBgra8888: return 4;
+    case PixelFormat::kRgbaF16:  return 8;
+    case PixelFormat::kAlpha8:
+    case PixelFormat::kGray8:    return 1;
+  }
+  return 0;
+}
+
 struct SurfaceFormatData {
   SurfaceFormat format;
   uint32_t bitsPerPixel;
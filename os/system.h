@@ -42,6 +42,8 @@ class System;
 
 using SystemRef = Ref<System>;
 
+using LoadSurfaceCallback = std::function<void(const Ref<Surface>& surface)>;
+
 // TODO why we just don't return nullptr if the window creation fails?
 //      maybe an error handler function?
 class WindowCreationException : public std::runtime_error {
@@ -174,6 +176,17 @@ public:
   virtual Ref<Surface> loadSurface(const char* filename) = 0;
   virtual Ref<Surface> loadRgbaSurface(const char* filename) = 0;
 
+  // Loads the given image file in a background thread and calls the
+  // callback from the main thread (with an Event::Callback event
+  // processed by the event queue) with the loaded surface (or
+  // nullptr if the file cannot be loaded). If "targetSize" is not
+  // empty, the image is scaled down to fit in that size (keeping the
+  // aspect ratio), decoding it directly in a smaller resolution if
+  // the image format supports it. Useful to load thumbnails.
+  virtual void loadSurfaceAsync(const char* filename,
+                                const gfx::Size& targetSize,
+                                LoadSurfaceCallback&& callback) = 0;
+
   // Creates a new cursor with the given surface.
   //
   // Warning: On Windows there is a limit of 10,000 GDI objects per
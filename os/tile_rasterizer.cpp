@@ -0,0 +1,201 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "os/tile_rasterizer.h"
+
+#include "base/debug.h"
+#include "gfx/matrix.h"
+#include "os/recording_surface.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace os {
+
+namespace {
+
+// Hashes the pixels of a raster surface (64 bits at a time, it's
+// only used to compare the pixels of the same tile between frames).
+uint64_t hash_pixels(const Surface* surface)
+{
+  uint64_t hash = 0xcbf29ce484222325ull;
+  const size_t rowBytes = size_t(surface->width()) * 4;
+  for (int y = 0; y < surface->height(); ++y) {
+    const uint8_t* p = surface->getData(0, y);
+    if (!p)
+      return 0;
+
+    size_t i = 0;
+    for (; i + 8 <= rowBytes; i += 8) {
+      uint64_t v;
+      std::memcpy(&v, p + i, 8);
+      hash = (hash ^ v) * 0x100000001b3ull;
+      hash ^= hash >> 29;
+    }
+    for (; i < rowBytes; ++i)
+      hash = (hash ^ p[i]) * 0x100000001b3ull;
+  }
+  return hash;
+}
+
+// Copies the pixels of a raster surface (row by row, without
+// padding) to "pixels".
+void copy_pixels(const Surface* surface, std::vector<uint8_t>& pixels)
+{
+  const size_t rowBytes = size_t(surface->width()) * 4;
+  pixels.resize(rowBytes * surface->height());
+  for (int y = 0; y < surface->height(); ++y) {
+    const uint8_t* p = surface->getData(0, y);
+    if (!p) {
+      pixels.clear();
+      return;
+    }
+    std::memcpy(&pixels[y * rowBytes], p, rowBytes);
+  }
+}
+
+bool same_pixels(const Surface* surface, const std::vector<uint8_t>& pixels)
+{
+  const size_t rowBytes = size_t(surface->width()) * 4;
+  if (pixels.empty() || pixels.size() != rowBytes * surface->height())
+    return false;
+
+  for (int y = 0; y < surface->height(); ++y) {
+    const uint8_t* p = surface->getData(0, y);
+    if (!p || std::memcmp(&pixels[y * rowBytes], p, rowBytes) != 0)
+      return false;
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+TileRasterizer::TileRasterizer(int threads, int tileSize)
+  : m_threads(threads > 0 ? threads : std::max<int>(1, std::thread::hardware_concurrency()))
+  , m_tileSize(std::max(16, tileSize))
+{
+  // With one thread the tiles are rasterized in the calling thread
+  if (m_threads > 1)
+    m_pool = std::make_unique<base::thread_pool>(m_threads);
+}
+
+TileRasterizer::~TileRasterizer()
+{
+}
+
+void TileRasterizer::reset()
+{
+  m_tiles.clear();
+  m_dst.reset();
+  m_dstSize = gfx::Size();
+}
+
+bool TileRasterizer::createTiles(Surface* dst)
+{
+  const gfx::Size size(dst->width(), dst->height());
+  if (m_dst.get() == dst && m_dstSize == size)
+    return !m_tiles.empty();
+
+  reset();
+  m_dst = AddRef(dst);
+  m_dstSize = size;
+
+  for (int y = 0; y < size.h; y += m_tileSize) {
+    for (int x = 0; x < size.w; x += m_tileSize) {
+      Tile tile;
+      tile.bounds = gfx::Rect(x, y, m_tileSize, m_tileSize) & dst->bounds();
+      tile.view = dst->makeSubsurface(tile.bounds);
+      if (!tile.view) {
+        m_tiles.clear();
+        return false;
+      }
+      m_tiles.push_back(std::move(tile));
+    }
+  }
+  return !m_tiles.empty();
+}
+
+gfx::Region TileRasterizer::rasterize(const RecordingSurface* recording,
+                                      Surface* dst,
+                                      const gfx::Region& invalid)
+{
+  ASSERT(recording);
+  ASSERT(dst);
+
+  if (recording->hasScrolls() || !createTiles(dst)) {
+    recording->playback(dst);
+    // Pixels have been modified outside the tiles
+    for (Tile& tile : m_tiles)
+      tile.hasHash = false;
+    return invalid;
+  }
+
+  const gfx::Rect drawBounds = recording->drawBounds();
+  const gfx::Rect invalidBounds = invalid.bounds();
+
+  auto rasterTile = [recording](Tile& tile, const bool draw) {
+    if (draw) {
+      Surface* view = tile.view.get();
+      view->save();
+      view->setMatrix(gfx::Matrix::MakeTrans(-tile.bounds.x, -tile.bounds.y));
+      // Skip commands outside the tile
+      recording->playback(view, gfx::Region(view->bounds()));
+      view->restore();
+    }
+    tile.hash = hash_pixels(tile.view.get());
+    tile.hasHash = true;
+    tile.changed = (!tile.presented || tile.hash != tile.presentedHash ||
+                    !same_pixels(tile.view.get(), tile.presentedPixels));
+  };
+
+  for (Tile& tile : m_tiles) {
+    const bool draw = (!recording->isEmpty() && tile.bounds.intersects(drawBounds));
+    const bool present = (tile.bounds.intersects(invalidBounds) &&
+                          invalid.contains(tile.bounds) != gfx::Region::Out);
+    if (!draw && !(present && !tile.hasHash))
+      continue;
+
+    if (m_pool)
+      m_pool->execute([&rasterTile, &tile, draw] { rasterTile(tile, draw); });
+    else
+      rasterTile(tile, draw);
+  }
+  if (m_pool)
+    m_pool->wait_all();
+
+  // Present only the invalid part of tiles that changed
+  gfx::Region result;
+  for (Tile& tile : m_tiles) {
+    if (!tile.bounds.intersects(invalidBounds))
+      continue;
+
+    const gfx::Region::Overlap overlap = invalid.contains(tile.bounds);
+    if (overlap == gfx::Region::Out || !tile.changed)
+      continue;
+
+    if (overlap == gfx::Region::In) {
+      result |= gfx::Region(tile.bounds);
+      copy_pixels(tile.view.get(), tile.presentedPixels);
+      tile.presentedHash = tile.hash;
+      tile.presented = true;
+      tile.changed = false;
+    }
+    else {
+      // Partially presented tiles are presented again the next time
+      gfx::Region part(tile.bounds);
+      part &= invalid;
+      result |= part;
+    }
+  }
+  return result;
+}
+
+} // namespace os
@@ -0,0 +1,88 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OS_TILE_RASTERIZER_H_INCLUDED
+#define OS_TILE_RASTERIZER_H_INCLUDED
+#pragma once
+
+#include "base/disable_copying.h"
+#include "base/thread_pool.h"
+#include "gfx/rect.h"
+#include "gfx/region.h"
+#include "os/surface.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace os {
+
+class RecordingSurface;
+
+// Replays a RecordingSurface in a raster surface splitting the
+// surface in tiles, where each tile is rasterized in parallel in a
+// thread pool (using Surface::makeSubsurface() to draw each tile with
+// its own canvas). It also keeps a hash and a copy of the pixels of
+// each tile to know which tiles really changed since the last time
+// they were presented on the screen.
+class TileRasterizer {
+public:
+  static constexpr int kDefaultTileSize = 256;
+
+  // Uses the given number of threads (or one thread per CPU core if
+  // "threads" is 0).
+  explicit TileRasterizer(int threads = 0, int tileSize = kDefaultTileSize);
+  ~TileRasterizer();
+
+  int threads() const { return m_threads; }
+  int tileSize() const { return m_tileSize; }
+
+  // Replays all the commands of "recording" in "dst" (rasterizing
+  // only the tiles that intersect recording->drawBounds()). Returns
+  // the part of "invalid" that must be presented on the screen: the
+  // tiles where the pixels changed since the last time they were
+  // presented.
+  //
+  // If the recording cannot be replayed in tiles (it has scrolls, or
+  // "dst" doesn't support subsurfaces) it's replayed directly in
+  // "dst" from the calling thread, and "invalid" is returned.
+  gfx::Region rasterize(const RecordingSurface* recording,
+                        Surface* dst,
+                        const gfx::Region& invalid);
+
+  // Forgets all tiles (e.g. when the destination surface changes).
+  void reset();
+
+private:
+  struct Tile {
+    gfx::Rect bounds;
+    SurfaceRef view;
+    uint64_t hash = 0;          // Hash of the current pixels
+    uint64_t presentedHash = 0; // Hash of the presented pixels
+    // Copy of the presented pixels, compared with the current pixels
+    // when the hash is the same (to avoid skipping a tile that changed
+    // because of a hash collision)
+    std::vector<uint8_t> presentedPixels;
+    bool hasHash = false;
+    bool presented = false;
+    bool changed = true; // True if the current pixels weren't presented
+  };
+
+  bool createTiles(Surface* dst);
+
+  int m_threads;
+  int m_tileSize;
+  std::unique_ptr<base::thread_pool> m_pool;
+  SurfaceRef m_dst;
+  gfx::Size m_dstSize;
+  std::vector<Tile> m_tiles;
+
+  DISABLE_COPYING(TileRasterizer);
+};
+
+} // namespace os
+
+#endif
@@ -0,0 +1,143 @@
+// LAF OS Library
+// Copyright (C) 2025  Igara Studio S.A.
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <gtest/gtest.h>
+
+#if !LAF_SKIA
+
+  #include "os/none/surface.h"
+  #include "os/recording_surface.h"
+  #include "os/tile_rasterizer.h"
+
+using namespace os;
+
+namespace {
+
+void draw_scene(Surface* s, gfx::Color color)
+{
+  Paint paint;
+  paint.color(color);
+  s->drawRect(gfx::Rect(10, 10, 100, 50), paint);
+
+  paint.antialias(true);
+  paint.color(gfx::rgba(0, 0, 255, 128));
+  s->drawCircle(60, 60, 40, paint);
+
+  paint.style(Paint::Stroke);
+  paint.strokeWidth(3.0f);
+  s->drawLine(0, 0, 127, 100, paint);
+
+  s->putPixel(gfx::rgba(255, 255, 0), 70, 3);
+}
+
+bool same_pixels(const Surface* a, const Surface* b)
+{
+  for (int y = 0; y < a->height(); ++y)
+    for (int x = 0; x < a->width(); ++x)
+      if (a->getPixel(x, y) != b->getPixel(x, y))
+        return false;
+  return true;
+}
+
+} // anonymous namespace
+
+TEST(TileRasterizer, Subsurface)
+{
+  SurfaceRef s = os::make_ref<NoneSurface>(8, 8, nullptr);
+  SurfaceRef sub = s->makeSubsurface(gfx::Rect(2, 3, 4, 4));
+  ASSERT_TRUE(sub);
+  EXPECT_EQ(4, sub->width());
+  EXPECT_EQ(gfx::Rect(0, 0, 4, 4), sub->getClipBounds());
+
+  Paint paint;
+  paint.color(gfx::rgba(255, 0, 0));
+  sub->drawRect(gfx::Rect(-10, -10, 100, 100), paint);
+  EXPECT_EQ(0, s->getPixel(1, 3));
+  EXPECT_EQ(gfx::rgba(255, 0, 0), s->getPixel(2, 3));
+  EXPECT_EQ(gfx::rgba(255, 0, 0), s->getPixel(5, 6));
+  EXPECT_EQ(0, s->getPixel(6, 6));
+  EXPECT_EQ(0, s->getPixel(5, 7));
+
+  EXPECT_FALSE(s->makeSubsurface(gfx::Rect(6, 6, 4, 4)));
+}
+
+TEST(TileRasterizer, SameResultWithAnyNumberOfThreads)
+{
+  SurfaceRef expected = os::make_ref<NoneSurface>(128, 100, nullptr);
+  draw_scene(expected.get(), gfx::rgba(255, 0, 0));
+
+  auto rec = os::make_ref<RecordingSurface>(128, 100);
+  draw_scene(rec.get(), gfx::rgba(255, 0, 0));
+
+  for (int threads : { 1, 2, 4 }) {
+    TileRasterizer tiles(threads, 32);
+    EXPECT_EQ(threads, tiles.threads());
+
+    SurfaceRef s = os::make_ref<NoneSurface>(128, 100, nullptr);
+    const gfx::Region invalid(s->bounds());
+    gfx::Region present = tiles.rasterize(rec.get(), s.get(), invalid);
+    EXPECT_TRUE(same_pixels(expected.get(), s.get()));
+    EXPECT_EQ(s->bounds(), present.bounds());
+
+    // Nothing changed
+    auto empty = os::make_ref<RecordingSurface>(128, 100);
+    present = tiles.rasterize(empty.get(), s.get(), invalid);
+    EXPECT_TRUE(present.isEmpty());
+
+    // Same pixels drawn again (an opaque rectangle)
+    Paint paint;
+    paint.color(gfx::rgba(255, 0, 0));
+    empty->drawRect(gfx::Rect(90, 12, 8, 6), paint);
+    present = tiles.rasterize(empty.get(), s.get(), invalid);
+    EXPECT_TRUE(present.isEmpty());
+  }
+}
+
+TEST(TileRasterizer, PresentOnlyChangedTiles)
+{
+  TileRasterizer tiles(2, 32);
+  SurfaceRef s = os::make_ref<NoneSurface>(128, 128, nullptr);
+  const gfx::Region invalid(s->bounds());
+
+  auto rec = os::make_ref<RecordingSurface>(128, 128);
+  draw_scene(rec.get(), gfx::rgba(255, 0, 0));
+  tiles.rasterize(rec.get(), s.get(), invalid);
+
+  // Change the color of one pixel
+  rec->reset();
+  rec->putPixel(gfx::rgba(0, 255, 0), 40, 70);
+  gfx::Region present = tiles.rasterize(rec.get(), s.get(), invalid);
+  EXPECT_EQ(gfx::Rect(32, 64, 32, 32), present.bounds());
+  EXPECT_EQ(gfx::rgba(0, 255, 0), s->getPixel(40, 70));
+
+  // Changed tile but not invalidated, it's presented later
+  rec->reset();
+  rec->putPixel(gfx::rgba(0, 0, 255), 100, 100);
+  present = tiles.rasterize(rec.get(), s.get(), gfx::Region(gfx::Rect(0, 0, 10, 10)));
+  EXPECT_TRUE(present.isEmpty());
+
+  rec->reset();
+  present = tiles.rasterize(rec.get(), s.get(), invalid);
+  EXPECT_EQ(gfx::Rect(96, 96, 32, 32), present.bounds());
+
+  // Scrolls are not replayed in tiles
+  rec->reset();
+  rec->scrollTo(gfx::Rect(0, 0, 64, 64), 32, 0);
+  present = tiles.rasterize(rec.get(), s.get(), invalid);
+  EXPECT_EQ(s->bounds(), present.bounds());
+}
+
+#endif // !LAF_SKIA
+
+int app_main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
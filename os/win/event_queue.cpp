@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2019-2022  Igara Studio S.A.
+// Copyright (C) 2019-2025  Igara Studio S.A.
 // Copyright (C) 2012-2018  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -30,7 +30,7 @@ void EventQueueWin::clearEvents()
   m_events.clear();
 }
 
-void EventQueueWin::getEvent(Event& ev, double timeout)
+void EventQueueWin::onGetEvent(Event& ev, double timeout)
 {
   const base::tick_t untilTick = base::current_tick() + timeout * 1000.0;
   MSG msg;
@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2020-2021  Igara Studio S.A.
+// Copyright (C) 2020-2025  Igara Studio S.A.
 // Copyright (C) 2012-2018  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -20,9 +20,11 @@ namespace os {
 class EventQueueWin : public EventQueue {
 public:
   void queueEvent(const Event& ev) override;
-  void getEvent(Event& ev, double timeout) override;
   void clearEvents();
 
+protected:
+  void onGetEvent(Event& ev, double timeout) override;
+
 private:
   base::concurrent_queue<Event> m_events;
 };
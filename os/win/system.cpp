@@ -12,9 +12,11 @@
 #include "os/win/system.h"
 
 #include "gfx/color.h"
+#include "gfx/pixel_conversion.h"
 #include "os/win/screen.h"
 
 #include <limits>
+#include <vector>
 
 #pragma push_macro("ERROR")
 #undef ERROR
@@ -217,21 +219,25 @@ CursorRef SystemWin::makeCursor(const os::Surface* surface,
   if (!g_cursor_cache.recreate(sz))
     return nullptr;
 
+  gfx::PixelMasks masks;
+  masks.r = format.redMask;
+  masks.g = format.greenMask;
+  masks.b = format.blueMask;
+  masks.a = format.alphaMask;
+  const gfx::PixelUnpacker unpacker(32, masks);
+
+  // Each row of the surface is converted to ARGB only once
+  std::vector<uint32_t> argb(surface->width());
   uint32_t* bits = g_cursor_cache.bits();
   for (int y = 0; y < sz.h; ++y) {
-    const uint32_t* ptr = (const uint32_t*)surface->getData(0, (sz.h - 1 - y) / scale);
-    for (int x = 0, u = 0; x < sz.w; ++x, ++bits) {
-      uint32_t c = *ptr;
-      uint32_t a = ((c & format.alphaMask) >> format.alphaShift);
-
-      *bits = (a << 24) | (((c & format.redMask) >> format.redShift) << 16) |
-              (((c & format.greenMask) >> format.greenShift) << 8) |
-              (((c & format.blueMask) >> format.blueShift));
-      if (++u == scale) {
-        u = 0;
-        ++ptr;
-      }
+    if (y == 0 || (sz.h - 1 - y) / scale != (sz.h - y) / scale) {
+      unpacker.unpack(surface->getData(0, (sz.h - 1 - y) / scale),
+                      argb.data(),
+                      int(argb.size()));
+      gfx::swizzle_rb(argb.data(), argb.data(), int(argb.size()));
     }
+    for (int x = 0; x < sz.w; ++x, ++bits)
+      *bits = argb[x / scale];
   }
 
   ICONINFO ii;
@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2019-2021  Igara Studio S.A.
+// Copyright (C) 2019-2025  Igara Studio S.A.
 //
 // This file is released under the terms of the MIT license.
 // Read LICENSE.txt for more information.
@@ -14,9 +14,18 @@
 #include "gfx/region.h"
 #include "os/event.h"
 #include "os/event_queue.h"
+#include "os/surface.h"
+
+#include <atomic>
 
 namespace os {
 
+static std::atomic<uint32_t> g_lastWindowId(0);
+
+Window::Window() : m_id(++g_lastWindowId)
+{
+}
+
 gfx::Rect Window::bounds() const
 {
   return gfx::Rect(0, 0, width(), height());
@@ -27,6 +36,17 @@ void Window::invalidate()
   invalidateRegion(gfx::Region(bounds()));
 }
 
+void Window::invalidateDamage()
+{
+  Surface* surface = this->surface();
+  if (!surface || !surface->isDamageTracking())
+    return;
+
+  const gfx::Region damage = surface->takeDamage();
+  if (!damage.isEmpty())
+    invalidateRegion(damage);
+}
+
 gfx::Point Window::pointToScreen(const gfx::Point& clientPosition) const
 {
   gfx::Point res = clientPosition;
@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (c) 2018-2024  Igara Studio S.A.
+// Copyright (c) 2018-2025  Igara Studio S.A.
 // Copyright (c) 2012-2018  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -18,6 +18,7 @@
 #include "os/screen.h"
 #include "os/surface_list.h"
 
+#include <cstdint>
 #include <functional>
 #include <string>
 
@@ -71,8 +72,13 @@ class Window : public RefCount {
 public:
   typedef void* NativeHandle;
 
+  Window();
   virtual ~Window() {}
 
+  // Unique ID of this window in the process (it's never reused, even
+  // when the window is destroyed). IDs start from 1.
+  uint32_t id() const { return m_id; }
+
   // Real rectangle of this window (including title bar, etc.) in
   // the screen. (The scale is not involved.)
   virtual gfx::Rect frame() const = 0;
@@ -118,11 +124,27 @@ public:
   virtual void invalidateRegion(const gfx::Region& rgn) = 0;
   void invalidate();
 
+  // Invalidates only the area of surface() that was modified since
+  // the last call (see Surface::setDamageTracking()). Does nothing if
+  // the surface doesn't track damage or nothing was drawn. Note that
+  // the surface can be re-created when the window is resized, so
+  // damage tracking must be enabled again on Event::ResizeWindow.
+  void invalidateDamage();
+
   // GPU-related functions
   virtual bool gpuAcceleration() const = 0;
   virtual void setGpuAcceleration(bool state) {}
   virtual void swapBuffers() = 0;
 
+  // Tiled rasterization for non-GPU windows: surface() returns an
+  // os::RecordingSurface, and the recorded commands are rasterized
+  // in tiles from several threads (see os::TileRasterizer) when the
+  // window is invalidated, presenting only the tiles that changed.
+  // The recording (including its matrix and clip) is reset after
+  // each invalidateRegion(), and pixels of surface() cannot be read.
+  virtual bool tiledRasterization() const { return false; }
+  virtual void setTiledRasterization(bool state) {}
+
   // Focus the window to receive the keyboard input by default.
   virtual void activate() = 0;
   virtual void maximize() = 0;
@@ -229,6 +251,7 @@ protected:
   virtual void onSetDragTarget() {}
 
 private:
+  const uint32_t m_id;
   void* m_userData;
   DragTarget* m_dragTarget = nullptr;
 };
@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2019-2022  Igara Studio S.A.
+// Copyright (C) 2019-2025  Igara Studio S.A.
 // Copyright (C) 2016-2018  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -16,10 +16,16 @@
 
 #include <X11/Xlib.h>
 #include <fcntl.h>
-#include <sys/select.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/poll.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <cerrno>
+#include <cstdint>
+#include <iterator>
+
 #define EV_TRACE(...)
 
 namespace os {
@@ -69,19 +75,14 @@ const char* get_event_name(XEvent& event)
 }
 #endif
 
-void wait_file_descriptor_for_reading(int fd, base::tick_t timeoutMilliseconds)
+void add_fd_for_reading(int epollFd, int fd)
 {
-  fd_set fds;
-  FD_ZERO(&fds);
-  FD_SET(fd, &fds);
-
-  timeval timeout;
-  timeout.tv_sec = timeoutMilliseconds / 1000;
-  timeout.tv_usec = ((timeoutMilliseconds % 1000) * 1000);
-
-  // First argument must be set to the highest-numbered file
-  // descriptor in any of the three sets, plus 1.
-  select(fd + 1, &fds, nullptr, nullptr, &timeout);
+  epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.fd = fd;
+  if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == -1) {
+    EV_TRACE("XEvent: Failed to add fd %d to epoll\n", fd);
+  }
 }
 
 } // anonymous namespace
@@ -96,59 +97,83 @@ EventQueueX11::EventQueueX11()
       return;
     }
   }
-  pipe_fd = open(fifoPath.c_str(), O_RDONLY | O_NONBLOCK);
+  pipe_fd = open(fifoPath.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
   if (pipe_fd == -1) {
     EV_TRACE("XEvent: Failed to open named pipe\n");
   }
+  else {
+    m_fifoWriteFd = open(fifoPath.c_str(), O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+  }
 }
 
 EventQueueX11::~EventQueueX11()
 {
-  if (pipe_fd != -1) {
-    close(pipe_fd);
-    pipe_fd = -1;
+  for (int* fd : { &m_epollFd, &m_wakeFd, &m_fifoWriteFd, &pipe_fd }) {
+    if (*fd != -1) {
+      close(*fd);
+      *fd = -1;
+    }
   }
 }
 
 void EventQueueX11::queueEvent(const Event& ev)
 {
-  m_events.push(ev);
+  // Stylus samples are merged in the last MouseMove if it wasn't
+  // delivered yet (so we get one MouseMove with all the samples
+  // received between two getEvent() calls).
+  if (ev.type() == Event::MouseMove && !ev.pointerSamples().empty()) {
+    m_events.push_or_merge(ev, [](Event& last, const Event& next) {
+      return last.mergeMouseMove(next);
+    });
+  }
+  else {
+    m_events.push(ev);
+  }
+
+  // Wake up the main thread if it's waiting for events (this happens
+  // only when the event is queued from a background thread).
+  if (m_waiting && m_wakeFd != -1) {
+    const uint64_t value = 1;
+    (void)write(m_wakeFd, &value, sizeof(value));
+  }
 }
 
-void EventQueueX11::getEvent(Event& ev, double timeout)
+void EventQueueX11::onGetEvent(Event& ev, double timeout)
 {
-  base::tick_t startTime = base::current_tick();
+  const base::tick_t startTime = base::current_tick();
 
   ev.setWindow(nullptr);
 
+  // Send pending requests to the X server without waiting a reply (a
+  // XSync() would be a full round trip in each call), and read the
+  // events that are already available in the connection.
   ::Display* display = X11::instance()->display();
-  XSync(display, False);
+  XFlush(display);
 
-  XEvent event;
-  int events = XEventsQueued(display, QueuedAlready);
-  if (events == 0) {
-    if (timeout == kWithoutTimeout) {
-      // Wait for a XEvent only if we have an empty queue of os::Event
-      // (so there is no more events to process in our own queue).
-      if (m_events.empty())
-        events = 1;
-      else
-        events = 0;
-    }
-    else if (timeout > 0.0) {
-      // Wait timeout (waiting the X11 connection file description for
-      // a read operation). We've to use this method to wait for
-      // events with timeout because we don't have a X11 function like
-      // XNextEvent() with a timeout.
-      const base::tick_t timeoutMsecs = base::tick_t(timeout * 1000.0);
-      const base::tick_t elapsedMsecs = base::current_tick() - startTime;
-      if (int(timeoutMsecs - elapsedMsecs) > 0) {
-        const int connFileDesc = ConnectionNumber(display);
-        wait_file_descriptor_for_reading(connFileDesc, timeoutMsecs - elapsedMsecs);
+  int events = XEventsQueued(display, QueuedAfterReading);
+  while (true) {
+    // Sleep only if there is nothing to do, in other case we just
+    // check the FIFO and the wake up eventfd without waiting.
+    int waitMsecs = 0;
+    if (events == 0 && m_events.empty()) {
+      if (timeout == kWithoutTimeout) {
+        waitMsecs = -1;
+      }
+      else if (timeout > 0.0) {
+        const base::tick_t timeoutMsecs = base::tick_t(timeout * 1000.0);
+        const base::tick_t elapsedMsecs = base::current_tick() - startTime;
+        if (timeoutMsecs > elapsedMsecs)
+          waitMsecs = int(timeoutMsecs - elapsedMsecs);
       }
-
-      events = XEventsQueued(display, QueuedAlready);
     }
+
+    const bool xdata = waitEvents(display, waitMsecs);
+    if (xdata && events == 0)
+      events = XEventsQueued(display, QueuedAfterReading);
+
+    // Continue waiting if we were woken up by incomplete X11 data
+    if (waitMsecs == 0 || events > 0 || !m_events.empty())
+      break;
   }
 
   // If the user is not converting dead keys it means that we are not
@@ -158,6 +183,7 @@ void EventQueueX11::getEvent(Event& ev, double timeout)
   // key pressed.
   const bool removeRepeats = (!WindowX11::textInput());
 
+  XEvent event;
   for (int i = 0; i < events; ++i) {
     XNextEvent(display, &event);
 
@@ -188,29 +214,149 @@ void EventQueueX11::getEvent(Event& ev, double timeout)
     }
   }
 
-  if (pipe_fd != -1) {
-    char buf[4096];
-    ssize_t n = read(pipe_fd, buf, sizeof(buf) - 1);
-    if (n > 0) {
-      buf[n] = 0;
-      std::vector<std::string> files;
-      std::istringstream iss(buf);
-      std::string line;
-      while (std::getline(iss, line)) {
-        if (!line.empty())
-          files.push_back(line);
-      }
-      if (!files.empty()) {
-        Event dropEv;
-        dropEv.setType(Event::DropFiles);
-        dropEv.setFiles(files);
-        os::queue_event(dropEv);
-      }
+  if (!m_events.try_pop(ev))
+    ev.setType(Event::None);
+}
+
+bool EventQueueX11::waitEvents(::Display* display, int timeoutMsecs)
+{
+  if (!initEpoll()) {
+    // Wait only the X11 connection
+    pollfd pfd = { ConnectionNumber(display), POLLIN, 0 };
+    return (poll(&pfd, 1, timeoutMsecs) > 0);
+  }
+
+  // The X11 display is created after the EventQueue instance
+  const int displayFd = ConnectionNumber(display);
+  if (displayFd != m_displayFd) {
+    m_displayFd = displayFd;
+    add_fd_for_reading(m_epollFd, displayFd);
+  }
+
+  if (timeoutMsecs != 0) {
+    // Check the queue again after m_waiting=true, so an event queued
+    // from other thread before this point is not lost (and events
+    // queued after this point will write to m_wakeFd).
+    m_waiting = true;
+    if (!m_events.empty())
+      timeoutMsecs = 0;
+  }
+
+  epoll_event ready[16];
+  int n;
+  do {
+    n = epoll_wait(m_epollFd, ready, std::size(ready), timeoutMsecs);
+  } while (n == -1 && errno == EINTR);
+  m_waiting = false;
+
+  bool xdata = false;
+  for (int i = 0; i < n; ++i) {
+    const int fd = ready[i].data.fd;
+    if (fd == m_displayFd) {
+      xdata = true;
+    }
+    else if (fd == m_wakeFd) {
+      uint64_t value;
+      (void)read(m_wakeFd, &value, sizeof(value));
+    }
+    else if (fd == pipe_fd) {
+      readEventsFifo();
+    }
+    else {
+      auto it = m_fdWatches.find(fd);
+      if (it == m_fdWatches.end())
+        continue;
+
+      std::shared_ptr<FdWatch> watch = it->second;
+      Event ev;
+      ev.setType(Event::Callback);
+      ev.setCallback([this, watch] {
+        if (!watch->active)
+          return;
+        watch->callback(watch->fd);
+
+        // The callback can remove the watch
+        if (watch->active) {
+          epoll_event event = {};
+          event.events = EPOLLIN | EPOLLONESHOT;
+          event.data.fd = watch->fd;
+          epoll_ctl(m_epollFd, EPOLL_CTL_MOD, watch->fd, &event);
+        }
+      });
+      m_events.push(ev);
     }
   }
+  return xdata;
+}
 
-  if (!m_events.try_pop(ev))
-    ev.setType(Event::None);
+bool EventQueueX11::initEpoll()
+{
+  if (m_epollFd != -1)
+    return true;
+
+  m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+  if (m_epollFd == -1) {
+    EV_TRACE("XEvent: Failed to create epoll fd\n");
+    return false;
+  }
+  m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (m_wakeFd != -1)
+    add_fd_for_reading(m_epollFd, m_wakeFd);
+  if (pipe_fd != -1)
+    add_fd_for_reading(m_epollFd, pipe_fd);
+  return true;
+}
+
+bool EventQueueX11::addFdWatch(const int fd, FdCallback&& callback)
+{
+  ASSERT(callback);
+  if (fd < 0 || m_fdWatches.find(fd) != m_fdWatches.end() || !initEpoll())
+    return false;
+
+  epoll_event event = {};
+  event.events = EPOLLIN | EPOLLONESHOT;
+  event.data.fd = fd;
+  if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event) == -1)
+    return false;
+
+  auto watch = std::make_shared<FdWatch>();
+  watch->fd = fd;
+  watch->callback = std::move(callback);
+  m_fdWatches[fd] = watch;
+  return true;
+}
+
+void EventQueueX11::removeFdWatch(const int fd)
+{
+  auto it = m_fdWatches.find(fd);
+  if (it == m_fdWatches.end())
+    return;
+
+  it->second->active = false;
+  m_fdWatches.erase(it);
+  epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+void EventQueueX11::readEventsFifo()
+{
+  char buf[4096];
+  ssize_t n = read(pipe_fd, buf, sizeof(buf) - 1);
+  if (n > 0) {
+    buf[n] = 0;
+    std::vector<std::string> files;
+    std::istringstream iss(buf);
+    std::string line;
+    while (std::getline(iss, line)) {
+      if (!line.empty())
+        files.push_back(line);
+    }
+    if (!files.empty()) {
+      Event dropEv;
+      dropEv.setType(Event::DropFiles);
+      dropEv.setFiles(files);
+      os::queue_event(dropEv);
+    }
+  }
 }
 
 void EventQueueX11::clearEvents()
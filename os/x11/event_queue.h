@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2021-2022  Igara Studio S.A.
+// Copyright (C) 2021-2025  Igara Studio S.A.
 // Copyright (C) 2016-2018  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -14,25 +14,62 @@
 #include "os/event_queue.h"
 #include "os/x11/x11.h"
 
+#include <atomic>
 #include <deque>
+#include <map>
+#include <memory>
 
 namespace os {
 
 class EventQueueX11 : public EventQueue {
 public:
   void queueEvent(const Event& ev) override;
-  void getEvent(Event& ev, double timeout) override;
   void clearEvents() override;
+  bool addFdWatch(int fd, FdCallback&& callback) override;
+  void removeFdWatch(int fd) override;
   EventQueueX11();
   ~EventQueueX11() override;
 
   bool isEmpty() const { return m_events.empty(); }
 
+protected:
+  void onGetEvent(Event& ev, double timeout) override;
+
 private:
+  struct FdWatch {
+    int fd;
+    bool active = true;
+    FdCallback callback;
+  };
+
   void processX11Event(XEvent& event);
 
+  // Creates the epoll instance the first time it's needed, returns
+  // false if it cannot be created.
+  bool initEpoll();
+
+  // Waits until the X11 connection, the events FIFO, the wake up
+  // eventfd, or a watched fd has data to read (or the timeout in milliseconds is
+  // reached, -1 = without timeout, 0 = don't wait). Returns false if
+  // there is no X11 data to read.
+  bool waitEvents(::Display* display, int timeoutMsecs);
+  void readEventsFifo();
+
   base::concurrent_queue<Event> m_events;
   int pipe_fd = -1;
+  // Write end of our own FIFO, opened just to avoid EPOLLHUP events
+  // each time an external writer closes the FIFO.
+  int m_fifoWriteFd = -1;
+  // Used to wake up the main thread from queueEvent()
+  int m_wakeFd = -1;
+  int m_epollFd = -1;
+  int m_displayFd = -1; // X11 connection fd registered in m_epollFd
+  // True when the main thread is (or is about to be) blocked in
+  // epoll_wait() and needs m_wakeFd to wake up from queueEvent().
+  std::atomic<bool> m_waiting = false;
+  // File descriptors watched with addFdWatch(), registered with
+  // EPOLLONESHOT and enabled again when the callback is executed.
+  std::map<int, std::shared_ptr<FdWatch>> m_fdWatches;
 };
 
 using EventQueueImpl = EventQueueX11;
@@ -10,6 +10,7 @@
 
 #include "os/x11/system.h"
 
+#include "gfx/pixel_conversion.h"
 #include "os/x11/cursor.h"
 
 #include <X11/Xcursor/Xcursor.h>
@@ -17,6 +18,7 @@
 
 #include <algorithm>
 #include <array>
+#include <vector>
 
 namespace os {
 
@@ -119,23 +121,26 @@ CursorRef SystemX11::makeCursor(const Surface* surface, const gfx::Point& focus,
   const int w = scale * surface->width();
   const int h = scale * surface->height();
 
+  gfx::PixelMasks masks;
+  masks.r = format.redMask;
+  masks.g = format.greenMask;
+  masks.b = format.blueMask;
+  masks.a = format.alphaMask;
+  const gfx::PixelUnpacker unpacker(32, masks);
+
   ::Cursor xcursor = X11_None;
   ::XcursorImage* image = g_cachedCursorImage.recreate(w, h);
   if (image != X11_None) {
+    // Each row of the surface is converted to ARGB only once
+    std::vector<uint32_t> argb(surface->width());
     XcursorPixel* dst = image->pixels;
     for (int y = 0; y < h; ++y) {
-      const uint32_t* src = (const uint32_t*)surface->getData(0, y / scale);
-      for (int x = 0, u = 0; x < w; ++x, ++dst) {
-        const uint32_t c = *src;
-        *dst = (((c & format.alphaMask) >> format.alphaShift) << 24) |
-               (((c & format.redMask) >> format.redShift) << 16) |
-               (((c & format.greenMask) >> format.greenShift) << 8) |
-               (((c & format.blueMask) >> format.blueShift));
-        if (++u == scale) {
-          u = 0;
-          ++src;
-        }
+      if (y % scale == 0) {
+        unpacker.unpack(surface->getData(0, y / scale), argb.data(), int(argb.size()));
+        gfx::swizzle_rb(argb.data(), argb.data(), int(argb.size()));
       }
+      for (int x = 0; x < w; ++x, ++dst)
+        *dst = argb[x / scale];
     }
 
     // We have to limit the focus position inside the cursor area to
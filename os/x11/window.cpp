@@ -18,6 +18,7 @@
 #include "base/thread.h"
 #include "base/trim_string.h"
 #include "gfx/border.h"
+#include "gfx/pixel_conversion.h"
 #include "gfx/rect.h"
 #include "gfx/region.h"
 #include "os/dnd.h"
@@ -34,6 +35,7 @@
 #include "os/x11/x11.h"
 #include "os/x11/xinput.h"
 
+#include <algorithm>
 #include <array>
 #include <map>
 #include <set>
@@ -696,19 +698,24 @@ void WindowX11::setIcons(const SurfaceList& icons)
     SurfaceFormatData format;
     icon->getFormat(&format);
 
+    gfx::PixelMasks masks;
+    masks.r = format.redMask;
+    masks.g = format.greenMask;
+    masks.b = format.blueMask;
+    masks.a = format.alphaMask;
+    const gfx::PixelUnpacker unpacker(32, masks);
+
+    // _NET_WM_ICON uses ARGB pixels stored in "long" items
+    std::vector<uint32_t> argb(w);
     std::vector<unsigned long> data(w * h + 2);
     int i = 0;
     data[i++] = w;
     data[i++] = h;
     for (int y = 0; y < h; ++y) {
-      const uint32_t* p = (const uint32_t*)icon->getData(0, y);
-      for (int x = 0; x < w; ++x, ++p) {
-        const uint32_t c = *p;
-        data[i++] = (((c & format.blueMask) >> format.blueShift)) |
-                    (((c & format.greenMask) >> format.greenShift) << 8) |
-                    (((c & format.redMask) >> format.redShift) << 16) |
-                    (((c & format.alphaMask) >> format.alphaShift) << 24);
-      }
+      unpacker.unpack(icon->getData(0, y), argb.data(), w);
+      gfx::swizzle_rb(argb.data(), argb.data(), w);
+      std::copy(argb.begin(), argb.end(), data.begin() + i);
+      i += w;
     }
 
     const Atom _NET_WM_ICON = XInternAtom(m_display, "_NET_WM_ICON", False);
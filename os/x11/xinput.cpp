@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2020-2024  Igara Studio S.A.
+// Copyright (C) 2020-2025  Igara Studio S.A.
 //
 // This file is released under the terms of the MIT license.
 // Read LICENSE.txt for more information.
@@ -15,10 +15,35 @@
 #include "os/system.h"
 #include "os/x11/x11.h"
 
+#include <algorithm>
 #include <cstring>
 
 namespace os {
 
+namespace {
+
+// Returns the value of the given axis from the axis_data of a
+// device event (which contains "count" axes from "first").
+template<typename T>
+bool get_axis_value(const T* event, const int axis, int& value)
+{
+  if (axis < event->first_axis || axis >= event->first_axis + event->axes_count)
+    return false;
+  value = event->axis_data[axis - event->first_axis];
+  return true;
+}
+
+// Converts the tilt value to the [-1.0, +1.0] range
+float normalize_tilt(const int value, const int min, const int max)
+{
+  if (min >= max)
+    return 0.0f;
+  const float mid = (min + max) / 2.0f;
+  return std::clamp((value - mid) / ((max - min) / 2.0f), -1.0f, 1.0f);
+}
+
+} // anonymous namespace
+
 XInput::~XInput()
 {
   if (m_xi) {
@@ -120,6 +145,10 @@ void XInput::load(::Display* display)
       info.pointerType = pointerType;
       info.minPressure = valuator->axes[2].min_value;
       info.maxPressure = valuator->axes[2].max_value;
+      if (valuator->num_axes >= 5) {
+        info.tiltX = { valuator->axes[3].min_value, valuator->axes[3].max_value };
+        info.tiltY = { valuator->axes[4].min_value, valuator->axes[4].max_value };
+      }
 
       XDevice* device = XOpenDevice(display, devInfo->id);
       if (!device)
@@ -174,11 +203,13 @@ void XInput::convertExtensionEvent(const XEvent& xevent, Event& ev, int scale, T
 {
   ev.setType(m_eventTypes[xevent.type]);
 
-  gfx::Point pos;
+  gfx::PointF pos;
   KeyModifiers modifiers = kKeyNoneModifier;
   const Event::MouseButton button = Event::NoneButton;
   XID deviceid;
-  int pressure;
+  int pressure = 0;
+  int tilt[2] = { 0, 0 };
+  bool hasTilt = false;
 
   switch (ev.type()) {
     case Event::MouseDown:
@@ -186,10 +217,11 @@ void XInput::convertExtensionEvent(const XEvent& xevent, Event& ev, int scale, T
       const auto* button = (const XDeviceButtonEvent*)&xevent;
       time = button->time;
       deviceid = button->deviceid;
-      pos.x = button->x / scale;
-      pos.y = button->y / scale;
+      pos.x = float(button->x) / scale;
+      pos.y = float(button->y) / scale;
       modifiers = get_modifiers_from_x(button->state);
-      pressure = button->axis_data[2];
+      get_axis_value(button, 2, pressure);
+      hasTilt = (get_axis_value(button, 3, tilt[0]) && get_axis_value(button, 4, tilt[1]));
       ev.setButton(get_mouse_button_from_x(button->button));
       break;
     }
@@ -198,10 +230,11 @@ void XInput::convertExtensionEvent(const XEvent& xevent, Event& ev, int scale, T
       const auto* motion = (const XDeviceMotionEvent*)&xevent;
       time = motion->time;
       deviceid = motion->deviceid;
-      pos.x = motion->x / scale;
-      pos.y = motion->y / scale;
+      pos.x = float(motion->x) / scale;
+      pos.y = float(motion->y) / scale;
       modifiers = get_modifiers_from_x(motion->state);
-      pressure = motion->axis_data[2];
+      get_axis_value(motion, 2, pressure);
+      hasTilt = (get_axis_value(motion, 3, tilt[0]) && get_axis_value(motion, 4, tilt[1]));
       break;
     }
 
@@ -209,7 +242,11 @@ void XInput::convertExtensionEvent(const XEvent& xevent, Event& ev, int scale, T
   }
 
   ev.setModifiers(modifiers);
-  ev.setPosition(pos);
+  ev.setPosition(gfx::Point(pos));
+
+  PointerSample sample;
+  sample.position = pos;
+  sample.time = convertTime(time);
 
   auto it = m_info.find(deviceid);
   ASSERT(it != m_info.end());
@@ -220,7 +257,36 @@ void XInput::convertExtensionEvent(const XEvent& xevent, Event& ev, int scale, T
                      float(info.maxPressure - info.minPressure));
     }
     ev.setPointerType(info.pointerType);
+
+    sample.pressure = ev.pressure();
+    if (hasTilt) {
+      sample.tiltX = normalize_tilt(tilt[0], info.tiltX.min, info.tiltX.max);
+      sample.tiltY = normalize_tilt(tilt[1], info.tiltY.min, info.tiltY.max);
+    }
+  }
+
+  // Consecutive MouseMove events are merged in the EventQueue (see
+  // Event::mergeMouseMove()) keeping all the samples.
+  ev.addPointerSample(sample);
+}
+
+base::tick_t XInput::convertTime(const Time time)
+{
+  // The X server time is in milliseconds too, we just add the
+  // elapsed time since the previous sample (adjusted if we see a
+  // sample from the future, i.e. the first event was received with
+  // some delay). The unsigned 32-bit difference works even if the X
+  // time wrapped around.
+  const base::tick_t now = base::current_tick();
+  base::tick_t tick = now;
+  if (m_hasLastTime) {
+    const int32_t delta = int32_t(uint32_t(time) - m_lastTime);
+    tick = base::tick_t(std::clamp<int64_t>(int64_t(m_lastTick) + delta, 0, int64_t(now)));
   }
+  m_lastTime = uint32_t(time);
+  m_lastTick = tick;
+  m_hasLastTime = true;
+  return tick;
 }
 
 void XInput::addEvent(int type, XEventClass eventClass, Event::Type ourEventype)
@@ -1,5 +1,5 @@
 // LAF OS Library
-// Copyright (C) 2020-2022  Igara Studio S.A.
+// Copyright (C) 2020-2025  Igara Studio S.A.
 //
 // This file is released under the terms of the MIT license.
 // Read LICENSE.txt for more information.
@@ -16,6 +16,7 @@
 #include <X11/Xlib.h>
 #include <X11/extensions/XInput.h>
 
+#include <cstdint>
 #include <map>
 #include <vector>
 
@@ -49,17 +50,34 @@ public:
 private:
   void addEvent(int type, XEventClass eventClass, Event::Type ourEventype);
 
+  struct Axis {
+    int min = 0;
+    int max = 0;
+  };
+
   struct Info {
     PointerType pointerType;
     int minPressure = 0;
     int maxPressure = 1000;
+    // Axes 3 and 4 (if the device has them)
+    Axis tiltX;
+    Axis tiltY;
   };
 
+  // Converts the X server time to base::current_tick() time.
+  base::tick_t convertTime(Time time);
+
   base::dll m_xi = nullptr;
   std::vector<XDevice*> m_openDevices;
   std::map<XID, Info> m_info;
   std::vector<XEventClass> m_eventClasses;
   std::vector<Event::Type> m_eventTypes;
+  // Last converted X server time and its base::current_tick() time
+  // (the X server time is a 32-bit value that wraps around every
+  // ~49.7 days, so only the difference between two times is used)
+  uint32_t m_lastTime = 0;
+  base::tick_t m_lastTick = 0;
+  bool m_hasLastTime = false;
 };
 
 } // namespace os
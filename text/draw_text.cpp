@@ -1,5 +1,5 @@
 // LAF Text Library
-// Copyright (C) 2020-2024  Igara Studio S.A.
+// Copyright (C) 2020-2025  Igara Studio S.A.
 // Copyright (C) 2017  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -33,44 +33,21 @@
   #include "include/core/SkCanvas.h"
 #endif
 
-namespace text {
-
-void draw_text(os::Surface* surface,
-               const FontRef& font,
-               const std::string& text,
-               gfx::PointF pos,
-               const os::Paint* paint,
-               const TextAlign textAlign)
-{
-  ASSERT(surface);
-  if (!surface)
-    return;
+#include <optional>
 
-  const TextBlobRef blob = TextBlob::Make(font, text);
-  if (!blob)
-    return;
-
-  switch (textAlign) {
-    case TextAlign::Left:   break;
-    case TextAlign::Center: pos.x -= blob->bounds().w / 2.0f; break;
-    case TextAlign::Right:  pos.x -= blob->bounds().w; break;
-  }
+namespace text {
 
-  draw_text(surface, blob, pos, paint);
-}
+namespace {
 
-void draw_text(os::Surface* surface,
-               const TextBlobRef& blob,
-               const gfx::PointF& pos,
-               const os::Paint* paint)
+// Draws the blob in the real surface.
+void draw_text_blob(os::Surface* surface,
+                    const TextBlobRef& blob,
+                    const gfx::PointF& pos,
+                    const os::Paint* paint)
 {
-  ASSERT(surface);
-  ASSERT(blob);
-  if (!surface || !blob)
-    return;
-
 #if LAF_SKIA
   if (const auto* skiaBlob = dynamic_cast<const SkiaTextBlob*>(blob.get())) {
+    surface->addDamage(gfx::RectF(blob->bounds()).offset(pos), paint);
     static_cast<os::SkiaSurface*>(surface)->canvas().drawTextBlob(
       skiaBlob->skTextBlob(),
       pos.x,
@@ -88,7 +65,7 @@ void draw_text(os::Surface* surface,
         gfx::PointF subPos = pos;
         if (!run.positions.empty())
           subPos += run.positions[0];
-        draw_text(surface, run.subBlob, subPos, paint);
+        draw_text_blob(surface, run.subBlob, subPos, paint);
         continue;
       }
 
@@ -107,4 +84,51 @@ void draw_text(os::Surface* surface,
   // TODO impl
 }
 
+} // anonymous namespace
+
+void draw_text(os::Surface* surface,
+               const FontRef& font,
+               const std::string& text,
+               gfx::PointF pos,
+               const os::Paint* paint,
+               const TextAlign textAlign)
+{
+  ASSERT(surface);
+  if (!surface)
+    return;
+
+  const TextBlobRef blob = TextBlob::Make(font, text);
+  if (!blob)
+    return;
+
+  switch (textAlign) {
+    case TextAlign::Left:   break;
+    case TextAlign::Center: pos.x -= blob->bounds().w / 2.0f; break;
+    case TextAlign::Right:  pos.x -= blob->bounds().w; break;
+  }
+
+  draw_text(surface, blob, pos, paint);
+}
+
+void draw_text(os::Surface* surface,
+               const TextBlobRef& blob,
+               const gfx::PointF& pos,
+               const os::Paint* paint)
+{
+  ASSERT(surface);
+  ASSERT(blob);
+  if (!surface || !blob)
+    return;
+
+  // The blob and the paint are kept in the function as it can be
+  // called later (e.g. when the surface is a RecordingSurface).
+  std::optional<os::Paint> paintCopy;
+  if (paint)
+    paintCopy = *paint;
+  surface->drawFunc(gfx::RectF(blob->bounds()).offset(pos),
+                    [blob, pos, paintCopy](os::Surface* surface) {
+                      draw_text_blob(surface, blob, pos, (paintCopy ? &*paintCopy : nullptr));
+                    });
+}
+
 } // namespace text
@@ -1,5 +1,5 @@
 // LAF Text Library
-// Copyright (c) 2022-2024  Igara Studio S.A.
+// Copyright (c) 2022-2025  Igara Studio S.A.
 // Copyright (C) 2017  David Capello
 //
 // This file is released under the terms of the MIT license.
@@ -19,6 +19,8 @@
 #include "text/fwd.h"
 #include "text/shaper_features.h"
 
+#include <limits>
+
 namespace os {
 class Surface;
 class Paint;
@@ -32,6 +34,22 @@ class DrawTextDelegate {
 public:
   virtual ~DrawTextDelegate() {}
 
+  // Returns true to use spans of text (preProcessSpan()) instead of
+  // individual characters (preProcessChar()/preDrawChar()/
+  // postDrawChar()) to specify the colors of the text. In this case
+  // consecutive glyphs with the same colors are drawn together,
+  // which is a lot faster for long texts (e.g. syntax highlighting).
+  virtual bool useSpans() const { return false; }
+
+  // Called when the character that starts at the UTF-8 byte "index"
+  // is not inside the last returned span. It must set the "fg"/"bg"
+  // colors and return the end of the span (the UTF-8 index after the
+  // last byte that uses these colors).
+  virtual int preProcessSpan(const int index, gfx::Color& fg, gfx::Color& bg)
+  {
+    return std::numeric_limits<int>::max();
+  }
+
   // This is called before drawing the character.
   virtual void preProcessChar(const int index,
                               const codepoint_t codepoint,
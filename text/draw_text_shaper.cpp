@@ -1,5 +1,5 @@
 // LAF Text Library
-// Copyright (c) 2024  Igara Studio S.A.
+// Copyright (c) 2024-2025  Igara Studio S.A.
 //
 // This file is released under the terms of the MIT license.
 // Read LICENSE.txt for more information.
@@ -10,6 +10,7 @@
 
 #include "text/draw_text.h"
 
+#include "base/utf8_decode.h"
 #include "os/paint.h"
 #include "os/surface.h"
 #include "text/sprite_sheet_font.h"
@@ -23,6 +24,9 @@
   #include "include/core/SkCanvas.h"
 #endif
 
+#include <algorithm>
+#include <vector>
+
 namespace text {
 
 namespace {
@@ -42,114 +46,147 @@ public:
     , m_bg(bg)
     , m_origin(origin)
     , m_delegate(delegate)
+    , m_useSpans(delegate && delegate->useSpans())
   {
   }
 
   // TextBlob::RunHandler impl
   void commitRunBuffer(TextBlob::RunInfo& info) override
   {
-    if (info.clusters && info.glyphCount > 0) {
-      float advanceX = 0.0f;
+    if (!info.clusters || info.glyphCount == 0)
+      return;
+
+    // First glyph of the current sub-run of glyphs with the same
+    // colors (only used with spans)
+    int subRunBegin = 0;
+    gfx::RectF subRunBounds;
+
+    const int n = int(info.glyphCount);
+    for (int i = 0; i < n; ++i) {
+      const int utf8Begin = info.utf8Range.begin + info.clusters[i];
+
+      gfx::RectF bounds = info.getGlyphBounds(i);
+      bounds.offset(m_origin);
+
+      if (m_useSpans) {
+        if (utf8Begin < m_spanBegin || utf8Begin >= m_spanEnd) {
+          const gfx::Color fg = m_fg;
+          const gfx::Color bg = m_bg;
+          m_spanBegin = utf8Begin;
+          m_spanEnd = std::max(utf8Begin + 1, m_delegate->preProcessSpan(utf8Begin, m_fg, m_bg));
+
+          if (i > subRunBegin && (fg != m_fg || bg != m_bg)) {
+            drawGlyphs(info, subRunBegin, i, subRunBounds, fg, bg);
+            subRunBegin = i;
+            subRunBounds = gfx::RectF();
+          }
+        }
+        subRunBounds |= bounds;
+        continue;
+      }
 
-      os::Paint paint;
-      paint.style(os::Paint::Fill);
+      if (m_delegate) {
+        // Decode the first code point of the glyph cluster
+        // (without allocating a string for each glyph)
+        base::utf8_decode decode(m_text.begin() + utf8Begin, m_text.end());
+        const codepoint_t codepoint = decode.next();
 
-      for (int i = 0; i < info.glyphCount; ++i) {
-        int utf8Begin, utf8End;
+        m_delegate->preProcessChar(utf8Begin, codepoint, m_fg, m_bg, bounds);
+        m_delegate->preDrawChar(bounds);
+      }
 
-        // LTR
-        if (!info.rtl) {
-          utf8Begin = info.utf8Range.begin + info.clusters[i];
-          utf8End = (i + 1 < info.glyphCount ? info.utf8Range.begin + info.clusters[i + 1] :
-                                               info.utf8Range.end);
-        }
-        // RTL
-        else {
-          utf8Begin = info.utf8Range.begin + info.clusters[i];
-          utf8End = (i == 0 ? info.utf8Range.end : info.utf8Range.begin + info.clusters[i - 1]);
-        }
+      drawGlyphs(info, i, i + 1, bounds, m_fg, m_bg);
 
-        const std::string utf8text = m_text.substr(utf8Begin, utf8End - utf8Begin);
-
-        gfx::RectF bounds = info.getGlyphBounds(i);
-        bounds.offset(m_origin);
-
-        advanceX += bounds.w;
-
-        if (m_delegate) {
-          const std::wstring widetext = base::from_utf8(utf8text);
-          codepoint_t codepoint = 0;
-          if (!widetext.empty()) {
-            // On macOS and Linux wchar_t has 32-bits
-            if constexpr (sizeof(wchar_t) >= 4) {
-              codepoint = widetext[0];
-            }
-            // On Windows wchar_t has 16-bits (wide strings are UTF-16 strings)
-            else if constexpr (sizeof(wchar_t) == 2) {
-              codepoint = base::utf16_to_codepoint(widetext.size() > 1 ? widetext[1] : widetext[0],
-                                                   widetext.size() > 1 ? widetext[0] : 0);
-            }
-            else {
-              codepoint = 0;
-            }
-          }
+      if (m_delegate)
+        m_delegate->postDrawChar(bounds);
+    }
 
-          m_delegate->preProcessChar(utf8Begin, codepoint, m_fg, m_bg, bounds);
-        }
+    if (m_useSpans)
+      drawGlyphs(info, subRunBegin, n, subRunBounds, m_fg, m_bg);
+  }
 
-        if (m_delegate)
-          m_delegate->preDrawChar(bounds);
+private:
+  // Draws the glyphs [begin, end) of the run with the given colors
+  // ("bounds" are the bounds of all these glyphs).
+  void drawGlyphs(const TextBlob::RunInfo& info,
+                  const int begin,
+                  const int end,
+                  const gfx::RectF& bounds,
+                  const gfx::Color fg,
+                  const gfx::Color bg)
+  {
+    if (!m_surface || begin >= end)
+      return;
 
-        if (m_bg != gfx::ColorNone) {
-          paint.color(m_bg);
-          m_surface->drawRect(bounds, paint);
-        }
+    os::Paint paint;
+    paint.style(os::Paint::Fill);
 
-        if (m_surface && info.font) {
-          if (info.font->type() == FontType::SpriteSheet) {
-            const auto* spriteFont = static_cast<const SpriteSheetFont*>(info.font.get());
-            const os::Surface* sheet = spriteFont->sheetSurface();
-            const gfx::Rect sourceBounds = spriteFont->getGlyphBoundsOnSheet(info.glyphs[i]);
-
-            m_surface->drawColoredRgbaSurface(
-              sheet,
-              m_fg,
-              gfx::ColorNone,
-              gfx::Clip(gfx::Point(info.positions[i] + m_origin + info.point), sourceBounds));
-          }
+    if (bg != gfx::ColorNone) {
+      paint.color(bg);
+      m_surface->drawRect(bounds, paint);
+    }
+
+    if (!info.font)
+      return;
+
+    if (info.font->type() == FontType::SpriteSheet) {
+      const auto* spriteFont = static_cast<const SpriteSheetFont*>(info.font.get());
+      const os::Surface* sheet = spriteFont->sheetSurface();
+
+      for (int i = begin; i < end; ++i) {
+        const gfx::Rect sourceBounds = spriteFont->getGlyphBoundsOnSheet(info.glyphs[i]);
+        m_surface->drawColoredRgbaSurface(
+          sheet,
+          fg,
+          gfx::ColorNone,
+          gfx::Clip(gfx::Point(info.positions[i] + m_origin + info.point), sourceBounds));
+      }
+    }
 #if LAF_SKIA
-          else if (info.font->type() == FontType::Native) {
-            SkGlyphID glyphs = info.glyphs[i];
-            SkPoint positions = os::to_skia(info.positions[i]); //
-            uint32_t clusters = info.clusters[i];
-            paint.color(m_fg);
-            static_cast<os::SkiaSurface*>(m_surface)->canvas().drawGlyphs(
-              1,
-              &glyphs,
-              &positions,
-              &clusters,
-              utf8text.size(),
-              utf8text.data(),
-              os::to_skia(m_origin + info.point),
-              static_cast<SkiaFont*>(info.font.get())->skFont(),
-              paint.skPaint());
-          }
-#endif
-        }
+    else if (info.font->type() == FontType::Native) {
+      paint.color(fg);
 
-        if (m_delegate)
-          m_delegate->postDrawChar(bounds);
+      const int n = end - begin;
+      std::vector<SkGlyphID> glyphs(n);
+      std::vector<SkPoint> positions(n);
+      for (int i = 0; i < n; ++i) {
+        glyphs[i] = SkGlyphID(info.glyphs[begin + i]);
+        gfx::PointF pos = info.positions[begin + i];
+        if (info.offsets)
+          pos += info.offsets[begin + i];
+        positions[i] = os::to_skia(pos);
       }
+
+      auto drawFunc = [glyphs = std::move(glyphs),
+                       positions = std::move(positions),
+                       origin = os::to_skia(m_origin + info.point),
+                       font = info.font,
+                       bounds,
+                       paint](os::Surface* surface) {
+        surface->addDamage(bounds, &paint);
+        static_cast<os::SkiaSurface*>(surface)->canvas().drawGlyphs(
+          int(glyphs.size()),
+          glyphs.data(),
+          positions.data(),
+          origin,
+          static_cast<SkiaFont*>(font.get())->skFont(),
+          paint.skPaint());
+      };
+      m_surface->drawFunc(bounds, drawFunc);
     }
+#endif
   }
 
-private:
   os::Surface* m_surface;
   const std::string& m_text;
   gfx::Color m_fg;
   gfx::Color m_bg;
   gfx::PointF m_origin;
   DrawTextDelegate* m_delegate;
+  bool m_useSpans;
+  // Last span returned by DrawTextDelegate::preProcessSpan()
+  int m_spanBegin = 0;
+  int m_spanEnd = 0;
 };
 
 } // anonymous namespace
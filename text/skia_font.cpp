@@ -23,6 +23,16 @@ SkiaFont::~SkiaFont()
 {
 }
 
+FontRef SkiaFontCache::get(const SkFont& skFont)
+{
+  for (const FontRef& font : m_fonts) {
+    if (static_cast<SkiaFont*>(font.get())->skFont() == skFont)
+      return font;
+  }
+  m_fonts.push_back(base::make_ref<SkiaFont>(skFont));
+  return m_fonts.back();
+}
+
 bool SkiaFont::isValid() const
 {
   return true;
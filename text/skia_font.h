@@ -12,6 +12,8 @@
 
 #include "include/core/SkFont.h"
 
+#include <vector>
+
 namespace text {
 
 class SkiaFont : public Font {
@@ -46,6 +48,21 @@ private:
   SkFont m_skFont;
 };
 
+// Reuses the same SkiaFont for all the runs of a text blob with the
+// same SkFont (it's used only while the blob is shaped or visited,
+// so fonts are never shared between blobs). If a run handler
+// modifies a font it doesn't match its SkFont anymore, and the next
+// runs get a new SkiaFont.
+class SkiaFontCache {
+public:
+  FontRef get(const SkFont& skFont);
+
+private:
+  // Just a few fonts are used in a blob (the original font + some
+  // fallbacks), so a linear search is enough.
+  std::vector<FontRef> m_fonts;
+};
+
 } // namespace text
 
 #endif
@@ -1,5 +1,5 @@
 // LAF Text Library
-// Copyright (c) 2024  Igara Studio S.A.
+// Copyright (c) 2024-2025  Igara Studio S.A.
 //
 // This file is released under the terms of the MIT license.
 // Read LICENSE.txt for more information.
@@ -29,10 +29,11 @@ void SkiaTextBlob::visitRuns(const RunVisitor& visitor)
   SkTextBlob::Iter::ExperimentalRun run;
   TextBlob::RunInfo subInfo;
   std::vector<gfx::PointF> positions;
+  SkiaFontCache fonts;
 
   while (iter.experimentalNext(&run)) {
     const int n = run.count;
-    subInfo.font = base::make_ref<SkiaFont>(run.font);
+    subInfo.font = fonts.get(run.font);
     subInfo.glyphCount = n;
     subInfo.glyphs = const_cast<glyph_t*>(run.glyphs);
     if (positions.size() < n)
@@ -1,5 +1,5 @@
 // LAF Text Library
-// Copyright (C) 2019-2024  Igara Studio S.A.
+// Copyright (C) 2019-2025  Igara Studio S.A.
 //
 // This file is released under the terms of the MIT license.
 // Read LICENSE.txt for more information.
@@ -23,6 +23,7 @@
 #include "modules/skshaper/include/SkShaper.h"
 
 #include <limits>
+#include <memory>
 #include <vector>
 
 namespace text {
@@ -63,7 +64,7 @@ public:
     // Now the m_buffer field is valid and can be used
     size_t n = info.glyphCount;
     TextBlob::RunInfo subInfo;
-    subInfo.font = base::make_ref<SkiaFont>(info.fFont);
+    subInfo.font = m_fonts.get(info.fFont);
     subInfo.glyphCount = n;
     subInfo.rtl = (info.fBidiLevel & 1);
     subInfo.utf8Range.begin = info.utf8Range.begin();
@@ -106,9 +107,89 @@ private:
   Buffer m_buffer;
   std::vector<gfx::PointF> m_positions;
   std::vector<gfx::PointF> m_offsets;
+  SkiaFontCache m_fonts;
   gfx::RectF m_bounds;
 };
 
+// Shaping state reused between MakeWithShaper() calls from the same
+// thread. Creating the SkShaper (HarfBuzz font/buffer caches) for
+// each call dominated the time to shape short UI strings.
+class ShapingContext {
+public:
+  static ShapingContext& instance()
+  {
+    static thread_local ShapingContext ctx;
+    return ctx;
+  }
+
+  // Returns nullptr if the context is already in use (e.g. if
+  // MakeWithShaper() is called from a TextBlob::RunHandler).
+  SkShaper* acquire(const sk_sp<SkFontMgr>& fontMgr)
+  {
+    if (m_busy)
+      return nullptr;
+    if (!m_shaper || m_fontMgr != fontMgr) {
+      m_fontMgr = fontMgr;
+      m_shaper = SkShaper::Make(fontMgr);
+      if (!m_shaper)
+        return nullptr;
+    }
+    m_busy = true;
+    return m_shaper.get();
+  }
+
+  void release() { m_busy = false; }
+
+private:
+  sk_sp<SkFontMgr> m_fontMgr;
+  std::unique_ptr<SkShaper> m_shaper;
+  bool m_busy = false;
+};
+
+// Uses the shaper of the thread's ShapingContext while this object
+// is alive (or a temporary shaper if the context is in use), so the
+// context is released even if the shaping throws an exception.
+class ShaperScope {
+public:
+  ShaperScope(const sk_sp<SkFontMgr>& fontMgr)
+    : m_ctx(ShapingContext::instance())
+    , m_shaper(m_ctx.acquire(fontMgr))
+  {
+    if (!m_shaper) {
+      m_ownShaper = SkShaper::Make(fontMgr);
+      m_shaper = m_ownShaper.get();
+    }
+  }
+
+  ~ShaperScope()
+  {
+    if (!m_ownShaper && m_shaper)
+      m_ctx.release();
+  }
+
+  SkShaper* shaper() const { return m_shaper; }
+
+private:
+  ShapingContext& m_ctx;
+  SkShaper* m_shaper;
+  std::unique_ptr<SkShaper> m_ownShaper;
+};
+
+// Returns true if the text is all ASCII, so we can avoid the ICU
+// BiDi and script detection (it's always left-to-right, and Latin
+// or Common script).
+bool is_ascii(const std::string& text, bool& hasLetters)
+{
+  hasLetters = false;
+  for (const char chr : text) {
+    if (chr & 0x80)
+      return false;
+    if ((chr >= 'a' && chr <= 'z') || (chr >= 'A' && chr <= 'Z'))
+      hasLetters = true;
+  }
+  return true;
+}
+
 } // namespace
 
 TextBlobRef SkiaTextBlob::MakeWithShaper(const FontMgrRef& fontMgr,
@@ -125,12 +206,25 @@ TextBlobRef SkiaTextBlob::MakeWithShaper(const FontMgrRef& fontMgr,
   auto skFontMgr = static_cast<SkiaFontMgr*>(fontMgr.get())->skFontMgr();
   sk_sp<SkTextBlob> textBlob;
   gfx::RectF bounds;
-  if (auto shaper = SkShaper::Make(skFontMgr)) {
+  ShaperScope scope(skFontMgr);
+
+  if (SkShaper* shaper = scope.shaper()) {
     ShaperRunHandler shaperHandler(text.c_str(), { 0, 0 }, handler);
 
-    auto bidiRun = SkShaper::MakeBiDiRunIterator(text.c_str(), text.size(), 0xfe);
-    constexpr SkFourByteTag tag = SkSetFourByteTag('Z', 'y', 'y', 'y');
-    auto scriptRun = SkShaper::MakeScriptRunIterator(text.c_str(), text.size(), tag);
+    std::unique_ptr<SkShaper::BiDiRunIterator> bidiRun;
+    std::unique_ptr<SkShaper::ScriptRunIterator> scriptRun;
+    bool hasLetters;
+    if (is_ascii(text, hasLetters)) {
+      bidiRun = std::make_unique<SkShaper::TrivialBiDiRunIterator>(0, text.size());
+      scriptRun = std::make_unique<SkShaper::TrivialScriptRunIterator>(
+        hasLetters ? SkSetFourByteTag('L', 'a', 't', 'n') : SkSetFourByteTag('Z', 'y', 'y', 'y'),
+        text.size());
+    }
+    else {
+      bidiRun = SkShaper::MakeBiDiRunIterator(text.c_str(), text.size(), 0xfe);
+      constexpr SkFourByteTag tag = SkSetFourByteTag('Z', 'y', 'y', 'y');
+      scriptRun = SkShaper::MakeScriptRunIterator(text.c_str(), text.size(), tag);
+    }
     auto languageRun = SkShaper::MakeStdLanguageRunIterator(text.c_str(), text.size());
     auto fontRun = SkShaper::MakeFontMgrRunIterator(text.c_str(),
                                                     text.size(),